@@ -12,26 +12,56 @@
 #include <string>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/LifetimeSanitizer.h"
+#include "Common/Microcontroller/MessageProtocol.h"
 
 namespace PokemonAutomation{
 
 
+//  Message bodies are never longer than PABB_MAX_MESSAGE_SIZE so they are
+//  stored inline. Building, copying and queuing a message never allocates.
+class BotBaseMessageBody{
+public:
+    BotBaseMessageBody() = default;
+    BotBaseMessageBody(const void* data, size_t bytes){
+        if (bytes > PABB_MAX_MESSAGE_SIZE){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Message is too long: " + std::to_string(bytes));
+        }
+        memcpy(m_data, data, bytes);
+        m_size = (uint8_t)bytes;
+    }
+
+    size_t size() const{ return m_size; }
+    const char* data() const{ return m_data; }
+    char* data(){ return m_data; }
+
+    std::string to_string() const{ return std::string(m_data, m_size); }
+
+private:
+    alignas(uint64_t) char m_data[PABB_MAX_MESSAGE_SIZE];
+    uint8_t m_size = 0;
+};
+
+
 struct BotBaseMessage{
     uint8_t type;
-    std::string body;
+    BotBaseMessageBody body;
 
     LifetimeSanitizer sanitizer;
 
     BotBaseMessage() = default;
-    BotBaseMessage(uint8_t p_type, std::string p_body)
+    BotBaseMessage(uint8_t p_type, const void* data, size_t bytes)
+        : type(p_type)
+        , body(data, bytes)
+    {}
+    BotBaseMessage(uint8_t p_type, const std::string& p_body)
         : type(p_type)
-        , body(std::move(p_body))
+        , body(p_body.data(), p_body.size())
     {}
 
     template <typename Params>
     BotBaseMessage(uint8_t p_type, const Params& params)
         : type(p_type)
-        , body((char*)&params, sizeof(params))
+        , body(&params, sizeof(params))
     {}
 
     template <uint8_t MessageType, typename MessageBody>
@@ -49,7 +79,7 @@ struct BotBaseMessage{
                 "Received incorrect response size: " + std::to_string(body.size())
             );
         }
-        memcpy(&params, body.c_str(), body.size());
+        memcpy(&params, body.data(), body.size());
         sanitizer.check_usage();
     }
 
@@ -0,0 +1,139 @@
+/*  Emulated Serial Link
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/PanicDump.h"
+#include "EmulatedLink.h"
+
+namespace PokemonAutomation{
+
+
+std::string EmulatedLinkSettings::to_str() const{
+    std::string str;
+    str += baud_rate == 0 ? "unthrottled" : std::to_string(baud_rate) + " baud";
+    str += ", latency = " + tostr_fixed(latency.count() / 1000., 1) + " ms";
+    str += " (+" + tostr_fixed(jitter.count() / 1000., 1) + " ms)";
+    str += ", drop = " + tostr_fixed(drop_rate * 100, 1) + "%";
+    str += ", corrupt = " + tostr_fixed(corrupt_rate * 100, 1) + "%";
+    return str;
+}
+
+
+
+EmulatedLink::EmulatedLink(const EmulatedLinkSettings& settings, Receiver receiver)
+    : m_settings(settings)
+    , m_receiver(std::move(receiver))
+    , m_stopping(false)
+    , m_wire_free(WallClock::min())
+    , m_last_delivery(WallClock::min())
+    , m_rng(settings.seed)
+    , m_thread(run_with_catch, "EmulatedLink::thread_loop()", [this]{ thread_loop(); })
+{}
+EmulatedLink::~EmulatedLink(){
+    stop();
+}
+void EmulatedLink::stop(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (m_stopping){
+            return;
+        }
+        m_stopping = true;
+        m_queue.clear();
+        m_cv.notify_all();
+    }
+    m_thread.join();
+}
+
+EmulatedLinkStats EmulatedLink::stats() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_stats;
+}
+
+
+
+void EmulatedLink::send(const void* data, size_t bytes){
+    if (bytes == 0){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_stopping){
+        return;
+    }
+
+    m_stats.packets++;
+    m_stats.bytes += bytes;
+
+    //  The packet still occupies the wire even if it gets lost.
+    WallClock now = current_time();
+    WallClock start = std::max(now, m_wire_free);
+    if (m_settings.baud_rate != 0){
+        m_wire_free = start + std::chrono::microseconds(bytes * 10 * 1000000 / m_settings.baud_rate);
+    }else{
+        m_wire_free = start;
+    }
+
+    std::uniform_real_distribution<double> uniform(0, 1);
+    if (uniform(m_rng) < m_settings.drop_rate){
+        m_stats.dropped++;
+        return;
+    }
+
+    Packet packet;
+    packet.data.assign((const char*)data, bytes);
+    if (uniform(m_rng) < m_settings.corrupt_rate){
+        m_stats.corrupted++;
+        size_t bit = std::uniform_int_distribution<size_t>(0, bytes * 8 - 1)(m_rng);
+        packet.data[bit / 8] ^= (char)(1 << (bit % 8));
+    }
+
+    WallClock deliver = m_wire_free + m_settings.latency;
+    if (m_settings.jitter.count() > 0){
+        deliver += std::chrono::microseconds(
+            std::uniform_int_distribution<int64_t>(0, m_settings.jitter.count())(m_rng)
+        );
+    }
+
+    //  Jitter can't reorder anything.
+    deliver = std::max(deliver, m_last_delivery);
+    m_last_delivery = deliver;
+
+    packet.deliver = deliver;
+    m_queue.emplace_back(std::move(packet));
+    m_cv.notify_all();
+}
+
+
+void EmulatedLink::thread_loop(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (true){
+        if (m_stopping){
+            return;
+        }
+        if (m_queue.empty()){
+            m_cv.wait(lg);
+            continue;
+        }
+        WallClock deliver = m_queue.front().deliver;
+        if (current_time() < deliver){
+            m_cv.wait_until(lg, deliver);
+            continue;
+        }
+
+        Packet packet = std::move(m_queue.front());
+        m_queue.pop_front();
+
+        lg.unlock();
+        m_receiver(packet.data.data(), packet.data.size());
+        lg.lock();
+    }
+}
+
+
+
+}
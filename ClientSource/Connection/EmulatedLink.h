@@ -0,0 +1,103 @@
+/*  Emulated Serial Link
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      One direction of an emulated serial line. Everything passed to
+ *  "send()" is delivered to the receiver on a separate thread after it has
+ *  been throttled to the baud rate and delayed by the latency and jitter.
+ *  Each "send()" call is treated as one packet which may be dropped or have
+ *  a bit flipped.
+ *
+ *  Delivery is always in order, just like a real serial line.
+ *
+ */
+
+#ifndef PokemonAutomation_EmulatedLink_H
+#define PokemonAutomation_EmulatedLink_H
+
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <random>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+
+struct EmulatedLinkSettings{
+    //  8N1, so 10 bits per byte. Zero is unthrottled.
+    uint32_t baud_rate = 0;
+
+    //  Each packet is delayed by "latency" plus a uniform random amount
+    //  up to "jitter".
+    std::chrono::microseconds latency{0};
+    std::chrono::microseconds jitter{0};
+
+    //  Probability that a packet is dropped or has one bit flipped.
+    double drop_rate = 0;
+    double corrupt_rate = 0;
+
+    uint64_t seed = 0;
+
+    std::string to_str() const;
+};
+
+struct EmulatedLinkStats{
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint64_t dropped = 0;
+    uint64_t corrupted = 0;
+};
+
+
+class EmulatedLink{
+public:
+    using Receiver = std::function<void(const void* data, size_t bytes)>;
+
+public:
+    EmulatedLink(const EmulatedLinkSettings& settings, Receiver receiver);
+    ~EmulatedLink();
+
+    //  Drop everything that hasn't been delivered yet. The receiver will not
+    //  be called again after this returns.
+    void stop();
+
+    void send(const void* data, size_t bytes);
+
+    EmulatedLinkStats stats() const;
+
+
+private:
+    void thread_loop();
+
+
+private:
+    struct Packet{
+        WallClock deliver;
+        std::string data;
+    };
+
+    const EmulatedLinkSettings m_settings;
+    const Receiver m_receiver;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+
+    std::deque<Packet> m_queue;
+    WallClock m_wire_free;
+    WallClock m_last_delivery;
+    std::mt19937_64 m_rng;
+    EmulatedLinkStats m_stats;
+
+    std::thread m_thread;
+};
+
+
+
+}
+#endif
@@ -34,7 +34,7 @@ void MessageLogger::on_send(const BotBaseMessage& message, bool is_retransmit){
 #if 0
         if (message.type == PABB_MSG_CONTROLLER_STATE){
             pabb_controller_state body;
-            memcpy(&body, message.body.c_str(), sizeof(pabb_controller_state));
+            memcpy(&body, message.body.data(), sizeof(pabb_controller_state));
             print = body.ticks >= 5;
         }
 #endif
@@ -43,6 +43,8 @@ PABotBase::PABotBase(
     , m_send_seq(1)
     , m_retransmit_delay(retransmit_delay)
     , m_last_ack(current_time())
+    , m_rtt(retransmit_delay)
+    , m_retransmit_wakeup(WallClock::max())
     , m_state(State::RUNNING)
     , m_error(false)
     , m_retransmit_thread(run_with_catch, "PABotBase::retransmit_thread()", [this]{ retransmit_thread(); })
@@ -62,11 +64,11 @@ size_t PABotBase::inflight_requests(){
     //  Must be called under m_state_lock.
 
     size_t ret = m_pending_requests.size();
-    for (const auto& item : m_pending_commands){
-        if (item.second.state == AckState::NOT_ACKED){
+    m_pending_commands.for_each([&](uint64_t, const PendingCommand& command){
+        if (command.state == AckState::NOT_ACKED){
             ret++;
         }
-    }
+    });
     return ret;
 }
 
@@ -91,9 +93,12 @@ void PABotBase::stop(){
     {
         std::lock_guard<std::mutex> lg(m_sleep_lock);
         m_cv.notify_all();
+        m_retransmit_cv.notify_all();
     }
     m_retransmit_thread.join();
 
+    m_logger.log("Serial Connection: " + rtt_stats().to_str(), COLOR_DARKGREEN);
+
     {
         SpinLockGuard lg(m_state_lock, "PABotBase::stop()");
 
@@ -105,7 +110,7 @@ void PABotBase::stop(){
         memcpy(&params, &seqnum_s, sizeof(seqnum_t));
 //        try_issue_request<PABB_MSG_REQUEST_STOP>(params);
 //        m_state.store(State::STOPPING, std::memory_order_release);
-        BotBaseMessage stop_request(PABB_MSG_REQUEST_STOP, std::string((char*)&params, sizeof(params)));
+        BotBaseMessage stop_request(PABB_MSG_REQUEST_STOP, params);
         send_message(stop_request, false);
     }
 
@@ -120,6 +125,15 @@ void PABotBase::stop(){
 void PABotBase::set_queue_limit(size_t queue_limit){
     m_max_pending_requests.store(queue_limit, std::memory_order_relaxed);
 }
+RttStats PABotBase::rtt_stats(){
+    //  Only copy the estimator under the lock. Every send and ack needs it.
+    //  Sort the samples after it's released.
+    RttEstimator rtt = [&]{
+        SpinLockGuard lg(m_state_lock, "PABotBase::rtt_stats()");
+        return m_rtt;
+    }();
+    return rtt.stats();
+}
 
 void PABotBase::wait_for_all_requests(const Cancellable* cancelled){
     m_sanitizer.check_usage();
@@ -231,46 +245,40 @@ void PABotBase::clear_all_active_commands(uint64_t seqnum){
 //        cout << "asdf" << endl;
 //    }
 
-    if (!m_pending_commands.empty()){
-        //  Remove all active commands up to the seqnum.
-        while (true){
-            auto iter = m_pending_commands.begin();
-            if (iter == m_pending_commands.end() || iter->first > seqnum){
-                break;
-            }
-            iter->second.sanitizer.check_usage();
-            m_pending_commands.erase(iter);
+    //  Remove all active commands up to the seqnum.
+    while (!m_pending_commands.empty()){
+        uint64_t oldest = m_pending_commands.oldest();
+        if (oldest > seqnum){
+            break;
         }
+        m_pending_commands.find(oldest)->sanitizer.check_usage();
+        m_pending_commands.erase(oldest);
     }
 
     m_cv.notify_all();
 }
-template <typename Map>
-uint64_t PABotBase::infer_full_seqnum(const Map& map, seqnum_t seqnum) const{
+template <typename Table>
+uint64_t PABotBase::infer_full_seqnum(const Table& table, seqnum_t seqnum) const{
     m_sanitizer.check_usage();
 
     //  The protocol uses a 32-bit seqnum that wraps around. For our purposes of
     //  retransmits, we use a full 64-bit seqnum to maintain sorting order
     //  across the wrap-arounds.
 
-    //  Since the oldest unacked messaged will never be more than 63 (MAX_SEQNUM_GAP)
+    //  Since the oldest unacked messaged will never be more than MAX_SEQNUM_GAP
     //  requests old, there is no ambiguity on which request is being referred
     //  to with just the lower 32 bits.
     //  Here we infer the upper 32 bits of the seqnum to obtain the full 64-bit
-    //  seqnum that we need to index our map.
+    //  seqnum that we need to index our table.
 
-    //  This needs to be called inside the lock. Furthermore, the map must not
-    //  be empty. If it is empty, we know we don't have it and can drop it
+    //  This needs to be called inside the lock. Furthermore, the table must
+    //  not be empty. If it is empty, we know we don't have it and can drop it
     //  before we even call this function.
 
-    //  Figure out the upper 32 bits of the seqnum.
-    uint64_t lo = map.begin()->first;
-    uint64_t hi = map.rbegin()->first;
-    uint64_t lo_candidate = (lo & 0xffffffff00000000) | seqnum;
-    uint64_t hi_candidate = (hi & 0xffffffff00000000) | seqnum;
-    return lo_candidate >= lo
-        ? lo_candidate
-        : hi_candidate;
+    //  The only candidate is the first one at or after the oldest live seqnum.
+    //  Anything else will not be found in the table.
+    uint64_t oldest = table.oldest();
+    return oldest + (seqnum_t)(seqnum - (seqnum_t)oldest);
 }
 
 uint64_t PABotBase::oldest_live_seqnum() const{
@@ -279,10 +287,10 @@ uint64_t PABotBase::oldest_live_seqnum() const{
     //  Must call under state lock.
     uint64_t oldest = m_send_seq;
     if (!m_pending_requests.empty()){
-        oldest = std::min(oldest, m_pending_requests.begin()->first);
+        oldest = std::min(oldest, m_pending_requests.oldest());
     }
     if (!m_pending_commands.empty()){
-        oldest = std::min(oldest, m_pending_commands.begin()->first);
+        oldest = std::min(oldest, m_pending_commands.oldest());
     }
     return oldest;
 }
@@ -295,7 +303,7 @@ void PABotBase::process_ack_request(BotBaseMessage message){
         m_sniffer->log("Ignoring message with invalid size.");
         return;
     }
-    const Params* params = (const Params*)message.body.c_str();
+    const Params* params = (const Params*)message.body.data();
     seqnum_t seqnum = params->seqnum;
 
     AckState state;
@@ -308,20 +316,23 @@ void PABotBase::process_ack_request(BotBaseMessage message){
         }
 
         uint64_t full_seqnum = infer_full_seqnum(m_pending_requests, seqnum);
-        std::map<uint64_t, PendingRequest>::iterator iter = m_pending_requests.find(full_seqnum);
-        if (iter == m_pending_requests.end()){
+        PendingRequest* handle = m_pending_requests.find(full_seqnum);
+        if (handle == nullptr){
             m_sniffer->log("Unexpected request ack message: seqnum = " + std::to_string(seqnum));
             return;
         }
-        iter->second.sanitizer.check_usage();
+        handle->sanitizer.check_usage();
 
-        state = iter->second.state;
+        state = handle->state;
         if (state == AckState::NOT_ACKED){
-            if (iter->second.silent_remove){
-                m_pending_requests.erase(iter);
+            if (handle->retransmits == 0){
+                m_rtt.add_sample(std::chrono::duration_cast<std::chrono::microseconds>(current_time() - handle->first_sent));
+            }
+            if (handle->silent_remove){
+                m_pending_requests.erase(full_seqnum);
             }else{
-                iter->second.state = AckState::ACKED;
-                iter->second.ack = std::move(message);
+                handle->state = AckState::ACKED;
+                handle->ack = std::move(message);
             }
         }
     }
@@ -351,7 +362,7 @@ void PABotBase::process_ack_command(BotBaseMessage message){
         m_sniffer->log("Ignoring message with invalid size.");
         return;
     }
-    const Params* params = (const Params*)message.body.c_str();
+    const Params* params = (const Params*)message.body.data();
     seqnum_t seqnum = params->seqnum;
 
     SpinLockGuard lg(m_state_lock, "PABotBase::process_ack_command()");
@@ -362,20 +373,23 @@ void PABotBase::process_ack_command(BotBaseMessage message){
     }
 
     uint64_t full_seqnum = infer_full_seqnum(m_pending_commands, seqnum);
-    auto iter = m_pending_commands.find(full_seqnum);
-    if (iter == m_pending_commands.end()){
+    PendingCommand* handle = m_pending_commands.find(full_seqnum);
+    if (handle == nullptr){
         m_sniffer->log("Unexpected command ack message: seqnum = " + std::to_string(seqnum));
         return;
     }
-    iter->second.sanitizer.check_usage();
+    handle->sanitizer.check_usage();
 
     m_last_ack.store(current_time(), std::memory_order_release);
 
-    switch (iter->second.state){
+    switch (handle->state){
     case AckState::NOT_ACKED:
 //        std::cout << "acked: " << full_seqnum << std::endl;
-        iter->second.state = AckState::ACKED;
-        iter->second.ack = std::move(message);
+        if (handle->retransmits == 0){
+            m_rtt.add_sample(std::chrono::duration_cast<std::chrono::microseconds>(current_time() - handle->first_sent));
+        }
+        handle->state = AckState::ACKED;
+        handle->ack = std::move(message);
         return;
     case AckState::ACKED:
         m_sniffer->log("Duplicate command ack message: seqnum = " + std::to_string(seqnum));
@@ -393,7 +407,7 @@ void PABotBase::process_command_finished(BotBaseMessage message){
         m_sniffer->log("Ignoring message with invalid size.");
         return;
     }
-    const Params* params = (const Params*)message.body.c_str();
+    const Params* params = (const Params*)message.body.data();
     seqnum_t seqnum = params->seqnum;
     seqnum_t command_seqnum = params->seq_of_original_command;
 
@@ -405,7 +419,7 @@ void PABotBase::process_command_finished(BotBaseMessage message){
     std::lock_guard<std::mutex> lg0(m_sleep_lock);
     SpinLockGuard lg1(m_state_lock, "PABotBase::process_command_finished() - 0");
 
-    send_message(BotBaseMessage(PABB_MSG_ACK_REQUEST, std::string((char*)&ack, sizeof(ack))), false);
+    send_message(BotBaseMessage(PABB_MSG_ACK_REQUEST, ack), false);
 
     if (m_pending_commands.empty()){
         m_sniffer->log(
@@ -416,23 +430,23 @@ void PABotBase::process_command_finished(BotBaseMessage message){
     }
 
     uint64_t full_seqnum = infer_full_seqnum(m_pending_commands, command_seqnum);
-    auto iter = m_pending_commands.find(full_seqnum);
-    if (iter == m_pending_commands.end()){
+    PendingCommand* handle = m_pending_commands.find(full_seqnum);
+    if (handle == nullptr){
         m_sniffer->log(
             "Unexpected command finished message: seqnum = " + std::to_string(seqnum) +
             ", command_seqnum = " + std::to_string(command_seqnum)
         );
         return;
     }
-    iter->second.sanitizer.check_usage();
+    handle->sanitizer.check_usage();
 
-    switch (iter->second.state){
+    switch (handle->state){
     case AckState::NOT_ACKED:
     case AckState::ACKED:
-        iter->second.state = AckState::FINISHED;
-        iter->second.ack = std::move(message);
-        if (iter->second.silent_remove){
-            m_pending_commands.erase(iter);
+        handle->state = AckState::FINISHED;
+        handle->ack = std::move(message);
+        if (handle->silent_remove){
+            m_pending_commands.erase(full_seqnum);
         }
         m_cv.notify_all();
         return;
@@ -465,7 +479,7 @@ void PABotBase::on_recv_message(BotBaseMessage message){
             m_sniffer->log("Ignoring message with invalid size.");
             return;
         }
-        const pabb_MsgInfoInvalidType* params = (const pabb_MsgInfoInvalidType*)message.body.c_str();
+        const pabb_MsgInfoInvalidType* params = (const pabb_MsgInfoInvalidType*)message.body.data();
         m_error_message = "PABotBase incompatibility. Device does not recognize message type: " + std::to_string(params->type);
         m_logger.log(m_error_message, COLOR_RED);
         m_error.store(true, std::memory_order_release);
@@ -477,7 +491,7 @@ void PABotBase::on_recv_message(BotBaseMessage message){
             m_sniffer->log("Ignoring message with invalid size.");
             return;
         }
-        const pabb_MsgInfoMissedRequest* params = (const pabb_MsgInfoMissedRequest*)message.body.c_str();
+        const pabb_MsgInfoMissedRequest* params = (const pabb_MsgInfoMissedRequest*)message.body.data();
         if (params->seqnum == 1){
             m_error_message = "Serial connection has been interrupted.";
             m_logger.log(m_error_message, COLOR_RED);
@@ -494,51 +508,112 @@ void PABotBase::on_recv_message(BotBaseMessage message){
     }
 }
 
+template <typename Pending>
+void PABotBase::schedule_retransmit(Pending& pending, uint64_t seqnum, bool is_command, WallClock now){
+    //  Must call under state lock.
+    pending.timeout = pending.retransmits == 0
+        ? m_rtt.rto()
+        : RttEstimator::backoff(pending.timeout);
+    pending.retransmit_deadline = now + pending.timeout;
+    m_retransmit_timers.push(RetransmitTimer{pending.retransmit_deadline, seqnum, is_command});
+}
+template <typename Pending>
+void PABotBase::resend(Pending& pending, uint64_t seqnum, bool is_command, WallClock now){
+    //  Must call under state lock.
+    pending.sanitizer.check_usage();
+
+    send_message(pending.request, true);
+    m_rtt.count_retransmit();
+    pending.retransmits++;
+    schedule_retransmit(pending, seqnum, is_command, now);
+}
+template <typename Pending>
+void PABotBase::retransmit(Pending* pending, const RetransmitTimer& timer, WallClock now){
+    //  Must call under state lock.
+
+    //  Already acked or removed.
+    if (pending == nullptr || pending->state != AckState::NOT_ACKED){
+        return;
+    }
+
+    //  Already resent and rescheduled since this timer was set.
+    if (timer.deadline != pending->retransmit_deadline){
+        return;
+    }
+
+    resend(*pending, timer.seqnum, timer.is_command, now);
+
+    //  If this message was lost, the device has dropped every message after
+    //  it as well (#8 in MessageProtocol.h). Resend the unacked ones now, in
+    //  order. Otherwise each waits for its own timer, new messages keep
+    //  arriving ahead of them and the device stays behind. If they did
+    //  arrive, the device just acks them again. (#9)
+    for (uint64_t seqnum = timer.seqnum + 1; seqnum < m_send_seq; seqnum++){
+        PendingRequest* request = m_pending_requests.find(seqnum);
+        if (request != nullptr && request->state == AckState::NOT_ACKED){
+            resend(*request, seqnum, false, now);
+        }
+        PendingCommand* command = m_pending_commands.find(seqnum);
+        if (command != nullptr && command->state == AckState::NOT_ACKED){
+            resend(*command, seqnum, true, now);
+        }
+    }
+}
+void PABotBase::wake_retransmit_thread(WallClock deadline){
+    //  Must call without any locks.
+
+    //  Pull in the retransmit thread's wake up time if this is due sooner.
+    //  It rechecks this under m_sleep_lock before it sleeps so the notify
+    //  can't be missed.
+    WallClock wakeup = m_retransmit_wakeup.load(std::memory_order_acquire);
+    while (deadline < wakeup){
+        if (m_retransmit_wakeup.compare_exchange_weak(wakeup, deadline)){
+            std::lock_guard<std::mutex> lg(m_sleep_lock);
+            m_retransmit_cv.notify_all();
+            return;
+        }
+    }
+}
 void PABotBase::retransmit_thread(){
     m_sanitizer.check_usage();
 
 //    cout << "retransmit_thread()" << endl;
-    auto last_sent = current_time();
     while (m_state.load(std::memory_order_acquire) == State::RUNNING){
-        auto now = current_time();
-
-        if (now - last_sent < m_retransmit_delay){
-            std::unique_lock<std::mutex> lg(m_sleep_lock);
-            if (m_state.load(std::memory_order_acquire) != State::RUNNING){
-                break;
-            }
-            if (m_error.load(std::memory_order_acquire)){
-                break;
+        WallClock next_wakeup;
+        {
+            //  Process retransmits.
+            SpinLockGuard lg(m_state_lock, "PABotBase::retransmit_thread()");
+
+            //  Retransmit
+            //      Pop every timer that is due and retransmit the message if
+            //  it still hasn't been acked. Each retransmit is rescheduled with
+            //  double the timeout.
+            WallClock now = current_time();
+            while (!m_retransmit_timers.empty() && m_retransmit_timers.top().deadline <= now){
+                RetransmitTimer timer = m_retransmit_timers.top();
+                m_retransmit_timers.pop();
+                if (timer.is_command){
+                    retransmit(m_pending_commands.find(timer.seqnum), timer, now);
+                }else{
+                    retransmit(m_pending_requests.find(timer.seqnum), timer, now);
+                }
             }
-            m_cv.wait_for(lg, m_retransmit_delay);
-            continue;
-        }
-
-        //  Process retransmits.
-        SpinLockGuard lg(m_state_lock, "PABotBase::retransmit_thread()");
-//        std::cout << "retransmit_thread - m_pending_messages.size(): " << m_pending_messages.size() << std::endl;
-//        cout << "m_pending_messages.size()" << endl;
-
-        //  Retransmit
-        //      Iterate through all pending requests and retransmit them in
-        //  chronological order. Skip the ones that are new.
-        for (auto& item : m_pending_requests){
-            item.second.sanitizer.check_usage();
-            if (item.second.state == AckState::NOT_ACKED &&
-                current_time() - item.second.first_sent >= m_retransmit_delay
-            ){
-                send_message(item.second.request, true);
+
+            next_wakeup = now + m_retransmit_delay;
+            if (!m_retransmit_timers.empty()){
+                next_wakeup = std::min(next_wakeup, m_retransmit_timers.top().deadline);
             }
+            m_retransmit_wakeup.store(next_wakeup, std::memory_order_release);
         }
-        for (auto& item : m_pending_commands){
-            item.second.sanitizer.check_usage();
-            if (item.second.state == AckState::NOT_ACKED &&
-                current_time() - item.second.first_sent >= m_retransmit_delay
-            ){
-                send_message(item.second.request, true);
-            }
+
+        std::unique_lock<std::mutex> lg(m_sleep_lock);
+        if (m_error.load(std::memory_order_acquire)){
+            break;
         }
-        last_sent = current_time();
+        m_retransmit_cv.wait_until(lg, next_wakeup, [&]{
+            return m_state.load(std::memory_order_acquire) != State::RUNNING ||
+                m_retransmit_wakeup.load(std::memory_order_acquire) < next_wakeup;
+        });
     }
 //    cout << "retransmit_thread() - exit" << endl;
 }
@@ -560,54 +635,61 @@ uint64_t PABotBase::try_issue_request(
         throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
     }
 
-    SpinLockGuard lg(m_state_lock, "PABotBase::try_issue_request()");
-    if (cancelled != nullptr && cancelled->cancelled()){
-        throw OperationCancelledException();
-    }
+    uint64_t seqnum;
+    WallClock deadline;
+    {
+        SpinLockGuard lg(m_state_lock, "PABotBase::try_issue_request()");
+        if (cancelled != nullptr && cancelled->cancelled()){
+            throw OperationCancelledException();
+        }
 
-    State state = m_state.load(std::memory_order_acquire);
-    if (state != State::RUNNING){
-        throw InvalidConnectionStateException();
-    }
-    if (m_error.load(std::memory_order_acquire)){
-        throw ConnectionException(&m_logger, m_error_message);
-    }
+        State state = m_state.load(std::memory_order_acquire);
+        if (state != State::RUNNING){
+            throw InvalidConnectionStateException();
+        }
+        if (m_error.load(std::memory_order_acquire)){
+            throw ConnectionException(&m_logger, m_error_message);
+        }
 
-    size_t queue_limit = m_max_pending_requests.load(std::memory_order_relaxed);
+        size_t queue_limit = m_max_pending_requests.load(std::memory_order_relaxed);
 
-    //  Too many unacked requests in flight.
-    if (inflight_requests() >= queue_limit){
-        m_logger.log("Message throttled due to too many inflight requests.");
-        return 0;
-    }
+        //  Too many unacked requests in flight.
+        if (inflight_requests() >= queue_limit){
+            m_logger.log("Message throttled due to too many inflight requests.");
+            return 0;
+        }
 
-    //  Don't get too far ahead of the oldest seqnum.
-    uint64_t seqnum = m_send_seq;
-    if (seqnum - oldest_live_seqnum() > MAX_SEQNUM_GAP){
-        return 0;
-    }
+        //  Don't get too far ahead of the oldest seqnum.
+        seqnum = m_send_seq;
+        if (seqnum - oldest_live_seqnum() > MAX_SEQNUM_GAP){
+            return 0;
+        }
 
-    seqnum_t seqnum_s = (seqnum_t)seqnum;
-    memcpy(&message.body[0], &seqnum_s, sizeof(seqnum_t));
+        seqnum_t seqnum_s = (seqnum_t)seqnum;
+        memcpy(message.body.data(), &seqnum_s, sizeof(seqnum_t));
 
-    std::pair<std::map<uint64_t, PendingRequest>::iterator, bool> ret = m_pending_requests.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(seqnum),
-        std::forward_as_tuple()
-    );
-    if (!ret.second){
-        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Duplicate sequence number: " + std::to_string(seqnum));
-    }
+        PendingRequest* ret = m_pending_requests.insert(seqnum);
+        if (ret == nullptr){
+            throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Duplicate sequence number: " + std::to_string(seqnum));
+        }
 
-    m_send_seq = seqnum + 1;
+        m_send_seq = seqnum + 1;
 
-    PendingRequest& handle = ret.first->second;
+        PendingRequest& handle = *ret;
 
-    handle.silent_remove = silent_remove;
-    handle.request = std::move(message);
-    handle.first_sent = current_time();
+        handle.silent_remove = silent_remove;
+        handle.request = std::move(message);
+        handle.first_sent = current_time();
 
-    send_message(handle.request, false);
+        schedule_retransmit(handle, seqnum, false, handle.first_sent);
+        deadline = handle.first_sent + handle.timeout;
+        m_rtt.count_send();
+
+        send_message(handle.request, false);
+    }
+
+    //  Let the retransmit thread know if this is due before its next wake up.
+    wake_retransmit_thread(deadline);
 
     return seqnum;
 }
@@ -625,60 +707,67 @@ uint64_t PABotBase::try_issue_command(
         throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
     }
 
-    SpinLockGuard lg(m_state_lock, "PABotBase::try_issue_command()");
-    if (cancelled != nullptr && cancelled->cancelled()){
-        throw OperationCancelledException();
-    }
+    uint64_t seqnum;
+    WallClock deadline;
+    {
+        SpinLockGuard lg(m_state_lock, "PABotBase::try_issue_command()");
+        if (cancelled != nullptr && cancelled->cancelled()){
+            throw OperationCancelledException();
+        }
 
-    State state = m_state.load(std::memory_order_acquire);
-    if (state != State::RUNNING){
-        throw InvalidConnectionStateException();
-    }
-    if (m_error.load(std::memory_order_acquire)){
-        throw ConnectionException(&m_logger, m_error_message);
-    }
+        State state = m_state.load(std::memory_order_acquire);
+        if (state != State::RUNNING){
+            throw InvalidConnectionStateException();
+        }
+        if (m_error.load(std::memory_order_acquire)){
+            throw ConnectionException(&m_logger, m_error_message);
+        }
 
-    size_t queue_limit = m_max_pending_requests.load(std::memory_order_relaxed);
+        size_t queue_limit = m_max_pending_requests.load(std::memory_order_relaxed);
 
-    //  Command queue is full.
-    if (m_pending_commands.size() >= queue_limit){
+        //  Command queue is full.
+        if (m_pending_commands.size() >= queue_limit){
 //        cout << "Command queue is full" << endl;
-        return 0;
-    }
+            return 0;
+        }
 
-    //  Too many unacked requests in flight.
-    if (inflight_requests() >= queue_limit){
-        m_logger.log("Message throttled due to too many inflight requests.");
-        return 0;
-    }
+        //  Too many unacked requests in flight.
+        if (inflight_requests() >= queue_limit){
+            m_logger.log("Message throttled due to too many inflight requests.");
+            return 0;
+        }
 
-    //  Don't get too far ahead of the oldest seqnum.
-    uint64_t seqnum = m_send_seq;
-    if (seqnum - oldest_live_seqnum() > MAX_SEQNUM_GAP){
-        return 0;
-    }
+        //  Don't get too far ahead of the oldest seqnum.
+        seqnum = m_send_seq;
+        if (seqnum - oldest_live_seqnum() > MAX_SEQNUM_GAP){
+            return 0;
+        }
 
-    seqnum_t seqnum_s = (seqnum_t)seqnum;
-    memcpy(&message.body[0], &seqnum_s, sizeof(seqnum_t));
+        seqnum_t seqnum_s = (seqnum_t)seqnum;
+        memcpy(message.body.data(), &seqnum_s, sizeof(seqnum_t));
 
-    std::pair<std::map<uint64_t, PendingCommand>::iterator, bool> ret = m_pending_commands.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(seqnum),
-        std::forward_as_tuple()
-    );
-    if (!ret.second){
-        throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Duplicate sequence number: " + std::to_string(seqnum));
-    }
+        PendingCommand* ret = m_pending_commands.insert(seqnum);
+        if (ret == nullptr){
+            throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Duplicate sequence number: " + std::to_string(seqnum));
+        }
+
+        m_send_seq = seqnum + 1;
 
-    m_send_seq = seqnum + 1;
+        PendingCommand& handle = *ret;
 
-    PendingCommand& handle = ret.first->second;
+        handle.silent_remove = silent_remove;
+        handle.request = std::move(message);
+        handle.first_sent = current_time();
 
-    handle.silent_remove = silent_remove;
-    handle.request = std::move(message);
-    handle.first_sent = current_time();
+        schedule_retransmit(handle, seqnum, true, handle.first_sent);
+        deadline = handle.first_sent + handle.timeout;
+        m_rtt.count_send();
+
+        send_message(handle.request, false);
+    }
 
-    send_message(handle.request, false);
+    //  Let the retransmit thread know if this is due before its next wake up.
+    wake_retransmit_thread(deadline);
 
     return seqnum;
 }
@@ -812,26 +901,26 @@ BotBaseMessage PABotBase::wait_for_request(uint64_t seqnum){
     while (true){
         {
             SpinLockGuard slg(m_state_lock, "PABotBase::issue_request_and_wait()");
-            auto iter = m_pending_requests.find(seqnum);
-            if (iter == m_pending_requests.end()){
+            PendingRequest* handle = m_pending_requests.find(seqnum);
+            if (handle == nullptr){
                 throw OperationCancelledException();
             }
-            iter->second.sanitizer.check_usage();
+            handle->sanitizer.check_usage();
 
             State state = m_state.load(std::memory_order_acquire);
             if (state != State::RUNNING){
-                m_pending_requests.erase(iter);
+                m_pending_requests.erase(seqnum);
                 m_cv.notify_all();
                 throw InvalidConnectionStateException();
             }
             if (m_error.load(std::memory_order_acquire)){
-                m_pending_requests.erase(iter);
+                m_pending_requests.erase(seqnum);
                 m_cv.notify_all();
                 throw ConnectionException(&m_logger, m_error_message);
             }
-            if (iter->second.state == AckState::ACKED){
-                BotBaseMessage ret = std::move(iter->second.ack);
-                m_pending_requests.erase(iter);
+            if (handle->state == AckState::ACKED){
+                BotBaseMessage ret = std::move(handle->ack);
+                m_pending_requests.erase(seqnum);
                 m_cv.notify_all();
                 return ret;
             }
@@ -25,7 +25,8 @@
 #define PokemonAutomation_PABotBase_H
 
 #include <string.h>
-#include <map>
+#include <vector>
+#include <queue>
 #include <atomic>
 #include <condition_variable>
 #include <thread>
@@ -33,6 +34,8 @@
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "ClientSource/Connection/MessageLogger.h"
 #include "ClientSource/Connection/PABotBaseConnection.h"
+#include "ClientSource/Connection/PendingMessageTable.h"
+#include "ClientSource/Connection/RttEstimator.h"
 #include "BotBase.h"
 #include "BotBaseMessage.h"
 
@@ -42,7 +45,12 @@ namespace PokemonAutomation{
 
 class PABotBase : public BotBase, private PABotBaseConnection{
 //    static const size_t MAX_PENDING_REQUESTS = PABB_DEVICE_QUEUE_SIZE;
-    static const seqnum_t MAX_SEQNUM_GAP = (seqnum_t)-1 >> 2;
+
+    //  Every live seqnum must fit in the pending tables. This is several
+    //  times the largest device queue so it will only throttle if something
+    //  old is stuck waiting for a response.
+    static const size_t PENDING_CAPACITY = 256;
+    static const uint64_t MAX_SEQNUM_GAP = PENDING_CAPACITY - 1;
 
 public:
     PABotBase(
@@ -74,6 +82,8 @@ public:
     }
     void set_queue_limit(size_t queue_limit);
 
+    RttStats rtt_stats();
+
 public:
     //  Basic Requests
 
@@ -106,6 +116,11 @@ private:
         BotBaseMessage request;
         BotBaseMessage ack;
         WallClock first_sent;
+        uint32_t retransmits = 0;
+        std::chrono::microseconds timeout;
+        //  Deadline of the live retransmit timer. Any other timer for this
+        //  message is stale.
+        WallClock retransmit_deadline;
         LifetimeSanitizer sanitizer;
     };
     struct PendingCommand{
@@ -114,11 +129,29 @@ private:
         BotBaseMessage request;
         BotBaseMessage ack;
         WallClock first_sent;
+        uint32_t retransmits = 0;
+        std::chrono::microseconds timeout;
+        //  Deadline of the live retransmit timer. Any other timer for this
+        //  message is stale.
+        WallClock retransmit_deadline;
         LifetimeSanitizer sanitizer;
     };
 
-    template <typename Map>
-    uint64_t infer_full_seqnum(const Map& map, seqnum_t seqnum) const;
+    //  When an unacked message is next due to be retransmitted. These are
+    //  never removed early. Timers for messages that have since been acked
+    //  or rescheduled are skipped when they come up.
+    struct RetransmitTimer{
+        WallClock deadline;
+        uint64_t seqnum;
+        bool is_command;
+
+        bool operator>(const RetransmitTimer& x) const{
+            return deadline > x.deadline;
+        }
+    };
+
+    template <typename Table>
+    uint64_t infer_full_seqnum(const Table& table, seqnum_t seqnum) const;
 
     uint64_t oldest_live_seqnum() const;
 
@@ -130,6 +163,13 @@ private:
 
     void clear_all_active_commands(uint64_t seqnum);
 
+    template <typename Pending>
+    void schedule_retransmit(Pending& pending, uint64_t seqnum, bool is_command, WallClock now);
+    template <typename Pending>
+    void resend(Pending& pending, uint64_t seqnum, bool is_command, WallClock now);
+    template <typename Pending>
+    void retransmit(Pending* pending, const RetransmitTimer& timer, WallClock now);
+    void wake_retransmit_thread(WallClock deadline);
     void retransmit_thread();
 
 private:
@@ -176,23 +216,36 @@ private:
     std::atomic<size_t> m_max_pending_requests;
 
     uint64_t m_send_seq;
+
+    //  Initial retransmit timeout until there are RTT samples. This is also
+    //  the longest the retransmit thread will sleep.
     std::chrono::milliseconds m_retransmit_delay;
     std::atomic<std::chrono::time_point<std::chrono::system_clock>> m_last_ack;
 
-    std::map<uint64_t, PendingRequest> m_pending_requests;
-    std::map<uint64_t, PendingCommand> m_pending_commands;
+    PendingMessageTable<PendingRequest, PENDING_CAPACITY> m_pending_requests;
+    PendingMessageTable<PendingCommand, PENDING_CAPACITY> m_pending_commands;
+
+    //  These are protected by m_state_lock.
+    RttEstimator m_rtt;
+    std::priority_queue<RetransmitTimer, std::vector<RetransmitTimer>, std::greater<RetransmitTimer>> m_retransmit_timers;
+
+    //  When the retransmit thread will next wake up.
+    std::atomic<WallClock> m_retransmit_wakeup;
 
     //  If you need both locks, always acquire m_sleep_lock first!
     SpinLock m_state_lock;
     std::mutex m_sleep_lock;
 
     std::condition_variable m_cv;
+    std::condition_variable m_retransmit_cv;
     std::atomic<State> m_state;
     std::atomic<bool> m_error;
     std::string m_error_message;
-    std::thread m_retransmit_thread;
 
+    //  Must be constructed before the retransmit thread starts using it.
     LifetimeSanitizer m_sanitizer;
+
+    std::thread m_retransmit_thread;
 };
 
 
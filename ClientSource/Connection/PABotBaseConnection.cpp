@@ -4,6 +4,8 @@
  * 
  */
 
+#include <string.h>
+#include <algorithm>
 #include "Common/CRC32.h"
 #include "Common/Microcontroller/MessageProtocol.h"
 #include "ClientSource/Libraries/Logging.h"
@@ -21,6 +23,8 @@ MessageSniffer null_sniffer;
 
 PABotBaseConnection::PABotBaseConnection(Logger& logger, std::unique_ptr<StreamConnection> connection)
     : m_connection(std::move(connection))
+    , m_recv_start(0)
+    , m_recv_end(0)
     , m_logger(logger)
     , m_sniffer(&null_sniffer)
 {
@@ -71,74 +75,86 @@ void PABotBaseConnection::send_message(const BotBaseMessage& message, bool is_re
         throw InternalProgramError(&m_logger, PA_CURRENT_FUNCTION, "Message is too long.");
     }
 
-    std::string buffer;
-    buffer += ~(uint8_t)total_bytes;
-    buffer += message.type;
-    buffer += message.body;
-    buffer += std::string(sizeof(uint32_t), 0);
-    pabb_crc32_write_to_message(&buffer[0], buffer.size());
+    char buffer[PABB_MAX_PACKET_SIZE];
+    buffer[0] = ~(uint8_t)total_bytes;
+    buffer[1] = message.type;
+    memcpy(buffer + 2, message.body.data(), message.body.size());
+    pabb_crc32_write_to_message(buffer, total_bytes);
 
-    m_connection->send(&buffer[0], buffer.size());
+    m_connection->send(buffer, total_bytes);
 }
 
 
 void PABotBaseConnection::on_recv(const void* data, size_t bytes){
-    //  Push into receive buffer.
-    for (size_t c = 0; c < bytes; c++){
-        m_recv_buffer.emplace_back(((const char*)data)[c]);
+    const char* ptr = (const char*)data;
+    while (bytes > 0){
+        //  Move the leftovers to the front to make room.
+        if (m_recv_start != 0){
+            memmove(m_recv_buffer, m_recv_buffer + m_recv_start, m_recv_end - m_recv_start);
+            m_recv_end -= m_recv_start;
+            m_recv_start = 0;
+        }
+
+        size_t block = std::min(bytes, RECV_BUFFER_SIZE - m_recv_end);
+        memcpy(m_recv_buffer + m_recv_end, ptr, block);
+        m_recv_end += block;
+        ptr += block;
+        bytes -= block;
+
+        parse_recv_buffer();
     }
+}
+void PABotBaseConnection::parse_recv_buffer(){
+    while (m_recv_start < m_recv_end){
+        const char* message = m_recv_buffer + m_recv_start;
+        size_t available = m_recv_end - m_recv_start;
 
-    while (!m_recv_buffer.empty()){
-        uint8_t length = ~m_recv_buffer[0];
+        uint8_t length = ~message[0];
 
-        if (m_recv_buffer[0] == 0){
+        if (message[0] == 0){
             m_sniffer->log("Skipping zero byte.");
-            m_recv_buffer.pop_front();
+            m_recv_start++;
             continue;
         }
 
         //  Message is too short.
         if (length < PABB_PROTOCOL_OVERHEAD){
             m_sniffer->log("Message is too short: bytes = " + std::to_string(length));
-            m_recv_buffer.pop_front();
+            m_recv_start++;
             continue;
         }
 
         //  Message is too long.
         if (length > PABB_MAX_PACKET_SIZE){
             m_sniffer->log("Message is too long: bytes = " + std::to_string(length));
-            m_recv_buffer.pop_front();
+            m_recv_start++;
             continue;
         }
 
         //  Message is incomplete.
-        if (length > m_recv_buffer.size()){
+        if (length > available){
             return;
         }
 
-        std::string message(m_recv_buffer.begin(), m_recv_buffer.begin() + length);
-
         //  Verify checksum
         {
             //  Calculate checksum.
-            uint32_t checksumA = pabb_crc32(0xffffffff, &message[0], length - sizeof(uint32_t));
+            uint32_t checksumA = pabb_crc32(0xffffffff, message, length - sizeof(uint32_t));
 
             //  Read the checksum from the message.
-            uint32_t checksumE = ((uint32_t*)(&message[0] + length))[-1];
+            uint32_t checksumE;
+            memcpy(&checksumE, message + length - sizeof(uint32_t), sizeof(uint32_t));
 
             //  Compare
-//            std::cout << checksumA << " / " << checksumE << std::endl;
             if (checksumA != checksumE){
                 m_sniffer->log("Invalid Checksum: bytes = " + std::to_string(length));
-//                std::cout << checksumA << " / " << checksumE << std::endl;
-//                log(message_to_string(message[1], &message[2], length - PABB_PROTOCOL_OVERHEAD));
-                m_recv_buffer.pop_front();
+                m_recv_start++;
                 continue;
             }
         }
-        m_recv_buffer.erase(m_recv_buffer.begin(), m_recv_buffer.begin() + length);
+        m_recv_start += length;
 
-        BotBaseMessage msg(message[1], std::string(&message[2], length - PABB_PROTOCOL_OVERHEAD));
+        BotBaseMessage msg(message[1], message + 2, length - PABB_PROTOCOL_OVERHEAD);
         m_sniffer->on_recv(msg);
         on_recv_message(std::move(msg));
     }
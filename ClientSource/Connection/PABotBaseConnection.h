@@ -16,7 +16,6 @@
 
 #include <memory>
 #include <string>
-#include <deque>
 #include "Common/Compiler.h"
 #include "Common/Microcontroller/MessageProtocol.h"
 #include "BotBase.h"
@@ -47,9 +46,20 @@ private:
     virtual void on_recv(const void* data, size_t bytes) override;
     virtual void on_recv_message(BotBaseMessage message) = 0;
 
+    void parse_recv_buffer();
+
 private:
+    //  Anything left over after parsing is shorter than one packet. So this
+    //  only needs to be big enough to batch up reads.
+    static const size_t RECV_BUFFER_SIZE = 16 * PABB_MAX_PACKET_SIZE;
+
     std::unique_ptr<StreamConnection> m_connection;
-    std::deque<char> m_recv_buffer;
+
+    //  Unparsed bytes are [m_recv_start, m_recv_end). They are kept contiguous
+    //  so frames can be checked and parsed in place.
+    char m_recv_buffer[RECV_BUFFER_SIZE];
+    size_t m_recv_start;
+    size_t m_recv_end;
 
 protected:
     Logger& m_logger;
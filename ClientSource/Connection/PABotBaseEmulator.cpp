@@ -0,0 +1,490 @@
+/*  PABotBase Emulator
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "Common/CRC32.h"
+#include "Common/Cpp/PanicDump.h"
+#include "Common/NintendoSwitch/NintendoSwitch_Protocol_PushButtons.h"
+#include "Common/NintendoSwitch/NintendoSwitch_Protocol_Superscalar.h"
+#include "PABotBaseEmulator.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+template <typename Params>
+bool read_params(Params& params, const char* body, size_t size){
+    if (size != sizeof(Params)){
+        return false;
+    }
+    memcpy(&params, body, sizeof(Params));
+    return true;
+}
+
+//  How many ticks a command holds up the command queue.
+//  Superscalar commands hand off to the next command after "delay" even if
+//  their buttons are still held. Anything unknown is treated as instant.
+uint32_t command_ticks(uint8_t type, const char* body, size_t size){
+    switch (type){
+    case PABB_MSG_COMMAND_PBF_WAIT:{
+        pabb_pbf_wait params;
+        return read_params(params, body, size) ? params.ticks : 0;
+    }
+    case PABB_MSG_COMMAND_PBF_PRESS_BUTTON:{
+        pabb_pbf_press_button params;
+        return read_params(params, body, size) ? (uint32_t)params.hold_ticks + params.release_ticks : 0;
+    }
+    case PABB_MSG_COMMAND_PBF_PRESS_DPAD:{
+        pabb_pbf_press_dpad params;
+        return read_params(params, body, size) ? (uint32_t)params.hold_ticks + params.release_ticks : 0;
+    }
+    case PABB_MSG_COMMAND_PBF_MOVE_JOYSTICK_L:
+    case PABB_MSG_COMMAND_PBF_MOVE_JOYSTICK_R:{
+        pabb_pbf_move_joystick params;
+        return read_params(params, body, size) ? (uint32_t)params.hold_ticks + params.release_ticks : 0;
+    }
+    case PABB_MSG_COMMAND_MASH_BUTTON:{
+        pabb_pbf_mash_button params;
+        return read_params(params, body, size) ? params.ticks : 0;
+    }
+    case PABB_MSG_CONTROLLER_STATE:{
+        pabb_controller_state params;
+        return read_params(params, body, size) ? params.ticks : 0;
+    }
+    case PABB_MSG_COMMAND_SSF_DO_NOTHING:{
+        pabb_ssf_do_nothing params;
+        return read_params(params, body, size) ? params.ticks : 0;
+    }
+    case PABB_MSG_COMMAND_SSF_PRESS_BUTTON:{
+        pabb_ssf_press_button params;
+        return read_params(params, body, size) ? params.delay : 0;
+    }
+    case PABB_MSG_COMMAND_SSF_PRESS_DPAD:{
+        pabb_ssf_press_dpad params;
+        return read_params(params, body, size) ? params.delay : 0;
+    }
+    case PABB_MSG_COMMAND_SSF_PRESS_JOYSTICK_L:
+    case PABB_MSG_COMMAND_SSF_PRESS_JOYSTICK_R:{
+        pabb_ssf_press_joystick params;
+        return read_params(params, body, size) ? params.delay : 0;
+    }
+    case PABB_MSG_COMMAND_SSF_MASH1_BUTTON:{
+        pabb_ssf_mash1_button params;
+        return read_params(params, body, size) ? params.ticks : 0;
+    }
+    case PABB_MSG_COMMAND_SSF_MASH2_BUTTON:{
+        pabb_ssf_mash2_button params;
+        return read_params(params, body, size) ? params.ticks : 0;
+    }
+    case PABB_MSG_COMMAND_SSF_MASH_AZS:{
+        pabb_ssf_mash_AZs params;
+        return read_params(params, body, size) ? params.ticks : 0;
+    }
+    case PABB_MSG_COMMAND_SSF_SCROLL:{
+        pabb_ssf_issue_scroll params;
+        return read_params(params, body, size) ? params.delay : 0;
+    }
+    default:
+        return 0;
+    }
+}
+
+}
+
+
+
+PABotBaseEmulator::PABotBaseEmulator(const PABotBaseEmulatorSettings& settings, Sender send)
+    : m_settings(settings)
+    , m_send(std::move(send))
+    , m_boot_time(current_time())
+    , m_stopping(false)
+    , m_expected_seqnum(1)
+    , m_device_seqnum(1)
+    , m_next_command_interrupts(false)
+    , m_running(false)
+    , m_running_end(WallClock::min())
+    , m_interrupt(false)
+    , m_thread(run_with_catch, "PABotBaseEmulator::thread_loop()", [this]{ thread_loop(); })
+{}
+PABotBaseEmulator::~PABotBaseEmulator(){
+    stop();
+}
+void PABotBaseEmulator::stop(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (m_stopping){
+            return;
+        }
+        m_stopping = true;
+        m_cv.notify_all();
+    }
+    m_thread.join();
+}
+
+PABotBaseEmulatorStats PABotBaseEmulator::stats() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_stats;
+}
+std::vector<EmulatedCommandRecord> PABotBaseEmulator::command_history() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_history;
+}
+void PABotBaseEmulator::clear_history(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    m_history.clear();
+}
+
+uint32_t PABotBaseEmulator::device_clock() const{
+    return (uint32_t)((current_time() - m_boot_time) / m_settings.tick);
+}
+
+
+
+void PABotBaseEmulator::send_message(uint8_t type, const void* body, size_t size){
+    //  Must call under lock.
+    char buffer[PABB_MAX_PACKET_SIZE];
+    size_t total_bytes = PABB_PROTOCOL_OVERHEAD + size;
+    buffer[0] = ~(uint8_t)total_bytes;
+    buffer[1] = type;
+    memcpy(buffer + 2, body, size);
+    pabb_crc32_write_to_message(buffer, total_bytes);
+    m_send(buffer, total_bytes);
+}
+template <uint8_t Type, typename Params>
+void PABotBaseEmulator::send_message(const Params& params){
+    static_assert(sizeof(Params) <= PABB_MAX_MESSAGE_SIZE, "Message is too long.");
+    send_message(Type, &params, sizeof(Params));
+}
+
+
+
+void PABotBaseEmulator::on_recv(const void* data, size_t bytes){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_stopping){
+        return;
+    }
+    m_recv_buffer.append((const char*)data, bytes);
+    parse_recv_buffer();
+}
+void PABotBaseEmulator::parse_recv_buffer(){
+    //  Same rules as PABotBaseConnection::parse_recv_buffer().
+    size_t start = 0;
+    while (start < m_recv_buffer.size()){
+        const char* message = m_recv_buffer.data() + start;
+        size_t available = m_recv_buffer.size() - start;
+
+        if (message[0] == 0){
+            start++;
+            continue;
+        }
+
+        uint8_t length = ~message[0];
+        if (length < PABB_PROTOCOL_OVERHEAD || length > PABB_MAX_PACKET_SIZE){
+            m_stats.invalid_bytes++;
+            start++;
+            continue;
+        }
+        if (length > available){
+            break;
+        }
+
+        uint32_t checksumA = pabb_crc32(0xffffffff, message, length - sizeof(uint32_t));
+        uint32_t checksumE;
+        memcpy(&checksumE, message + length - sizeof(uint32_t), sizeof(uint32_t));
+        if (checksumA != checksumE){
+            m_stats.invalid_bytes++;
+            start++;
+            continue;
+        }
+
+        start += length;
+        on_message(message[1], message + 2, length - PABB_PROTOCOL_OVERHEAD);
+    }
+    m_recv_buffer.erase(0, start);
+}
+
+
+
+PABotBaseEmulator::SeqnumCheck PABotBaseEmulator::check_seqnum(uint32_t seqnum){
+    int32_t diff = (int32_t)(seqnum - m_expected_seqnum);
+    if (diff < 0){
+        m_stats.duplicates++;
+        return SeqnumCheck::DUPLICATE;
+    }
+    if (diff > 0){
+        m_stats.missed++;
+        pabb_MsgInfoMissedRequest params;
+        params.seqnum = m_expected_seqnum;
+        send_message<PABB_MSG_ERROR_MISSED_REQUEST>(params);
+        return SeqnumCheck::MISSED;
+    }
+    return SeqnumCheck::NEXT;
+}
+
+void PABotBaseEmulator::on_message(uint8_t type, const char* body, size_t size){
+    if (PABB_MSG_IS_REQUEST(type)){
+        on_request(type, body, size);
+        return;
+    }
+    if (PABB_MSG_IS_COMMAND(type)){
+        on_command(type, body, size);
+        return;
+    }
+
+    //  The host acking a command-finished message.
+    pabb_MsgAckRequest ack;
+    if (type == PABB_MSG_ACK_REQUEST && read_params(ack, body, size)){
+        m_pending_finishes.erase(ack.seqnum);
+    }
+}
+void PABotBaseEmulator::on_request(uint8_t type, const char* body, size_t size){
+    if (size < sizeof(seqnum_t)){
+        pabb_MsgInfoInvalidMessage params;
+        params.message_length = (uint8_t)(size + PABB_PROTOCOL_OVERHEAD);
+        send_message<PABB_MSG_ERROR_INVALID_MESSAGE>(params);
+        return;
+    }
+    seqnum_t seqnum;
+    memcpy(&seqnum, body, sizeof(seqnum_t));
+    m_stats.requests++;
+
+    //  A reset is accepted no matter what the seqnum is.
+    if (type == PABB_MSG_SEQNUM_RESET){
+        m_expected_seqnum = seqnum + 1;
+        pabb_MsgAckRequest ack;
+        ack.seqnum = seqnum;
+        send_message<PABB_MSG_ACK_REQUEST>(ack);
+        return;
+    }
+
+    //  Requests are idempotent so duplicates are simply run again.
+    switch (check_seqnum(seqnum)){
+    case SeqnumCheck::NEXT:
+        m_expected_seqnum++;
+        break;
+    case SeqnumCheck::DUPLICATE:
+        break;
+    case SeqnumCheck::MISSED:
+        return;
+    }
+
+    switch (type){
+    case PABB_MSG_REQUEST_PROTOCOL_VERSION:
+    case PABB_MSG_REQUEST_PROGRAM_VERSION:
+    case PABB_MSG_REQUEST_CLOCK:{
+        pabb_MsgAckRequestI32 ack;
+        ack.seqnum = seqnum;
+        ack.data = type == PABB_MSG_REQUEST_PROTOCOL_VERSION ? PABB_PROTOCOL_VERSION
+            : type == PABB_MSG_REQUEST_PROGRAM_VERSION ? PABB_PROGRAM_VERSION
+            : device_clock();
+        send_message<PABB_MSG_ACK_REQUEST_I32>(ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_PROGRAM_ID:
+    case PABB_MSG_REQUEST_QUEUE_SIZE:{
+        pabb_MsgAckRequestI8 ack;
+        ack.seqnum = seqnum;
+        ack.data = type == PABB_MSG_REQUEST_PROGRAM_ID ? m_settings.program_id : m_settings.queue_size;
+        send_message<PABB_MSG_ACK_REQUEST_I8>(ack);
+        return;
+    }
+    case PABB_MSG_REQUEST_STOP:
+    case PABB_MSG_REQUEST_NEXT_CMD_INTERRUPT:{
+        if (type == PABB_MSG_REQUEST_STOP){
+            clear_command_queue();
+        }else{
+            m_next_command_interrupts = true;
+        }
+        pabb_MsgAckRequest ack;
+        ack.seqnum = seqnum;
+        send_message<PABB_MSG_ACK_REQUEST>(ack);
+        return;
+    }
+    default:{
+        pabb_MsgInfoInvalidType params;
+        params.type = type;
+        send_message<PABB_MSG_ERROR_INVALID_TYPE>(params);
+        return;
+    }
+    }
+}
+void PABotBaseEmulator::on_command(uint8_t type, const char* body, size_t size){
+    if (size < sizeof(seqnum_t)){
+        pabb_MsgInfoInvalidMessage params;
+        params.message_length = (uint8_t)(size + PABB_PROTOCOL_OVERHEAD);
+        send_message<PABB_MSG_ERROR_INVALID_MESSAGE>(params);
+        return;
+    }
+    seqnum_t seqnum;
+    memcpy(&seqnum, body, sizeof(seqnum_t));
+
+    pabb_MsgAckCommand ack;
+    ack.seqnum = seqnum;
+
+    switch (check_seqnum(seqnum)){
+    case SeqnumCheck::NEXT:
+        break;
+    case SeqnumCheck::DUPLICATE:
+        send_message<PABB_MSG_ACK_COMMAND>(ack);
+        return;
+    case SeqnumCheck::MISSED:
+        return;
+    }
+
+    if (m_next_command_interrupts){
+        m_next_command_interrupts = false;
+        clear_command_queue();
+    }
+
+    //  Queue is full. Don't advance the seqnum so the host's retransmit of
+    //  this command will be accepted later.
+    if (m_commands.size() >= m_settings.queue_size){
+        m_stats.commands_dropped++;
+        pabb_MsgInfoCommandDropped params;
+        params.seqnum = seqnum;
+        send_message<PABB_MSG_ERROR_COMMAND_DROPPED>(params);
+        return;
+    }
+
+    m_expected_seqnum++;
+    m_stats.commands++;
+
+    QueuedCommand command;
+    command.seqnum = seqnum;
+    command.type = type;
+    command.ticks = command_ticks(type, body, size);
+    command.received = current_time();
+    m_commands.emplace_back(command);
+
+    send_message<PABB_MSG_ACK_COMMAND>(ack);
+    m_cv.notify_all();
+}
+
+void PABotBaseEmulator::clear_command_queue(){
+    //  Must call under lock.
+
+    //  The running command is stopped by the command thread so it still
+    //  reports that it finished.
+    size_t keep = m_running ? 1 : 0;
+    m_commands.resize(std::min(m_commands.size(), keep));
+    m_interrupt = m_running;
+    m_cv.notify_all();
+}
+
+
+
+void PABotBaseEmulator::thread_loop(){
+    //  End of the last command on the tick clock.
+    WallClock clock = WallClock::min();
+
+    std::unique_lock<std::mutex> lg(m_lock);
+    while (!m_stopping){
+        WallClock now = current_time();
+
+        //  Finish the running command.
+        if (m_running && (m_interrupt || m_running_end <= now)){
+            const QueuedCommand& command = m_commands.front();
+
+            PendingFinish& finish = m_pending_finishes[m_device_seqnum];
+            finish.message.seqnum = m_device_seqnum;
+            finish.message.seq_of_original_command = command.seqnum;
+            finish.message.finish_time = device_clock();
+            finish.next_send = now + m_settings.finish_retransmit_delay;
+            m_device_seqnum++;
+            send_message<PABB_MSG_REQUEST_COMMAND_FINISHED>(finish.message);
+
+            clock = m_interrupt ? now : m_running_end;
+            m_commands.pop_front();
+            m_running = false;
+            m_interrupt = false;
+        }
+
+        //  Start the next one.
+        if (!m_running && !m_commands.empty()){
+            const QueuedCommand& command = m_commands.front();
+
+            EmulatedCommandRecord record;
+            record.seqnum = command.seqnum;
+            record.type = command.type;
+            record.ticks = command.ticks;
+            record.received = command.received;
+            record.underrun = clock != WallClock::min() && clock < command.received;
+            record.scheduled = std::max(clock, command.received);
+            record.started = now;
+            m_history.emplace_back(record);
+            if (record.underrun){
+                m_stats.underruns++;
+            }
+
+            m_running = true;
+            m_running_end = record.scheduled + command.ticks * m_settings.tick;
+            continue;
+        }
+
+        //  Retransmit unacked command-finished messages.
+        WallClock next = WallClock::max();
+        for (auto& item : m_pending_finishes){
+            PendingFinish& finish = item.second;
+            if (finish.next_send <= now){
+                m_stats.finish_retransmits++;
+                send_message<PABB_MSG_REQUEST_COMMAND_FINISHED>(finish.message);
+                finish.next_send = now + m_settings.finish_retransmit_delay;
+            }
+            next = std::min(next, finish.next_send);
+        }
+        if (m_running){
+            next = std::min(next, m_running_end);
+        }
+
+        if (next == WallClock::max()){
+            m_cv.wait(lg);
+        }else{
+            m_cv.wait_until(lg, next);
+        }
+    }
+}
+
+
+
+EmulatedSerialConnection::EmulatedSerialConnection(const PABotBaseEmulatorSettings& settings)
+    : m_device_to_host(new EmulatedLink(
+        settings.device_to_host,
+        [this](const void* data, size_t bytes){ on_recv(data, bytes); }
+    ))
+    , m_emulator(new PABotBaseEmulator(
+        settings,
+        [this](const void* data, size_t bytes){ m_device_to_host->send(data, bytes); }
+    ))
+    , m_host_to_device(new EmulatedLink(
+        settings.host_to_device,
+        [this](const void* data, size_t bytes){ m_emulator->on_recv(data, bytes); }
+    ))
+    , m_stopped(false)
+{}
+EmulatedSerialConnection::~EmulatedSerialConnection(){
+    stop();
+}
+void EmulatedSerialConnection::stop(){
+    if (m_stopped){
+        return;
+    }
+    m_stopped = true;
+
+    //  Shut down from the host's end so nothing is in flight towards
+    //  something that's already gone.
+    m_host_to_device->stop();
+    m_emulator->stop();
+    m_device_to_host->stop();
+}
+void EmulatedSerialConnection::send(const void* data, size_t bytes){
+    m_host_to_device->send(data, bytes);
+}
+
+
+
+}
@@ -0,0 +1,207 @@
+/*  PABotBase Emulator
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A host-side emulation of the device end of the serial protocol. (see
+ *  Common/Microcontroller/MessageProtocol.h) This lets the PABotBase client
+ *  and everything on top of it run without a flashed microcontroller.
+ *
+ *  What it does:
+ *      -   Frames and checksums every message. Bad frames are skipped a byte
+ *          at a time, the same as the real device.
+ *      -   Tracks the host's seqnums. Retransmits are acked but not run again.
+ *          Anything ahead of the expected seqnum is reported as missed.
+ *      -   Answers the basic requests. (versions, program ID, queue size, clock)
+ *      -   Queues up to "queue_size" commands and runs them back-to-back on
+ *          the 8ms tick clock. Commands that don't fit are dropped with
+ *          PABB_MSG_ERROR_COMMAND_DROPPED.
+ *      -   Sends PABB_MSG_REQUEST_COMMAND_FINISHED when each command ends and
+ *          retransmits it until the host acks it.
+ *
+ *  It does not drive a controller. Instead it records when every command
+ *  started so that the timing can be checked against what was asked for.
+ *
+ *  There are two ways to attach it:
+ *      -   EmulatedSerialConnection: An in-process StreamConnection that can
+ *          be handed straight to PABotBase.
+ *      -   PABotBaseEmulatorPTY: A Linux/macOS pseudo-terminal that anything
+ *          can open as if it were a serial port.
+ *
+ */
+
+#ifndef PokemonAutomation_PABotBaseEmulator_H
+#define PokemonAutomation_PABotBaseEmulator_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Time.h"
+#include "Common/Microcontroller/MessageProtocol.h"
+#include "Common/PokemonSwSh/PokemonProgramIDs.h"
+#include "EmulatedLink.h"
+#include "StreamInterface.h"
+
+namespace PokemonAutomation{
+
+
+struct PABotBaseEmulatorSettings{
+    uint8_t queue_size = PABB_DEVICE_QUEUE_SIZE;
+    uint8_t program_id = PABB_PID_PABOTBASE_12KB;
+
+    //  Length of one controller tick. The real device runs at 125 ticks/second.
+    std::chrono::microseconds tick{8000};
+
+    //  How long to wait for the host to ack a command-finished message.
+    std::chrono::milliseconds finish_retransmit_delay{PABB_RETRANSMIT_DELAY_MILLIS};
+
+    EmulatedLinkSettings host_to_device;
+    EmulatedLinkSettings device_to_host;
+};
+
+//  One command as it was run by the emulator.
+struct EmulatedCommandRecord{
+    uint32_t seqnum;
+    uint8_t type;
+    uint32_t ticks;
+
+    //  When the command arrived, when it should have started on the tick
+    //  clock, and when the emulator actually got to it.
+    WallClock received;
+    WallClock scheduled;
+    WallClock started;
+
+    //  True if the command queue ran dry before this command arrived.
+    //  Its start time is then set by when it arrived instead of by the end
+    //  of the previous command.
+    bool underrun;
+};
+
+struct PABotBaseEmulatorStats{
+    uint64_t requests = 0;
+    uint64_t commands = 0;
+    uint64_t duplicates = 0;        //  Retransmits of something already seen.
+    uint64_t missed = 0;            //  Seqnum was ahead of what was expected.
+    uint64_t commands_dropped = 0;  //  Command queue was full.
+    uint64_t invalid_bytes = 0;     //  Bytes skipped while looking for a valid frame.
+    uint64_t finish_retransmits = 0;
+    uint64_t underruns = 0;
+};
+
+
+class PABotBaseEmulator{
+public:
+    using Sender = std::function<void(const void* data, size_t bytes)>;
+
+public:
+    //  "send" is how the device writes back to the host.
+    PABotBaseEmulator(const PABotBaseEmulatorSettings& settings, Sender send);
+    ~PABotBaseEmulator();
+
+    void stop();
+
+    //  Raw bytes from the host.
+    void on_recv(const void* data, size_t bytes);
+
+    PABotBaseEmulatorStats stats() const;
+
+    //  Every command that was started, in the order it started.
+    std::vector<EmulatedCommandRecord> command_history() const;
+    void clear_history();
+
+
+private:
+    struct QueuedCommand{
+        uint32_t seqnum;
+        uint8_t type;
+        uint32_t ticks;
+        WallClock received;
+    };
+    struct PendingFinish{
+        pabb_MsgRequestCommandFinished message;
+        WallClock next_send;
+    };
+
+    void parse_recv_buffer();
+    void on_message(uint8_t type, const char* body, size_t size);
+    void on_request(uint8_t type, const char* body, size_t size);
+    void on_command(uint8_t type, const char* body, size_t size);
+
+    enum class SeqnumCheck{
+        NEXT,       //  The one we're expecting.
+        DUPLICATE,  //  Already seen. The ack was lost.
+        MISSED,     //  Something before it was lost. Don't run it.
+    };
+    SeqnumCheck check_seqnum(uint32_t seqnum);
+
+    template <uint8_t Type, typename Params>
+    void send_message(const Params& params);
+    void send_message(uint8_t type, const void* body, size_t size);
+
+    void clear_command_queue();
+    uint32_t device_clock() const;
+
+    void thread_loop();
+
+
+private:
+    const PABotBaseEmulatorSettings m_settings;
+    const Sender m_send;
+    const WallClock m_boot_time;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping;
+
+    std::string m_recv_buffer;
+
+    uint32_t m_expected_seqnum;
+    uint32_t m_device_seqnum;
+    bool m_next_command_interrupts;
+
+    //  The front of the queue is the one that's running.
+    std::deque<QueuedCommand> m_commands;
+    bool m_running;
+    WallClock m_running_end;
+    bool m_interrupt;
+
+    std::map<uint32_t, PendingFinish> m_pending_finishes;
+
+    PABotBaseEmulatorStats m_stats;
+    std::vector<EmulatedCommandRecord> m_history;
+
+    std::thread m_thread;
+};
+
+
+
+//  An in-process serial connection to an emulated device.
+class EmulatedSerialConnection : public StreamConnection{
+public:
+    EmulatedSerialConnection(const PABotBaseEmulatorSettings& settings);
+    virtual ~EmulatedSerialConnection();
+
+    virtual void stop() override;
+    virtual void send(const void* data, size_t bytes) override;
+
+    PABotBaseEmulator& emulator(){ return *m_emulator; }
+    EmulatedLinkStats host_to_device_stats() const{ return m_host_to_device->stats(); }
+    EmulatedLinkStats device_to_host_stats() const{ return m_device_to_host->stats(); }
+
+private:
+    std::unique_ptr<EmulatedLink> m_device_to_host;
+    std::unique_ptr<PABotBaseEmulator> m_emulator;
+    std::unique_ptr<EmulatedLink> m_host_to_device;
+    bool m_stopped;
+};
+
+
+
+}
+#endif
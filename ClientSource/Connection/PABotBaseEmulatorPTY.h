@@ -0,0 +1,173 @@
+/*  PABotBase Emulator on a Pseudo-Terminal
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Attaches a PABotBaseEmulator to the master end of a new pseudo-terminal.
+ *  The slave end ("device_name()", something like "/dev/pts/3") can then be
+ *  opened by anything that talks to a serial port, including SerialConnection
+ *  and the full program.
+ *
+ *  Loss and corruption are applied to each read from the terminal instead of
+ *  to each message since the message boundaries aren't known at that point.
+ *
+ *  POSIX only.
+ *
+ */
+
+#ifndef PokemonAutomation_PABotBaseEmulatorPTY_H
+#define PokemonAutomation_PABotBaseEmulatorPTY_H
+
+#ifndef _WIN32
+
+#include <stdlib.h>
+#include <string>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
+#include "PABotBaseEmulator.h"
+
+namespace PokemonAutomation{
+
+
+class PABotBaseEmulatorPTY{
+public:
+    PABotBaseEmulatorPTY(const PABotBaseEmulatorSettings& settings)
+        : m_exit(false)
+    {
+        m_fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (m_fd == -1){
+            int error = errno;
+            throw ConnectionException(nullptr, "posix_openpt() failed. Error = " + std::to_string(error));
+        }
+        try{
+            if (grantpt(m_fd) == -1 || unlockpt(m_fd) == -1){
+                int error = errno;
+                throw ConnectionException(nullptr, "Unable to unlock pseudo-terminal. Error = " + std::to_string(error));
+            }
+            const char* name = ptsname(m_fd);
+            if (name == nullptr){
+                int error = errno;
+                throw ConnectionException(nullptr, "ptsname() failed. Error = " + std::to_string(error));
+            }
+            m_device_name = name;
+
+            //  Raw binary in both directions. Whoever opens the slave end will
+            //  set this again, but the line must not mangle anything before then.
+            struct termios options;
+            if (tcgetattr(m_fd, &options) == -1){
+                int error = errno;
+                throw ConnectionException(nullptr, "tcgetattr() failed. Error = " + std::to_string(error));
+            }
+            cfmakeraw(&options);
+            if (tcsetattr(m_fd, TCSANOW, &options) == -1){
+                int error = errno;
+                throw ConnectionException(nullptr, "tcsetattr() failed. Error = " + std::to_string(error));
+            }
+
+            //  Never block on writes. If nothing is reading the other end,
+            //  the output is lost just like it would be on a real port.
+            int flags = fcntl(m_fd, F_GETFL);
+            if (flags == -1 || fcntl(m_fd, F_SETFL, flags | O_NONBLOCK) == -1){
+                int error = errno;
+                throw ConnectionException(nullptr, "fcntl() failed. Error = " + std::to_string(error));
+            }
+
+            m_device_to_host.reset(new EmulatedLink(
+                settings.device_to_host,
+                [this](const void* data, size_t bytes){ write_all(data, bytes); }
+            ));
+            m_emulator.reset(new PABotBaseEmulator(
+                settings,
+                [this](const void* data, size_t bytes){ m_device_to_host->send(data, bytes); }
+            ));
+            m_host_to_device.reset(new EmulatedLink(
+                settings.host_to_device,
+                [this](const void* data, size_t bytes){ m_emulator->on_recv(data, bytes); }
+            ));
+
+            m_listener = std::thread(run_with_catch, "PABotBaseEmulatorPTY::PABotBaseEmulatorPTY()", [this]{ recv_loop(); });
+        }catch (...){
+            m_host_to_device.reset();
+            m_emulator.reset();
+            m_device_to_host.reset();
+            close(m_fd);
+            throw;
+        }
+    }
+    ~PABotBaseEmulatorPTY(){
+        if (!m_exit.load(std::memory_order_acquire)){
+            stop();
+        }
+    }
+
+    void stop(){
+        m_exit.store(true, std::memory_order_release);
+        m_listener.join();
+        m_host_to_device->stop();
+        m_emulator->stop();
+        m_device_to_host->stop();
+        close(m_fd);
+    }
+
+    const std::string& device_name() const{ return m_device_name; }
+    PABotBaseEmulator& emulator(){ return *m_emulator; }
+
+private:
+    void write_all(const void* data, size_t bytes){
+        const char* ptr = (const char*)data;
+        while (bytes > 0){
+            ssize_t written = write(m_fd, ptr, bytes);
+            if (written <= 0){
+                return;
+            }
+            ptr += written;
+            bytes -= written;
+        }
+    }
+
+    void recv_loop(){
+        char buffer[32];
+        while (!m_exit.load(std::memory_order_acquire)){
+            struct pollfd pfd;
+            pfd.fd = m_fd;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, 50) <= 0 || !(pfd.revents & POLLIN)){
+                //  POLLHUP while the slave end is closed. Don't spin on it.
+                if (pfd.revents & POLLHUP){
+                    usleep(50000);
+                }
+                continue;
+            }
+            ssize_t actual = read(m_fd, buffer, sizeof(buffer));
+            if (actual > 0){
+                m_host_to_device->send(buffer, actual);
+            }
+        }
+    }
+
+
+private:
+    int m_fd;
+    std::string m_device_name;
+    std::atomic<bool> m_exit;
+
+    std::unique_ptr<EmulatedLink> m_device_to_host;
+    std::unique_ptr<PABotBaseEmulator> m_emulator;
+    std::unique_ptr<EmulatedLink> m_host_to_device;
+
+    std::thread m_listener;
+};
+
+
+
+}
+
+#endif
+#endif
@@ -0,0 +1,125 @@
+/*  Pending Message Table
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A fixed-capacity table of in-flight messages indexed by their full
+ *  64-bit seqnum. Each seqnum has exactly one slot (seqnum % CAPACITY) so
+ *  nothing here ever searches or allocates after construction.
+ *
+ *  Seqnums must be inserted in increasing order and every live seqnum must
+ *  be within CAPACITY of the oldest one. It is up to the caller to not get
+ *  that far ahead.
+ *
+ *  None of this is thread-safe.
+ *
+ */
+
+#ifndef PokemonAutomation_PendingMessageTable_H
+#define PokemonAutomation_PendingMessageTable_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace PokemonAutomation{
+
+
+template <typename Entry, size_t CAPACITY>
+class PendingMessageTable{
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power-of-two.");
+
+public:
+    PendingMessageTable()
+        : m_slots(CAPACITY)
+        , m_size(0)
+        , m_oldest(1)
+        , m_newest(0)
+    {}
+
+    size_t size() const{ return m_size; }
+    bool empty() const{ return m_size == 0; }
+
+    //  The oldest live seqnum. Only meaningful if the table isn't empty.
+    uint64_t oldest() const{
+        while (m_oldest <= m_newest && slot(m_oldest).seqnum != m_oldest){
+            m_oldest++;
+        }
+        return m_oldest;
+    }
+
+    //  Returns null if "seqnum" isn't in the table.
+    Entry* find(uint64_t seqnum){
+        Slot& entry = slot(seqnum);
+        return entry.seqnum == seqnum && seqnum != 0 ? &entry.entry : nullptr;
+    }
+
+    //  Returns a freshly constructed entry.
+    //  Returns null if "seqnum" is out of order or its slot is still in use.
+    Entry* insert(uint64_t seqnum){
+        if (seqnum == 0 || seqnum <= m_newest){
+            return nullptr;
+        }
+        Slot& entry = slot(seqnum);
+        if (entry.seqnum != 0){
+            return nullptr;
+        }
+        if (m_size == 0){
+            m_oldest = seqnum;
+        }
+        entry.seqnum = seqnum;
+        entry.entry = Entry();
+        m_newest = seqnum;
+        m_size++;
+        return &entry.entry;
+    }
+
+    void erase(uint64_t seqnum){
+        Slot& entry = slot(seqnum);
+        if (entry.seqnum != seqnum || seqnum == 0){
+            return;
+        }
+        entry.seqnum = 0;
+        m_size--;
+    }
+
+    //  Call "function(seqnum, entry)" on everything from oldest to newest.
+    //  "function" must not insert or erase.
+    template <typename Function>
+    void for_each(Function&& function){
+        if (m_size == 0){
+            return;
+        }
+        for (uint64_t seqnum = oldest(); seqnum <= m_newest; seqnum++){
+            Slot& entry = slot(seqnum);
+            if (entry.seqnum == seqnum){
+                function(seqnum, entry.entry);
+            }
+        }
+    }
+
+
+private:
+    struct Slot{
+        uint64_t seqnum = 0;    //  Zero if the slot is free.
+        Entry entry;
+    };
+
+    Slot& slot(uint64_t seqnum){
+        return m_slots[seqnum & (CAPACITY - 1)];
+    }
+    const Slot& slot(uint64_t seqnum) const{
+        return m_slots[seqnum & (CAPACITY - 1)];
+    }
+
+
+private:
+    std::vector<Slot> m_slots;
+    size_t m_size;
+    mutable uint64_t m_oldest;  //  Nothing older than this is live.
+    uint64_t m_newest;          //  The last seqnum that was inserted.
+};
+
+
+
+}
+#endif
@@ -0,0 +1,102 @@
+/*  Round-Trip Time Estimator
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include <vector>
+#include "Common/Cpp/PrettyPrint.h"
+#include "RttEstimator.h"
+
+namespace PokemonAutomation{
+
+
+std::string RttStats::to_str() const{
+    auto ms = [](std::chrono::microseconds x){
+        return tostr_fixed(x.count() / 1000., 1) + " ms";
+    };
+    std::string str;
+    if (samples == 0){
+        str += "RTT: ---";
+    }else{
+        str += "RTT: " + ms(srtt) + " (+/- " + ms(rttvar) + ")";
+        str += ", min/p50/p90/p99/max = " + ms(min) + " / " + ms(p50) + " / " + ms(p90) + " / " + ms(p99) + " / " + ms(max);
+    }
+    str += ", RTO: " + ms(rto);
+    str += ", Retransmits: " + std::to_string(retransmits) + " / " + std::to_string(sent);
+    return str;
+}
+
+
+constexpr std::chrono::milliseconds RttEstimator::MIN_RTO;
+constexpr std::chrono::milliseconds RttEstimator::MAX_RTO;
+
+RttEstimator::RttEstimator(std::chrono::milliseconds initial_rto)
+    : m_srtt(0)
+    , m_rttvar(0)
+    , m_rto(initial_rto)
+    , m_sent(0)
+    , m_retransmits(0)
+    , m_samples(0)
+{}
+
+void RttEstimator::add_sample(std::chrono::microseconds rtt){
+    if (rtt.count() < 0){
+        rtt = std::chrono::microseconds(0);
+    }
+
+    if (m_samples == 0){
+        m_srtt = rtt;
+        m_rttvar = rtt / 2;
+    }else{
+        //  alpha = 1/8, beta = 1/4
+        std::chrono::microseconds error = m_srtt > rtt ? m_srtt - rtt : rtt - m_srtt;
+        m_rttvar = (3 * m_rttvar + error) / 4;
+        m_srtt = (7 * m_srtt + rtt) / 8;
+    }
+
+    std::chrono::microseconds rto = m_srtt + 4 * m_rttvar;
+    m_rto = std::min<std::chrono::microseconds>(std::max<std::chrono::microseconds>(rto, MIN_RTO), MAX_RTO);
+
+    m_history[m_samples & (HISTORY - 1)] = rtt;
+    m_samples++;
+}
+
+std::chrono::microseconds RttEstimator::backoff(std::chrono::microseconds timeout){
+    return std::min<std::chrono::microseconds>(2 * timeout, MAX_RTO);
+}
+
+RttStats RttEstimator::stats() const{
+    RttStats stats;
+    stats.sent = m_sent;
+    stats.retransmits = m_retransmits;
+    stats.samples = m_samples;
+    stats.srtt = m_srtt;
+    stats.rttvar = m_rttvar;
+    stats.rto = m_rto;
+
+    if (m_samples == 0){
+        return stats;
+    }
+
+    std::vector<std::chrono::microseconds> history(
+        m_history,
+        m_history + std::min<uint64_t>(m_samples, HISTORY)
+    );
+    std::sort(history.begin(), history.end());
+    auto percentile = [&](size_t percent){
+        return history[(history.size() - 1) * percent / 100];
+    };
+    stats.min = history.front();
+    stats.p50 = percentile(50);
+    stats.p90 = percentile(90);
+    stats.p99 = percentile(99);
+    stats.max = history.back();
+
+    return stats;
+}
+
+
+
+}
@@ -0,0 +1,91 @@
+/*  Round-Trip Time Estimator
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Tracks how long the device takes to ack messages and computes the
+ *  retransmit timeout from it. This follows RFC 6298: a smoothed RTT and RTT
+ *  variance, RTO = SRTT + 4 * RTTVAR, and the timeout doubles for every
+ *  retransmit of the same message.
+ *
+ *  Only messages that were never retransmitted are sampled. (Karn's algorithm)
+ *  Otherwise there's no way to tell which copy the ack was for.
+ *
+ *  None of this is thread-safe.
+ *
+ */
+
+#ifndef PokemonAutomation_RttEstimator_H
+#define PokemonAutomation_RttEstimator_H
+
+#include <stdint.h>
+#include <string>
+#include <chrono>
+
+namespace PokemonAutomation{
+
+
+struct RttStats{
+    uint64_t sent = 0;
+    uint64_t retransmits = 0;
+    uint64_t samples = 0;
+
+    //  Estimator state.
+    std::chrono::microseconds srtt{0};
+    std::chrono::microseconds rttvar{0};
+    std::chrono::microseconds rto{0};
+
+    //  Distribution of the most recent samples.
+    std::chrono::microseconds min{0};
+    std::chrono::microseconds p50{0};
+    std::chrono::microseconds p90{0};
+    std::chrono::microseconds p99{0};
+    std::chrono::microseconds max{0};
+
+    std::string to_str() const;
+};
+
+
+class RttEstimator{
+public:
+    static constexpr std::chrono::milliseconds MIN_RTO{20};
+    static constexpr std::chrono::milliseconds MAX_RTO{500};
+
+public:
+    //  "initial_rto" is used until the first sample arrives.
+    RttEstimator(std::chrono::milliseconds initial_rto);
+
+    void add_sample(std::chrono::microseconds rtt);
+
+    void count_send(){ m_sent++; }
+    void count_retransmit(){ m_retransmits++; }
+
+    //  Timeout for a message that hasn't been retransmitted yet.
+    std::chrono::microseconds rto() const{ return m_rto; }
+
+    //  Timeout to use after retransmitting a message that timed out
+    //  after "timeout".
+    static std::chrono::microseconds backoff(std::chrono::microseconds timeout);
+
+    //  This sorts the recent samples. If the estimator is behind a lock,
+    //  copy it out and call this on the copy.
+    RttStats stats() const;
+
+
+private:
+    //  Must be a power-of-two.
+    static constexpr size_t HISTORY = 256;
+
+    std::chrono::microseconds m_srtt;
+    std::chrono::microseconds m_rttvar;
+    std::chrono::microseconds m_rto;
+
+    uint64_t m_sent;
+    uint64_t m_retransmits;
+    uint64_t m_samples;
+    std::chrono::microseconds m_history[HISTORY];
+};
+
+
+
+}
+#endif
@@ -345,7 +345,7 @@ std::string message_to_string(const BotBaseMessage& message){
         ss << "Unknown Message Type " << (unsigned)message.type << ": length = " << message.body.size();
         return ss.str();
     }
-    return iter->second(message.body);
+    return iter->second(message.body.to_string());
 }
 
 
@@ -28,6 +28,9 @@ void program_BeamReset          (const std::string& device_name = "");
 void program_FriendDelete       (const std::string& device_name = "");
 void program_DateSpam_WattFarmer(const std::string& device_name = "");
 
+//  Protocol Benchmark
+void program_ProtocolBenchmark  (const std::string& device_name = "");
+
 void sandbox(const std::string& device_name);
 
 }
@@ -74,6 +77,7 @@ int main(){
 //        program_BeamReset();
 //        program_FriendDelete();
 //        program_DateSpam_WattFarmer();
+//        program_ProtocolBenchmark();
 
 //        sandbox("");
     }catch (const char* str){
@@ -12,6 +12,8 @@ CURRENT += Libraries/Utilities.cpp
 CURRENT += Connection/Unicode.cpp
 CURRENT += Connection/PABotBaseConnection.cpp
 CURRENT += Connection/PABotBase.cpp
+CURRENT += Connection/EmulatedLink.cpp
+CURRENT += Connection/PABotBaseEmulator.cpp
 CURRENT += Programs/DeviceLogger.cpp
 CURRENT += Programs/TurboA.cpp
 CURRENT += Programs/ClothingBuyer.cpp
@@ -19,6 +21,7 @@ CURRENT += Programs/BallThrower.cpp
 CURRENT += Programs/BeamReset.cpp
 CURRENT += Programs/FriendDelete.cpp
 CURRENT += Programs/DateSpam-WattFarmer.cpp
+CURRENT += Programs/ProtocolBenchmark.cpp
 
 SOURCES := $(SOURCES) $(addprefix $(CURRENT_DIR)/, $(CURRENT))
 endif
@@ -0,0 +1,263 @@
+/*  Protocol Benchmark
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Measures how well the serial protocol keeps up under different link
+ *  conditions. This runs against the device emulator so no hardware is needed.
+ *
+ *  For each link condition, two workloads are run:
+ *
+ *      Throughput: A long run of zero-tick commands. This is limited only by
+ *      the protocol, the link and the device queue size.
+ *
+ *      Timing:     A run of short button presses. The device should run these
+ *      back-to-back on the tick clock. Every time the device's queue runs dry
+ *      (an underrun) the next press starts late. The error is how far each
+ *      press started from where it should have.
+ *
+ *  Device Name:
+ *      ""      Run against an in-process emulator.
+ *      "pty"   Run against an emulator on a pseudo-terminal. This goes through
+ *              SerialConnection just like a real device. (POSIX only)
+ *      other   Run only the throughput workload against a real device.
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include "Common/Cpp/AbstractLogger.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Microcontroller/DeviceRoutines.h"
+#include "ClientSource/Connection/SerialConnection.h"
+#include "ClientSource/Connection/PABotBase.h"
+#include "ClientSource/Connection/PABotBaseEmulator.h"
+#include "ClientSource/Connection/PABotBaseEmulatorPTY.h"
+#include "NintendoSwitch/Commands/NintendoSwitch_Messages_Superscalar.h"
+
+namespace PokemonAutomation{
+
+using namespace NintendoSwitch;
+
+
+namespace{
+
+const size_t THROUGHPUT_COMMANDS = 500;
+const size_t TIMING_COMMANDS = 200;
+const uint16_t TIMING_TICKS = 2;
+
+
+//  PABotBase logs every throttled message. Only show the errors.
+class BenchmarkLogger : public Logger{
+public:
+    virtual void log(const std::string& msg, Color color) override{
+        if (color == COLOR_RED){
+            std::cout << msg << std::endl;
+        }
+    }
+};
+
+
+struct LinkScenario{
+    const char* name;
+    EmulatedLinkSettings link;
+};
+std::vector<LinkScenario> link_scenarios(){
+    auto make = [](
+        uint32_t baud_rate, int latency_us, int jitter_us,
+        double drop_rate, double corrupt_rate
+    ){
+        EmulatedLinkSettings link;
+        link.baud_rate = baud_rate;
+        link.latency = std::chrono::microseconds(latency_us);
+        link.jitter = std::chrono::microseconds(jitter_us);
+        link.drop_rate = drop_rate;
+        link.corrupt_rate = corrupt_rate;
+        return link;
+    };
+    return {
+        {"Ideal",           make(0,                 0,      0,      0,      0)},
+        {"115200 baud",     make(PABB_BAUD_RATE,    0,      0,      0,      0)},
+        {"USB adapter",     make(PABB_BAUD_RATE,    1000,   1000,   0,      0)},
+        {"USB hub",         make(PABB_BAUD_RATE,    4000,   6000,   0,      0)},
+        {"1% loss",         make(PABB_BAUD_RATE,    1000,   1000,   0.01,   0)},
+        {"1% corruption",   make(PABB_BAUD_RATE,    1000,   1000,   0,      0.01)},
+        {"Lossy hub",       make(PABB_BAUD_RATE,    4000,   6000,   0.02,   0.01)},
+    };
+}
+
+
+struct Result{
+    double commands_per_second = 0;
+    RttStats rtt;
+
+    //  Timing workload only. (needs the emulator)
+    bool has_timing = false;
+    size_t underruns = 0;
+    double error_p50 = 0;
+    double error_p99 = 0;
+    double error_max = 0;
+    uint64_t commands_dropped = 0;
+    uint64_t duplicates = 0;
+};
+
+
+std::unique_ptr<PABotBase> open_botbase(Logger& logger, std::unique_ptr<StreamConnection> connection){
+    std::unique_ptr<PABotBase> botbase(new PABotBase(logger, std::move(connection)));
+    botbase->connect();
+    botbase->set_queue_limit(Microcontroller::device_queue_size(*botbase));
+    return botbase;
+}
+
+double run_throughput(BotBase& botbase){
+    BotBaseContext context(botbase);
+    WallClock start = current_time();
+    for (size_t c = 0; c < THROUGHPUT_COMMANDS; c++){
+        context.issue_request(DeviceRequest_ssf_do_nothing(0));
+    }
+    context.wait_for_all_requests();
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - start).count() / 1000000.;
+    return THROUGHPUT_COMMANDS / seconds;
+}
+
+void run_timing(BotBase& botbase, PABotBaseEmulator& emulator, const PABotBaseEmulatorSettings& settings, Result& result){
+    emulator.clear_history();
+    PABotBaseEmulatorStats before = emulator.stats();
+
+    BotBaseContext context(botbase);
+    for (size_t c = 0; c < TIMING_COMMANDS; c++){
+        context.issue_request(DeviceRequest_ssf_press_button(BUTTON_A, TIMING_TICKS, TIMING_TICKS / 2, 0));
+    }
+    context.wait_for_all_requests();
+
+    PABotBaseEmulatorStats after = emulator.stats();
+    std::vector<EmulatedCommandRecord> history = emulator.command_history();
+
+    //  How far each press started from where it would have if the queue
+    //  never ran dry. The first press always starts from an empty queue so
+    //  it doesn't count.
+    std::vector<double> errors;
+    result.underruns = 0;
+    for (size_t c = 1; c < history.size(); c++){
+        if (history[c].underrun){
+            result.underruns++;
+        }
+        WallClock ideal = history[c - 1].started + history[c - 1].ticks * settings.tick;
+        auto error = std::chrono::duration_cast<std::chrono::microseconds>(history[c].started - ideal);
+        errors.emplace_back(std::abs(error.count()) / 1000.);
+    }
+    std::sort(errors.begin(), errors.end());
+
+    result.has_timing = true;
+    result.commands_dropped = after.commands_dropped - before.commands_dropped;
+    result.duplicates = after.duplicates - before.duplicates;
+    if (!errors.empty()){
+        result.error_p50 = errors[(errors.size() - 1) * 50 / 100];
+        result.error_p99 = errors[(errors.size() - 1) * 99 / 100];
+        result.error_max = errors.back();
+    }
+}
+
+
+void print_header(){
+    std::cout << std::left << std::setw(16) << "Link";
+    std::cout << std::right;
+    std::cout << std::setw(10) << "cmd/s";
+    std::cout << std::setw(10) << "RTT p50";
+    std::cout << std::setw(10) << "RTT p99";
+    std::cout << std::setw(8) << "Rexmit";
+    std::cout << std::setw(10) << "Underrun";
+    std::cout << std::setw(10) << "Err p50";
+    std::cout << std::setw(10) << "Err p99";
+    std::cout << std::setw(10) << "Err max";
+    std::cout << std::setw(8) << "Drops";
+    std::cout << std::setw(8) << "Dupes";
+    std::cout << std::endl;
+}
+void print_result(const std::string& name, const Result& result){
+    auto ms = [](std::chrono::microseconds x){
+        return tostr_fixed(x.count() / 1000., 2);
+    };
+    std::cout << std::left << std::setw(16) << name;
+    std::cout << std::right;
+    std::cout << std::setw(10) << tostr_fixed(result.commands_per_second, 0);
+    std::cout << std::setw(10) << ms(result.rtt.p50);
+    std::cout << std::setw(10) << ms(result.rtt.p99);
+    std::cout << std::setw(8) << result.rtt.retransmits;
+    if (result.has_timing){
+        std::cout << std::setw(10) << result.underruns;
+        std::cout << std::setw(10) << tostr_fixed(result.error_p50, 2);
+        std::cout << std::setw(10) << tostr_fixed(result.error_p99, 2);
+        std::cout << std::setw(10) << tostr_fixed(result.error_max, 2);
+        std::cout << std::setw(8) << result.commands_dropped;
+        std::cout << std::setw(8) << result.duplicates;
+    }
+    std::cout << std::endl;
+}
+
+
+}
+
+
+
+void program_ProtocolBenchmark(const std::string& device_name){
+    std::cout << "Starting Protocol Benchmark..." << std::endl;
+    std::cout << std::endl;
+    std::cout << "Throughput: " << THROUGHPUT_COMMANDS << " zero-tick commands." << std::endl;
+    std::cout << "Timing:     " << TIMING_COMMANDS << " presses of " << TIMING_TICKS << " ticks. Errors are in milliseconds." << std::endl;
+    std::cout << std::endl;
+
+    BenchmarkLogger logger;
+
+    //  Real device. Only the host side can be measured.
+    if (!device_name.empty() && device_name != "pty"){
+        std::unique_ptr<PABotBase> botbase = open_botbase(
+            logger, std::make_unique<SerialConnection>(device_name, PABB_BAUD_RATE)
+        );
+        Result result;
+        result.commands_per_second = run_throughput(*botbase);
+        result.rtt = botbase->rtt_stats();
+        print_header();
+        print_result(device_name, result);
+        return;
+    }
+
+    print_header();
+    uint64_t seed = 0;
+    for (const LinkScenario& scenario : link_scenarios()){
+        PABotBaseEmulatorSettings settings;
+        settings.host_to_device = scenario.link;
+        settings.host_to_device.seed = seed++;
+        settings.device_to_host = scenario.link;
+        settings.device_to_host.seed = seed++;
+
+        Result result;
+        if (device_name.empty()){
+            EmulatedSerialConnection* connection = new EmulatedSerialConnection(settings);
+            PABotBaseEmulator& emulator = connection->emulator();
+            std::unique_ptr<PABotBase> botbase = open_botbase(logger, std::unique_ptr<StreamConnection>(connection));
+            result.commands_per_second = run_throughput(*botbase);
+            run_timing(*botbase, emulator, settings, result);
+            result.rtt = botbase->rtt_stats();
+        }else{
+#ifdef _WIN32
+            std::cout << "Pseudo-terminals are not supported on Windows." << std::endl;
+            return;
+#else
+            PABotBaseEmulatorPTY pty(settings);
+            std::unique_ptr<PABotBase> botbase = open_botbase(
+                logger, std::make_unique<SerialConnection>(pty.device_name(), PABB_BAUD_RATE)
+            );
+            result.commands_per_second = run_throughput(*botbase);
+            run_timing(*botbase, pty.emulator(), settings, result);
+            result.rtt = botbase->rtt_stats();
+#endif
+        }
+        print_result(scenario.name, result);
+    }
+}
+
+
+
+}
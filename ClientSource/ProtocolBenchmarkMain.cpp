@@ -0,0 +1,31 @@
+/*  Protocol Benchmark Entry Point
+ * 
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ * 
+ *      Standalone entry point for the protocol benchmark so it can be built
+ *  without the rest of the client. See CMakeLists.txt.
+ * 
+ *  Usage: ProtocolBenchmark [device name]
+ * 
+ */
+
+#include <string>
+#include <iostream>
+
+namespace PokemonAutomation{
+    void program_ProtocolBenchmark(const std::string& device_name = "");
+}
+
+
+int main(int argc, char** argv){
+    using namespace PokemonAutomation;
+
+    try{
+        program_ProtocolBenchmark(argc > 1 ? argv[1] : "");
+    }catch (std::exception& e){
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
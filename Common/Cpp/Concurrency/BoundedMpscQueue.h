@@ -0,0 +1,115 @@
+/*  Bounded MPSC Queue
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Fixed-size lock-free queue for many producers and one consumer.
+ *
+ *  Each slot carries a sequence number that tells whether it is ready to be
+ *  written or read for the current lap around the ring. Producers claim a
+ *  slot with a CAS on the write position. The consumer owns the read
+ *  position so it doesn't need any atomics of its own.
+ *
+ *  Neither side ever waits. When the queue is full or empty, the call fails
+ *  and it's up to the caller to decide what to do.
+ *
+ */
+
+#ifndef PokemonAutomation_BoundedMpscQueue_H
+#define PokemonAutomation_BoundedMpscQueue_H
+
+#include <stddef.h>
+#include <atomic>
+#include <memory>
+
+namespace PokemonAutomation{
+
+
+template <typename Type>
+class BoundedMpscQueue{
+public:
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    void operator=(const BoundedMpscQueue&) = delete;
+
+    //  "capacity" is rounded up to a power of two.
+    BoundedMpscQueue(size_t capacity)
+        : m_mask(round_up_pow2(capacity) - 1)
+        , m_slots(new Slot[m_mask + 1])
+        , m_write(0)
+        , m_read(0)
+    {
+        for (size_t c = 0; c <= m_mask; c++){
+            m_slots[c].sequence.store(c, std::memory_order_relaxed);
+        }
+    }
+
+    size_t capacity() const{ return m_mask + 1; }
+
+    //  Safe to call from any thread.
+    //  Returns false if the queue is full. "item" is left untouched in that case.
+    bool try_push(Type&& item){
+        size_t position = m_write.load(std::memory_order_relaxed);
+        while (true){
+            Slot& slot = m_slots[position & m_mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)position;
+            if (diff == 0){
+                if (m_write.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)){
+                    slot.item = std::move(item);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }else if (diff < 0){
+                //  The consumer hasn't freed this slot from the last lap.
+                return false;
+            }else{
+                position = m_write.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //  Must only be called from the consumer thread.
+    bool empty() const{
+        return m_slots[m_read & m_mask].sequence.load(std::memory_order_acquire) != m_read + 1;
+    }
+
+    //  Must only be called from the consumer thread.
+    //  Returns false if the queue is empty.
+    bool try_pop(Type& item){
+        Slot& slot = m_slots[m_read & m_mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != m_read + 1){
+            return false;
+        }
+        item = std::move(slot.item);
+        slot.sequence.store(m_read + m_mask + 1, std::memory_order_release);
+        m_read++;
+        return true;
+    }
+
+
+private:
+    static size_t round_up_pow2(size_t x){
+        size_t ret = 1;
+        while (ret < x){
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    struct Slot{
+        std::atomic<size_t> sequence;
+        Type item;
+    };
+
+    const size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+
+    //  Keep the producer and consumer positions on separate cache lines.
+    alignas(64) std::atomic<size_t> m_write;
+    alignas(64) size_t m_read;
+};
+
+
+
+}
+#endif
@@ -4,6 +4,7 @@
  *
  */
 
+#include <algorithm>
 #include "PeriodicScheduler.h"
 
 #include <iostream>
@@ -144,6 +145,12 @@ bool PeriodicRunner::cancel(std::exception_ptr exception) noexcept{
     m_cv.notify_all();
     return false;
 }
+void PeriodicRunner::run_batch(const std::vector<void*>& events, bool is_back_to_back) noexcept{
+    for (void* event : events){
+        run(event, is_back_to_back);
+        is_back_to_back = true;
+    }
+}
 void PeriodicRunner::thread_loop(){
     bool is_back_to_back = false;
     std::unique_lock<std::mutex> lg(m_lock);
@@ -169,11 +176,23 @@ void PeriodicRunner::thread_loop(){
         idle_since_last_check = WallClock::duration(0);
 //        cout << m_utilization.utilization() << endl;
 
-        void* event = m_scheduler.request_next_event(now);
+        //  Grab everything that is due now. Stop if an event comes around
+        //  again in the same batch. (can happen if the period is zero)
+        m_batch.clear();
+        while (true){
+            void* event = m_scheduler.request_next_event(now);
+            if (event == nullptr){
+                break;
+            }
+            if (std::find(m_batch.begin(), m_batch.end(), event) != m_batch.end()){
+                break;
+            }
+            m_batch.emplace_back(event);
+        }
 
-        //  Event is available now. Run it.
-        if (event != nullptr){
-            run(event, is_back_to_back);
+        //  Events are available now. Run them.
+        if (!m_batch.empty()){
+            run_batch(m_batch, is_back_to_back);
             is_back_to_back = true;
             continue;
         }
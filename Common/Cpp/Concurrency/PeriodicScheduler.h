@@ -10,6 +10,7 @@
 #define PokemonAutomation_PeriodicScheduler_H
 
 #include <chrono>
+#include <vector>
 #include <map>
 #include <mutex>
 #include <condition_variable>
@@ -84,6 +85,11 @@ protected:
     //  is too slow to keep up.
     virtual void run(void* event, bool is_back_to_back) noexcept = 0;
 
+    //  Run all the events that are due at the same time. The default
+    //  implementation runs them one at a time in schedule order.
+    //  Child classes can override this to run them together. (e.g. in parallel)
+    virtual void run_batch(const std::vector<void*>& events, bool is_back_to_back) noexcept;
+
 private:
     void thread_loop();
 protected:
@@ -100,6 +106,7 @@ private:
     UtilizationTracker m_utilization;
 
     PeriodicScheduler m_scheduler;
+    std::vector<void*> m_batch;
 
     std::unique_ptr<AsyncTask> m_runner;
 };
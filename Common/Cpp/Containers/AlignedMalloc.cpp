@@ -10,6 +10,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include <new>
+#ifdef PA_BENCHMARK_ALLOCATIONS
+#include <atomic>
+#endif
 #include "Common/Cpp/Exceptions.h"
 #include "AlignedMalloc.h"
 
@@ -22,7 +25,20 @@ const size_t BUFFER_CHECK_TOP = (size_t)0xc72bf73f0559cfe4;
 namespace PokemonAutomation{
 
 
+#ifdef PA_BENCHMARK_ALLOCATIONS
+namespace{
+std::atomic<uint64_t> aligned_malloc_count(0);
+}
+uint64_t aligned_malloc_calls(){
+    return aligned_malloc_count.load(std::memory_order_relaxed);
+}
+#endif
+
+
 void* aligned_malloc(size_t bytes, size_t alignment){
+#ifdef PA_BENCHMARK_ALLOCATIONS
+    aligned_malloc_count.fetch_add(1, std::memory_order_relaxed);
+#endif
     if (alignment < sizeof(size_t)){
         alignment = sizeof(size_t);
     }
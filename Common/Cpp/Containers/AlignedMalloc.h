@@ -8,6 +8,9 @@
 #define PokemonAutomation_AlignedMalloc_H
 
 #include <stddef.h>
+#ifdef PA_BENCHMARK_ALLOCATIONS
+#include <stdint.h>
+#endif
 
 namespace PokemonAutomation{
 
@@ -16,6 +19,11 @@ void* aligned_malloc(size_t bytes, size_t alignment);
 void aligned_free(void* ptr);
 void check_aligned_ptr(const void *ptr);
 
+#ifdef PA_BENCHMARK_ALLOCATIONS
+//  Number of calls to aligned_malloc() so far. Used by the test benchmarks.
+uint64_t aligned_malloc_calls();
+#endif
+
 
 }
 #endif
@@ -17,6 +17,7 @@ CONFIG += force_debug_info
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+#DEFINES += PA_BENCHMARK_ALLOCATIONS    # counts heap allocations in the command line test benchmark. Not for shipped builds.
 
 win32-g++{
     CONFIG += c++1z
@@ -77,6 +78,7 @@ SOURCES += \
     ../ClientSource/Connection/MessageLogger.cpp \
     ../ClientSource/Connection/PABotBase.cpp \
     ../ClientSource/Connection/PABotBaseConnection.cpp \
+    ../ClientSource/Connection/RttEstimator.cpp \
     ../ClientSource/Libraries/Logging.cpp \
     ../ClientSource/Libraries/MessageConverter.cpp \
     ../Common/CRC32.cpp \
@@ -162,6 +164,7 @@ SOURCES += \
     Source/CommonFramework/AudioPipeline/IO/AudioFileLoader.cpp \
     Source/CommonFramework/AudioPipeline/IO/AudioSink.cpp \
     Source/CommonFramework/AudioPipeline/IO/AudioSource.cpp \
+    Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHistory.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.cpp \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.cpp \
@@ -202,6 +205,7 @@ SOURCES += \
     Source/CommonFramework/ImageTools/ImageFilter.cpp \
     Source/CommonFramework/ImageTools/ImageGradient.cpp \
     Source/CommonFramework/ImageTools/ImageManip.cpp \
+    Source/CommonFramework/ImageTools/ImagePyramid.cpp \
     Source/CommonFramework/ImageTools/ImageStats.cpp \
     Source/CommonFramework/ImageTools/SolidColorTest.cpp \
     Source/CommonFramework/ImageTools/WaterfillUtilities.cpp \
@@ -219,6 +223,7 @@ SOURCES += \
     Source/CommonFramework/Inference/FrozenImageDetector.cpp \
     Source/CommonFramework/Inference/ImageMatchDetector.cpp \
     Source/CommonFramework/Inference/ImageTools.cpp \
+    Source/CommonFramework/Inference/SpectrogramFrontEnd.cpp \
     Source/CommonFramework/Inference/SpectrogramMatcher.cpp \
     Source/CommonFramework/Inference/StatAccumulator.cpp \
     Source/CommonFramework/InferenceInfra/AudioInferencePivot.cpp \
@@ -247,6 +252,7 @@ SOURCES += \
     Source/CommonFramework/OCR/OCR_SmallDictionaryMatcher.cpp \
     Source/CommonFramework/OCR/OCR_StringMatchResult.cpp \
     Source/CommonFramework/OCR/OCR_StringNormalization.cpp \
+    Source/CommonFramework/OCR/OCR_SubstringMatchIndex.cpp \
     Source/CommonFramework/OCR/OCR_TextMatcher.cpp \
     Source/CommonFramework/OCR/OCR_TrainingTools.cpp \
     Source/CommonFramework/Options/Environment/ProcessorLevelOption.cpp \
@@ -270,6 +276,8 @@ SOURCES += \
     Source/CommonFramework/Panels/UI/SettingsPanelWidget.cpp \
     Source/CommonFramework/PersistentSettings.cpp \
     Source/CommonFramework/ProgramSession.cpp \
+    Source/CommonFramework/Resources/ResourcePreloader.cpp \
+    Source/CommonFramework/Resources/SpriteBundle.cpp \
     Source/CommonFramework/Resources/SpriteDatabase.cpp \
     Source/CommonFramework/SetupSettings.cpp \
     Source/CommonFramework/Tools/BlackBorderCheck.cpp \
@@ -278,6 +286,7 @@ SOURCES += \
     Source/CommonFramework/Tools/DebugDumper.cpp \
     Source/CommonFramework/Tools/ErrorDumper.cpp \
     Source/CommonFramework/Tools/FileDownloader.cpp \
+    Source/CommonFramework/Tools/ImageDumpQueue.cpp \
     Source/CommonFramework/Tools/InterruptableCommands.cpp \
     Source/CommonFramework/Tools/MultiConsoleErrors.cpp \
     Source/CommonFramework/Tools/ProgramEnvironment.cpp \
@@ -290,6 +299,8 @@ SOURCES += \
     Source/CommonFramework/VideoPipeline/Backends/CameraWidgetQt6.cpp \
     Source/CommonFramework/VideoPipeline/Backends/VideoToolsQt5.cpp \
     Source/CommonFramework/VideoPipeline/CameraOption.cpp \
+    Source/CommonFramework/VideoPipeline/FileVideoFeed.cpp \
+    Source/CommonFramework/VideoPipeline/Stats/SerialConnectionStats.cpp \
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.cpp \
     Source/CommonFramework/VideoPipeline/UI/CameraSelectorWidget.cpp \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWidget.cpp \
@@ -342,12 +353,26 @@ SOURCES += \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_AVX2.cpp \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_AVX512.cpp \
     Source/Kernels/BinaryMatrix/Kernels_BinaryMatrix_Core_x64_SSE42.cpp \
+    Source/Kernels/ImageDownscale/Kernels_ImageDownscale.cpp \
+    Source/Kernels/ImageDownscale/Kernels_ImageDownscale_Default.cpp \
+    Source/Kernels/ImageDownscale/Kernels_ImageDownscale_x64_AVX2.cpp \
+    Source/Kernels/ImageDownscale/Kernels_ImageDownscale_x64_AVX512.cpp \
+    Source/Kernels/ImageDownscale/Kernels_ImageDownscale_x64_SSE41.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_Default.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_arm64_NEON.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX2.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_AVX512.cpp \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_SSE42.cpp \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient.cpp \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_Default.cpp \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_x64_AVX2.cpp \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_x64_SSE41.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_Default.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX2.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX512.cpp \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_SSE41.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_Default.cpp \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness_arm64_NEON.cpp \
@@ -375,6 +400,7 @@ SOURCES += \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Core_x86_AVX512.cpp \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Core_x86_SSE41.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill.cpp \
+    Source/Kernels/Waterfill/Kernels_Waterfill_ComponentTree.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x16_x64_AVX2.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x32_x64_AVX512-GF.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x32_x64_AVX512.cpp \
@@ -384,6 +410,9 @@ SOURCES += \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x8_x64_SSE42.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.cpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.cpp \
+    Source/Kernels/Xoroshiro128Plus/Kernels_Xoroshiro128Plus.cpp \
+    Source/Kernels/Xoroshiro128Plus/Kernels_Xoroshiro128Plus_Default.cpp \
+    Source/Kernels/Xoroshiro128Plus/Kernels_Xoroshiro128Plus_x64_AVX2.cpp \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_Device.cpp \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_DigitEntry.cpp \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_PushButtons.cpp \
@@ -458,6 +487,7 @@ SOURCES += \
     Source/Pokemon/Resources/Pokemon_PokeballNames.cpp \
     Source/Pokemon/Resources/Pokemon_PokemonNames.cpp \
     Source/Pokemon/Resources/Pokemon_PokemonSlugs.cpp \
+    Source/Pokemon/Resources/Pokemon_Preload.cpp \
     Source/PokemonBDSP/Inference/Battles/PokemonBDSP_BattleBallReader.cpp \
     Source/PokemonBDSP/Inference/Battles/PokemonBDSP_BattleMenuDetector.cpp \
     Source/PokemonBDSP/Inference/Battles/PokemonBDSP_EndBattleDetector.cpp \
@@ -532,6 +562,7 @@ SOURCES += \
     Source/PokemonHome/PokemonHome_Panels.cpp \
     Source/PokemonHome/PokemonHome_Settings.cpp \
     Source/PokemonHome/Programs/PokemonHome_BoxSorting.cpp \
+    Source/PokemonHome/Programs/PokemonHome_BoxSortingPlanner.cpp \
     Source/PokemonHome/Programs/PokemonHome_GenerateNameOCR.cpp \
     Source/PokemonHome/Programs/PokemonHome_PageSwap.cpp \
     Source/PokemonLA/Inference/Battles/PokemonLA_BattleMenuDetector.cpp \
@@ -631,6 +662,7 @@ SOURCES += \
     Source/PokemonLA/Resources/PokemonLA_AvailablePokemon.cpp \
     Source/PokemonLA/Resources/PokemonLA_NameDatabase.cpp \
     Source/PokemonLA/Resources/PokemonLA_PokemonSprites.cpp \
+    Source/PokemonLA/Resources/PokemonLA_Preload.cpp \
     Source/PokemonLA/Resources/PokemonLA_WeatherAndTimeIcons.cpp \
     Source/PokemonSV/Inference/Battles/PokemonSV_BattleBallReader.cpp \
     Source/PokemonSV/Inference/Battles/PokemonSV_EncounterWatcher.cpp \
@@ -761,6 +793,7 @@ SOURCES += \
     Source/PokemonSV/Resources/PokemonSV_ItemSprites.cpp \
     Source/PokemonSV/Resources/PokemonSV_NameDatabase.cpp \
     Source/PokemonSV/Resources/PokemonSV_PokemonSprites.cpp \
+    Source/PokemonSV/Resources/PokemonSV_Preload.cpp \
     Source/PokemonSV/Resources/PokemonSV_TournamentPrizeNames.cpp \
     Source/PokemonSwSh/Commands/PokemonSwSh_Commands_AutoHosts.cpp \
     Source/PokemonSwSh/Commands/PokemonSwSh_Commands_DateSpam.cpp \
@@ -947,16 +980,21 @@ SOURCES += \
     Source/PokemonSwSh/Resources/PokemonSwSh_NameDatabase.cpp \
     Source/PokemonSwSh/Resources/PokemonSwSh_PokeballSprites.cpp \
     Source/PokemonSwSh/Resources/PokemonSwSh_PokemonSprites.cpp \
+    Source/PokemonSwSh/Resources/PokemonSwSh_Preload.cpp \
     Source/PokemonSwSh/Resources/PokemonSwSh_TypeMatchup.cpp \
     Source/PokemonSwSh/Resources/PokemonSwSh_TypeSprites.cpp \
     Source/PokemonSwSh/ShinyHuntTracker.cpp \
+    Source/SpriteBundles.cpp \
     Source/Tests/CommandLineTests.cpp \
     Source/Tests/CommonFramework_Tests.cpp \
+    Source/Tests/InferenceReplay.cpp \
     Source/Tests/Kernels_Tests.cpp \
     Source/Tests/NintendoSwitch_Tests.cpp \
+    Source/Tests/PokemonHome_Tests.cpp \
     Source/Tests/PokemonLA_Tests.cpp \
     Source/Tests/PokemonSV_Tests.cpp \
     Source/Tests/PokemonSwSh_Tests.cpp \
+    Source/Tests/TestBenchmark.cpp \
     Source/Tests/TestMap.cpp \
     Source/Tests/TestUtils.cpp \
     Source/ZeldaTotK/Programs/ZeldaTotK_BowItemDuper.cpp \
@@ -1043,6 +1081,8 @@ HEADERS += \
     ../ClientSource/Connection/MessageSniffer.h \
     ../ClientSource/Connection/PABotBase.h \
     ../ClientSource/Connection/PABotBaseConnection.h \
+    ../ClientSource/Connection/PendingMessageTable.h \
+    ../ClientSource/Connection/RttEstimator.h \
     ../ClientSource/Connection/SerialConnection.h \
     ../ClientSource/Connection/SerialConnectionPOSIX.h \
     ../ClientSource/Connection/SerialConnectionWinAPI.h \
@@ -1055,6 +1095,7 @@ HEADERS += \
     ../Common/Cpp/CancellableScope.h \
     ../Common/Cpp/Color.h \
     ../Common/Cpp/Concurrency/AsyncDispatcher.h \
+    ../Common/Cpp/Concurrency/BoundedMpscQueue.h \
     ../Common/Cpp/Concurrency/FireForgetDispatcher.h \
     ../Common/Cpp/Concurrency/ParallelTaskRunner.h \
     ../Common/Cpp/Concurrency/PeriodicScheduler.h \
@@ -1167,6 +1208,7 @@ HEADERS += \
     Source/CommonFramework/AudioPipeline/IO/AudioFileLoader.h \
     Source/CommonFramework/AudioPipeline/IO/AudioSink.h \
     Source/CommonFramework/AudioPipeline/IO/AudioSource.h \
+    Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHistory.h \
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.h \
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.h \
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.h \
@@ -1221,6 +1263,7 @@ HEADERS += \
     Source/CommonFramework/ImageTools/ImageFilter.h \
     Source/CommonFramework/ImageTools/ImageGradient.h \
     Source/CommonFramework/ImageTools/ImageManip.h \
+    Source/CommonFramework/ImageTools/ImagePyramid.h \
     Source/CommonFramework/ImageTools/ImageStats.h \
     Source/CommonFramework/ImageTools/SolidColorTest.h \
     Source/CommonFramework/ImageTools/WaterfillUtilities.h \
@@ -1240,6 +1283,7 @@ HEADERS += \
     Source/CommonFramework/Inference/ImageMatchDetector.h \
     Source/CommonFramework/Inference/ImageTools.h \
     Source/CommonFramework/Inference/InferenceThrottler.h \
+    Source/CommonFramework/Inference/SpectrogramFrontEnd.h \
     Source/CommonFramework/Inference/SpectrogramMatcher.h \
     Source/CommonFramework/Inference/StatAccumulator.h \
     Source/CommonFramework/Inference/TimeWindowStatTracker.h \
@@ -1272,6 +1316,7 @@ HEADERS += \
     Source/CommonFramework/OCR/OCR_SmallDictionaryMatcher.h \
     Source/CommonFramework/OCR/OCR_StringMatchResult.h \
     Source/CommonFramework/OCR/OCR_StringNormalization.h \
+    Source/CommonFramework/OCR/OCR_SubstringMatchIndex.h \
     Source/CommonFramework/OCR/OCR_TextMatcher.h \
     Source/CommonFramework/OCR/OCR_TrainingTools.h \
     Source/CommonFramework/Options/Environment/ProcessPriorityOption.h \
@@ -1297,6 +1342,8 @@ HEADERS += \
     Source/CommonFramework/Panels/UI/SettingsPanelWidget.h \
     Source/CommonFramework/PersistentSettings.h \
     Source/CommonFramework/ProgramSession.h \
+    Source/CommonFramework/Resources/ResourcePreloader.h \
+    Source/CommonFramework/Resources/SpriteBundle.h \
     Source/CommonFramework/Resources/SpriteDatabase.h \
     Source/CommonFramework/SetupSettings.h \
     Source/CommonFramework/Tools/BlackBorderCheck.h \
@@ -1305,6 +1352,7 @@ HEADERS += \
     Source/CommonFramework/Tools/DebugDumper.h \
     Source/CommonFramework/Tools/ErrorDumper.h \
     Source/CommonFramework/Tools/FileDownloader.h \
+    Source/CommonFramework/Tools/ImageDumpQueue.h \
     Source/CommonFramework/Tools/InterruptableCommands.h \
     Source/CommonFramework/Tools/MultiConsoleErrors.h \
     Source/CommonFramework/Tools/ProgramEnvironment.h \
@@ -1319,7 +1367,9 @@ HEADERS += \
     Source/CommonFramework/VideoPipeline/CameraInfo.h \
     Source/CommonFramework/VideoPipeline/CameraOption.h \
     Source/CommonFramework/VideoPipeline/CameraSession.h \
+    Source/CommonFramework/VideoPipeline/FileVideoFeed.h \
     Source/CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h \
+    Source/CommonFramework/VideoPipeline/Stats/SerialConnectionStats.h \
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h \
     Source/CommonFramework/VideoPipeline/UI/CameraSelectorWidget.h \
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWidget.h \
@@ -1397,7 +1447,19 @@ HEADERS += \
     Source/Kernels/BinaryMatrix/Kernels_PackedBinaryMatrixCore.tpp \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.h \
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.tpp \
+    Source/Kernels/ImageDownscale/Kernels_ImageDownscale.h \
+    Source/Kernels/ImageDownscale/Kernels_ImageDownscale_Routines.h \
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.h \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient.h \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_Default.h \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_Routines.h \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_x64_AVX2.h \
+    Source/Kernels/ImageGradient/Kernels_ImageGradient_x64_SSE41.h \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV.h \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_Default.h \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX2.h \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX512.h \
+    Source/Kernels/ImageHSV/Kernels_ImageHSV_x64_SSE41.h \
     Source/Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr.h \
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h \
@@ -1416,6 +1478,7 @@ HEADERS += \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution.h \
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Routines.h \
     Source/Kernels/Waterfill/Kernels_Waterfill.h \
+    Source/Kernels/Waterfill/Kernels_Waterfill_ComponentTree.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x16_x64_AVX2.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x32_x64_AVX512-GF.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x32_x64_AVX512.h \
@@ -1431,6 +1494,7 @@ HEADERS += \
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.h \
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.tpp \
     Source/Kernels/Waterfill/Kernels_Waterfill_Types.h \
+    Source/Kernels/Xoroshiro128Plus/Kernels_Xoroshiro128Plus.h \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_Device.h \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_DigitEntry.h \
     Source/NintendoSwitch/Commands/NintendoSwitch_Commands_PushButtons.h \
@@ -1512,6 +1576,7 @@ HEADERS += \
     Source/Pokemon/Resources/Pokemon_PokeballNames.h \
     Source/Pokemon/Resources/Pokemon_PokemonNames.h \
     Source/Pokemon/Resources/Pokemon_PokemonSlugs.h \
+    Source/Pokemon/Resources/Pokemon_Preload.h \
     Source/PokemonBDSP/Inference/Battles/PokemonBDSP_BattleBallReader.h \
     Source/PokemonBDSP/Inference/Battles/PokemonBDSP_BattleMenuDetector.h \
     Source/PokemonBDSP/Inference/Battles/PokemonBDSP_EndBattleDetector.h \
@@ -1588,6 +1653,7 @@ HEADERS += \
     Source/PokemonHome/PokemonHome_Panels.h \
     Source/PokemonHome/PokemonHome_Settings.h \
     Source/PokemonHome/Programs/PokemonHome_BoxSorting.h \
+    Source/PokemonHome/Programs/PokemonHome_BoxSortingPlanner.h \
     Source/PokemonHome/Programs/PokemonHome_GenerateNameOCR.h \
     Source/PokemonHome/Programs/PokemonHome_PageSwap.h \
     Source/PokemonLA/Inference/Battles/PokemonLA_BattleMenuDetector.h \
@@ -1687,6 +1753,7 @@ HEADERS += \
     Source/PokemonLA/Resources/PokemonLA_AvailablePokemon.h \
     Source/PokemonLA/Resources/PokemonLA_NameDatabase.h \
     Source/PokemonLA/Resources/PokemonLA_PokemonSprites.h \
+    Source/PokemonLA/Resources/PokemonLA_Preload.h \
     Source/PokemonLA/Resources/PokemonLA_WeatherAndTimeIcons.h \
     Source/PokemonSV/Inference/Battles/PokemonSV_BattleBallReader.h \
     Source/PokemonSV/Inference/Battles/PokemonSV_EncounterWatcher.h \
@@ -1820,6 +1887,7 @@ HEADERS += \
     Source/PokemonSV/Resources/PokemonSV_ItemSprites.h \
     Source/PokemonSV/Resources/PokemonSV_NameDatabase.h \
     Source/PokemonSV/Resources/PokemonSV_PokemonSprites.h \
+    Source/PokemonSV/Resources/PokemonSV_Preload.h \
     Source/PokemonSV/Resources/PokemonSV_TournamentPrizeNames.h \
     Source/PokemonSwSh/Commands/PokemonSwSh_Commands_AutoHosts.h \
     Source/PokemonSwSh/Commands/PokemonSwSh_Commands_DateSpam.h \
@@ -2010,16 +2078,21 @@ HEADERS += \
     Source/PokemonSwSh/Resources/PokemonSwSh_NameDatabase.h \
     Source/PokemonSwSh/Resources/PokemonSwSh_PokeballSprites.h \
     Source/PokemonSwSh/Resources/PokemonSwSh_PokemonSprites.h \
+    Source/PokemonSwSh/Resources/PokemonSwSh_Preload.h \
     Source/PokemonSwSh/Resources/PokemonSwSh_TypeMatchup.h \
     Source/PokemonSwSh/Resources/PokemonSwSh_TypeSprites.h \
     Source/PokemonSwSh/ShinyHuntTracker.h \
+    Source/SpriteBundles.h \
     Source/Tests/CommandLineTests.h \
     Source/Tests/CommonFramework_Tests.h \
+    Source/Tests/InferenceReplay.h \
     Source/Tests/Kernels_Tests.h \
     Source/Tests/NintendoSwitch_Tests.h \
+    Source/Tests/PokemonHome_Tests.h \
     Source/Tests/PokemonLA_Tests.h \
     Source/Tests/PokemonSV_Tests.h \
     Source/Tests/PokemonSwSh_Tests.h \
+    Source/Tests/TestBenchmark.h \
     Source/Tests/TestMap.h \
     Source/Tests/TestUtils.h \
     Source/ZeldaTotK/Programs/ZeldaTotK_BowItemDuper.h \
@@ -37,6 +37,17 @@ public:
     {}
 };
 
+//  Reads the spectrums of an audio feed as they come in.
+//  Keep one of these around and pass it to AudioFeed::read_spectrums() each
+//  time. The buffer is reused so this doesn't allocate once it's warmed up.
+struct AudioSpectrumCursor{
+    //  Stamp of the next spectrum to read. ~0 means start from the latest one.
+    uint64_t next_stamp = ~(uint64_t)0;
+
+    //  The spectrums from the last read. Ordered from newest to oldest.
+    std::vector<AudioSpectrum> spectrums;
+};
+
 //  Define basic interface of an audio feed to be used by programs or other services.
 //  All the functions in the interface should be thread safe.
 class AudioFeed{
@@ -52,6 +63,19 @@ public:
     //  Returned spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
     virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) = 0;
 
+    //  Replace "cursor.spectrums" with everything since the last read and move
+    //  the cursor forward. The first read returns only the latest spectrum.
+    virtual void read_spectrums(AudioSpectrumCursor& cursor){
+        if (cursor.next_stamp == ~(uint64_t)0){
+            cursor.spectrums = spectrums_latest(1);
+        }else{
+            cursor.spectrums = spectrums_since(cursor.next_stamp);
+        }
+        if (!cursor.spectrums.empty()){
+            cursor.next_stamp = cursor.spectrums[0].stamp + 1;
+        }
+    }
+
     //  Add visual overlay to the spectrums starting at `starting_stamp` and before `end_stamp` with `color`.
     virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) = 0;
 };
@@ -254,6 +254,9 @@ std::vector<AudioSpectrum> AudioSession::spectrums_since(uint64_t starting_seqnu
 std::vector<AudioSpectrum> AudioSession::spectrums_latest(size_t num_last_spectrums){
     return m_spectrum_holder.spectrums_latest(num_last_spectrums);
 }
+void AudioSession::read_spectrums(AudioSpectrumCursor& cursor){
+    m_spectrum_holder.read_spectrums(cursor);
+}
 void AudioSession::add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color){
     m_spectrum_holder.add_overlay(starting_seqnum, end_seqnum, color);
 }
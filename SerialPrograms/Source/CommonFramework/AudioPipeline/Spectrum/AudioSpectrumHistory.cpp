@@ -0,0 +1,90 @@
+/*  Audio Spectrum History
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "AudioSpectrumHistory.h"
+
+namespace PokemonAutomation{
+
+
+
+AudioSpectrumHistory::AudioSpectrumHistory(size_t capacity)
+    : m_slots(capacity, AudioSpectrum(0, 0, nullptr))
+    , m_oldest(0)
+    , m_next(0)
+{}
+
+void AudioSpectrumHistory::clear(){
+    SpinLockGuard lg(m_lock, "AudioSpectrumHistory::clear()");
+    for (AudioSpectrum& slot : m_slots){
+        slot.magnitudes.reset();
+    }
+    m_oldest = m_next.load(std::memory_order_relaxed);
+}
+uint64_t AudioSpectrumHistory::push(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> magnitudes){
+    //  Swap the old buffer out under the lock, but let it go outside of it.
+    //  It may be the last reference.
+    std::shared_ptr<const AlignedVector<float>> evicted;
+
+    SpinLockGuard lg(m_lock, "AudioSpectrumHistory::push()");
+
+    uint64_t stamp = m_next.load(std::memory_order_relaxed);
+    AudioSpectrum& slot = m_slots[stamp % m_slots.size()];
+    slot.stamp = stamp;
+    slot.sample_rate = sample_rate;
+    evicted = std::move(slot.magnitudes);
+    slot.magnitudes = std::move(magnitudes);
+
+    if (stamp - m_oldest >= m_slots.size()){
+        m_oldest = stamp - m_slots.size() + 1;
+    }
+    m_next.store(stamp + 1, std::memory_order_release);
+
+    return stamp;
+}
+
+
+void AudioSpectrumHistory::read_range(std::vector<AudioSpectrum>& spectrums, uint64_t start, uint64_t end) const{
+    //  Must call under lock.
+    start = std::max(start, m_oldest);
+    for (uint64_t stamp = end; stamp-- > start;){
+        spectrums.emplace_back(m_slots[stamp % m_slots.size()]);
+    }
+}
+void AudioSpectrumHistory::read_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_stamp) const{
+    spectrums.clear();
+
+    //  Nothing new. Don't touch the lock.
+    if (starting_stamp >= m_next.load(std::memory_order_acquire)){
+        return;
+    }
+
+    SpinLockGuard lg(m_lock, "AudioSpectrumHistory::read_since()");
+    read_range(spectrums, starting_stamp, m_next.load(std::memory_order_relaxed));
+}
+void AudioSpectrumHistory::read_latest(std::vector<AudioSpectrum>& spectrums, size_t num_latest_spectrums) const{
+    spectrums.clear();
+
+    SpinLockGuard lg(m_lock, "AudioSpectrumHistory::read_latest()");
+    uint64_t end = m_next.load(std::memory_order_relaxed);
+    uint64_t start = end - std::min<uint64_t>(end, num_latest_spectrums);
+    read_range(spectrums, start, end);
+}
+void AudioSpectrumHistory::read(AudioSpectrumCursor& cursor) const{
+    if (cursor.next_stamp == ~(uint64_t)0){
+        read_latest(cursor.spectrums, 1);
+    }else{
+        read_since(cursor.spectrums, cursor.next_stamp);
+    }
+    if (!cursor.spectrums.empty()){
+        cursor.next_stamp = cursor.spectrums[0].stamp + 1;
+    }
+}
+
+
+
+
+}
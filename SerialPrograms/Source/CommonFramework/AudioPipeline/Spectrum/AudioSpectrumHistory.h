@@ -0,0 +1,70 @@
+/*  Audio Spectrum History
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A fixed-capacity ring of the most recent spectrums, indexed by stamp.
+ *  One thread pushes. Any number of threads read.
+ *
+ *  Nothing is allocated after construction. Readers copy out only the
+ *  spectrum headers (the magnitudes are shared) into a buffer that they keep
+ *  across calls. A reader that is already caught up never takes the lock.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_AudioSpectrumHistory_H
+#define PokemonAutomation_AudioPipeline_AudioSpectrumHistory_H
+
+#include <atomic>
+#include <vector>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+
+namespace PokemonAutomation{
+
+
+class AudioSpectrumHistory{
+public:
+    AudioSpectrumHistory(size_t capacity);
+
+    size_t capacity() const{ return m_slots.size(); }
+
+    //  Stamp that the next pushed spectrum will get.
+    uint64_t next_stamp() const{ return m_next.load(std::memory_order_acquire); }
+
+    //  Drop everything. Stamps keep counting up from where they were.
+    void clear();
+
+    //  Returns the stamp of the new spectrum.
+    uint64_t push(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> magnitudes);
+
+
+public:
+    //  These replace the contents of "spectrums" and keep its capacity.
+    //  Spectrums are ordered from newest to oldest.
+
+    void read_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_stamp) const;
+    void read_latest(std::vector<AudioSpectrum>& spectrums, size_t num_latest_spectrums) const;
+
+    //  Read everything that "cursor" hasn't seen yet and move it forward.
+    void read(AudioSpectrumCursor& cursor) const;
+
+
+private:
+    void read_range(std::vector<AudioSpectrum>& spectrums, uint64_t start, uint64_t end) const;
+
+
+private:
+    mutable SpinLock m_lock;
+
+    //  Slot for stamp "s" is "m_slots[s % capacity]".
+    std::vector<AudioSpectrum> m_slots;
+
+    //  Stamps [m_oldest, m_next) are in the ring.
+    uint64_t m_oldest;
+    std::atomic<uint64_t> m_next;
+};
+
+
+
+}
+#endif
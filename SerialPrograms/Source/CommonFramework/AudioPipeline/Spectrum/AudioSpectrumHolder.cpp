@@ -21,6 +21,7 @@ AudioSpectrumHolder::AudioSpectrumHolder()
     , m_freq_visualization_block_boundaries(m_num_freq_visualization_blocks+1)
     , m_spectrograph(m_num_freq_visualization_blocks, m_num_freq_windows)
     , m_freqVisStamps(m_num_freq_windows)
+    , m_spectrums(40)
 {
     m_last_spectrum.values.resize(m_num_freq_visualization_blocks);
     m_last_spectrum.colors.resize(m_num_freq_visualization_blocks);
@@ -96,11 +97,8 @@ void AudioSpectrumHolder::clear(){
     m_freqVisStamps.assign(m_freqVisStamps.size(), SIZE_MAX);
 
     {
-        // update m_spectrum_stamp_start in case the audio widget is used
+        // The stamps keep counting up in case the audio widget is used
         // again to store new spectrums.
-        if (m_spectrums.size() > 0){
-            m_spectrum_stamp_start = m_spectrums.front().stamp + 1;
-        }
         m_spectrums.clear();
 
         m_spectrograph.clear();
@@ -151,11 +149,7 @@ void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<cons
     const AlignedVector<float>& output = *fft_output;
 
     {
-        const size_t stamp = (m_spectrums.size() > 0) ? m_spectrums.front().stamp + 1 : m_spectrum_stamp_start;
-        m_spectrums.emplace_front(stamp, sample_rate, fft_output);
-        if (m_spectrums.size() > m_spectrum_history_length){
-            m_spectrums.pop_back();
-        }
+        const uint64_t stamp = m_spectrums.push(sample_rate, fft_output);
 
         // std::cout << "Load FFT output , stamp " << spectrum->stamp << std::endl;
         m_freqVisStamps[m_nextFFTWindowIndex] = stamp;
@@ -246,33 +240,17 @@ void AudioSpectrumHolder::add_overlay(uint64_t starting_stamp, uint64_t end_stam
 
 std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_since(uint64_t starting_stamp){
     std::vector<AudioSpectrum> spectrums;
-
-    std::lock_guard<std::mutex> lg(m_state_lock);
-
-    for (const auto& ptr : m_spectrums){
-        if (ptr.stamp >= starting_stamp){
-            spectrums.emplace_back(ptr);
-        } else{
-            break;
-        }
-    }
+    m_spectrums.read_since(spectrums, starting_stamp);
     return spectrums;
 }
 std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_latest(size_t num_latest_spectrums){
     std::vector<AudioSpectrum> spectrums;
-
-    std::lock_guard<std::mutex> lg(m_state_lock);
-
-    size_t i = 0;
-    for (const auto& ptr : m_spectrums){
-        if (i == num_latest_spectrums){
-            break;
-        }
-        spectrums.push_back(ptr);
-        i++;
-    }
+    m_spectrums.read_latest(spectrums, num_latest_spectrums);
     return spectrums;
 }
+void AudioSpectrumHolder::read_spectrums(AudioSpectrumCursor& cursor) const{
+    m_spectrums.read(cursor);
+}
 AudioSpectrumHolder::SpectrumSnapshot AudioSpectrumHolder::get_last_spectrum() const{
     std::lock_guard<std::mutex> lg(m_state_lock);
     return m_last_spectrum;
@@ -13,6 +13,7 @@
 #include <fstream>
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "AudioSpectrumHistory.h"
 #include "Spectrograph.h"
 
 namespace PokemonAutomation{
@@ -46,6 +47,10 @@ public:
     std::vector<AudioSpectrum> spectrums_since(uint64_t starting_stamp);
     std::vector<AudioSpectrum> spectrums_latest(size_t num_latest_spectrums);
 
+    //  Same as above, but reuses the cursor's buffer and doesn't wait on
+    //  the spectrograph.
+    void read_spectrums(AudioSpectrumCursor& cursor) const;
+
     struct SpectrumSnapshot{
         std::vector<float> values;
         std::vector<uint32_t> colors;
@@ -88,12 +93,9 @@ private:
 
     // record the past FFT output frequencies to serve as the interface
     // of audio inference for automation programs.
-    // The head of the list is the most recent FFT window, while the tail
-    // is the oldest in history.
-    std::list<AudioSpectrum> m_spectrums;
-    size_t m_spectrum_history_length = 40;
-    // The initial timestamp for the incoming spectrums.
-    size_t m_spectrum_stamp_start = 0;
+    // This has its own lock so that the inference callbacks polling it don't
+    // wait on the spectrograph or the UI.
+    AudioSpectrumHistory m_spectrums;
 
     // Develop purpose: used to save received frequencies to disk
     bool m_saveFreqToDisk = false;
@@ -4,6 +4,7 @@
  *
  */
 
+#include <atomic>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Kernels/AbsFFT/Kernels_AbsFFT.h"
@@ -13,6 +14,10 @@
 namespace PokemonAutomation{
 
 
+//  Don't hold on to more than this many spare FFT outputs.
+const size_t MAX_FFT_OUTPUT_POOL_SIZE = 256;
+
+
 
 std::unique_ptr<AudioFloatToFFT> make_FFT_streamer(AudioChannelFormat format){
     switch (format){
@@ -113,12 +118,38 @@ void AudioFloatToFFT::run_fft(){
             index = 0;
         }
     }
-    std::shared_ptr<AlignedVector<float>> out = std::make_unique<AlignedVector<float>>(NUM_FFT_SAMPLES / 2);
+    std::shared_ptr<AlignedVector<float>> out = get_output_buffer();
     Kernels::AbsFFT::fft_abs(FFT_LENGTH_POWER_OF_TWO, out->data(), m_fft_input.data());
     for (FFTListener* listener : m_listeners){
         listener->on_fft(m_sample_rate, out);
     }
 }
+std::shared_ptr<AlignedVector<float>> AudioFloatToFFT::get_output_buffer(){
+    //  Buffers are released in about the same order they were handed out.
+    //  So start looking after the last one that was reused.
+    size_t size = m_output_pool.size();
+    for (size_t c = 0; c < size; c++){
+        size_t index = m_output_pool_index + c;
+        if (index >= size){
+            index -= size;
+        }
+        //  Only the pool holds it. Anyone downstream that still wants the
+        //  old contents must hold a strong reference, not a weak_ptr.
+        if (m_output_pool[index].use_count() == 1){
+            //  use_count() is a relaxed load. Make sure the last holder is
+            //  done reading before we write over it.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            m_output_pool_index = index + 1 < size ? index + 1 : 0;
+            return m_output_pool[index];
+        }
+    }
+
+    std::shared_ptr<AlignedVector<float>> out = std::make_shared<AlignedVector<float>>(NUM_FFT_SAMPLES / 2);
+    if (size < MAX_FFT_OUTPUT_POOL_SIZE){
+        m_output_pool.emplace_back(out);
+    }
+    return out;
+}
 void AudioFloatToFFT::drop_from_front(size_t frames){
     if (frames >= m_buffered){
         m_buffered = 0;
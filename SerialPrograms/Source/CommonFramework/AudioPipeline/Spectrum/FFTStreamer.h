@@ -37,6 +37,7 @@ private:
     void convert(float* fft_input, const float* audio_stream, size_t frames);
     void run_fft();
     void drop_from_front(size_t frames);
+    std::shared_ptr<AlignedVector<float>> get_output_buffer();
 
 private:
     size_t m_sample_rate;
@@ -51,6 +52,12 @@ private:
 
     AlignedVector<float> m_fft_input;
 
+    //  Listeners hold on to the FFT outputs for a while. (the spectrum
+    //  history keeps the last 40) Once they've all let go of one, it gets
+    //  reused here instead of allocating a new one for every FFT.
+    std::vector<std::shared_ptr<AlignedVector<float>>> m_output_pool;
+    size_t m_output_pool_index = 0;
+
     std::set<FFTListener*> m_listeners;
 };
 
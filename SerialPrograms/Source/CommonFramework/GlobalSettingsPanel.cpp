@@ -173,6 +173,21 @@ GlobalSettings::GlobalSettings()
         "Thread priority of computation threads.",
         DEFAULT_PRIORITY_COMPUTE
     )
+    , PARALLEL_VIDEO_INFERENCE(
+        "<b>Parallel Video Inference:</b><br>"
+        "Run all the visual detectors that are due on the same frame in parallel instead of one at a time. "
+        "This lowers detection latency when many detectors are active, but uses more CPU cores.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        false
+    )
+    , PARALLEL_OCR_THREADS(
+        "<b>Parallel OCR Threads:</b><br>"
+        "When reading text through multiple color filters, OCR up to this many of the filtered images at the same time. "
+        "Set to 1 to read them one at a time. Each thread keeps its own Tesseract instance which uses more memory.<br>"
+        "Restart the program for this to fully take effect.",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        4, 1, 32
+    )
     , AUDIO_FILE_VOLUME_SCALE(
         "<b>Audio File Input Volume Scale:</b><br>"
         "Multiply audio file playback by this factor. (This is linear scale. So each factor of 10 is 20dB.)",
@@ -242,6 +257,8 @@ GlobalSettings::GlobalSettings()
     PA_ADD_OPTION(REALTIME_THREAD_PRIORITY0);
     PA_ADD_OPTION(INFERENCE_PRIORITY0);
     PA_ADD_OPTION(COMPUTE_PRIORITY0);
+    PA_ADD_OPTION(PARALLEL_VIDEO_INFERENCE);
+    PA_ADD_OPTION(PARALLEL_OCR_THREADS);
 
     PA_ADD_OPTION(AUDIO_FILE_VOLUME_SCALE);
     PA_ADD_OPTION(AUDIO_DEVICE_VOLUME_SCALE);
@@ -283,6 +300,8 @@ void GlobalSettings::load_json(const JsonValue& json){
         ) + ")</font>"
     );
 
+    obj->read_boolean(BUILD_SPRITE_BUNDLES, "BUILD_SPRITE_BUNDLES");
+
     COMMAND_LINE_TEST_LIST.clear();
     COMMAND_LINE_IGNORE_LIST.clear();
     const JsonObject* command_line_tests_setting = obj->get_object("COMMAND_LINE_TESTS");
@@ -293,6 +312,11 @@ void GlobalSettings::load_json(const JsonValue& json){
             COMMAND_LINE_TEST_FOLDER = "CommandLineTests";
         }
 
+        command_line_tests_setting->read_integer(COMMAND_LINE_BENCHMARK_ITERATIONS, "BENCHMARK_ITERATIONS", 0, 1000000);
+        if (!command_line_tests_setting->read_string(COMMAND_LINE_BENCHMARK_OUTPUT, "BENCHMARK_OUTPUT")){
+            COMMAND_LINE_BENCHMARK_OUTPUT = "CommandLineBenchmark.json";
+        }
+
         const JsonArray* test_list = command_line_tests_setting->get_array("TEST_LIST");
         if (test_list){
             for (const auto& value: *test_list){
@@ -336,6 +360,10 @@ void GlobalSettings::load_json(const JsonValue& json){
                     std::cout << "..." << std::endl;
                 }
             }
+            if (COMMAND_LINE_BENCHMARK_ITERATIONS > 0){
+                std::cout << "Benchmark each test " << COMMAND_LINE_BENCHMARK_ITERATIONS << " times. "
+                          << "Save results to " << COMMAND_LINE_BENCHMARK_OUTPUT << std::endl;
+            }
         }
     }
 }
@@ -344,10 +372,13 @@ void GlobalSettings::load_json(const JsonValue& json){
 JsonValue GlobalSettings::to_json() const{
     JsonObject obj = std::move(*BatchOption::to_json().get_object());
     obj["NAUGHTY_MODE"] = PreloadSettings::instance().NAUGHTY_MODE;
+    obj["BUILD_SPRITE_BUNDLES"] = BUILD_SPRITE_BUNDLES;
 
     JsonObject command_line_test_obj;
     command_line_test_obj["RUN"] = COMMAND_LINE_TEST_MODE;
     command_line_test_obj["FOLDER"] = COMMAND_LINE_TEST_FOLDER;
+    command_line_test_obj["BENCHMARK_ITERATIONS"] = COMMAND_LINE_BENCHMARK_ITERATIONS;
+    command_line_test_obj["BENCHMARK_OUTPUT"] = COMMAND_LINE_BENCHMARK_OUTPUT;
 
     {
         JsonArray test_list;
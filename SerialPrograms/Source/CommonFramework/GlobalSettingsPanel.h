@@ -105,6 +105,8 @@ public:
     ThreadPriorityOption REALTIME_THREAD_PRIORITY0;
     ThreadPriorityOption INFERENCE_PRIORITY0;
     ThreadPriorityOption COMPUTE_PRIORITY0;
+    BooleanCheckBoxOption PARALLEL_VIDEO_INFERENCE;
+    SimpleIntegerOption<uint8_t> PARALLEL_OCR_THREADS;
 
     FloatingPointOption AUDIO_FILE_VOLUME_SCALE;
     FloatingPointOption AUDIO_DEVICE_VOLUME_SCALE;
@@ -129,6 +131,14 @@ public:
     // Which tests to ignore running under the command line test mode.
     // If a test path appears in both COMMAND_LINE_TEST_LIST and COMMAND_LINE_IGNORE_LIST, it's still ignored.
     std::vector<std::string> COMMAND_LINE_IGNORE_LIST;
+    // If non-zero, benchmark each passing test by running it this many more times.
+    // See Tests/TestBenchmark.h.
+    size_t COMMAND_LINE_BENCHMARK_ITERATIONS = 0;
+    // Where to write the benchmark results as JSON.
+    std::string COMMAND_LINE_BENCHMARK_OUTPUT;
+
+    // Write the sprite bundles instead of launching the GUI. See SpriteBundles.h.
+    bool BUILD_SPRITE_BUNDLES = false;
 };
 
 
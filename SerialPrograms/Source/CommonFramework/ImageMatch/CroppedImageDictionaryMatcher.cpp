@@ -5,6 +5,7 @@
  */
 
 #include <cmath>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
@@ -80,12 +81,56 @@ ImageMatchResult CroppedImageDictionaryMatcher::match(
 
 
 
+    //  Group the templates by dimensions so that each crop only needs to be
+    //  resized once per distinct template size.
+    struct Entry{
+        size_t width;
+        size_t height;
+        size_t index;
+        const WeightedExactImageMatcher* matcher;
+
+        bool operator<(const Entry& x) const{
+            if (width != x.width) return width < x.width;
+            if (height != x.height) return height < x.height;
+            return index < x.index;
+        }
+    };
+    std::vector<Entry> entries;
+    entries.reserve(m_database.size());
     for (const auto& item : m_database){
-        for (const ImageViewRGB32& crop : crops){
-            double alpha = item.second.diff(crop);
+        const ImageRGB32& image_template = item.second.image_template();
+        entries.emplace_back(Entry{image_template.width(), image_template.height(), entries.size(), &item.second});
+    }
+    std::sort(entries.begin(), entries.end());
+
+    std::vector<double> alphas(entries.size() * crops.size());
+    ImageRGB32 scaled;
+    ImageRGB32 buffer;
+    for (size_t s = 0; s < entries.size();){
+        size_t width = entries[s].width;
+        size_t height = entries[s].height;
+        size_t e = s + 1;
+        while (e < entries.size() && entries[e].width == width && entries[e].height == height){
+            e++;
+        }
+        for (size_t c = 0; c < crops.size(); c++){
+            scaled = crops[c].scale_to(width, height);
+            for (size_t i = s; i < e; i++){
+                alphas[entries[i].index * crops.size() + c] = entries[i].matcher->diff_presized(scaled, buffer);
+            }
+        }
+        s = e;
+    }
+
+    //  Add in the same order as a straight loop over the templates.
+    size_t index = 0;
+    for (const auto& item : m_database){
+        for (size_t c = 0; c < crops.size(); c++){
+            double alpha = alphas[index * crops.size() + c];
             results.add(alpha, item.first);
             results.clear_beyond_spread(alpha_spread);
         }
+        index++;
     }
 
 
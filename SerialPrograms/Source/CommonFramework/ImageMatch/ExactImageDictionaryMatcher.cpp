@@ -112,9 +112,11 @@ double ExactImageDictionaryMatcher::compare(
 //    sprite.m_image.save("sprite.png");
 //    images[0].save("image.png");
 
+    //  The images are already the same size as the sprite.
+    ImageRGB32 buffer;
     double best = 10000;
     for (const ImageRGB32& image : images){
-        double rmsd_alpha = sprite.diff(image);
+        double rmsd_alpha = sprite.diff_presized(image, buffer);
 //        cout << rmsd_alpha << endl;
 //        if (rmsd_alpha < 0.38){
 //            sprite.m_image.save("sprite.png");
@@ -5,6 +5,7 @@
  */
 
 #include <cmath>
+#include <string.h>
 #include "Common/Cpp/Exceptions.h"
 #include "ImageDiff.h"
 #include "ExactImageMatcher.h"
@@ -27,7 +28,7 @@ ExactImageMatcher::ExactImageMatcher(ImageRGB32 image)
 //    cout << m_stats.stddev.sum() << endl;
 }
 
-ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& image) const{
+void ExactImageMatcher::scale_template_brightness(ImageRGB32& buffer, const ImageViewRGB32& image) const{
     FloatPixel image_brightness = pixel_average(image, m_image);
     FloatPixel scale = image_brightness / m_stats.average;
 
@@ -36,10 +37,20 @@ ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& im
     if (std::isnan(scale.b)) scale.b = 1.0;
     scale.bound(0.85, 1.15);
 
-    ImageRGB32 ret = m_image.copy();
-    scale_brightness(ret, scale);
-//    ret.save("test.png");
-    return ret;
+    size_t width = m_image.width();
+    size_t height = m_image.height();
+    if (buffer.width() != width || buffer.height() != height){
+        buffer = ImageRGB32(width, height);
+    }
+    const char* src = (const char*)m_image.data();
+    char* dst = (char*)buffer.data();
+    for (size_t r = 0; r < height; r++){
+        memcpy(dst, src, width * sizeof(uint32_t));
+        src += m_image.bytes_per_row();
+        dst += buffer.bytes_per_row();
+    }
+    scale_brightness(buffer, scale);
+//    buffer.save("test.png");
 }
 
 
@@ -53,42 +64,65 @@ double ExactImageMatcher::rmsd(const ImageViewRGB32& image) const{
 //    cout << "ExactImageMatcher::rmsd(): image = " << image.width() << " x " << image.height() << endl;
     ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
 //    cout << "ExactImageMatcher::rmsd(): scaled = " << scaled.width() << " x " << scaled.height() << endl;
-    ImageRGB32 reference = scale_template_brightness(scaled);
+    ImageRGB32 reference;
+    return rmsd_presized(scaled, reference);
+}
+double ExactImageMatcher::rmsd(const ImageViewRGB32& image, Color background) const{
+    if (!image){
+        return 1000.;
+    }
+    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
+    ImageRGB32 reference;
+    return rmsd_presized(scaled, background, reference);
+}
+double ExactImageMatcher::rmsd_masked(const ImageViewRGB32& image) const{
+    if (!image){
+        return 1000.;
+    }
+    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
+    ImageRGB32 reference;
+    return rmsd_masked_presized(scaled, reference);
+}
+
+
+double ExactImageMatcher::rmsd_presized(const ImageViewRGB32& image, ImageRGB32& buffer) const{
+    if (!image){
+        return 1000.;
+    }
+    scale_template_brightness(buffer, image);
 
 #if 0
     static int c = 0;
     image.save("test-" + std::to_string(c) + "-image.png");
-    reference.save("test-" + std::to_string(c) + "-sprite.png");
+    buffer.save("test-" + std::to_string(c) + "-sprite.png");
     c++;
 #endif
 
-    double rmsd = pixel_RMSD(reference, scaled);
+    double rmsd = pixel_RMSD(buffer, image);
 //    cout << "rmsd = " << rmsd << endl;
     return rmsd;
 }
-double ExactImageMatcher::rmsd(const ImageViewRGB32& image, Color background) const{
+double ExactImageMatcher::rmsd_presized(const ImageViewRGB32& image, Color background, ImageRGB32& buffer) const{
     if (!image){
         return 1000.;
     }
-    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-    ImageRGB32 reference = scale_template_brightness(scaled);
+    scale_template_brightness(buffer, image);
 
 #if 0
     static int c = 0;
-    scaled.save("test-" + std::to_string(c) + "-image.png");
-    reference.save("test-" + std::to_string(c) + "-sprite.png");
+    image.save("test-" + std::to_string(c) + "-image.png");
+    buffer.save("test-" + std::to_string(c) + "-sprite.png");
     c++;
 #endif
 
-    return pixel_RMSD(reference, scaled, background);
+    return pixel_RMSD(buffer, image, background);
 }
-double ExactImageMatcher::rmsd_masked(const ImageViewRGB32& image) const{
+double ExactImageMatcher::rmsd_masked_presized(const ImageViewRGB32& image, ImageRGB32& buffer) const{
     if (!image){
         return 1000.;
     }
-    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-    ImageRGB32 reference = scale_template_brightness(scaled);
-    return pixel_RMSD_masked(reference, scaled);
+    scale_template_brightness(buffer, image);
+    return pixel_RMSD_masked(buffer, image);
 }
 
 
@@ -118,6 +152,12 @@ double WeightedExactImageMatcher::diff_masked(const ImageViewRGB32& image) const
     }
     return rmsd_masked(image) * m_multiplier;
 }
+double WeightedExactImageMatcher::diff_presized(const ImageViewRGB32& image, ImageRGB32& buffer) const{
+    if (!image){
+        return 1000.;
+    }
+    return rmsd_presized(image, buffer) * m_multiplier;
+}
 
 
 
@@ -48,12 +48,20 @@ public:
     // If both two images have alpha==0 on one pixel, that pixel is ignored.
     double rmsd_masked(const ImageViewRGB32& image) const;
 
+    // Same as the above, but `image` must already have the same shape as the image template.
+    // `buffer` is scratch space for the brightness-scaled template. Reuse it across calls
+    // (e.g. when matching the same image against many templates of the same shape) to avoid
+    // allocating a new template copy on every call.
+    double rmsd_presized(const ImageViewRGB32& image, ImageRGB32& buffer) const;
+    double rmsd_presized(const ImageViewRGB32& image, Color background, ImageRGB32& buffer) const;
+    double rmsd_masked_presized(const ImageViewRGB32& image, ImageRGB32& buffer) const;
+
     const ImageRGB32& image_template() const { return m_image; }
 
 private:
-    // scale stored image template according to the brightness of `image`, assign
-    // the scaled template to `reference`.
-    ImageRGB32 scale_template_brightness(const ImageViewRGB32& image) const;
+    // scale stored image template according to the brightness of `image`, write
+    // the scaled template to `buffer`. `buffer` is resized if needed.
+    void scale_template_brightness(ImageRGB32& buffer, const ImageViewRGB32& image) const;
 
 protected:
     ImageRGB32 m_image;
@@ -88,6 +96,9 @@ public:
     // Like ExactImageMatcher::rmsd_masked(image) but scale based on template stddev.
     double diff_masked(const ImageViewRGB32& image) const;
 
+    // Like ExactImageMatcher::rmsd_presized(image, buffer) but scale based on template stddev.
+    double diff_presized(const ImageViewRGB32& image, ImageRGB32& buffer) const;
+
 public:
     double m_multiplier;
 };
@@ -98,6 +98,19 @@ PackedBinaryMatrix compress_rgb32_to_binary_multirange(
 
 
 
+//  Filter on the HSV of each pixel without building an ImageHSV32 first.
+//  `mins` and `maxs` are packed like the pixels of ImageHSV32. Alpha must
+//  also be in range. If the min hue is larger than the max hue, the hue
+//  range wraps around through H = 0.
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs
+);
+
+
+
+
+
 PackedBinaryMatrix compress_rgb32_to_binary_euclidean(
     const ImageViewRGB32& image,
     uint32_t expected, double max_euclidean_distance
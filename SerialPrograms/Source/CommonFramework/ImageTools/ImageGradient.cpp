@@ -4,6 +4,13 @@
  *
  */
 
+#include <math.h>
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+#include <cmath>
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels/ImageGradient/Kernels_ImageGradient.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "ImageGradient.h"
@@ -154,7 +161,86 @@ size_t count_vertical_translucent_border_pixels(const ImageViewRGB32& image, con
 }
 
 
+namespace{
 
+//  Run the Sobel kernel into a buffer of packed gradients. See Kernels_ImageGradient.h for the format.
+AlignedVector<uint32_t> run_sobel_gradient(const ImageViewRGB32& image){
+    AlignedVector<uint32_t> gradient(image.width() * image.height());
+    Kernels::sobel_gradient_rgb32(
+        gradient.data(), image.width() * sizeof(uint32_t),
+        image.data(), image.bytes_per_row(),
+        image.width(), image.height()
+    );
+    return gradient;
+}
+
+}
+
+ImageRGB32 compute_sobel_gradient(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    AlignedVector<uint32_t> gradient = run_sobel_gradient(image);
+
+    ImageRGB32 result(width, height);
+    for (size_t y = 0; y < height; y++){
+        const uint32_t* in = gradient.data() + y * width;
+        for (size_t x = 0; x < width; x++){
+            uint32_t g = in[x];
+            if (g == Kernels::SOBEL_GRADIENT_NONE){
+                result.pixel(x, y) = 0;
+                continue;
+            }
+            //  Average over the 3 channels.
+            int gx = ((int16_t)(g & 0xffff) + 1) / 3;
+            int gy = ((int16_t)(g >> 16) + 1) / 3;
+            uint32_t gxc = (uint32_t)std::min(std::abs(gx), 255);
+            uint32_t gyc = (uint32_t)std::min(std::abs(gy), 255);
+            result.pixel(x, y) = 0xff000000 | (gxc << 16) | (gyc << 8);
+        }
+    }
+    return result;
+}
 
+std::vector<double> compute_sobel_gradient_histogram(const ImageViewRGB32& image, size_t num_bins, int min_magnitude2){
+    std::vector<double> result(num_bins, 0.);
+    if (num_bins == 0){
+        return result;
+    }
+    const double inverse_bin_angle = num_bins / (2. * M_PI);
+    AlignedVector<uint32_t> gradient = run_sobel_gradient(image);
+
+    size_t count = 0;
+    for (size_t c = 0; c < image.width() * image.height(); c++){
+        uint32_t g = gradient[c];
+        if (g == Kernels::SOBEL_GRADIENT_NONE){
+            continue;
+        }
+        int gx = (int16_t)(g & 0xffff);
+        int gy = (int16_t)(g >> 16);
+        if (gx*gx + gy*gy <= min_magnitude2){
+            continue;
+        }
+        count++;
+        double angle = std::atan2(gy, gx);  //  [-pi, pi]
+        size_t bin = (size_t)std::max((angle + M_PI) * inverse_bin_angle, 0.);
+        result[std::min(bin, num_bins - 1)]++;
+    }
+
+    for (double& bin : result){
+        bin /= count;
+    }
+    return result;
+}
+
+double sobel_gradient_block_distance(
+    const ImageViewRGB32& gradient_template, const ImageViewRGB32& gradient,
+    size_t max_offset, size_t block_radius
+){
+    return Kernels::gradient_block_match_rgb32(
+        gradient.data(), gradient.bytes_per_row(), gradient.width(), gradient.height(),
+        gradient_template.data(), gradient_template.bytes_per_row(), gradient_template.width(), gradient_template.height(),
+        max_offset, block_radius
+    );
+}
 
 }
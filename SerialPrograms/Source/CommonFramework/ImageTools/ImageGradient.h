@@ -37,5 +37,29 @@ size_t count_horizontal_translucent_border_pixels(const ImageViewRGB32& image, c
 // The image is supposed to have a very small width, as it only holds a vertical border line.
 size_t count_vertical_translucent_border_pixels(const ImageViewRGB32& image, const Color& threshold, bool dark_left);
 
+
+// Run a 3x3 Sobel filter over the image. The gradient of each pixel is the average over the RGB channels.
+// Each output pixel stores the absolute x gradient (capped at 255) in the red channel and the absolute y
+// gradient in the green channel, with an alpha of 255.
+// Pixels on the image border, and pixels whose 3x3 window contains a pixel with alpha < 128, are set to 0
+// (fully transparent).
+ImageRGB32 compute_sobel_gradient(const ImageViewRGB32& image);
+
+// Histogram of the Sobel gradient directions over the image, with `num_bins` bins spanning [-pi, pi).
+// Only gradients whose squared magnitude (summed over the RGB channels) is above `min_magnitude2` are
+// counted. The histogram is normalized to sum to 1. Transparent windows are skipped as in
+// `compute_sobel_gradient()`.
+std::vector<double> compute_sobel_gradient_histogram(const ImageViewRGB32& image, size_t num_bins, int min_magnitude2);
+
+// Compare two gradient images returned by `compute_sobel_gradient()`.
+// For every non-transparent pixel of `gradient`, the (2 * block_radius + 1)^2 block around it is compared
+// against the same block of `gradient_template` shifted by up to `max_offset` pixels in each direction.
+// The best shift is picked for each pixel independently. Returns the average of these best block
+// distances, or NaN if no pixel can be compared.
+double sobel_gradient_block_distance(
+    const ImageViewRGB32& gradient_template, const ImageViewRGB32& gradient,
+    size_t max_offset, size_t block_radius
+);
+
 }
 #endif
@@ -0,0 +1,64 @@
+/*  Image Pyramid
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <algorithm>
+#include "Kernels/ImageDownscale/Kernels_ImageDownscale.h"
+#include "ImagePyramid.h"
+
+namespace PokemonAutomation{
+
+
+
+ImageRGB32 downscale_half(const ImageViewRGB32& image){
+    ImageRGB32 ret(image.width() / 2, image.height() / 2);
+    Kernels::downscale_half(
+        ret.data(), ret.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        ret.width(), ret.height()
+    );
+    return ret;
+}
+
+
+
+ImagePyramidRGB32::ImagePyramidRGB32(std::shared_ptr<const ImageRGB32> image)
+    : m_base(std::move(image))
+    , m_built(0)
+{}
+
+ImageViewRGB32 ImagePyramidRGB32::level(size_t level){
+    if (!m_base){
+        return ImageViewRGB32();
+    }
+    if (level == 0 || !*m_base){
+        return *m_base;
+    }
+    level = std::min(level, MAX_LEVEL);
+
+    //  Fast path: Already built.
+    size_t built = m_built.load(std::memory_order_acquire);
+    if (level > built){
+        std::lock_guard<std::mutex> lg(m_lock);
+        built = m_built.load(std::memory_order_relaxed);
+        while (built < level){
+            const ImageViewRGB32& previous = built == 0 ? (const ImageViewRGB32&)*m_base : m_levels[built - 1];
+            if (previous.width() < 2 || previous.height() < 2){
+                break;
+            }
+            m_levels[built] = downscale_half(previous);
+            built++;
+            m_built.store(built, std::memory_order_release);
+        }
+    }
+
+    //  Image too small to go this far down.
+    level = std::min(level, built);
+    return level == 0 ? (const ImageViewRGB32&)*m_base : m_levels[level - 1];
+}
+
+
+
+}
@@ -0,0 +1,56 @@
+/*  Image Pyramid
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A set of progressively half-sized copies of an image.
+ *
+ *  Level 0 is the original image. Level N is 1/2^N the width and height.
+ *  Each level is built lazily from the previous one the first time it is
+ *  requested and is then reused by all later callers.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImagePyramid_H
+#define PokemonAutomation_CommonFramework_ImagePyramid_H
+
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+
+namespace PokemonAutomation{
+
+
+//  Downscale the image by 2 in each dimension using a 2x2 box filter.
+//  An odd last row or column is dropped.
+ImageRGB32 downscale_half(const ImageViewRGB32& image);
+
+
+class ImagePyramidRGB32{
+public:
+    //  1/2, 1/4, 1/8
+    static constexpr size_t MAX_LEVEL = 3;
+
+public:
+    ImagePyramidRGB32(std::shared_ptr<const ImageRGB32> image);
+
+    const std::shared_ptr<const ImageRGB32>& base() const{ return m_base; }
+
+    //  Return the image at the specified level. Builds it if needed.
+    //  The returned view is valid for as long as this pyramid is alive.
+    //  If the level would be empty, returns the smallest non-empty level.
+    //  Thread-safe.
+    ImageViewRGB32 level(size_t level);
+
+private:
+    std::shared_ptr<const ImageRGB32> m_base;
+
+    std::mutex m_lock;
+    std::atomic<size_t> m_built;
+    ImageRGB32 m_levels[MAX_LEVEL];
+};
+
+
+
+}
+#endif
@@ -97,6 +97,9 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     if (m_matcher == nullptr || m_matcher->sample_rate() != sample_rate){
         m_console.log("Loading spectrogram...");
         m_matcher = build_spectrogram_matcher(sample_rate);
+        if (m_front_end){
+            m_matcher->use_front_end(*m_front_end);
+        }
     }
 
     // Feed spectrum one by one to the matcher:
@@ -115,8 +118,7 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     bool found = false;
     const float threshold = get_score_threshold();
     for (auto it = new_spectrums.rbegin(); it != new_spectrums.rend(); it++){
-        std::vector<AudioSpectrum> single_spectrum = {*it};
-        const float matcher_score = m_matcher->match(single_spectrum);
+        const float matcher_score = m_matcher->match(*it);
         // std::cout << "error: " << matcherScore << std::endl;
 
         if (m_lowest_error < 1.0){
@@ -163,10 +165,9 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
 
             // Tell m_matcher to skip the remaining spectrums so that if `process_spectrums()` gets
             // called again on a newer batch of spectrums, m_matcher is happy.
-            m_matcher->skip(std::vector<AudioSpectrum>(
-                new_spectrums.begin(),
-                new_spectrums.begin() + std::distance(it + 1, new_spectrums.rend())
-            ));
+            for (auto skip_it = it + 1; skip_it != new_spectrums.rend(); skip_it++){
+                m_matcher->skip(*skip_it);
+            }
 
             // Skip the remaining spectrums.
             break;
@@ -197,6 +198,13 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     return m_detected_callback(m_last_error);
 }
 
+void AudioPerSpectrumDetectorBase::set_spectrogram_front_end(std::shared_ptr<SpectrogramFrontEnd> front_end){
+    m_front_end = std::move(front_end);
+    if (m_matcher && m_front_end){
+        m_matcher->use_front_end(*m_front_end);
+    }
+}
+
 void AudioPerSpectrumDetectorBase::clear(){
     m_matcher->clear();
 }
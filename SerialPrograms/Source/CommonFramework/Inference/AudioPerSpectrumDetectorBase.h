@@ -38,6 +38,7 @@ namespace PokemonAutomation{
 
 class ConsoleHandle;
 class SpectrogramMatcher;
+class SpectrogramFrontEnd;
 
 // A virtual base class for audio detectors to match an audio template starting at each incoming
 // spectrum in the audio stream.
@@ -74,6 +75,9 @@ public:
         AudioFeed& audio_feed
     ) override;
 
+    // Implement AudioInferenceCallback::set_spectrogram_front_end()
+    virtual void set_spectrogram_front_end(std::shared_ptr<SpectrogramFrontEnd> front_end) override;
+
     // Clear internal data to be used on another audio stream.
     void clear();
 
@@ -114,6 +118,8 @@ protected:
     bool m_last_reported = false;
     
     std::unique_ptr<SpectrogramMatcher> m_matcher;
+    // If set, the matcher reads its filtered spectrums from here.
+    std::shared_ptr<SpectrogramFrontEnd> m_front_end;
 
     std::vector<std::pair<float, std::string>> m_errors;
 };
@@ -26,12 +26,17 @@ AudioTemplateCache& AudioTemplateCache::instance(){
 
 
 const AudioTemplate* AudioTemplateCache::get_nothrow_internal(const std::string& full_path_no_ext, size_t sample_rate){
-    SpinLockGuard lg(m_lock);
-    auto iter = m_cache.find(full_path_no_ext);
-    if (iter != m_cache.end()){
-        return &iter->second;
+    {
+        SpinLockGuard lg(m_lock);
+        auto iter = m_cache.find(full_path_no_ext);
+        if (iter != m_cache.end()){
+            return &iter->second;
+        }
     }
 
+    //  Decode without holding the lock so that templates can be loaded in
+    //  parallel. If two threads race on the same template, the first one to
+    //  finish wins and the other copy is thrown away.
     std::string full_path = full_path_no_ext + ".wav";
     if (!QFileInfo::exists(QString::fromStdString(full_path))){
         full_path = full_path_no_ext + ".mp3";
@@ -42,8 +47,9 @@ const AudioTemplate* AudioTemplateCache::get_nothrow_internal(const std::string&
         return nullptr;
     }
 
-    iter = m_cache.emplace(
-        std::move(full_path_no_ext),
+    SpinLockGuard lg(m_lock);
+    auto iter = m_cache.emplace(
+        full_path_no_ext,
         std::move(audio_template)
     ).first;
 
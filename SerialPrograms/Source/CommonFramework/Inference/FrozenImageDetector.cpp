@@ -4,6 +4,7 @@
  *
  */
 
+#include <cmath>
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/ImageMatch/ImageDiff.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
@@ -36,12 +37,50 @@ FrozenImageDetector::FrozenImageDetector(
 void FrozenImageDetector::make_overlays(VideoOverlaySet& set) const{
     set.add(m_color, m_box);
 }
+bool FrozenImageDetector::definitely_changed(const VideoSnapshot& frame) const{
+    //  Most of the time the screen isn't frozen. Check that on the 1/4 scale
+    //  frames first and skip the full resolution comparison if the full
+    //  resolution RMSD is guaranteed to be over the threshold. Otherwise fall
+    //  through to the full comparison so the threshold means what it always has.
+    //
+    //  Each 1/4 scale pixel is the mean of a 4x4 block. Averaging can't raise
+    //  the RMS. (Jensen) The two rounded 2x2 averages move each channel of each
+    //  frame by at most 1/2 each. So each channel of a small difference is off
+    //  by at most 2 and each pixel by at most sqrt(3 * 2^2) = sqrt(12).
+    //  With M small pixels covering 16*M of the N full pixels:
+    //
+    //      full_rmsd^2 >= (16 * M / N) * (small_rmsd - sqrt(12))^2
+    //
+    //  This assumes opaque frames, which video frames always are.
+    size_t width = frame->width();
+    size_t height = frame->height();
+    ImageViewRGB32 previous = m_previous.downscaled(2);
+    ImageViewRGB32 current = frame.downscaled(2);
+    if (width < 4 || height < 4 ||
+        previous.width() != width / 4 || previous.height() != height / 4 ||
+        current.width() != width / 4 || current.height() != height / 4
+    ){
+        return false;
+    }
+
+    double margin = ImageMatch::pixel_RMSD(previous, current) - std::sqrt(12.);
+    if (margin <= 0){
+        return false;
+    }
+    double coverage = 16. * (double)(current.width() * current.height()) / (double)(width * height);
+    return coverage * margin * margin > m_rmsd_threshold * m_rmsd_threshold;
+}
 bool FrozenImageDetector::process_frame(const VideoSnapshot& frame){
     if (m_previous->width() != frame->width() || m_previous->height() != frame->height()){
         m_previous = frame;
         return false;
     }
 
+    if (definitely_changed(frame)){
+        m_previous = frame;
+        return false;
+    }
+
     double rmsd = ImageMatch::pixel_RMSD(m_previous, frame);
 //    cout << "rmsd = " << rmsd << endl;
     if (rmsd > m_rmsd_threshold){
@@ -29,6 +29,9 @@ public:
     virtual bool process_frame(const VideoSnapshot& frame) override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
 
+private:
+    bool definitely_changed(const VideoSnapshot& frame) const;
+
 private:
     Color m_color;
     ImageFloatBox m_box;
@@ -0,0 +1,160 @@
+/*  Spectrogram Front-End
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <tuple>
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels/Kernels_Alignment.h"
+#include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "SpectrogramFrontEnd.h"
+
+namespace PokemonAutomation{
+
+
+
+std::vector<float> buildSpikeKernel(size_t numFrequencies, size_t halfSampleRate){
+    std::vector<float> kernel;
+    // We find a good kernel when sample rate is 48K and numFrequencies is 2048:
+    // [-4.f, -3.f, -2.f, -1.f, 0.f, 1.f, 2.f, 3.f, 4.f, 4.f, 3.f, 2.f, 1.f, 0.f, -1.f, -2.f, -3.f, -4.f]
+    // This spans frenquency range of 17 * halfSampleRate / numFrequencies = 199.21875Hz, where 17 is the number of intervals in the above series.
+    // For another sample rate and numFrequencies combination, the number of intervals is
+    // 199.21875 * numFrequencies / halfSampleRate
+    size_t numKernelIntervals = int(199.21875 * numFrequencies / halfSampleRate + 0.5);
+    size_t slopeLen = numKernelIntervals / 2;
+    for(size_t i = 0; i <= slopeLen; i++){
+        kernel.push_back(-4.0f + 8.f * i / (float)slopeLen);
+    }
+    for(size_t i = ((numKernelIntervals+1) % 2); i <= slopeLen; i++){
+        kernel.push_back(-4.0f + 8.f * (slopeLen-i)/(float)slopeLen);
+    }
+    return kernel;
+}
+
+// std::vector<float> buildSmoothKernel(size_t numFrequencies, size_t halfSampleRate){
+//     std::vector<float> kernel;
+//     // We find a good kernel when sample rate is 48K and numFrequencies is 2048:
+//     // [0.0111, 0.135, 0.606, 1.0, 0.606, 0.135, 0.0111], built as Gaussian distribution with sigma(stddev) as 1.0
+//     // The equation for Gaussian is exp(-x^2/(2 sigma^2))
+//     // We can think sigma value as 1.0 * frequency_gap = 1.0 * halfSampleRate / numFrequencies = 11.71875 Hz
+// }
+
+
+
+bool SpectrogramFilter::operator<(const SpectrogramFilter& x) const{
+    return std::tie(mode, sample_rate, num_frequencies, freq_start, freq_end)
+         < std::tie(x.mode, x.sample_rate, x.num_frequencies, x.freq_start, x.freq_end);
+}
+
+
+
+SpectrogramChannel::SpectrogramChannel(const SpectrogramFilter& filter)
+    : m_filter(filter)
+    , m_history(HISTORY_SIZE)
+{
+    const size_t numRawFrequencies = m_filter.freq_end - m_filter.freq_start;
+    switch (m_filter.mode){
+    case SpectrogramMode::SPIKE_CONV:
+        m_conv_kernel = buildSpikeKernel(m_filter.num_frequencies, m_filter.sample_rate / 2);
+        m_num_frequencies = numRawFrequencies < m_conv_kernel.size()
+            ? 0
+            : numRawFrequencies - m_conv_kernel.size() + 1;
+        m_freq_start = 0;
+        m_freq_end = m_num_frequencies;
+        break;
+    case SpectrogramMode::AVERAGE_5:
+        m_num_frequencies = numRawFrequencies / 5;
+        m_freq_start = 0;
+        m_freq_end = m_num_frequencies;
+        break;
+    case SpectrogramMode::RAW:
+    default:
+        m_num_frequencies = m_filter.num_frequencies;
+        m_freq_start = m_filter.freq_start;
+        m_freq_end = m_filter.freq_end;
+        break;
+    }
+}
+
+void SpectrogramChannel::filter(float* dst, const float* src) const{
+    switch (m_filter.mode){
+    case SpectrogramMode::SPIKE_CONV:
+        if (m_num_frequencies == 0){
+            return;
+        }
+        Kernels::SpikeConvolution::compute_spike_kernel(
+            dst, src + m_filter.freq_start, m_filter.freq_end - m_filter.freq_start,
+            m_conv_kernel.data(), m_conv_kernel.size()
+        );
+        return;
+    case SpectrogramMode::AVERAGE_5:
+        for (size_t j = 0; j < m_num_frequencies; j++){
+            const float* rawFreqMag = src + m_filter.freq_start + j*5;
+            dst[j] = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
+        }
+        return;
+    case SpectrogramMode::RAW:
+    default:
+        memcpy(dst, src, m_num_frequencies * sizeof(float));
+        return;
+    }
+}
+
+FilteredSpectrum SpectrogramChannel::get(const AudioSpectrum& spectrum){
+    if (spectrum.sample_rate != m_filter.sample_rate ||
+        spectrum.magnitudes == nullptr ||
+        spectrum.magnitudes->size() != m_filter.num_frequencies
+    ){
+        return FilteredSpectrum();
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    //  Stamps keep counting up even when the audio stream is cleared. So the
+    //  stamp alone tells us if we've already filtered this spectrum.
+    size_t index = spectrum.stamp % HISTORY_SIZE;
+    FilteredSpectrum& entry = m_history[index];
+    if (entry.stamp == spectrum.stamp){
+        return entry;
+    }
+
+    FilteredSpectrum filtered;
+    filtered.stamp = spectrum.stamp;
+    if (m_filter.mode == SpectrogramMode::RAW){
+        filtered.magnitudes = spectrum.magnitudes;
+    }else{
+        size_t buffer_size = Kernels::align_int_up<PA_ALIGNMENT>(m_num_frequencies * sizeof(float)) / sizeof(float);
+        auto magnitudes = std::make_shared<AlignedVector<float>>(buffer_size);
+        filter(magnitudes->data(), spectrum.magnitudes->data());
+        filtered.magnitudes = std::move(magnitudes);
+    }
+
+    float normSqr = 0.0f;
+    for (size_t i = m_freq_start; i < m_freq_end; i++){
+        float mag = (*filtered.magnitudes)[i];
+        normSqr += mag * mag;
+    }
+    filtered.norm_sqr = normSqr;
+
+    entry = filtered;
+    return filtered;
+}
+
+
+
+std::shared_ptr<SpectrogramChannel> SpectrogramFrontEnd::get_channel(const SpectrogramFilter& filter){
+    std::lock_guard<std::mutex> lg(m_lock);
+    std::shared_ptr<SpectrogramChannel>& channel = m_channels[filter];
+    if (!channel){
+        channel = std::make_shared<SpectrogramChannel>(filter);
+    }
+    return channel;
+}
+
+
+
+
+}
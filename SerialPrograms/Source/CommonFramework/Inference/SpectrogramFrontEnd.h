@@ -0,0 +1,127 @@
+/*  Spectrogram Front-End
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Shared spectrum preprocessing for the spectrogram matchers that listen to
+ *  the same audio stream.
+ *
+ *  Every SpectrogramMatcher filters the incoming spectrums before it matches
+ *  them against its template. When several detectors run on the same audio
+ *  feed, most of them use the same filter. Without sharing, each one would
+ *  filter the same spectrums again.
+ *
+ *  A SpectrogramChannel filters each spectrum only once and keeps the recent
+ *  results in a ring buffer indexed by stamp. A SpectrogramFrontEnd gives
+ *  out one channel per filter. The matchers only keep pointers to the
+ *  filtered spectrums and run their own template correlation.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_SpectrogramFrontEnd_H
+#define PokemonAutomation_CommonFramework_SpectrogramFrontEnd_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include "Common/Cpp/Containers/AlignedVector.h"
+
+namespace PokemonAutomation{
+
+class AudioSpectrum;
+
+
+enum class SpectrogramMode{
+    // Don't do any processing on each window of spectrum, matching raw spectrums.
+    RAW,
+    // Do convolution on each window of spectrum with a peak detection kernel, before matching spectrums.
+    SPIKE_CONV,
+    // Do convolution on each window of spectrum with a Gaussian smooth kernel, before matching spectrums.
+    // GAUSSIAN_CONV,
+    // Average every 5 frequencies to reduce computation.
+    AVERAGE_5,
+};
+
+
+// The preprocessing to run on each spectrum of an audio stream.
+struct SpectrogramFilter{
+    SpectrogramMode mode;
+    size_t sample_rate;
+    // Number of frequencies in the raw spectrums.
+    size_t num_frequencies;
+    // Range of the raw frequencies to keep. (end is one past the last)
+    size_t freq_start;
+    size_t freq_end;
+
+    bool operator<(const SpectrogramFilter& x) const;
+};
+
+
+// One spectrum after filtering.
+struct FilteredSpectrum{
+    uint64_t stamp = ~(uint64_t)0;
+    std::shared_ptr<const AlignedVector<float>> magnitudes;
+    // Sum of squares of the magnitudes that are used for matching.
+    float norm_sqr = 0;
+};
+
+
+// Filters the spectrums of one audio stream with one filter.
+// This class is thread-safe.
+class SpectrogramChannel{
+public:
+    // How many filtered spectrums to keep around for other matchers.
+    static constexpr size_t HISTORY_SIZE = 256;
+
+    SpectrogramChannel(const SpectrogramFilter& filter);
+
+    const SpectrogramFilter& filter() const{ return m_filter; }
+
+    // Number of frequencies in each filtered spectrum.
+    size_t num_frequencies() const{ return m_num_frequencies; }
+
+    // Range of the filtered frequencies that are used for matching.
+    size_t freq_start() const{ return m_freq_start; }
+    size_t freq_end() const{ return m_freq_end; }
+
+    // Filter one raw window. "dst" must hold "num_frequencies()" floats.
+    void filter(float* dst, const float* src) const;
+
+    // Return the filtered version of "spectrum".
+    // Each stamp is only filtered once no matter how many matchers ask for it.
+    // If the spectrum doesn't fit this filter, the returned magnitudes are null.
+    FilteredSpectrum get(const AudioSpectrum& spectrum);
+
+
+private:
+    const SpectrogramFilter m_filter;
+    size_t m_num_frequencies;
+    size_t m_freq_start;
+    size_t m_freq_end;
+    std::vector<float> m_conv_kernel;
+
+    std::mutex m_lock;
+    // Ring buffer indexed by "stamp % HISTORY_SIZE".
+    std::vector<FilteredSpectrum> m_history;
+};
+
+
+// Hands out one SpectrogramChannel per filter. This class is thread-safe.
+// Channels tell spectrums apart only by stamp. So a front-end must only be
+// fed from one audio stream whose stamps never repeat.
+class SpectrogramFrontEnd{
+public:
+    std::shared_ptr<SpectrogramChannel> get_channel(const SpectrogramFilter& filter);
+
+private:
+    std::mutex m_lock;
+    std::map<SpectrogramFilter, std::shared_ptr<SpectrogramChannel>> m_channels;
+};
+
+
+
+
+}
+#endif
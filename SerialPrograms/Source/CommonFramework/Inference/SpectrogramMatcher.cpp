@@ -2,12 +2,12 @@
 
 #include <cfloat>
 #include <cmath>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 //#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h"
-#include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
 #include "SpectrogramMatcher.h"
@@ -19,31 +19,29 @@
 namespace PokemonAutomation{
 
 
-std::vector<float> buildSpikeKernel(size_t numFrequencies, size_t halfSampleRate){
-    std::vector<float> kernel;
-    // We find a good kernel when sample rate is 48K and numFrequencies is 2048:
-    // [-4.f, -3.f, -2.f, -1.f, 0.f, 1.f, 2.f, 3.f, 4.f, 4.f, 3.f, 2.f, 1.f, 0.f, -1.f, -2.f, -3.f, -4.f]
-    // This spans frenquency range of 17 * halfSampleRate / numFrequencies = 199.21875Hz, where 17 is the number of intervals in the above series.
-    // For another sample rate and numFrequencies combination, the number of intervals is
-    // 199.21875 * numFrequencies / halfSampleRate
-    size_t numKernelIntervals = int(199.21875 * numFrequencies / halfSampleRate + 0.5);
-    size_t slopeLen = numKernelIntervals / 2;
-    for(size_t i = 0; i <= slopeLen; i++){
-        kernel.push_back(-4.0f + 8.f * i / (float)slopeLen);
+namespace{
+
+// Dot product with several independent accumulators so that it vectorizes.
+double dot_product(const float* a, const float* b, size_t length){
+    constexpr size_t LANES = 8;
+    float sums[LANES] = {};
+    size_t c = 0;
+    for (; c + LANES <= length; c += LANES){
+        for (size_t k = 0; k < LANES; k++){
+            sums[k] += a[c + k] * b[c + k];
+        }
+    }
+    double ret = 0;
+    for (; c < length; c++){
+        ret += a[c] * b[c];
     }
-    for(size_t i = ((numKernelIntervals+1) % 2); i <= slopeLen; i++){
-        kernel.push_back(-4.0f + 8.f * (slopeLen-i)/(float)slopeLen);
+    for (size_t k = 0; k < LANES; k++){
+        ret += sums[k];
     }
-    return kernel;
+    return ret;
 }
 
-// std::vector<float> buildSmoothKernel(size_t numFrequencies, size_t halfSampleRate){
-//     std::vector<float> kernel;
-//     // We find a good kernel when sample rate is 48K and numFrequencies is 2048:
-//     // [0.0111, 0.135, 0.606, 1.0, 0.606, 0.135, 0.0111], built as Gaussian distribution with sigma(stddev) as 1.0
-//     // The equation for Gaussian is exp(-x^2/(2 sigma^2))
-//     // We can think sigma value as 1.0 * frequency_gap = 1.0 * halfSampleRate / numFrequencies = 11.71875 Hz
-// }
+}
 
 
 SpectrogramMatcher::SpectrogramMatcher(
@@ -79,52 +77,20 @@ SpectrogramMatcher::SpectrogramMatcher(
     m_originalFreqStart = int(low_frequency_filter * m_numOriginalFrequencies / halfSampleRate + 0.5);
     m_originalFreqEnd = 20000 * m_numOriginalFrequencies / halfSampleRate + 1;
 
-    // Initialize the spike convolution kernel:
-    m_convKernel = buildSpikeKernel(m_numOriginalFrequencies, halfSampleRate);
+    m_channel = std::make_shared<SpectrogramChannel>(SpectrogramFilter{
+        m_mode, sample_rate, m_numOriginalFrequencies, m_originalFreqStart, m_originalFreqEnd
+    });
 
-    switch(m_mode){
-    case Mode::SPIKE_CONV:
-    {
-        // Do convolution on audio template
-        const size_t numConvedFrequencies = (m_originalFreqEnd - m_originalFreqStart) - m_convKernel.size() + 1;
-
-        AudioTemplate audio_template(numConvedFrequencies, numTemplateWindows);
+    if (m_mode != Mode::RAW){
+        // Filter the template the same way as the audio stream.
+        AudioTemplate audio_template(m_channel->num_frequencies(), numTemplateWindows);
         for (size_t i = 0; i < numTemplateWindows; i++){
-            conv(
-                m_template.getWindow(i) + m_originalFreqStart, m_originalFreqEnd - m_originalFreqStart,
-                audio_template.getWindow(i)
-            );
+            m_channel->filter(audio_template.getWindow(i), m_template.getWindow(i));
         }
-
         m_template = std::move(audio_template);
-        m_freqStart = 0;
-        m_freqEnd = numConvedFrequencies;
-        break;
-    }
-    case Mode::AVERAGE_5:
-    {
-        // Avereage every 5 frequencies
-        const size_t numNewFreq = (m_originalFreqEnd - m_originalFreqStart) / 5;
-
-        AudioTemplate audio_template(numNewFreq, numTemplateWindows);
-        for (size_t i = 0; i < numTemplateWindows; i++){
-            for (size_t j = 0; j < numNewFreq; j++){
-                const float * rawFreqMag = m_template.getWindow(i) + m_originalFreqStart + j*5;
-                const float newMag = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
-                audio_template.getWindow(i)[j] = newMag;
-            }
-        }
-
-        m_template = std::move(audio_template);
-        m_freqStart = 0;
-        m_freqEnd = numNewFreq;
-        break;
-    }
-    case Mode::RAW:
-        m_freqStart = m_originalFreqStart;
-        m_freqEnd = m_originalFreqEnd;
-        break;
     }
+    m_freqStart = m_channel->freq_start();
+    m_freqEnd = m_channel->freq_end();
 
     if (templateSubdivision <= 1){
         m_templateRange.emplace_back(0, numTemplateWindows);
@@ -145,36 +111,43 @@ SpectrogramMatcher::SpectrogramMatcher(
 //    cout << "m_numSpectrumsNeeded = " << m_numSpectrumsNeeded << endl;
 
     m_templateNorm = buildTemplateNorm();
-}
+    m_spectrums.resize(m_numSpectrumsNeeded);
 
-uint64_t SpectrogramMatcher::latestTimestamp() const{
-    if (m_spectrums.size() == 0){
-        return SIZE_MAX;
+    const size_t freqs = m_freqEnd - m_freqStart;
+    m_templateSumSqr.resize(m_templateRange.size());
+    for (size_t sub_index = 0; sub_index < m_templateRange.size(); sub_index++){
+        double sumSqr = 0;
+        for (size_t i = 0; i < m_numSpectrumsNeeded; i++){
+            const float* window = sub_template_window(sub_index, i);
+            sumSqr += dot_product(window, window, freqs);
+        }
+        m_templateSumSqr[sub_index] = sumSqr;
     }
-    return m_spectrums.front().stamp;
 }
 
-void SpectrogramMatcher::conv(const float* src, size_t num, float* dst){
-//    cout << (size_t)dst % 64 << endl;
+void SpectrogramMatcher::set_engine(Engine engine){
+    m_engine = engine;
+    if (m_engine == Engine::INCREMENTAL){
+        m_correlations.assign(m_templateRange.size(), std::vector<double>(m_numSpectrumsNeeded));
+    }else{
+        m_correlations.clear();
+    }
+    clear();
+}
 
-    const size_t numConvedFrequencies = num - m_convKernel.size() + 1;
-    if (num < m_convKernel.size()){
-        memset(dst, 0, numConvedFrequencies * sizeof(float));
+void SpectrogramMatcher::use_front_end(SpectrogramFrontEnd& front_end){
+    if (m_channel == nullptr){
         return;
     }
+    m_channel = front_end.get_channel(m_channel->filter());
+    clear();
+}
 
-#if 0
-    for (size_t i = 0; i < num-m_convKernel.size()+1; i++){
-        dst[i] = 0.0f;
-        for (size_t j = 0; j < m_convKernel.size(); j++){
-            dst[i] += src[i+j] * m_convKernel[j];
-        }
+uint64_t SpectrogramMatcher::latestTimestamp() const{
+    if (m_numSpectrumsStored == 0){
+        return SIZE_MAX;
     }
-#else
-    Kernels::SpikeConvolution::compute_spike_kernel(
-        dst, src, num, m_convKernel.data(), m_convKernel.size()
-    );
-#endif
+    return stored(0).stamp;
 }
 
 std::vector<float> SpectrogramMatcher::buildTemplateNorm() const {
@@ -194,84 +167,98 @@ std::vector<float> SpectrogramMatcher::buildTemplateNorm() const {
     return ret;
 }
 
-bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum){
+bool SpectrogramMatcher::update_to_new_spectrum(const AudioSpectrum& spectrum){
     if (m_numOriginalFrequencies != spectrum.magnitudes->size()){
         std::cout << "Error: number of frequencies don't match in SpectrogramMatcher::match() " << 
             m_numOriginalFrequencies << " " << spectrum.magnitudes->size() << std::endl;
         return false;
     }
-
-    switch(m_mode){
-    case Mode::SPIKE_CONV:
-    {
-        // Do the conv on new spectrum too.
-        AlignedVector<float> convedSpectrum(m_template.bufferSize());
-        conv(spectrum.magnitudes->data() + m_originalFreqStart,
-            m_originalFreqEnd - m_originalFreqStart, convedSpectrum.data());
-        
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(convedSpectrum));
-        break;
-    }
-    case Mode::AVERAGE_5:
-    {
-        AlignedVector<float> avgedSpectrum(m_template.bufferSize());
-        for(size_t j = 0; j < m_template.numFrequencies(); j++){
-            const float * rawFreqMag = spectrum.magnitudes->data() + m_originalFreqStart + j*5;
-            const float newMag = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
-            avgedSpectrum[j] = newMag;
-        }
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(avgedSpectrum));
-        break;
-    }
-    case Mode::RAW:
-        break;
+    if (m_numSpectrumsNeeded == 0){
+        return true;
     }
 
-    // Compute the norm square (= sum squares) of the spectrum, used for matching:
-    // TODO: if there will be multiple SpectrogramMatcher running on the same audio stream, can
-    // move this per-spectrum computation to a shared struct for those matchers to save computation.
-    float spectrumNormSqr = 0.0f;
-    for (size_t i = m_freqStart; i < m_freqEnd; i++){
-        float mag = (*spectrum.magnitudes)[i];
-        spectrumNormSqr += mag * mag;
+    // The filtering and the norm square of the spectrum are done by the
+    // channel so that they can be shared with other matchers.
+    FilteredSpectrum filtered = m_channel->get(spectrum);
+    if (filtered.magnitudes == nullptr){
+        std::cout << "Error: SpectrogramMatcher (" + m_name + ") spectrum does not fit the filter." << std::endl;
+        return false;
     }
-    m_spectrumNormSqrs.push_front(spectrumNormSqr);
 
-    m_spectrums.emplace_front(std::move(spectrum));
+    m_newestSpectrum = (m_newestSpectrum + 1) % m_spectrums.size();
+    m_spectrums[m_newestSpectrum] = std::move(filtered);
+    m_numSpectrumsStored = std::min(m_numSpectrumsStored + 1, m_spectrums.size());
+
+    if (m_engine == Engine::INCREMENTAL){
+        correlate_newest_spectrum();
+    }
 
     return true;
 }
 
+void SpectrogramMatcher::correlate_newest_spectrum(){
+    const FilteredSpectrum& newest = stored(0);
+    const size_t windows = m_numSpectrumsNeeded;
+    const size_t freqs = m_freqEnd - m_freqStart;
+
+    // A gap in the timestamps invalidates all the partial results.
+    if (m_lastStampCorrelated == ~(uint64_t)0 || newest.stamp != m_lastStampCorrelated + 1){
+        for (std::vector<double>& correlations : m_correlations){
+            std::fill(correlations.begin(), correlations.end(), 0.0);
+        }
+    }
+    m_lastStampCorrelated = newest.stamp;
+
+    const float* data = m_freqStart + newest.magnitudes->data();
+    for (size_t sub_index = 0; sub_index < m_correlations.size(); sub_index++){
+        std::vector<double>& correlations = m_correlations[sub_index];
+        // The new spectrum is the oldest one of the alignment ending at "stamp + windows - 1".
+        // Its slot still holds the alignment ending at "stamp - 1" which is finished.
+        correlations[(newest.stamp + windows - 1) % windows] = 0;
+        for (size_t i = 0; i < windows; i++){
+            // The new spectrum is the i-th newest one of the alignment ending at "stamp + i".
+            correlations[(newest.stamp + i) % windows] += dot_product(
+                data, sub_template_window(sub_index, i), freqs
+            );
+        }
+    }
+}
+
 bool SpectrogramMatcher::update_to_new_spectrums(const std::vector<AudioSpectrum>& new_spectrums){
     for (auto it = new_spectrums.rbegin(); it != new_spectrums.rend(); it++){
         if(!update_to_new_spectrum(*it)){
             return false;
         }
     }
+    return true;
+}
 
-    // pop out too old spectrums
-    while (m_spectrums.size() > m_numSpectrumsNeeded){
-        m_spectrums.pop_back();
-        m_spectrumNormSqrs.pop_back();
-    }
+const float* SpectrogramMatcher::sub_template_window(size_t sub_index, size_t i) const{
+    const size_t windows = m_templateRange[sub_index].second - m_templateRange[sub_index].first;
+    return m_freqStart + m_template.getWindow(windows - 1 - i);
+}
 
-    return true;
+std::pair<float, float> SpectrogramMatcher::sub_template_score(float scale, float error) const{
+    float score = sqrt(error) / m_templateNorm[0];
+//    cout << "score = " << score << endl;
+    score = std::min<float>(score, 1.0);
+
+    return std::make_pair(score, scale);
 }
 
 std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index) const {
 #if 0
-    auto iter = m_spectrums.begin();
-    auto iter2 = m_spectrumNormSqrs.begin();
+    size_t iter = 0;
     float streamSumSqr = 0.0f;
     float sumMulti = 0.0f;
 
     const size_t template_start = m_templateRange[sub_index].first;
     const size_t template_end = m_templateRange[sub_index].second;
-    for(size_t i = template_start; i < template_end; i++, iter++, iter2++){
+    for(size_t i = template_start; i < template_end; i++, iter++){
         // match in order from latest window to oldest
         const float* templateData = m_template.getWindow(template_end-1-i);
-        const float* streamData = iter->magnitudes->data();
-        streamSumSqr += *iter2;
+        const float* streamData = stored(iter).magnitudes->data();
+        streamSumSqr += stored(iter).norm_sqr;
         for(size_t j = m_freqStart; j < m_freqEnd; j++){
             sumMulti += templateData[j] * streamData[j];
         }
@@ -279,12 +266,12 @@ std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index)
 //    cout << "sumMulti = " << sumMulti << ", streamSumSqr = " << streamSumSqr << endl;
     const float scale = (streamSumSqr < 1e-6f ? 1.0f : sumMulti / streamSumSqr);
 
-    iter = m_spectrums.begin();
+    iter = 0;
     float sum = 0.0f;
     for(size_t i = template_start; i < template_end; i++, iter++){
         // match in order from latest window to oldest
         const float* templateData = m_template.getWindow(template_end-1-i);
-        const float* streamData = iter->magnitudes->data();
+        const float* streamData = stored(iter).magnitudes->data();
         for(size_t j = m_freqStart; j < m_freqEnd; j++){
             float d = templateData[j] - scale * streamData[j];
             sum += d * d;
@@ -292,7 +279,6 @@ std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index)
     }
 #else
     //  Build matrix.
-    auto iter = m_spectrums.begin();
     const size_t template_start = m_templateRange[sub_index].first;
     const size_t template_end = m_templateRange[sub_index].second;
     size_t windows = template_end - template_start;
@@ -301,11 +287,11 @@ std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index)
     size_t freqs = m_freqEnd - m_freqStart;
     std::vector<const float*> matrixA(windows);
     std::vector<const float*> matrixT(windows);
-    for (size_t i = 0; i < windows; i++, iter++){
+    for (size_t i = 0; i < windows; i++){
 //        cout << "Template: " << ((size_t)m_template.getWindow(template_end - 1 - i) % 64) << endl;
 //        cout << "Samples:  " << ((size_t)iter->magnitudes->data() % 64) << endl;
-        matrixT[i] = m_freqStart + m_template.getWindow(windows - 1 - i);
-        matrixA[i] = m_freqStart + iter->magnitudes->data();
+        matrixT[i] = sub_template_window(sub_index, i);
+        matrixA[i] = m_freqStart + stored(i).magnitudes->data();
 //        cout << matrixT[i] << " : " << matrixA[i] << endl;
     }
 
@@ -324,32 +310,57 @@ std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index)
     );
 #endif
 
+    return sub_template_score(scale, sum);
+}
 
-    float score = sqrt(sum) / m_templateNorm[0];
-//    cout << "score = " << score << endl;
-    score = std::min<float>(score, 1.0);
+std::pair<float, float> SpectrogramMatcher::match_sub_template_incremental(size_t sub_index) const{
+    const size_t windows = m_numSpectrumsNeeded;
 
-    return std::make_pair(score, scale);
+    const double sumAT = m_correlations[sub_index][stored(0).stamp % windows];
+    double sumAA = 0;
+    for (size_t i = 0; i < windows; i++){
+        sumAA += stored(i).norm_sqr;
+    }
+
+    //  Same scale as Kernels::ScaleInvariantMatrixMatch::compute_scale().
+    float scale = (float)(sumAT / sumAA);
+    scale = std::min<float>(scale, 1000000);
+
+    //  sum((scale * A - T)^2) expanded.
+    double error = scale * (scale * sumAA - 2 * sumAT) + m_templateSumSqr[sub_index];
+    error = std::max(error, 0.0);
+
+    return sub_template_score(scale, (float)error);
 }
 
 float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums){
     if (!update_to_new_spectrums(new_spectrums)){
         return FLT_MAX;
     }
+    return match_stored();
+}
 
-    if (m_spectrums.size() < m_numSpectrumsNeeded){
+float SpectrogramMatcher::match(const AudioSpectrum& new_spectrum){
+    if (!update_to_new_spectrum(new_spectrum)){
+        return FLT_MAX;
+    }
+    return match_stored();
+}
+
+float SpectrogramMatcher::match_stored(){
+    if (m_numSpectrumsNeeded == 0 || m_numSpectrumsStored < m_numSpectrumsNeeded){
         return FLT_MAX;
     }
 
     // Check whether the stored spectrums' timestamps are continuous:
-    size_t curStamp = m_spectrums.front().stamp;
+    size_t curStamp = stored(0).stamp;
     size_t lastStamp = curStamp + 1;
-    for (const auto& s : m_spectrums){
-        if (s.stamp != lastStamp - 1){
+    for (size_t i = 0; i < m_numSpectrumsStored; i++){
+        if (stored(i).stamp != lastStamp - 1){
             std::cout << "Error: SpectrogramMatcher (" + m_name + ") spectrum timestamps are not continuous:" << std::endl;
 
-            for(const auto& sp : m_spectrums){
-                std::cout << sp.stamp << ", ";
+            for (size_t j = 0; j < m_numSpectrumsStored; j++){
+                std::cout << stored(j).stamp << ", ";
             }
             std::cout << std::endl;
             return FLT_MAX;
@@ -362,17 +373,23 @@ float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums)
     }
     m_lastStampTested = curStamp;
     
+    auto match_sub = [this](size_t sub_index){
+        return m_engine == Engine::INCREMENTAL
+            ? match_sub_template_incremental(sub_index)
+            : match_sub_template(sub_index);
+    };
+
     // Do the match:
     float score = FLT_MAX; // the lower the score, the better the match
     if (m_templateRange.size() == 1){
         // Match the full template
-        std::tie(score, m_lastScale) = match_sub_template(0);
+        std::tie(score, m_lastScale) = match_sub(0);
     }else{
         // Match each indivdual sub-template
         for (size_t sub_template = 0; sub_template < m_templateRange.size(); sub_template++){
             float sub_template_score = FLT_MAX;
             float sub_template_scale = 1.0f;
-            std::tie(sub_template_score, sub_template_scale) = match_sub_template(sub_template);
+            std::tie(sub_template_score, sub_template_scale) = match_sub(sub_template);
             if (sub_template_score < score){
                 score = sub_template_score;
                 m_lastScale = sub_template_scale;
@@ -389,13 +406,26 @@ bool SpectrogramMatcher::skip(const std::vector<AudioSpectrum>& new_spectrums){
     // Since the computation is relatively small and we won't be skipping lots of frames anyway,
     // this should be fine for now.
     // We can improve this later.
+    // With Engine::INCREMENTAL, the spectrums also need to be correlated here since the
+    // following matches depend on them.
     return update_to_new_spectrums(new_spectrums);
 }
 
+bool SpectrogramMatcher::skip(const AudioSpectrum& new_spectrum){
+    return update_to_new_spectrum(new_spectrum);
+}
+
 void SpectrogramMatcher::clear(){
-    m_spectrums.clear();
-    m_spectrumNormSqrs.clear();
+    for (FilteredSpectrum& spectrum : m_spectrums){
+        spectrum = FilteredSpectrum();
+    }
+    m_newestSpectrum = 0;
+    m_numSpectrumsStored = 0;
     m_lastStampTested = SIZE_MAX;
+    for (std::vector<double>& correlations : m_correlations){
+        std::fill(correlations.begin(), correlations.end(), 0.0);
+    }
+    m_lastStampCorrelated = ~(uint64_t)0;
 }
 
 
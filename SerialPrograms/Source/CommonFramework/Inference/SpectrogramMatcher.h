@@ -11,9 +11,9 @@
 #include <array>
 #include <memory>
 #include <vector>
-#include <list>
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
+#include "SpectrogramFrontEnd.h"
 
 namespace PokemonAutomation{
 
@@ -23,15 +23,20 @@ class AudioSpectrum;
 // spectrogram of the incoming audio stream.
 class SpectrogramMatcher{
 public:
-    enum class Mode{
-        // Don't do any processing on each window of spectrum, matching raw spectrums.
-        RAW,
-        // Do convolution on each window of spectrum with a peak detection kernel, before matching spectrums.
-        SPIKE_CONV,
-        // Do convolution on each window of spectrum with a Gaussian smooth kernel, before matching spectrums.
-        // GAUSSIAN_CONV,
-        // Average every 5 frequencies to reduce computation.
-        AVERAGE_5,
+    using Mode = SpectrogramMode;
+
+    // How the correlation between the stored spectrums and the template is computed.
+    // Both engines return the same scores up to float rounding.
+    enum class Engine{
+        // Correlate all the stored spectrums against the template on every match.
+        // Cost per match is proportional to template length x bandwidth.
+        DIRECT,
+        // Correlate each new spectrum once against every template window when it
+        // arrives and accumulate the results into a circular buffer of partial
+        // scores, one for each alignment that the spectrum is part of.
+        // Skipped spectrums still need to be correlated, but a match only reads
+        // one entry of the buffer. Better for long templates.
+        INCREMENTAL,
     };
 
     // audioTemplate: the audio template for the audio stream to match against.
@@ -49,18 +54,31 @@ public:
 
     size_t sample_rate() const{ return m_sample_rate; }
 
+    Engine engine() const{ return m_engine; }
+    // Switch to another matching engine. Clears the stored spectrums.
+    void set_engine(Engine engine);
+
+    // Read the filtered spectrums from `front_end` instead of filtering them
+    // privately. This lets all the matchers on the same audio stream share
+    // the filtering. Clears the stored spectrums.
+    void use_front_end(SpectrogramFrontEnd& front_end);
+
     // Match the newest spectrums and return a match score.
     // Newer (larger timestamp) spectrums at beginning of `new_spectrums` while older (smaller
     // timestamp) spectrums at the end.
     // In invalid cases (internal error or not enough windows), return FLT_MAX
     float match(const std::vector<AudioSpectrum>& new_spectrums);
 
+    // Same as above, but with only one new spectrum.
+    float match(const AudioSpectrum& new_spectrum);
+
     // Pass some spectrums in but don't run match on them.
     // Used for skipping some spectrums to avoid unnecessary matching.
     // Newer (larger timestamp) spectrums at beginning of `new_spectrums` while older (smaller
     // timestamp) spectrums at the end.
     // Return true if there is no error.
     bool skip(const std::vector<AudioSpectrum>& new_spectrums);
+    bool skip(const AudioSpectrum& new_spectrum);
 
     // Clear internal data to be used on another audio stream.
     void clear();
@@ -78,22 +96,40 @@ public:
     float lastMatchedScale() const { return m_lastScale; }
 
 private:
-    void conv(const float* src, size_t num, float* dst);
-    
     // The function to build `m_templateNorm`
     std::vector<float> buildTemplateNorm() const;
 
+    // The template window to match with the i-th newest spectrum for a given sub-template.
+    const float* sub_template_window(size_t sub_index, size_t i) const;
+
+    // Convert the correlation results of a sub-template to its match score and scaling factor.
+    std::pair<float, float> sub_template_score(float scale, float error) const;
+
     // For a given sub-template, return its match score and scaling factor
     std::pair<float, float> match_sub_template(size_t sub_index) const;
 
+    // Same as `match_sub_template()`, but read the correlation from `m_correlations`.
+    std::pair<float, float> match_sub_template_incremental(size_t sub_index) const;
+
+    // Add the correlation of the newest stored spectrum to `m_correlations`.
+    void correlate_newest_spectrum();
+
     // Update internal data for the next new spectrum. Called by `update_to_new_spectrums()`.
     // Return true if there is no error.
-    bool update_to_new_spectrum(AudioSpectrum newSpectrum);
+    bool update_to_new_spectrum(const AudioSpectrum& newSpectrum);
 
     // Update internal data for the new specttrums.
     // Return true if there is no error.
     bool update_to_new_spectrums(const std::vector<AudioSpectrum>& new_spectrums);
 
+    // Run the match on the stored spectrums.
+    float match_stored();
+
+    // The i-th newest stored spectrum.
+    const FilteredSpectrum& stored(size_t i) const{
+        return m_spectrums[(m_newestSpectrum + m_spectrums.size() - i) % m_spectrums.size()];
+    }
+
 
 
 private:
@@ -116,17 +152,31 @@ private:
 
     Mode m_mode = Mode::RAW;
 
-    std::vector<float> m_convKernel;
+    // Where the filtered spectrums come from. Either private to this matcher
+    // or shared through a SpectrogramFrontEnd.
+    std::shared_ptr<SpectrogramChannel> m_channel;
 
-    // Spectrums from audio feed. They will be matched against the template.
-    std::list<AudioSpectrum> m_spectrums;
-    // Norm squares of each spectrum in `m_spectrums`.
-    std::list<float> m_spectrumNormSqrs;
+    // Filtered spectrums from audio feed. They will be matched against the template.
+    // Ring buffer of size `m_numSpectrumsNeeded`.
+    std::vector<FilteredSpectrum> m_spectrums;
+    size_t m_newestSpectrum = 0;
+    size_t m_numSpectrumsStored = 0;
     // How many spectrums needed to store.
     size_t m_numSpectrumsNeeded = 0;
 
     size_t m_lastStampTested = SIZE_MAX;
     float m_lastScale = 0.0f;
+
+    Engine m_engine = Engine::DIRECT;
+    // Used by Engine::INCREMENTAL:
+    // m_correlations[sub_index][stamp % m_numSpectrumsNeeded] is the (partial) dot product
+    // between the template and the stored spectrums for the alignment whose newest
+    // spectrum has timestamp `stamp`.
+    std::vector<std::vector<double>> m_correlations;
+    // Sum of squares of the template windows matched by each sub-template.
+    std::vector<double> m_templateSumSqr;
+    // Timestamp of the last spectrum added to `m_correlations`.
+    uint64_t m_lastStampCorrelated = ~(uint64_t)0;
 };
 
 
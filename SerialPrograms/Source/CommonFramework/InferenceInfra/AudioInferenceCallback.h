@@ -15,6 +15,7 @@ namespace PokemonAutomation{
 
 class AudioSpectrum;
 class AudioFeed;
+class SpectrogramFrontEnd;
 
 //  Base class for an audio inference object to be called perioridically by
 //  inference routines in InferenceRoutines.h.
@@ -33,6 +34,11 @@ public:
         AudioFeed& audio_feed
     ) = 0;
 
+    //  Called when this callback is attached to an AudioInferencePivot.
+    //  Callbacks that filter spectrums should get them from "front_end" so
+    //  that the filtering is shared with the other callbacks on the same feed.
+    virtual void set_spectrogram_front_end(std::shared_ptr<SpectrogramFrontEnd> front_end){}
+
 };
 
 
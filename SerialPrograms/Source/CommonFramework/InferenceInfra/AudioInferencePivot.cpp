@@ -6,6 +6,7 @@
 
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "CommonFramework/Inference/SpectrogramFrontEnd.h"
 #include "AudioInferencePivot.h"
 
 //#include <iostream>
@@ -22,7 +23,7 @@ struct AudioInferencePivot::PeriodicCallback{
     AudioInferenceCallback& callback;
     std::chrono::milliseconds period;
 
-    uint64_t last_seqnum = ~(uint64_t)0;
+    AudioSpectrumCursor cursor;
 
     StatAccumulatorI32 stats;
 
@@ -43,6 +44,7 @@ struct AudioInferencePivot::PeriodicCallback{
 AudioInferencePivot::AudioInferencePivot(CancellableScope& scope, AudioFeed& feed, AsyncDispatcher& dispatcher)
     : PeriodicRunner(dispatcher)
     , m_feed(feed)
+    , m_front_end(std::make_shared<SpectrogramFrontEnd>())
 {
     attach(scope);
 }
@@ -56,6 +58,8 @@ void AudioInferencePivot::add_callback(
     AudioInferenceCallback& callback,
     std::chrono::milliseconds period
 ){
+    callback.set_spectrogram_front_end(m_front_end);
+
     SpinLockGuard lg(m_lock);
     auto iter = m_map.find(&callback);
     if (iter != m_map.end()){
@@ -87,25 +91,17 @@ StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback&
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
-        std::vector<AudioSpectrum> spectrums;
-
-        if (callback.last_seqnum == ~(uint64_t)0){
-//            cout << "m_last_timestamp == SIZE_MAX" << endl;
-            spectrums = m_feed.spectrums_latest(1);
-        }else{
-//            cout << "(m_last_timestamp != SIZE_MAX" << endl;
-            //  Note: in this file we never consider the case that stamp may overflow.
-            //  It requires on the order of 1e10 years to overflow if we have about 25ms per stamp.
-            spectrums = m_feed.spectrums_since(callback.last_seqnum + 1);
-        }
-        if (spectrums.size() > 0){
-            //  spectrums[0] has the newest spectrum with the largest stamp:
-            callback.last_seqnum = spectrums[0].stamp;
-        }
+        //  Note: in this file we never consider the case that stamp may overflow.
+        //  It requires on the order of 1e10 years to overflow if we have about 25ms per stamp.
+        m_feed.read_spectrums(callback.cursor);
 
         WallClock time0 = current_time();
-        bool stop = callback.callback.process_spectrums(spectrums, m_feed);
+        bool stop = callback.callback.process_spectrums(callback.cursor.spectrums, m_feed);
         WallClock time1 = current_time();
+
+        //  Keep the buffer, but let go of the spectrums so the FFT can reuse them.
+        callback.cursor.spectrums.clear();
+
         callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
         if (stop){
             if (callback.set_when_triggered){
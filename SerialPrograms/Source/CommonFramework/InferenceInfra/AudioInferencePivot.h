@@ -16,6 +16,7 @@
 namespace PokemonAutomation{
 
 class AudioFeed;
+class SpectrogramFrontEnd;
 
 
 
@@ -46,6 +47,10 @@ private:
     struct PeriodicCallback;
 
     AudioFeed& m_feed;
+
+    //  Spectrum filtering shared by all the callbacks on this feed.
+    std::shared_ptr<SpectrogramFrontEnd> m_front_end;
+
     SpinLock m_lock;
     std::map<AudioInferenceCallback*, PeriodicCallback> m_map;
 
@@ -5,6 +5,7 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "VisualInferencePivot.h"
 
@@ -42,6 +43,7 @@ struct VisualInferencePivot::PeriodicCallback{
 
 VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, AsyncDispatcher& dispatcher)
     : PeriodicRunner(dispatcher)
+    , m_dispatcher(dispatcher)
     , m_feed(feed)
 {
     attach(scope);
@@ -84,6 +86,25 @@ StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback
     m_map.erase(iter);
     return stats;
 }
+bool VisualInferencePivot::process_frame(PeriodicCallback& callback, const VideoSnapshot& frame) noexcept{
+    try{
+        WallClock time0 = current_time();
+        bool stop = callback.callback.process_frame(frame);
+        WallClock time1 = current_time();
+        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+        return stop;
+    }catch (...){
+        callback.scope.cancel(std::current_exception());
+        return false;
+    }
+}
+void VisualInferencePivot::report_trigger(PeriodicCallback& callback) noexcept{
+    if (callback.set_when_triggered){
+        InferenceCallback* expected = nullptr;
+        callback.set_when_triggered->compare_exchange_strong(expected, &callback.callback);
+    }
+    callback.scope.cancel(nullptr);
+}
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
@@ -93,21 +114,68 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
             m_last = m_feed.snapshot();
             m_seqnum++;
         }
+    }catch (...){
+        callback.scope.cancel(std::current_exception());
+        return;
+    }
 
-        WallClock time0 = current_time();
-        bool stop = callback.callback.process_frame(m_last);
-        WallClock time1 = current_time();
-        callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
-        callback.last_seqnum = m_seqnum;
-        if (stop){
-            if (callback.set_when_triggered){
-                InferenceCallback* expected = nullptr;
-                callback.set_when_triggered->compare_exchange_strong(expected, &callback.callback);
-            }
-            callback.scope.cancel(nullptr);
+    bool stop = process_frame(callback, m_last);
+    callback.last_seqnum = m_seqnum;
+    if (stop){
+        report_trigger(callback);
+    }
+}
+void VisualInferencePivot::run_batch(const std::vector<void*>& events, bool is_back_to_back) noexcept{
+    if (events.size() <= 1 || !GlobalSettings::instance().PARALLEL_VIDEO_INFERENCE){
+        PeriodicRunner::run_batch(events, is_back_to_back);
+        return;
+    }
+
+    //  Grab a new frame if anything in the batch has already seen the cached one.
+    //  Then everything in the batch runs on the same frame.
+    bool refresh = !is_back_to_back;
+    for (void* event : events){
+        refresh |= ((PeriodicCallback*)event)->last_seqnum == m_seqnum;
+    }
+    try{
+        if (refresh){
+            m_last = m_feed.snapshot();
+            m_seqnum++;
         }
     }catch (...){
-        callback.scope.cancel(std::current_exception());
+        std::exception_ptr exception = std::current_exception();
+        for (void* event : events){
+            ((PeriodicCallback*)event)->scope.cancel(exception);
+        }
+        return;
+    }
+
+    //  "std::vector<bool>" is not safe to write to from multiple threads.
+    std::vector<char> stop(events.size(), false);
+    try{
+        m_dispatcher.run_in_parallel(
+            0, events.size(),
+            [&](size_t index){
+                stop[index] = process_frame(*(PeriodicCallback*)events[index], m_last);
+            }
+        );
+    }catch (...){
+        //  Failed to dispatch. (process_frame() itself never throws)
+        std::exception_ptr exception = std::current_exception();
+        for (void* event : events){
+            ((PeriodicCallback*)event)->scope.cancel(exception);
+        }
+        return;
+    }
+
+    //  Report triggers in schedule order so that the first-trigger-wins
+    //  result is the same as running the callbacks one at a time.
+    for (size_t c = 0; c < events.size(); c++){
+        PeriodicCallback& callback = *(PeriodicCallback*)events[c];
+        callback.last_seqnum = m_seqnum;
+        if (stop[c]){
+            report_trigger(callback);
+        }
     }
 }
 
@@ -40,12 +40,20 @@ public:
     StatAccumulatorI32 remove_callback(VisualInferenceCallback& callback);
 
 private:
+    struct PeriodicCallback;
+
     virtual void run(void* event, bool is_back_to_back) noexcept override;
+    virtual void run_batch(const std::vector<void*>& events, bool is_back_to_back) noexcept override;
     virtual OverlayStatSnapshot get_current() override;
 
-private:
-    struct PeriodicCallback;
+    //  Run the callback on "frame" and record its latency.
+    //  Returns true if the callback wants to stop.
+    //  Exceptions are forwarded to the callback's scope.
+    static bool process_frame(PeriodicCallback& callback, const VideoSnapshot& frame) noexcept;
+    static void report_trigger(PeriodicCallback& callback) noexcept;
 
+private:
+    AsyncDispatcher& m_dispatcher;
     VideoFeed& m_feed;
     SpinLock m_lock;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
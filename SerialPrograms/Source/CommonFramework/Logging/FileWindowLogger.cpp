@@ -7,6 +7,7 @@
 #include <QCoreApplication>
 #include <QMenuBar>
 #include <QDir>
+#include "Common/Cpp/Time.h"
 #include "CommonFramework/Windows/DpiScaler.h"
 #include "CommonFramework/Windows/WindowTracker.h"
 #include "FileWindowLogger.h"
@@ -18,6 +19,20 @@
 namespace PokemonAutomation{
 
 
+namespace{
+
+//  Most messages to write out at once.
+const size_t MAX_BATCH_SIZE = 1024;
+
+//  Flush the file once this much is buffered.
+const size_t FLUSH_SIZE = 64 * 1024;
+
+//  Flush at least this often when the queue never runs dry.
+const std::chrono::milliseconds FLUSH_INTERVAL(100);
+
+}
+
+
 Logger& global_logger_raw(){
     static FileWindowLogger logger((QCoreApplication::applicationName() + ".log").toStdString());
     return logger;
@@ -32,11 +47,19 @@ FileWindowLogger::~FileWindowLogger(){
     }
     m_thread.join();
 }
-FileWindowLogger::FileWindowLogger(const std::string& path)
+FileWindowLogger::FileWindowLogger(
+    const std::string& path,
+    size_t max_queue_size,
+    OverflowPolicy overflow_policy
+)
     : m_file(QString::fromStdString(path))
-    , m_max_queue_size(10000)
+    , m_overflow_policy(overflow_policy)
+    , m_queue(max_queue_size)
+    , m_dropped(0)
+    , m_total_dropped(0)
+    , m_writer_sleeping(false)
+    , m_blocked_producers(0)
     , m_stopping(false)
-    , m_thread(&FileWindowLogger::thread_loop, this)
 {
     bool exists = m_file.exists();
     m_file.open(QIODevice::WriteOnly | QIODevice::Append);
@@ -44,6 +67,7 @@ FileWindowLogger::FileWindowLogger(const std::string& path)
         std::string bom = "\xef\xbb\xbf";
         m_file.write(bom.c_str(), bom.size());
     }
+    m_thread = std::thread(&FileWindowLogger::thread_loop, this);
 }
 void FileWindowLogger::operator+=(FileWindowLoggerWindow& widget){
     std::lock_guard<std::mutex> lg(m_lock);
@@ -55,16 +79,34 @@ void FileWindowLogger::operator-=(FileWindowLoggerWindow& widget){
 }
 
 void FileWindowLogger::log(const std::string& msg, Color color){
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(msg, color);
-    m_cv.notify_all();
+    push(Entry{msg, color});
 }
 void FileWindowLogger::log(std::string&& msg, Color color){
-    std::unique_lock<std::mutex> lg(m_lock);
-    m_cv.wait(lg, [this]{ return m_queue.size() < m_max_queue_size; });
-    m_queue.emplace_back(std::move(msg), color);
-    m_cv.notify_all();
+    push(Entry{std::move(msg), color});
+}
+void FileWindowLogger::push(Entry&& entry){
+    while (!m_queue.try_push(std::move(entry))){
+        if (m_overflow_policy.load(std::memory_order_relaxed) == OverflowPolicy::DROP){
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            m_total_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        //  The timeout covers a wake-up that happens before we start waiting.
+        std::unique_lock<std::mutex> lg(m_lock);
+        m_blocked_producers.fetch_add(1, std::memory_order_relaxed);
+        m_cv.notify_all();
+        m_space_cv.wait_for(lg, std::chrono::milliseconds(10));
+        m_blocked_producers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    //  Pairs with the fence in "thread_loop()". Either we see that the writer
+    //  is going to sleep or the writer sees the new message.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writer_sleeping.load(std::memory_order_relaxed)){
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_cv.notify_all();
+    }
 }
 
 
@@ -135,42 +177,81 @@ QString FileWindowLogger::to_window_str(const std::string& msg, Color color){
 
     return QString::fromStdString(str);
 }
-void FileWindowLogger::internal_log(const std::string& msg, Color color){
-    std::string line = normalize_newlines(msg);
+void FileWindowLogger::flush_file(){
+    if (m_file_buffer.empty()){
+        return;
+    }
+    m_file.write(m_file_buffer.c_str(), m_file_buffer.size());
+    m_file.flush();
+    m_file_buffer.clear();
+}
+void FileWindowLogger::process_batch(std::vector<Entry>& batch){
+    bool has_windows;
     {
-        if (!m_windows.empty()){
-            QString str = to_window_str(line, color);
-            for (FileWindowLoggerWindow* window : m_windows){
-                window->log(str);
-            }
+        std::lock_guard<std::mutex> lg(m_lock);
+        has_windows = !m_windows.empty();
+    }
+
+    QStringList lines;
+    for (const Entry& entry : batch){
+        if (has_windows){
+            lines.append(to_window_str(normalize_newlines(entry.msg), entry.color));
         }
+        m_file_buffer += to_file_str(entry.msg);
     }
-    {
-        m_file.write(to_file_str(msg).c_str());
-        m_file.flush();
+
+    if (!lines.empty()){
+        std::lock_guard<std::mutex> lg(m_lock);
+        for (FileWindowLoggerWindow* window : m_windows){
+            window->log(lines);
+        }
     }
 }
 void FileWindowLogger::thread_loop(){
-    std::unique_lock<std::mutex> lg(m_lock);
+    std::vector<Entry> batch;
+    WallClock last_flush = current_time();
     while (true){
-        m_cv.wait(lg, [&]{
-            return m_stopping || !m_queue.empty();
-        });
-        if (m_stopping){
-            break;
+        Entry entry;
+        while (batch.size() < MAX_BATCH_SIZE && m_queue.try_pop(entry)){
+            batch.emplace_back(std::move(entry));
         }
-        auto& item = m_queue.front();
-        std::string msg = std::move(item.first);
-        Color color = item.second;
-        m_queue.pop_front();
 
-        lg.unlock();
-        internal_log(msg, color);
-        lg.lock();
+        uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0){
+            batch.emplace_back(Entry{
+                "FileWindowLogger: Dropped " + std::to_string(dropped) + " message(s) because the queue was full.",
+                COLOR_RED
+            });
+        }
 
-        if (m_queue.size() <= m_max_queue_size / 2){
-            m_cv.notify_all();
+        if (!batch.empty()){
+            process_batch(batch);
+            batch.clear();
+            if (m_blocked_producers.load(std::memory_order_relaxed) != 0){
+                std::lock_guard<std::mutex> lg(m_lock);
+                m_space_cv.notify_all();
+            }
+            if (m_file_buffer.size() >= FLUSH_SIZE || current_time() - last_flush >= FLUSH_INTERVAL){
+                flush_file();
+                last_flush = current_time();
+            }
+            continue;
         }
+
+        //  The queue has run dry.
+        flush_file();
+        last_flush = current_time();
+
+        std::unique_lock<std::mutex> lg(m_lock);
+        if (m_stopping && m_queue.empty()){
+            break;
+        }
+        m_writer_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_queue.empty()){
+            m_cv.wait_for(lg, FLUSH_INTERVAL);
+        }
+        m_writer_sleeping.store(false, std::memory_order_relaxed);
     }
 }
 
@@ -204,9 +285,11 @@ FileWindowLoggerWindow::FileWindowLoggerWindow(FileWindowLogger& logger, QWidget
 
     connect(
         this, &FileWindowLoggerWindow::signal_log,
-        m_text, [this](QString msg){
-//            cout << "signal_log(): " << msg.toStdString() << endl;
-            m_text->append(msg);
+        m_text, [this](QStringList lines){
+//            cout << "signal_log(): " << lines.size() << endl;
+            for (const QString& line : lines){
+                m_text->append(line);
+            }
         }
     );
 
@@ -224,7 +307,10 @@ FileWindowLoggerWindow::~FileWindowLoggerWindow(){
 
 void FileWindowLoggerWindow::log(QString msg){
 //    cout << "FileWindowLoggerWindow::log(): " << msg.toStdString() << endl;
-    emit signal_log(msg);
+    emit signal_log(QStringList{std::move(msg)});
+}
+void FileWindowLoggerWindow::log(QStringList lines){
+    emit signal_log(std::move(lines));
 }
 
 
@@ -2,19 +2,26 @@
  *
  *  From: https://github.com/PokemonAutomation/Arduino-Source
  *
+ *  Callers only push the message into a lock-free queue. A writer thread
+ *  drains the queue in batches. Each batch is one file write and one update
+ *  to each log window. The file is flushed when the queue runs dry, when the
+ *  buffer gets large, or after a short interval under constant load.
+ *
  */
 
 #ifndef PokemonAutomation_Logging_FileWindowLogger_H
 #define PokemonAutomation_Logging_FileWindowLogger_H
 
-#include <deque>
 #include <set>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <QFile>
+#include <QStringList>
 #include <QTextEdit>
 #include <QMainWindow>
+#include "Common/Cpp/Concurrency/BoundedMpscQueue.h"
 #include "Logger.h"
 
 namespace PokemonAutomation{
@@ -23,31 +30,76 @@ class FileWindowLoggerWindow;
 
 
 class FileWindowLogger : public Logger{
+public:
+    //  What to do when a message is logged while the queue is full.
+    enum class OverflowPolicy{
+        //  Wait for the writer to make room.
+        BLOCK,
+        //  Drop the message. The number of dropped messages is logged once
+        //  the writer catches up.
+        DROP,
+    };
+
 public:
     ~FileWindowLogger();
-    FileWindowLogger(const std::string& path);
+    FileWindowLogger(
+        const std::string& path,
+        size_t max_queue_size = 10000,
+        OverflowPolicy overflow_policy = OverflowPolicy::BLOCK
+    );
 
     void operator+=(FileWindowLoggerWindow& widget);
     void operator-=(FileWindowLoggerWindow& widget);
 
+    void set_overflow_policy(OverflowPolicy policy){
+        m_overflow_policy.store(policy, std::memory_order_relaxed);
+    }
+
+    //  Total number of messages dropped because the queue was full.
+    uint64_t dropped_messages() const{
+        return m_total_dropped.load(std::memory_order_relaxed);
+    }
+
     virtual void log(const std::string& msg, Color color = Color()) override;
     virtual void log(std::string&& msg, Color color = Color()) override;
 
 private:
+    struct Entry{
+        std::string msg;
+        Color color;
+    };
+
     static std::string normalize_newlines(const std::string& msg);
     static std::string to_file_str(const std::string& msg);
     static QString to_window_str(const std::string& msg, Color color);
 
-    void internal_log(const std::string& msg, Color color);
+    void push(Entry&& entry);
+
+    //  Write out everything in "m_file_buffer".
+    void flush_file();
+    void process_batch(std::vector<Entry>& batch);
     void thread_loop();
 
 private:
     QFile m_file;
-    size_t m_max_queue_size;
+    std::atomic<OverflowPolicy> m_overflow_policy;
+
+    BoundedMpscQueue<Entry> m_queue;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_total_dropped;
+
     std::mutex m_lock;
+    //  Wakes up the writer.
     std::condition_variable m_cv;
+    //  Wakes up producers that are blocked on a full queue.
+    std::condition_variable m_space_cv;
+    std::atomic<bool> m_writer_sleeping;
+    std::atomic<size_t> m_blocked_producers;
     bool m_stopping;
-    std::deque<std::pair<std::string, Color>> m_queue;
+
+    //  Only touched by the writer thread.
+    std::string m_file_buffer;
+
     std::set<FileWindowLoggerWindow*> m_windows;
     std::thread m_thread;
 };
@@ -61,9 +113,10 @@ public:
     virtual ~FileWindowLoggerWindow();
 
     void log(QString msg);
+    void log(QStringList lines);
 
 signals:
-    void signal_log(QString msg);
+    void signal_log(QStringList lines);
 
 private:
     FileWindowLogger& m_logger;
@@ -7,11 +7,16 @@
 #include <dpp/DPP_SilenceWarnings.h>
 #include <Integrations/DppIntegration/DppClient.h>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
 #include "Common/Cpp/ImageResolution.h"
 #include "PersistentSettings.h"
 #include "Tests/CommandLineTests.h"
+#include "SpriteBundles.h"
 #include "CrashDump.h"
 #include "Environment/HardwareValidation.h"
+#include "OCR/OCR_RawOCR.h"
+#include "Resources/ResourcePreloader.h"
+#include "Tools/ImageDumpQueue.h"
 #include "Logging/Logger.h"
 #include "Logging/OutputRedirector.h"
 //#include "Tools/StatsDatabase.h"
@@ -83,7 +88,12 @@ int main(int argc, char *argv[]){
     }
 
     if (GlobalSettings::instance().COMMAND_LINE_TEST_MODE){
-        return run_command_line_tests();
+        int ret = run_command_line_tests();
+        ImageDumpQueue::instance().stop();
+        return ret;
+    }
+    if (GlobalSettings::instance().BUILD_SPRITE_BUNDLES){
+        return build_sprite_bundles();
     }
 
     //  Check whether the hardware is powerful enough to run this program.
@@ -109,7 +119,21 @@ int main(int argc, char *argv[]){
     }
 
     set_working_directory();
-    
+
+    //  Preload the OCR instances in the background so that the first
+    //  multi-filter OCR reads don't have to wait for Tesseract to load.
+    //  The games register their own resources when their panel lists are built.
+    ResourcePreloader& preloader = ResourcePreloader::instance();
+    preloader.add(
+        "OCR: English", std::chrono::milliseconds(1000), {},
+        [](){
+            if (OCR::language_available(Language::English)){
+                OCR::ensure_instances(Language::English, GlobalSettings::instance().PARALLEL_OCR_THREADS);
+            }
+        }
+    );
+    preloader.preload({"OCR: English"});
+
     int ret = 0;
     {
         MainWindow w;
@@ -119,6 +143,12 @@ int main(int argc, char *argv[]){
         ret = application.exec();
     }
 
+    preloader.stop();
+
+    //  Finish writing the error images (and sending their reports) while
+    //  everything they use is still alive.
+    ImageDumpQueue::instance().stop();
+
     // Write program settings back to the json file.
     PERSISTENT_SETTINGS().write();
 
@@ -13,6 +13,8 @@
 #include "Common/Cpp/Json/JsonObject.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Tools/ImageDumpQueue.h"
 #include "CommonFramework/Tools/ProgramEnvironment.h"
 #include "CommonFramework/Tools/StatsTracking.h"
 #include "Integrations/DiscordWebhook.h"
@@ -405,41 +407,14 @@ void send_program_fatal_error_notification(
 
 
 
-void send_program_telemetry(
+#ifdef PA_OFFICIAL
+void send_program_telemetry_report(
     Logger& logger, bool is_error, Color color,
     const ProgramInfo& info,
     const std::string& title,
     const std::vector<std::pair<std::string, std::string>>& messages,
     const std::string& file
 ){
-#ifdef PA_OFFICIAL
-    if (!GlobalSettings::instance().SEND_ERROR_REPORTS){
-        return;
-    }
-
-    //  Rate limit the telemetry to 10/hour.
-    static std::mutex lock;
-    static std::set<WallClock> sends;
-    {
-        std::lock_guard<std::mutex> lg(lock);
-
-        WallClock now = current_time();
-        WallClock threshold = now - std::chrono::minutes(1);
-        while (!sends.empty()){
-            auto iter = sends.begin();
-            if (*iter > threshold){
-                break;
-            }
-            sends.erase(iter);
-        }
-        if (sends.size() >= 10){
-            logger.log("Error report suppressed due to rate limit.", COLOR_RED);
-            return;
-        }
-        sends.insert(now);
-    }
-
-
     bool hasFile = !file.empty();
     std::shared_ptr<PendingFileSend> pending = !hasFile
             ? nullptr
@@ -496,6 +471,60 @@ void send_program_telemetry(
     }else{
         sender.send_json(logger, QString::fromStdString(url), std::chrono::milliseconds(0), jsonContent, nullptr);
     }
+}
+#endif
+
+void send_program_telemetry(
+    Logger& logger, bool is_error, Color color,
+    const ProgramInfo& info,
+    const std::string& title,
+    const std::vector<std::pair<std::string, std::string>>& messages,
+    const std::string& file
+){
+#ifdef PA_OFFICIAL
+    if (!GlobalSettings::instance().SEND_ERROR_REPORTS){
+        return;
+    }
+
+    //  Rate limit the telemetry to 10/hour.
+    static std::mutex lock;
+    static std::set<WallClock> sends;
+    {
+        std::lock_guard<std::mutex> lg(lock);
+
+        WallClock now = current_time();
+        WallClock threshold = now - std::chrono::minutes(1);
+        while (!sends.empty()){
+            auto iter = sends.begin();
+            if (*iter > threshold){
+                break;
+            }
+            sends.erase(iter);
+        }
+        if (sends.size() >= 10){
+            logger.log("Error report suppressed due to rate limit.", COLOR_RED);
+            return;
+        }
+        sends.insert(now);
+    }
+
+    if (file.empty()){
+        send_program_telemetry_report(logger, is_error, color, info, title, messages, file);
+        return;
+    }
+
+    //  Error images are written in the background. Send the report from the
+    //  thread that writes the image instead of making the caller wait for it.
+    //  The caller's logger may be gone by then.
+    ImageDumpQueue::instance().then(
+        file,
+        [=]{
+            send_program_telemetry_report(
+                global_logger_tagged(), is_error, color,
+                info, title, messages, file
+            );
+        }
+    );
 #endif
 }
 
@@ -9,7 +9,6 @@
 #include "Common/Cpp/Json/JsonObject.h"
 #include "Common/Qt/StringToolsQt.h"
 #include "OCR_StringNormalization.h"
-#include "OCR_TextMatcher.h"
 #include "OCR_DictionaryOCR.h"
 
 #include <iostream>
@@ -28,6 +27,7 @@ DictionaryOCR::DictionaryOCR(
     bool first_only
 )
     : m_random_match_chance(random_match_chance)
+    , m_index(m_candidate_to_token, random_match_chance)
 {
     for (const auto& item0 : json){
         const std::string& token = item0.first;
@@ -50,6 +50,7 @@ DictionaryOCR::DictionaryOCR(
             }
         }
     }
+    m_index.rebuild();
     global_logger_tagged().log(
         "DictionaryOCR - Tokens: " + std::to_string(m_database.size()) +
         ", Match Candidates: " + std::to_string(m_candidate_to_token.size())
@@ -91,10 +92,7 @@ StringMatchResult DictionaryOCR::match_substring(
     const std::string& text,
     double log10p_spread
 ) const{
-    return OCR::match_substring(
-        m_candidate_to_token, m_random_match_chance,
-        text, log10p_spread
-    );
+    return m_index.match_substring(text, log10p_spread);
 }
 void DictionaryOCR::add_candidate(std::string token, const std::u32string& candidate){
     if (candidate.size() < 2){
@@ -108,6 +106,7 @@ void DictionaryOCR::add_candidate(std::string token, const std::u32string& candi
         //  New candidate. Add it to both maps.
         m_database[token].emplace_back(to_utf8(candidate));
         m_candidate_to_token[candidate].insert(std::move(token));
+        m_index.rebuild();
         return;
     }
 
@@ -4,6 +4,9 @@
  *
  */
 
+#include <atomic>
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTools/ImageFilter.h"
 #include "OCR_RawOCR.h"
@@ -14,6 +17,17 @@ namespace PokemonAutomation{
 namespace OCR{
 
 
+AsyncDispatcher& ocr_dispatcher(){
+    static AsyncDispatcher dispatcher(
+        [](){
+            GlobalSettings::instance().INFERENCE_PRIORITY0.set_on_this_thread();
+        },
+        0
+    );
+    return dispatcher;
+}
+
+
 StringMatchResult multifiltered_OCR(
     Language language, const DictionaryMatcher& dictionary, const ImageViewRGB32& image,
     const std::vector<TextColorRange>& text_color_ranges,
@@ -32,22 +46,51 @@ StringMatchResult multifiltered_OCR(
 
     double pixels_inv = 1. / (image.width() * image.height());
 
-    //  Run all the filters.
-    StringMatchResult ret;
-//    int c = 0;
+    //  Compute ratio of image that matches text color. Skip if it's out of
+    //  range. Do this first so we don't OCR images we will throw away.
+    std::vector<const ImageRGB32*> to_read;
     for (const auto& filtered : filtered_images){
-        std::string text = ocr_read(language, filtered.first);
-//        cout << text.toStdString() << endl;
-//        filtered.first.save("test" + QString::number(c++) + ".png");
-
-        //  Compute ratio of image that matches text color. Skip if it's out of range.
         double ratio = filtered.second * pixels_inv;
 //        cout << "ratio = " << ratio << endl;
         if (ratio < min_text_ratio || ratio > max_text_ratio){
             continue;
         }
+        to_read.emplace_back(&filtered.first);
+    }
+
+    //  Run all the filters.
+    std::vector<StringMatchResult> results(to_read.size());
+    auto read = [&](size_t index){
+        std::string text = ocr_read(language, *to_read[index]);
+//        cout << text << endl;
+        results[index] = dictionary.match_substring(language, text, log10p_spread);
+    };
+
+    size_t threads = std::min<size_t>(GlobalSettings::instance().PARALLEL_OCR_THREADS, to_read.size());
+    if (threads <= 1){
+        for (size_t c = 0; c < to_read.size(); c++){
+            read(c);
+        }
+    }else{
+        //  Cap the parallelism. Each worker takes the next unread image.
+        std::atomic<size_t> next(0);
+        ocr_dispatcher().run_in_parallel(
+            0, threads,
+            [&](size_t){
+                while (true){
+                    size_t index = next.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= to_read.size()){
+                        return;
+                    }
+                    read(index);
+                }
+            }
+        );
+    }
 
-        StringMatchResult current = dictionary.match_substring(language, text, log10p_spread);
+    //  Merge in filter order.
+    StringMatchResult ret;
+    for (const StringMatchResult& current : results){
         ret.exact_match |= current.exact_match;
         ret.results.insert(current.results.begin(), current.results.end());
     }
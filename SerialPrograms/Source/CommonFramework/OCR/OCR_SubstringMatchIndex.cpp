@@ -0,0 +1,296 @@
+/*  Substring Match Index
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "OCR_StringNormalization.h"
+#include "OCR_TextMatcher.h"
+#include "OCR_SubstringMatchIndex.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+//  Largest length that "random_match_probability()" supports.
+const size_t MAX_TABLE_LENGTH = 62;
+
+
+struct SubstringMatchIndex::Query{
+    std::u32string text;
+
+    //  The text as indices into the database alphabet. Characters that are
+    //  not in any candidate map to "alphabet_size".
+    std::vector<uint32_t> text_ids;
+
+    //  How many times each character occurs in the text.
+    std::vector<uint32_t> counts;
+
+    //  Scratch space. Always all zero between uses.
+    std::vector<uint32_t> used;
+    std::vector<uint64_t> peq;
+
+    Query(const std::vector<char32_t>& alphabet, std::u32string normalized)
+        : text(std::move(normalized))
+        , counts(alphabet.size() + 1)
+        , used(alphabet.size() + 1)
+        , peq(alphabet.size() + 1)
+    {
+        text_ids.reserve(text.size());
+        for (char32_t ch : text){
+            auto iter = std::lower_bound(alphabet.begin(), alphabet.end(), ch);
+            uint32_t id = iter != alphabet.end() && *iter == ch
+                ? (uint32_t)(iter - alphabet.begin())
+                : (uint32_t)alphabet.size();
+            text_ids.emplace_back(id);
+            counts[id]++;
+        }
+    }
+
+    //  Lower bound of "levenshtein_distance_substring(candidate, text)".
+    //  Every character in the candidate beyond what the text has of it
+    //  must be substituted or deleted.
+    size_t distance_lower_bound(const uint32_t* ids, size_t length){
+        size_t excess = 0;
+        for (size_t c = 0; c < length; c++){
+            if (++used[ids[c]] > counts[ids[c]]){
+                excess++;
+            }
+        }
+        for (size_t c = 0; c < length; c++){
+            used[ids[c]] = 0;
+        }
+        return excess;
+    }
+};
+
+
+
+SubstringMatchIndex::SubstringMatchIndex(const Database& database, double random_match_chance)
+    : m_database(database)
+    , m_random_match_chance(random_match_chance)
+{
+    rebuild();
+}
+void SubstringMatchIndex::rebuild(){
+    m_alphabet.clear();
+    m_entries.clear();
+    m_char_ids.clear();
+    m_entries.reserve(m_database.size());
+
+    size_t max_length = 0;
+    for (const auto& item : m_database){
+        m_alphabet.insert(m_alphabet.end(), item.first.begin(), item.first.end());
+        max_length = std::max(max_length, item.first.size());
+    }
+    std::sort(m_alphabet.begin(), m_alphabet.end());
+    m_alphabet.erase(std::unique(m_alphabet.begin(), m_alphabet.end()), m_alphabet.end());
+
+    for (const auto& item : m_database){
+        m_entries.emplace_back(Entry{&item, m_char_ids.size(), item.first.size()});
+        for (char32_t ch : item.first){
+            auto iter = std::lower_bound(m_alphabet.begin(), m_alphabet.end(), ch);
+            m_char_ids.emplace_back((uint32_t)(iter - m_alphabet.begin()));
+        }
+    }
+    max_length = std::min(max_length, MAX_TABLE_LENGTH);
+
+    //  The bounds are a running minimum so that they hold even if the
+    //  probabilities are not perfectly monotonic due to rounding.
+    for (size_t length = m_log10p.size(); length <= max_length; length++){
+        std::vector<double> row(length + 1);
+        std::vector<double> bounds(length + 1);
+        double bound = std::numeric_limits<double>::infinity();
+        row[0] = bound;
+        bounds[0] = bound;
+        for (size_t matched = 1; matched <= length; matched++){
+            row[matched] = std::log10(random_match_probability(length, matched, m_random_match_chance));
+            bound = std::min(bound, row[matched]);
+            bounds[matched] = bound;
+        }
+        m_log10p.emplace_back(std::move(row));
+        m_log10p_bounds.emplace_back(std::move(bounds));
+    }
+}
+double SubstringMatchIndex::log10p(size_t length, size_t matched) const{
+    if (length >= m_log10p.size()){
+        return std::log10(random_match_probability(length, matched, m_random_match_chance));
+    }
+    return m_log10p[length][matched];
+}
+double SubstringMatchIndex::log10p_lower_bound(size_t length, size_t max_matched) const{
+    if (length >= m_log10p_bounds.size()){
+        return -std::numeric_limits<double>::infinity();
+    }
+    return m_log10p_bounds[length][max_matched];
+}
+
+
+size_t SubstringMatchIndex::substring_distance(Query& query, size_t index) const{
+    const Entry& entry = m_entries[index];
+    size_t length = entry.length;
+    if (length == 0){
+        return 0;
+    }
+    if (length > 64){
+        return levenshtein_distance_substring(entry.item->first, query.text);
+    }
+
+    //  Myers' bit-parallel edit distance. (substring variant)
+    const uint32_t* ids = m_char_ids.data() + entry.offset;
+    std::vector<uint64_t>& peq = query.peq;
+    for (size_t c = 0; c < length; c++){
+        peq[ids[c]] |= (uint64_t)1 << c;
+    }
+
+    const uint64_t HIGH_BIT = (uint64_t)1 << (length - 1);
+    uint64_t pv = length == 64 ? ~(uint64_t)0 : ((uint64_t)1 << length) - 1;
+    uint64_t mv = 0;
+    size_t score = length;
+    size_t min = length;
+    for (uint32_t id : query.text_ids){
+        uint64_t eq = peq[id];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & HIGH_BIT){
+            score++;
+        }else if (mh & HIGH_BIT){
+            score--;
+        }
+        //  Matching may start anywhere in the text, so nothing shifts in.
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        min = std::min(min, score);
+    }
+
+    for (size_t c = 0; c < length; c++){
+        peq[ids[c]] = 0;
+    }
+    return min;
+}
+
+
+
+StringMatchResult SubstringMatchIndex::match_substring(const std::string& text, double log10p_spread) const{
+    StringMatchResult results;
+
+    std::u32string normalized = normalize_utf32(text);
+
+    //  Search for exact match of candidate.
+    auto iter = m_database.find(normalized);
+    if (iter != m_database.end()){
+        results.exact_match = true;
+        double probability = random_match_probability(normalized.size(), normalized.size(), m_random_match_chance);
+        double log10p = std::log10(probability);
+        for (const auto& target : iter->second){
+            results.add(
+                log10p,
+                StringMatchData{text, normalized, normalized, target}
+            );
+        }
+        return results;
+    }
+
+    Query query(m_alphabet, std::move(normalized));
+
+    //  Bound every candidate and pick out the most promising ones.
+    const size_t SEEDS = 16;
+    std::vector<double> bounds(m_entries.size(), std::numeric_limits<double>::infinity());
+    std::vector<std::pair<double, size_t>> seeds;
+    std::vector<size_t> possible_exact;
+    for (size_t c = 0; c < m_entries.size(); c++){
+        const Entry& entry = m_entries[c];
+        size_t excess = query.distance_lower_bound(m_char_ids.data() + entry.offset, entry.length);
+        size_t max_matched = entry.length - excess;
+        if (max_matched == 0){
+            continue;
+        }
+        if (excess == 0){
+            possible_exact.emplace_back(c);
+        }
+        double bound = log10p_lower_bound(entry.length, max_matched);
+        bounds[c] = bound;
+        if (seeds.size() < SEEDS || bound < seeds.front().first){
+            if (seeds.size() == SEEDS){
+                std::pop_heap(seeds.begin(), seeds.end());
+                seeds.pop_back();
+            }
+            seeds.emplace_back(bound, c);
+            std::push_heap(seeds.begin(), seeds.end());
+        }
+    }
+
+    //  Score the seeds first to get a good cutoff. Then only score the
+    //  candidates that can still fall within the spread.
+    struct Scored{
+        size_t index;
+        double log10p;
+    };
+    std::vector<Scored> scored;
+    double best = std::numeric_limits<double>::infinity();
+    auto score = [&](size_t index){
+        size_t token_length = m_entries[index].length;
+        size_t distance = substring_distance(query, index);
+        size_t matched = token_length - distance;
+        if (matched == 0){
+            return;
+        }
+
+        double log10p = this->log10p(token_length, matched);
+
+        if (distance == 0){
+            results.exact_match = true;
+        }
+
+        best = std::min(best, log10p);
+        scored.emplace_back(Scored{index, log10p});
+    };
+    for (const auto& item : seeds){
+        score(item.second);
+        bounds[item.second] = std::numeric_limits<double>::infinity();
+    }
+    for (size_t c = 0; c < m_entries.size(); c++){
+        if (bounds[c] <= best + log10p_spread){
+            score(c);
+            bounds[c] = std::numeric_limits<double>::infinity();
+        }
+    }
+
+    //  A pruned candidate may still be an exact substring of the text.
+    for (size_t c = 0; c < possible_exact.size() && !results.exact_match; c++){
+        size_t index = possible_exact[c];
+        if (bounds[index] != std::numeric_limits<double>::infinity() && substring_distance(query, index) == 0){
+            results.exact_match = true;
+        }
+    }
+
+    //  Add in database order so that ties are ordered the same as a full scan.
+    std::sort(
+        scored.begin(), scored.end(),
+        [](const Scored& x, const Scored& y){ return x.index < y.index; }
+    );
+    for (const Scored& item : scored){
+        if (item.log10p > best + log10p_spread){
+            continue;
+        }
+        const Database::value_type& entry = *m_entries[item.index].item;
+        for (const auto& slug : entry.second){
+            results.add(item.log10p, StringMatchData{text, query.text, entry.first, slug});
+        }
+    }
+
+    return results;
+}
+
+
+
+
+}
+}
@@ -0,0 +1,85 @@
+/*  Substring Match Index
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Prebuilt index over an OCR candidate dictionary. Returns exactly the
+ *  same results as OCR::match_substring() on the same database, but avoids
+ *  running the edit-distance DP against every candidate.
+ *
+ *  For each query, every candidate gets a cheap lower bound on its distance
+ *  from its character counts. Candidates are then visited in order of their
+ *  best possible score and the exact distance is computed using Myers'
+ *  bit-parallel algorithm. The scan stops as soon as no remaining candidate
+ *  can land within the spread of the best match found so far.
+ *
+ */
+
+#ifndef PokemonAutomation_OCR_SubstringMatchIndex_H
+#define PokemonAutomation_OCR_SubstringMatchIndex_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include "OCR_StringMatchResult.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+class SubstringMatchIndex{
+public:
+    using Database = std::map<std::u32string, std::set<std::string>>;
+
+    //  The index holds a reference to "database". Call "rebuild()" after
+    //  adding new candidates to it.
+    SubstringMatchIndex(const Database& database, double random_match_chance);
+
+    void rebuild();
+
+    StringMatchResult match_substring(const std::string& text, double log10p_spread) const;
+
+
+private:
+    struct Query;
+
+    //  Same as log10(random_match_probability()), but from the table.
+    double log10p(size_t length, size_t matched) const;
+
+    //  Lowest possible log10p for a candidate of length "length" that matches
+    //  at most "max_matched" characters.
+    double log10p_lower_bound(size_t length, size_t max_matched) const;
+
+    //  Returns "levenshtein_distance_substring(candidate, query.text)".
+    size_t substring_distance(Query& query, size_t index) const;
+
+
+private:
+    const Database& m_database;
+    double m_random_match_chance;
+
+    //  All distinct characters in the database. (sorted)
+    std::vector<char32_t> m_alphabet;
+
+    //  Database entries in map order. Each candidate is also stored as a
+    //  range of indices into "m_alphabet".
+    struct Entry{
+        const Database::value_type* item;
+        size_t offset;
+        size_t length;
+    };
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_char_ids;
+
+    //  m_log10p[length][matched]
+    std::vector<std::vector<double>> m_log10p;
+
+    //  m_log10p_bounds[length][max_matched]
+    std::vector<std::vector<double>> m_log10p_bounds;
+};
+
+
+
+}
+}
+#endif
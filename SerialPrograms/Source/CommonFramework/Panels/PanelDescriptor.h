@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "Common/Cpp/Color.h"
 
 namespace PokemonAutomation{
@@ -34,8 +35,17 @@ public:
     const std::string& doc_link() const{ return m_doc_link; }
     const std::string& description() const{ return m_description; }
 
+    //  Names of the ResourcePreloader resources this panel needs. They are
+    //  preloaded when the panel is opened.
+    const std::vector<std::string>& required_resources() const{ return m_required_resources; }
+
     virtual std::unique_ptr<PanelInstance> make_panel() const = 0;
 
+protected:
+    void set_required_resources(std::vector<std::string> resources){
+        m_required_resources = std::move(resources);
+    }
+
 private:
     const Color m_color;
     const std::string m_identifier;
@@ -43,6 +53,7 @@ private:
     const std::string m_display_name;
     const std::string m_doc_link;
     const std::string m_description;
+    std::vector<std::string> m_required_resources;
 };
 
 
@@ -8,6 +8,7 @@
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/PersistentSettings.h"
 #include "CommonFramework/Panels/PanelInstance.h"
+#include "CommonFramework/Resources/ResourcePreloader.h"
 #include "PanelListWidget.h"
 
 namespace PokemonAutomation{
@@ -85,6 +86,7 @@ void PanelListWidget::handle_panel_clicked(const std::string& text){
         return;
     }
     try{
+        ResourcePreloader::instance().preload(descriptor->required_resources());
         std::unique_ptr<PanelInstance> panel = descriptor->make_panel();
         panel->from_json(PERSISTENT_SETTINGS().panels[descriptor->identifier()]);
         m_panel_holder.load_panel(descriptor, std::move(panel));
@@ -120,14 +120,17 @@ void ProgramSession::load_historical_stats(){
     if (stats){
         m_logger.log("Loading historical stats...");
 //        m_current_stats = m_descriptor.make_stats();
-        StatSet set;
-        set.open_from_file(GlobalSettings::instance().STATS_FILE);
-        const std::string& identifier = m_descriptor.identifier();
-        StatList& list = set[identifier];
-        if (list.size() != 0){
-            list.aggregate(*stats);
+        bool ok = StatSet::aggregate_file(
+            GlobalSettings::instance().STATS_FILE,
+            m_descriptor.identifier(),
+            *stats
+        );
+        if (ok){
+            m_historical_stats = std::move(stats);
+        }else{
+            m_logger.log("Unable to load historical stats.", COLOR_RED);
+            push_error("Unable to load historical stats.");
         }
-        m_historical_stats = std::move(stats);
     }
 }
 void ProgramSession::update_historical_stats_with_current(){
@@ -0,0 +1,218 @@
+/*  Resource Preloader
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "ResourcePreloader.h"
+
+namespace PokemonAutomation{
+
+
+
+ResourcePreloader& ResourcePreloader::instance(){
+    static ResourcePreloader preloader;
+    return preloader;
+}
+ResourcePreloader::~ResourcePreloader(){
+    stop();
+}
+
+
+void ResourcePreloader::add(
+    std::string name,
+    std::chrono::milliseconds estimated_cost,
+    std::vector<std::string> dependencies,
+    std::function<void()> load
+){
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_resources.find(name) != m_resources.end()){
+        return;
+    }
+
+    //  Requiring dependencies to exist first also rules out cycles.
+    std::vector<Resource*> resolved;
+    for (const std::string& dependency : dependencies){
+        resolved.emplace_back(&get(dependency));
+    }
+
+    Resource& resource = m_resources[name];
+    resource.name = std::move(name);
+    resource.estimated_cost = estimated_cost;
+    resource.dependencies = std::move(resolved);
+    resource.load = std::move(load);
+}
+
+ResourcePreloader::Resource& ResourcePreloader::get(const std::string& name){
+    auto iter = m_resources.find(name);
+    if (iter == m_resources.end()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unknown preload resource: " + name);
+    }
+    return iter->second;
+}
+
+
+
+void ResourcePreloader::preload(const std::vector<std::string>& names){
+    if (names.empty()){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    if (m_stopping){
+        return;
+    }
+    for (const std::string& name : names){
+        enqueue(get(name));
+    }
+
+    if (m_threads.empty()){
+        size_t threads = std::max<size_t>(std::thread::hardware_concurrency() / 2, 1);
+        for (size_t c = 0; c < threads; c++){
+            m_threads.emplace_back(run_with_catch, "ResourcePreloader::thread_loop()", [this]{ thread_loop(); });
+        }
+    }
+    m_cv.notify_all();
+}
+void ResourcePreloader::enqueue(Resource& resource){
+    if (resource.state != State::NOT_STARTED){
+        return;
+    }
+    resource.state = State::QUEUED;
+    for (Resource* dependency : resource.dependencies){
+        enqueue(*dependency);
+    }
+}
+
+bool ResourcePreloader::is_finished(const Resource& resource) const{
+    return resource.state == State::DONE || resource.state == State::FAILED;
+}
+ResourcePreloader::Resource* ResourcePreloader::next_ready(){
+    //  Longest first. The cheap ones will fill in around them.
+    Resource* best = nullptr;
+    for (auto& item : m_resources){
+        Resource& resource = item.second;
+        if (resource.state != State::QUEUED){
+            continue;
+        }
+        bool ready = true;
+        for (const Resource* dependency : resource.dependencies){
+            ready &= is_finished(*dependency);
+        }
+        if (ready && (best == nullptr || best->estimated_cost < resource.estimated_cost)){
+            best = &resource;
+        }
+    }
+    return best;
+}
+
+
+
+void ResourcePreloader::wait_for(const std::vector<std::string>& names){
+    std::vector<Resource*> resources;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        for (const std::string& name : names){
+            resources.emplace_back(&get(name));
+        }
+    }
+    for (Resource* resource : resources){
+        wait_for(*resource);
+    }
+}
+void ResourcePreloader::wait_for(Resource& resource){
+    //  The dependency lists never change after "add()" so these can be read
+    //  without the lock.
+    for (Resource* dependency : resource.dependencies){
+        wait_for(*dependency);
+    }
+
+    std::unique_lock<std::mutex> lg(m_lock);
+    if (resource.state == State::NOT_STARTED || resource.state == State::QUEUED){
+        resource.state = State::RUNNING;
+        lg.unlock();
+        run(resource);
+        return;
+    }
+    m_cv.wait(lg, [&]{ return is_finished(resource); });
+}
+
+void ResourcePreloader::stop(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        for (auto& item : m_resources){
+            if (item.second.state == State::QUEUED){
+                item.second.state = State::NOT_STARTED;
+            }
+        }
+        m_cv.notify_all();
+    }
+    for (std::thread& thread : m_threads){
+        thread.join();
+    }
+    m_threads.clear();
+}
+
+
+
+void ResourcePreloader::run(Resource& resource){
+    Logger& logger = global_logger_tagged();
+    WallClock start = current_time();
+
+    std::string error;
+    try{
+        resource.load();
+    }catch (const Exception& e){
+        error = e.to_str();
+    }catch (const std::exception& e){
+        error = e.what();
+    }catch (...){
+        error = "Unknown exception.";
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start).count();
+    if (error.empty()){
+        logger.log(
+            "Preloaded " + resource.name + " in " + std::to_string(ms) +
+            " ms. (estimated " + std::to_string(resource.estimated_cost.count()) + " ms)",
+            COLOR_BLUE
+        );
+    }else{
+        logger.log("Unable to preload " + resource.name + " after " + std::to_string(ms) + " ms: " + error, COLOR_RED);
+    }
+
+    std::lock_guard<std::mutex> lg(m_lock);
+    resource.state = error.empty() ? State::DONE : State::FAILED;
+    m_cv.notify_all();
+}
+
+void ResourcePreloader::thread_loop(){
+    GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread();
+
+    while (true){
+        Resource* resource;
+        {
+            std::unique_lock<std::mutex> lg(m_lock);
+            if (m_stopping){
+                return;
+            }
+            resource = next_ready();
+            if (resource == nullptr){
+                m_cv.wait(lg);
+                continue;
+            }
+            resource->state = State::RUNNING;
+        }
+        run(*resource);
+    }
+}
+
+
+
+}
@@ -0,0 +1,107 @@
+/*  Resource Preloader
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Loads large resources (OCR dictionaries, sprite databases, lookup tables)
+ *  in the background so the first read from inside a program doesn't have to.
+ *
+ *  Each subsystem registers its resources here by name, along with what they
+ *  depend on and roughly how long they take to load. Program descriptors list
+ *  the resources they need. Those are queued when the panel is opened and
+ *  waited on before the program starts.
+ *
+ *  Queued resources are loaded on a small thread pool, most expensive first.
+ *  Every load is logged with how long it took.
+ *
+ */
+
+#ifndef PokemonAutomation_Resources_ResourcePreloader_H
+#define PokemonAutomation_Resources_ResourcePreloader_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace PokemonAutomation{
+
+
+class ResourcePreloader{
+public:
+    static ResourcePreloader& instance();
+
+    //  Register a resource.
+    //
+    //  "load" builds the resource. Since resources are normally lazy
+    //  singletons, this is usually just a call to the accessor. It may run on
+    //  any thread and is called at most once.
+    //
+    //  "dependencies" are loaded before this one and must already be
+    //  registered. Adding a name that already exists does nothing. That way,
+    //  shared resources can be registered by everything that uses them.
+    void add(
+        std::string name,
+        std::chrono::milliseconds estimated_cost,
+        std::vector<std::string> dependencies,
+        std::function<void()> load
+    );
+
+    //  Start loading these resources and their dependencies in the background.
+    //  Returns immediately.
+    void preload(const std::vector<std::string>& names);
+
+    //  Block until these resources are loaded. Anything that hasn't started
+    //  yet is loaded on the calling thread instead of waiting for a worker.
+    //  Load failures are logged, not thrown. The resource will throw again
+    //  when it's actually used.
+    void wait_for(const std::vector<std::string>& names);
+
+    //  Drop everything that hasn't started and wait for the rest to finish.
+    void stop();
+
+
+private:
+    enum class State{
+        NOT_STARTED,
+        QUEUED,
+        RUNNING,
+        DONE,
+        FAILED,
+    };
+    struct Resource{
+        std::string name;
+        std::chrono::milliseconds estimated_cost;
+        std::vector<Resource*> dependencies;
+        std::function<void()> load;
+        State state = State::NOT_STARTED;
+    };
+
+    ResourcePreloader() = default;
+    ~ResourcePreloader();
+
+    Resource& get(const std::string& name);
+    void enqueue(Resource& resource);
+    bool is_finished(const Resource& resource) const;
+    Resource* next_ready();
+
+    void wait_for(Resource& resource);
+    void run(Resource& resource);
+    void thread_loop();
+
+
+private:
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    bool m_stopping = false;
+    std::map<std::string, Resource> m_resources;
+    std::vector<std::thread> m_threads;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,296 @@
+/*  Sprite Bundle
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include "Common/Compiler.h"
+#include "Common/CRC32.h"
+#include "Common/Cpp/Exceptions.h"
+#include "SpriteBundle.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+const char BUNDLE_MAGIC[4] = {'P', 'A', 'S', 'B'};
+const uint32_t BUNDLE_VERSION = 1;
+
+//  All offsets are from the start of the file.
+struct BundleHeader{
+    char magic[4];
+    uint32_t version;
+    uint32_t checksum;
+    uint32_t sprite_count;
+    uint32_t feature_count;
+    uint32_t reserved;
+    uint64_t features_offset;   //  BundleString[feature_count]
+    uint64_t sprites_offset;    //  BundleSprite[sprite_count]
+    uint64_t images_offset;     //  BundleImage[sprite_count * (1 + feature_count)]
+    uint64_t strings_offset;    //  char[strings_bytes]
+    uint64_t strings_bytes;
+};
+struct BundleString{
+    uint32_t offset;    //  Into the string block.
+    uint32_t length;
+};
+struct BundleSprite{
+    BundleString slug;
+    uint32_t icon_min_x;
+    uint32_t icon_min_y;
+    uint32_t icon_max_x;
+    uint32_t icon_max_y;
+};
+//  For each sprite: the sprite itself followed by each of its features.
+//  Pixel data starts on a PA_ALIGNMENT boundary and rows are padded to
+//  PA_ALIGNMENT bytes, the same as ImageRGB32.
+struct BundleImage{
+    uint64_t offset;
+    uint64_t bytes_per_row;
+    uint32_t width;
+    uint32_t height;
+};
+
+uint64_t align_up(uint64_t x){
+    return (x + PA_ALIGNMENT - 1) & ~(uint64_t)(PA_ALIGNMENT - 1);
+}
+
+}
+
+
+
+std::string sprite_bundle_path(const std::string& sprite_path){
+    QFileInfo info(QString::fromStdString(sprite_path));
+    return info.dir().filePath(info.completeBaseName() + ".pabundle").toStdString();
+}
+
+uint32_t sprite_bundle_checksum(const std::string& sprite_path, const std::string& json_path){
+    uint32_t crc = 0xffffffff;
+    for (const std::string* path : {&sprite_path, &json_path}){
+        QFile file(QString::fromStdString(*path));
+        if (!file.open(QIODevice::ReadOnly)){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file.", *path);
+        }
+        while (!file.atEnd()){
+            QByteArray block = file.read((qint64)1 << 20);
+            crc = pabb_crc32_table(crc, block.data(), block.size());
+        }
+    }
+    return ~crc;
+}
+
+
+
+void write_sprite_bundle(
+    const std::string& path, uint32_t checksum,
+    const std::vector<SpriteBundleEntry>& sprites,
+    const std::vector<SpriteBundleFeature>& features
+){
+    std::string strings;
+    auto add_string = [&](const std::string& str){
+        BundleString ret{(uint32_t)strings.size(), (uint32_t)str.size()};
+        strings += str;
+        return ret;
+    };
+
+    std::vector<BundleString> feature_table;
+    for (const SpriteBundleFeature& feature : features){
+        feature_table.emplace_back(add_string(feature.name));
+    }
+
+    //  Compute every feature up front so the layout is known before writing.
+    std::vector<BundleSprite> sprite_table;
+    std::vector<ImageRGB32> feature_images;
+    std::vector<ImageViewRGB32> images;
+    for (const SpriteBundleEntry& sprite : sprites){
+        BundleSprite entry;
+        entry.slug = add_string(sprite.slug);
+        entry.icon_min_x = (uint32_t)sprite.icon.min_x;
+        entry.icon_min_y = (uint32_t)sprite.icon.min_y;
+        entry.icon_max_x = (uint32_t)sprite.icon.max_x;
+        entry.icon_max_y = (uint32_t)sprite.icon.max_y;
+        sprite_table.emplace_back(entry);
+        for (const SpriteBundleFeature& feature : features){
+            feature_images.emplace_back(feature.compute(sprite.sprite));
+        }
+    }
+    for (size_t s = 0; s < sprites.size(); s++){
+        images.emplace_back(sprites[s].sprite);
+        for (size_t f = 0; f < features.size(); f++){
+            images.emplace_back(feature_images[s * features.size() + f]);
+        }
+    }
+
+    BundleHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+    header.version = BUNDLE_VERSION;
+    header.checksum = checksum;
+    header.sprite_count = (uint32_t)sprite_table.size();
+    header.feature_count = (uint32_t)feature_table.size();
+
+    uint64_t offset = sizeof(header);
+    header.features_offset = offset;
+    offset += feature_table.size() * sizeof(BundleString);
+    header.sprites_offset = offset;
+    offset += sprite_table.size() * sizeof(BundleSprite);
+    header.images_offset = offset;
+    offset += images.size() * sizeof(BundleImage);
+    header.strings_offset = offset;
+    header.strings_bytes = strings.size();
+    offset += strings.size();
+
+    std::vector<BundleImage> image_table;
+    for (const ImageViewRGB32& image : images){
+        BundleImage entry;
+        offset = align_up(offset);
+        entry.offset = offset;
+        entry.bytes_per_row = align_up(image.width() * sizeof(uint32_t));
+        entry.width = (uint32_t)image.width();
+        entry.height = (uint32_t)image.height();
+        image_table.emplace_back(entry);
+        offset += entry.bytes_per_row * entry.height;
+    }
+
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to create sprite bundle.", path);
+    }
+    uint64_t written = 0;
+    auto write = [&](const void* data, uint64_t bytes){
+        if (file.write((const char*)data, bytes) != (qint64)bytes){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write sprite bundle.", path);
+        }
+        written += bytes;
+    };
+    const char zeros[PA_ALIGNMENT] = {};
+    auto pad_to = [&](uint64_t position){
+        write(zeros, position - written);
+    };
+
+    write(&header, sizeof(header));
+    write(feature_table.data(), feature_table.size() * sizeof(BundleString));
+    write(sprite_table.data(), sprite_table.size() * sizeof(BundleSprite));
+    write(image_table.data(), image_table.size() * sizeof(BundleImage));
+    write(strings.data(), strings.size());
+    for (size_t c = 0; c < images.size(); c++){
+        const ImageViewRGB32& image = images[c];
+        const BundleImage& entry = image_table[c];
+        pad_to(entry.offset);
+        size_t row_bytes = image.width() * sizeof(uint32_t);
+        for (size_t r = 0; r < image.height(); r++){
+            write((const char*)image.data() + r * image.bytes_per_row(), row_bytes);
+            pad_to(align_up(written));
+        }
+    }
+}
+
+
+
+SpriteBundle::~SpriteBundle() = default;
+
+std::unique_ptr<SpriteBundle> SpriteBundle::open(const std::string& path, uint32_t checksum){
+    std::unique_ptr<SpriteBundle> bundle(new SpriteBundle());
+    bundle->m_file.reset(new QFile(QString::fromStdString(path)));
+    QFile& file = *bundle->m_file;
+    if (!file.exists()){
+        return nullptr;
+    }
+    if (!file.open(QIODevice::ReadOnly)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open sprite bundle.", path);
+    }
+
+    const uint64_t size = file.size();
+    auto corrupt = [&](){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Sprite bundle is corrupt.", path);
+    };
+    auto in_range = [=](uint64_t offset, uint64_t bytes){
+        return offset <= size && bytes <= size - offset;
+    };
+
+    BundleHeader header;
+    if (!in_range(0, sizeof(header))){
+        corrupt();
+    }
+    const char* data = (const char*)file.map(0, size);
+    if (data == nullptr){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to map sprite bundle.", path);
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0){
+        corrupt();
+    }
+
+    //  Made by a different version of this code or from different sources.
+    //  Not an error. The caller will fall back to the sprite sheet.
+    if (header.version != BUNDLE_VERSION || header.checksum != checksum){
+        return nullptr;
+    }
+
+    const uint64_t image_count = (uint64_t)header.sprite_count * (1 + header.feature_count);
+    if (!in_range(header.features_offset, header.feature_count * sizeof(BundleString)) ||
+        !in_range(header.sprites_offset, header.sprite_count * sizeof(BundleSprite)) ||
+        !in_range(header.images_offset, image_count * sizeof(BundleImage)) ||
+        !in_range(header.strings_offset, header.strings_bytes)
+    ){
+        corrupt();
+    }
+
+    auto read_string = [&](const BundleString& str){
+        if ((uint64_t)str.offset + str.length > header.strings_bytes){
+            corrupt();
+        }
+        return std::string(data + header.strings_offset + str.offset, str.length);
+    };
+    auto read_image = [&](uint64_t index){
+        BundleImage entry;
+        memcpy(&entry, data + header.images_offset + index * sizeof(BundleImage), sizeof(entry));
+        if (entry.offset % sizeof(uint32_t) != 0 ||
+            entry.bytes_per_row % sizeof(uint32_t) != 0 ||
+            entry.bytes_per_row < entry.width * sizeof(uint32_t) ||
+            (entry.height != 0 && entry.bytes_per_row > size / entry.height) ||
+            !in_range(entry.offset, entry.bytes_per_row * entry.height)
+        ){
+            corrupt();
+        }
+        //  The view is read-only. Nothing writes through this pointer.
+        return ImageViewRGB32((uint32_t*)(data + entry.offset), entry.bytes_per_row, entry.width, entry.height);
+    };
+
+    for (uint32_t f = 0; f < header.feature_count; f++){
+        BundleString name;
+        memcpy(&name, data + header.features_offset + f * sizeof(BundleString), sizeof(name));
+        bundle->m_feature_names.emplace_back(read_string(name));
+    }
+
+    bundle->m_sprites.reserve(header.sprite_count);
+    for (uint32_t s = 0; s < header.sprite_count; s++){
+        BundleSprite entry;
+        memcpy(&entry, data + header.sprites_offset + s * sizeof(BundleSprite), sizeof(entry));
+
+        Sprite sprite;
+        sprite.slug = read_string(entry.slug);
+        sprite.sprite = read_image((uint64_t)s * (1 + header.feature_count));
+        if (entry.icon_min_x > entry.icon_max_x || entry.icon_max_x > sprite.sprite.width() ||
+            entry.icon_min_y > entry.icon_max_y || entry.icon_max_y > sprite.sprite.height()
+        ){
+            corrupt();
+        }
+        sprite.icon = ImagePixelBox(entry.icon_min_x, entry.icon_min_y, entry.icon_max_x, entry.icon_max_y);
+        for (uint32_t f = 0; f < header.feature_count; f++){
+            sprite.features.emplace_back(read_image((uint64_t)s * (1 + header.feature_count) + 1 + f));
+        }
+        bundle->m_sprites.emplace_back(std::move(sprite));
+    }
+
+    return bundle;
+}
+
+
+
+}
@@ -0,0 +1,92 @@
+/*  Sprite Bundle
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  A pre-decoded copy of a SpriteDatabase. Each sprite is stored as raw RGB32
+ *  pixels along with its trimmed bounds and any number of derived images
+ *  ("features") so the file can be memory-mapped and used in place.
+ *
+ *  The bundle for "<folder>/<name>.png" is "<folder>/<name>.pabundle". It
+ *  records a CRC32 of the sprite sheet and its json. If either of them
+ *  changes, the bundle no longer matches and is ignored.
+ *
+ */
+
+#ifndef PokemonAutomation_Resources_SpriteBundle_H
+#define PokemonAutomation_Resources_SpriteBundle_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+class QFile;
+
+namespace PokemonAutomation{
+
+
+//  An image that is derived from each sprite when the bundle is built.
+//  Rename the feature whenever "compute" changes. Otherwise old bundles will
+//  keep returning the old images.
+struct SpriteBundleFeature{
+    std::string name;
+    std::function<ImageRGB32(const ImageViewRGB32& sprite)> compute;
+};
+
+
+//  "sprite_path" is the full path of the sprite sheet.
+std::string sprite_bundle_path(const std::string& sprite_path);
+
+//  CRC32 of the contents of both files.
+uint32_t sprite_bundle_checksum(const std::string& sprite_path, const std::string& json_path);
+
+
+struct SpriteBundleEntry{
+    std::string slug;
+    ImageViewRGB32 sprite;
+    ImagePixelBox icon;     //  Bounds of the icon within "sprite".
+};
+
+//  Write a bundle with the specified sprites. The features are computed here.
+void write_sprite_bundle(
+    const std::string& path, uint32_t checksum,
+    const std::vector<SpriteBundleEntry>& sprites,
+    const std::vector<SpriteBundleFeature>& features
+);
+
+
+class SpriteBundle{
+public:
+    struct Sprite{
+        std::string slug;
+        ImageViewRGB32 sprite;
+        ImagePixelBox icon;
+        std::vector<ImageViewRGB32> features;   //  In the order of "feature_names()".
+    };
+
+public:
+    ~SpriteBundle();
+
+    //  Map the bundle at "path".
+    //  Returns null if the file doesn't exist or doesn't match "checksum".
+    //  Throws FileException if the file is corrupt.
+    static std::unique_ptr<SpriteBundle> open(const std::string& path, uint32_t checksum);
+
+    const std::vector<std::string>& feature_names() const{ return m_feature_names; }
+    const std::vector<Sprite>& sprites() const{ return m_sprites; }
+
+private:
+    SpriteBundle() = default;
+
+private:
+    std::unique_ptr<QFile> m_file;
+    std::vector<std::string> m_feature_names;
+    std::vector<Sprite> m_sprites;
+};
+
+
+
+}
+#endif
@@ -4,21 +4,62 @@
  *
  */
 
+#include <QFileInfo>
+#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonObject.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/ImageMatch/ImageCropper.h"
+#include "CommonFramework/Logging/Logger.h"
 #include "SpriteDatabase.h"
 
 namespace PokemonAutomation{
 
 
 
+namespace{
+
+//  The part of the sprite that isn't transparent.
+ImagePixelBox icon_box(const ImageViewRGB32& sprite){
+    return ImageMatch::enclosing_rectangle_with_pixel_filter(
+        sprite,
+        [](Color pixel){ return pixel.alpha() >= 128; }
+    );
+}
+
+}
+
+
+
 SpriteDatabase::SpriteDatabase(const char* sprite_path, const char* json_path)
-    : m_backing_image(RESOURCE_PATH() + sprite_path)
+    : SpriteDatabase(sprite_path, json_path, true)
+{}
+SpriteDatabase::SpriteDatabase(const char* sprite_path, const char* json_path, bool use_bundle)
+    : m_sprite_path(RESOURCE_PATH() + sprite_path)
+    , m_json_path(RESOURCE_PATH() + json_path)
 {
-    std::string path = RESOURCE_PATH() + json_path;
+    //  Only checksum the sources if there's a bundle to compare against.
+    std::string bundle_path = sprite_bundle_path(m_sprite_path);
+    if (use_bundle && QFileInfo::exists(QString::fromStdString(bundle_path))){
+        try{
+            m_bundle = SpriteBundle::open(bundle_path, sprite_bundle_checksum(m_sprite_path, m_json_path));
+        }catch (const FileException& error){
+            global_logger_tagged().log("Ignoring sprite bundle: " + error.message(), COLOR_RED);
+        }
+    }
+    if (m_bundle){
+        load_bundle();
+    }else{
+        load_sprite_sheet();
+    }
+}
+SpriteDatabase::~SpriteDatabase() = default;
+
+void SpriteDatabase::load_sprite_sheet(){
+    m_backing_image = ImageRGB32(m_sprite_path);
+
+    const std::string& path = m_json_path;
     JsonValue json = load_json_file(path);
     JsonObject& root = json.get_object_throw(path);
 
@@ -41,10 +82,25 @@ SpriteDatabase::SpriteDatabase(const char* sprite_path, const char* json_path)
         ImageViewRGB32 sprite = extract_box_reference(m_backing_image, ImagePixelBox(x, y, x + width, y + height));
         m_database.emplace(
             slug,
-            Sprite{sprite, ImageMatch::trim_image_alpha(sprite)}
+            Sprite{sprite, extract_box_reference(sprite, icon_box(sprite))}
         );
     }
 }
+void SpriteDatabase::load_bundle(){
+    const std::vector<SpriteBundle::Sprite>& sprites = m_bundle->sprites();
+    for (size_t c = 0; c < sprites.size(); c++){
+        const SpriteBundle::Sprite& sprite = sprites[c];
+        m_database.emplace(
+            sprite.slug,
+            Sprite{sprite.sprite, extract_box_reference(sprite.sprite, sprite.icon)}
+        );
+        m_bundle_sprites.emplace(sprite.slug, c);
+    }
+    const std::vector<std::string>& features = m_bundle->feature_names();
+    for (size_t c = 0; c < features.size(); c++){
+        m_bundle_features.emplace(features[c], c);
+    }
+}
 
 const SpriteDatabase::Sprite& SpriteDatabase::get_throw(const std::string& slug) const{
     auto iter = m_database.find(slug);
@@ -61,6 +117,33 @@ const SpriteDatabase::Sprite* SpriteDatabase::get_nothrow(const std::string& slu
     return &iter->second;
 }
 
+ImageViewRGB32 SpriteDatabase::feature(const std::string& slug, const std::string& name) const{
+    auto sprite = m_bundle_sprites.find(slug);
+    auto feature = m_bundle_features.find(name);
+    if (sprite == m_bundle_sprites.end() || feature == m_bundle_features.end()){
+        return ImageViewRGB32();
+    }
+    return m_bundle->sprites()[sprite->second].features[feature->second];
+}
+
+void SpriteDatabase::build_bundle(
+    const char* sprite_path, const char* json_path,
+    const std::vector<SpriteBundleFeature>& features
+){
+    //  Don't load the existing bundle. It is about to be overwritten.
+    SpriteDatabase database(sprite_path, json_path, false);
+
+    std::vector<SpriteBundleEntry> sprites;
+    for (const auto& item : database.m_database){
+        sprites.emplace_back(SpriteBundleEntry{item.first, item.second.sprite, icon_box(item.second.sprite)});
+    }
+    write_sprite_bundle(
+        sprite_bundle_path(database.m_sprite_path),
+        sprite_bundle_checksum(database.m_sprite_path, database.m_json_path),
+        sprites, features
+    );
+}
+
 
 
 }
@@ -8,7 +8,10 @@
 #define PokemonAutomation_Resources_SpriteCompositeImage_H
 
 #include <map>
+#include <memory>
+#include <vector>
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "SpriteBundle.h"
 
 namespace PokemonAutomation{
 
@@ -32,7 +35,11 @@ public:
     //          (next pokemon) ...
     //      }
     //  }
+    //
+    //  If there is an up-to-date sprite bundle for the sprite sheet (see
+    //  SpriteBundle.h), the sprites are read from that instead.
     SpriteDatabase(const char* sprite_path, const char* json_path);
+    ~SpriteDatabase();
 
 public:
     struct Sprite{
@@ -42,6 +49,18 @@ public:
     const Sprite& get_throw(const std::string& slug) const;
     const Sprite* get_nothrow(const std::string& slug) const;
 
+    //  Return the precomputed feature "name" of this sprite.
+    //  Returns an empty image if the sprites weren't loaded from a bundle that
+    //  has this feature. Callers should then compute it themselves.
+    ImageViewRGB32 feature(const std::string& slug, const std::string& name) const;
+
+    //  Decode the sprite sheet, ignoring any existing bundle, and write a new
+    //  bundle for it with the specified features.
+    static void build_bundle(
+        const char* sprite_path, const char* json_path,
+        const std::vector<SpriteBundleFeature>& features
+    );
+
     const std::map<std::string, Sprite>& get() const{
         return m_database;
     }
@@ -58,8 +77,19 @@ public:
           iterator end    (){ return m_database.end(); }
 
 private:
+    SpriteDatabase(const char* sprite_path, const char* json_path, bool use_bundle);
+    void load_sprite_sheet();
+    void load_bundle();
+
+private:
+    std::string m_sprite_path;
+    std::string m_json_path;
     std::map<std::string, Sprite> m_database;
     ImageRGB32 m_backing_image;
+
+    std::unique_ptr<SpriteBundle> m_bundle;
+    std::map<std::string, size_t> m_bundle_sprites;     //  Index into "m_bundle->sprites()".
+    std::map<std::string, size_t> m_bundle_features;    //  Index into "m_bundle->feature_names()".
 };
 
 
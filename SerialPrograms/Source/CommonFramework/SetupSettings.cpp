@@ -14,6 +14,7 @@
 #endif
 #include "Globals.h"
 #include "GlobalSettingsPanel.h"
+#include "Tools/StatsDatabase.h"
 #include "SetupSettings.h"
 
 #include <iostream>
@@ -104,6 +105,9 @@ bool migrate_stats(Logger& logger){
     }
 
     if (root_file.exists() && !folder_file.exists()){
+        //  Only the stats file is copied. Merge its journal into it first.
+        logger.log("Merging stats journal...");
+        StatSet::compact_file(path);
         logger.log("Migrating root file to the folder...");
         root_file.copy(folder_file.fileName());
         logger.log("Renaming root file as backup...");
@@ -201,6 +201,17 @@ const char* BotBaseHandle::try_next_interrupt(){
     }
     return nullptr;
 }
+bool BotBaseHandle::try_get_rtt_stats(RttStats& stats) const{
+    std::unique_lock<std::mutex> lg(m_lock, std::defer_lock);
+    if (!lg.try_lock()){
+        return false;
+    }
+    if (m_botbase == nullptr){
+        return false;
+    }
+    stats = m_botbase->rtt_stats();
+    return true;
+}
 
 void BotBaseHandle::stop_unprotected(){
     {
@@ -21,6 +21,7 @@ namespace PokemonAutomation{
 
 class MessageSniffer;
 class PABotBase;
+struct RttStats;
 
 
 class BotBaseHandle : public QObject{
@@ -71,6 +72,10 @@ public:
     const char* try_stop_commands();
     const char* try_next_interrupt();
 
+    //  Round-trip and retransmit stats for the current connection.
+    //  Returns false if there's no connection or the handle is busy.
+    bool try_get_rtt_stats(RttStats& stats) const;
+
 signals:
     void on_not_connected(std::string error);
     void on_connecting(const std::string& port_name);
@@ -8,7 +8,7 @@
 #include "DebugDumper.h"
 #include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/Globals.h"
-#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/Logging/Logger.h"
 
 namespace PokemonAutomation{
@@ -24,12 +24,19 @@ std::string dump_debug_image(
     Logger& logger,
     const std::string& path,
     const std::string& label,
-    const ImageViewRGB32& image
+    const ImageViewRGB32& image,
+    ImageDumpFormat format
 ){
     create_debug_folder(path);
-    std::string full_path = DEBUG_PATH() + path + "/" + now_to_filestring() + "-" + label + ".png";
-    logger.log("Saving debug image to: " + full_path, COLOR_YELLOW);
-    image.save(full_path);
+    std::string full_path = ImageDumpQueue::instance().dump(
+        logger,
+        DEBUG_PATH() + path + "/", now_to_filestring() + "-" + label,
+        std::make_shared<const ImageRGB32>(image.copy()),
+        format
+    );
+    if (!full_path.empty()){
+        logger.log("Saving debug image to: " + full_path, COLOR_YELLOW);
+    }
     return full_path;
 }
 
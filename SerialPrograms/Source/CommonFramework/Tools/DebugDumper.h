@@ -8,19 +8,23 @@
 #define PokemonAutomation_DebugDumper_H
 
 #include <string>
+#include "ImageDumpQueue.h"
 
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 class Logger;
 
-// Dump debug image to ./DebugDumps/`path`/<timestamp>-`label`.png
-// Return image path.
+// Dump debug image to ./DebugDumps/`path`/<timestamp>-`label`.png (or .qoi)
+// The image is saved in the background. Debug dumps favor speed over file
+// size so they default to a low PNG compression level.
+// Return image path, or empty string if the image was dropped.
 std::string dump_debug_image(
     Logger& logger,
     const std::string& path,
     const std::string& label,
-    const ImageViewRGB32& image
+    const ImageViewRGB32& image,
+    ImageDumpFormat format = ImageDumpFormat::PNG_FAST
 );
 
 }
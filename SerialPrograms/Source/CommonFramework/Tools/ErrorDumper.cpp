@@ -4,12 +4,10 @@
  *
  */
 
-#include <mutex>
-#include <QDir>
 #include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/Globals.h"
-#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/Notifications/EventNotificationOption.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
@@ -17,6 +15,7 @@
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "ConsoleHandle.h"
 #include "ErrorDumper.h"
+#include "ImageDumpQueue.h"
 #include "ProgramEnvironment.h"
 namespace PokemonAutomation{
 
@@ -27,16 +26,16 @@ std::string dump_image_alone(
     const ProgramInfo& program_info, const std::string& label,
     const ImageViewRGB32& image
 ){
-    static std::mutex lock;
-    std::lock_guard<std::mutex> lg(lock);
-
-    QDir().mkdir(ERROR_PATH().c_str());
-    std::string name = ERROR_PATH() + now_to_filestring();
-    name += "-";
-    name += label;
-    name += ".png";
-    logger.log("Saving failed inference image to: " + name, COLOR_RED);
-    image.save(name);
+    //  Copy the image so the caller is free to release it while the
+    //  background thread is still encoding.
+    std::string name = ImageDumpQueue::instance().dump(
+        logger,
+        ERROR_PATH(), now_to_filestring() + "-" + label,
+        std::make_shared<const ImageRGB32>(image.copy())
+    );
+    if (!name.empty()){
+        logger.log("Saving failed inference image to: " + name, COLOR_RED);
+    }
     return name;
 }
 std::string dump_image(
@@ -19,6 +19,9 @@ class Logger;
 class ProgramEnvironment;
 struct ProgramInfo;
 
+// Queue the image to be saved to ./ErrorDumps/ folder.
+// Return image path, or empty string if the image was dropped. The file is
+// written in the background. Use ImageDumpQueue::instance().wait() before reading it.
 std::string dump_image_alone(
     Logger& logger,
     const ProgramInfo& program_info, const std::string& label,
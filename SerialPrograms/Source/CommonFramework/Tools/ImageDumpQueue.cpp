@@ -0,0 +1,305 @@
+/*  Image Dump Queue
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include "Common/Cpp/PanicDump.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "ImageDumpQueue.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+//  Encode an image as QOI. (https://qoiformat.org/qoi-specification.pdf)
+std::string encode_qoi(const ImageViewRGB32& image){
+    const uint8_t OP_INDEX  = 0x00;
+    const uint8_t OP_DIFF   = 0x40;
+    const uint8_t OP_LUMA   = 0x80;
+    const uint8_t OP_RUN    = 0xc0;
+    const uint8_t OP_RGB    = 0xfe;
+    const uint8_t OP_RGBA   = 0xff;
+
+    size_t width = image.width();
+    size_t height = image.height();
+
+    std::string out;
+    out.reserve(14 + width * height * 4 + 8);
+
+    auto push_u32 = [&](uint32_t x){
+        out += (char)(x >> 24);
+        out += (char)(x >> 16);
+        out += (char)(x >>  8);
+        out += (char)(x >>  0);
+    };
+    out += "qoif";
+    push_u32((uint32_t)width);
+    push_u32((uint32_t)height);
+    out += (char)4;     //  RGBA
+    out += (char)0;     //  sRGB with linear alpha
+
+    uint32_t index[64] = {};
+    uint32_t previous = 0xff000000;
+    size_t run = 0;
+
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            uint32_t pixel = image.pixel(c, r);
+            if (pixel == previous){
+                run++;
+                if (run == 62){
+                    out += (char)(OP_RUN | (run - 1));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0){
+                out += (char)(OP_RUN | (run - 1));
+                run = 0;
+            }
+
+            uint8_t a = (uint8_t)(pixel >> 24);
+            uint8_t red = (uint8_t)(pixel >> 16);
+            uint8_t green = (uint8_t)(pixel >> 8);
+            uint8_t blue = (uint8_t)(pixel >> 0);
+
+            size_t hash = (red * 3 + green * 5 + blue * 7 + a * 11) % 64;
+            if (index[hash] == pixel){
+                out += (char)(OP_INDEX | hash);
+                previous = pixel;
+                continue;
+            }
+            index[hash] = pixel;
+
+            if (a == (uint8_t)(previous >> 24)){
+                int8_t dr = (int8_t)(red - (uint8_t)(previous >> 16));
+                int8_t dg = (int8_t)(green - (uint8_t)(previous >> 8));
+                int8_t db = (int8_t)(blue - (uint8_t)(previous >> 0));
+                int8_t dr_dg = (int8_t)(dr - dg);
+                int8_t db_dg = (int8_t)(db - dg);
+                if (-2 <= dr && dr <= 1 && -2 <= dg && dg <= 1 && -2 <= db && db <= 1){
+                    out += (char)(OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+                }else if (-32 <= dg && dg <= 31 && -8 <= dr_dg && dr_dg <= 7 && -8 <= db_dg && db_dg <= 7){
+                    out += (char)(OP_LUMA | (dg + 32));
+                    out += (char)((dr_dg + 8) << 4 | (db_dg + 8));
+                }else{
+                    out += (char)OP_RGB;
+                    out += (char)red;
+                    out += (char)green;
+                    out += (char)blue;
+                }
+            }else{
+                out += (char)OP_RGBA;
+                out += (char)red;
+                out += (char)green;
+                out += (char)blue;
+                out += (char)a;
+            }
+            previous = pixel;
+        }
+    }
+    if (run > 0){
+        out += (char)(OP_RUN | (run - 1));
+    }
+
+    out.append(7, (char)0);
+    out += (char)1;
+    return out;
+}
+
+}
+
+
+const char* image_dump_extension(ImageDumpFormat format){
+    switch (format){
+    case ImageDumpFormat::QOI:
+        return ".qoi";
+    case ImageDumpFormat::PNG:
+    case ImageDumpFormat::PNG_FAST:
+    default:
+        return ".png";
+    }
+}
+
+
+
+ImageDumpQueue& ImageDumpQueue::instance(){
+    static ImageDumpQueue queue;
+    return queue;
+}
+
+ImageDumpQueue::ImageDumpQueue(size_t threads, size_t max_pending, size_t max_per_minute)
+    : m_max_threads(threads == 0 ? 1 : threads)
+    , m_max_pending(max_pending)
+    , m_max_per_minute(max_per_minute)
+    , m_stopping(false)
+{}
+ImageDumpQueue::~ImageDumpQueue(){
+    //  Normally already done by main().
+    stop();
+}
+void ImageDumpQueue::stop(){
+    //  Finish writing everything that's been queued. The callers were
+    //  already given the paths.
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_stopping = true;
+        m_cv.notify_all();
+        threads = std::move(m_threads);
+        m_threads.clear();
+    }
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+}
+
+std::string ImageDumpQueue::dump(
+    Logger& logger,
+    const std::string& folder, const std::string& name,
+    std::shared_ptr<const ImageRGB32> image,
+    ImageDumpFormat format
+){
+    std::string path = folder + name + image_dump_extension(format);
+    const char* error = nullptr;
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+
+        WallClock now = current_time();
+        WallClock threshold = now - std::chrono::minutes(1);
+        while (!m_recent.empty() && m_recent.front() <= threshold){
+            m_recent.pop_front();
+        }
+
+        if (m_stopping){
+            error = "Image dump suppressed. The program is exiting: ";
+        }else if (m_recent.size() >= m_max_per_minute){
+            error = "Image dump suppressed due to rate limit: ";
+        }else if (m_queue.size() >= m_max_pending){
+            error = "Image dump suppressed. Too many images are waiting to be saved: ";
+        }else{
+            m_recent.push_back(now);
+            m_pending.insert(path);
+            m_queue.emplace_back(Job{path, std::move(image), format});
+            m_cv.notify_one();
+
+            //  Lazy create the threads.
+            if (m_threads.size() < m_max_threads && m_threads.size() < m_pending.size()){
+                m_threads.emplace_back(run_with_catch, "ImageDumpQueue::thread_loop()", [this]{ thread_loop(); });
+            }
+        }
+    }
+    if (error != nullptr){
+        logger.log(error + path, COLOR_RED);
+        return "";
+    }
+    return path;
+}
+
+void ImageDumpQueue::wait(const std::string& path){
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_done.wait(lg, [&]{ return m_pending.find(path) == m_pending.end(); });
+}
+void ImageDumpQueue::wait_all(){
+    std::unique_lock<std::mutex> lg(m_lock);
+    m_done.wait(lg, [&]{ return m_pending.empty(); });
+}
+void ImageDumpQueue::then(const std::string& path, std::function<void()> callback){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        if (m_pending.find(path) != m_pending.end()){
+            m_callbacks.emplace(path, std::move(callback));
+            return;
+        }
+    }
+    callback();
+}
+
+void ImageDumpQueue::thread_loop(){
+    GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread();
+    while (true){
+        Job job;
+        {
+            std::unique_lock<std::mutex> lg(m_lock);
+            m_cv.wait(lg, [&]{ return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()){
+                return;
+            }
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        //  Don't let one bad image take down the thread. Anyone waiting on
+        //  the remaining paths would wait forever.
+        try{
+            save(job);
+        }catch (const std::exception& e){
+            global_logger_tagged().log("Unable to save image to: " + job.path + " (" + e.what() + ")", COLOR_RED);
+        }
+
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lg(m_lock);
+            m_pending.erase(m_pending.find(job.path));
+            if (m_pending.find(job.path) == m_pending.end()){
+                auto range = m_callbacks.equal_range(job.path);
+                for (auto iter = range.first; iter != range.second; ++iter){
+                    callbacks.emplace_back(std::move(iter->second));
+                }
+                m_callbacks.erase(range.first, range.second);
+            }
+            m_done.notify_all();
+        }
+        for (std::function<void()>& callback : callbacks){
+            try{
+                callback();
+            }catch (const std::exception& e){
+                global_logger_tagged().log("Exception after saving image: " + job.path + " (" + e.what() + ")", COLOR_RED);
+            }
+        }
+    }
+}
+
+void ImageDumpQueue::save(const Job& job){
+    if (!job.image || !*job.image){
+        return;
+    }
+
+    QString path = QString::fromStdString(job.path);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    bool ok = false;
+    switch (job.format){
+    case ImageDumpFormat::PNG:
+        ok = job.image->save(job.path);
+        break;
+    case ImageDumpFormat::PNG_FAST:
+        //  Qt maps quality 80 to zlib level 1.
+        ok = job.image->to_QImage_ref().save(path, "PNG", 80);
+        break;
+    case ImageDumpFormat::QOI:{
+        std::string data = encode_qoi(*job.image);
+        QFile file(path);
+        ok = file.open(QIODevice::WriteOnly) &&
+            file.write(data.data(), data.size()) == (qint64)data.size();
+        break;
+    }
+    }
+
+    if (!ok){
+        global_logger_tagged().log("Unable to save image to: " + job.path, COLOR_RED);
+    }
+}
+
+
+
+
+}
@@ -0,0 +1,123 @@
+/*  Image Dump Queue
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Saves error and debug images on background threads.
+ *
+ *  Encoding a full-resolution PNG takes long enough to stall the program
+ *  thread that is asking for it. This queue takes ownership of the image,
+ *  hands back the path right away and does the encoding and disk write on
+ *  its own worker threads.
+ *
+ *  The queue is bounded and rate limited. Once either limit is hit, new
+ *  dumps are dropped (and logged) instead of piling up in memory.
+ *
+ *  Call "stop()" before the program exits so that the workers are finished
+ *  and joined before static destruction starts.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageDumpQueue_H
+#define PokemonAutomation_CommonFramework_ImageDumpQueue_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <set>
+#include <map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+class ImageRGB32;
+class Logger;
+
+
+enum class ImageDumpFormat{
+    PNG,        //  Default PNG compression. Smallest files.
+    PNG_FAST,   //  PNG with the fastest zlib level. Bigger files, much faster to write.
+    QOI,        //  Lossless "Quite OK Image" format. Fastest to write.
+};
+const char* image_dump_extension(ImageDumpFormat format);
+
+
+class ImageDumpQueue{
+public:
+    static ImageDumpQueue& instance();
+
+    ImageDumpQueue(
+        size_t threads = 2,
+        size_t max_pending = 8,
+        size_t max_per_minute = 60
+    );
+    ~ImageDumpQueue();
+
+    //  Queue "image" to be saved to "folder" + "name" + extension.
+    //  The folder is created if it doesn't exist.
+    //  Returns the full path of the file that will be written. The file may
+    //  not exist yet when this returns. Call "wait()" if you need to read it.
+    //  Returns an empty string if the image was dropped.
+    std::string dump(
+        Logger& logger,
+        const std::string& folder, const std::string& name,
+        std::shared_ptr<const ImageRGB32> image,
+        ImageDumpFormat format = ImageDumpFormat::PNG
+    );
+
+    //  Block until the file at "path" has been written. Returns immediately
+    //  if "path" isn't queued.
+    void wait(const std::string& path);
+
+    //  Block until everything that has been queued so far is written.
+    void wait_all();
+
+    //  Run "callback" once the file at "path" has been written. If "path"
+    //  isn't queued, it runs right away on this thread. Otherwise it runs on
+    //  the worker that wrote the file, so it must not need the caller's
+    //  stack or anything the caller owns.
+    void then(const std::string& path, std::function<void()> callback);
+
+    //  Stop taking new images, finish the ones that are queued and join the
+    //  workers. Later dumps are dropped.
+    void stop();
+
+
+private:
+    struct Job{
+        std::string path;
+        std::shared_ptr<const ImageRGB32> image;
+        ImageDumpFormat format;
+    };
+
+    void thread_loop();
+    static void save(const Job& job);
+
+private:
+    const size_t m_max_threads;
+    const size_t m_max_pending;
+    const size_t m_max_per_minute;
+
+    bool m_stopping;
+    std::deque<Job> m_queue;
+    //  Paths that are queued or being written.
+    std::multiset<std::string> m_pending;
+    //  Callbacks to run once their path is no longer pending.
+    std::multimap<std::string, std::function<void()>> m_callbacks;
+    //  Times of the recent dumps for the rate limit.
+    std::deque<WallClock> m_recent;
+
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::condition_variable m_done;
+    std::vector<std::thread> m_threads;
+};
+
+
+
+}
+#endif
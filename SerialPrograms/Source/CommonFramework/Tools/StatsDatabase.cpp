@@ -4,8 +4,13 @@
  *
  */
 
+#include <stdio.h>
+#include <algorithm>
+#include <mutex>
 #include <QFile>
+#include <QFileInfo>
 #include <QSaveFile>
+#include <QLockFile>
 #include "ClientSource/Libraries/Logging.h"
 #include "StatsDatabase.h"
 
@@ -131,11 +136,17 @@ std::string StatSet::to_str() const{
     return str;
 }
 
-void StatSet::save_to_file(const std::string& filepath){
-    QFile file(QString::fromStdString(filepath));
-    file.open(QIODevice::WriteOnly);
+bool StatSet::save_to_file(const std::string& filepath) const{
+    QSaveFile file(QString::fromStdString(filepath));
+    if (!file.open(QIODevice::WriteOnly)){
+        return false;
+    }
     std::string data = to_str();
-    file.write(data.c_str(), data.size());
+    if (file.write(data.c_str(), data.size()) != (qint64)data.size()){
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
 }
 void StatSet::open_from_file(const std::string& filepath){
     QFile file(QString::fromStdString(filepath));
@@ -147,31 +158,6 @@ void StatSet::open_from_file(const std::string& filepath){
     load_from_string(str.c_str());
 }
 
-bool StatSet::update_file(
-    const std::string& filepath,
-    const std::string& identifier,
-    StatsTracker& tracker
-){
-    QFile file(QString::fromStdString(filepath));
-    while (!file.open(QIODevice::ReadWrite)){
-        return false;
-    }
-    std::string data = file.readAll().data();
-
-    StatSet set;
-    set.load_from_string(data.c_str());
-
-    set[identifier] += tracker;
-
-    data = set.to_str();
-    file.seek(0);
-    file.write(data.c_str(), data.size());
-    file.resize(data.size());
-
-    return true;
-}
-
-
 bool StatSet::get_line(std::string& line, const char*& ptr){
     line.clear();
     for (;; ptr++){
@@ -244,5 +230,422 @@ void StatSet::load_from_string(const char* ptr){
 
 
 
+namespace{
+
+//  Merge the journal once it gets this large.
+const qint64 STATS_JOURNAL_COMPACTION_SIZE = 64 * 1024;
+
+std::mutex stats_file_lock;
+
+
+//  A StatsTracker that only keeps the raw counts. Used for the totals in the index.
+class StatCounts : public StatsTracker{
+public:
+    //  Serialize the counts in the same format as a stat line so that they can
+    //  be added to a tracker with "parse_and_append_line()".
+    std::string to_line() const{
+        std::string str;
+        for (const auto& item : m_stats){
+            if (!str.empty()){
+                str += " - ";
+            }
+            str += item.first;
+            str += ": ";
+            str += std::to_string(item.second.load(std::memory_order_relaxed));
+        }
+        return str;
+    }
+};
+
+
+//  One line of the journal: "<sequence number>\t<identifier>\t<stat line>"
+//  Sequence numbers start at 1 and only go up, across merges too.
+struct StatJournalEntry{
+    uint64_t seqnum;
+    std::string identifier;
+    std::string line;
+
+    std::string to_str() const{
+        return std::to_string(seqnum) + "\t" + identifier + "\t" + line;
+    }
+};
+
+struct StatIndex{
+    //  Size and modification time of the stats file that the index was built from.
+    qint64 file_size = -1;
+    qint64 file_time = -1;
+    //  Sequence number of the last journal entry in the stats file.
+    uint64_t last_merged = 0;
+    std::map<std::string, StatCounts> totals;
+};
+
+
+//  The stats file starts with this line (before the first section, which the
+//  parser skips) to record the last journal entry that was merged into it.
+//  It is written together with the entries, so it can't disagree with them.
+const std::string STATS_FILE_MERGED_HEADER = "Merged stats journal up to entry: ";
+
+
+std::string stats_journal_path(const std::string& filepath){
+    return filepath + ".journal";
+}
+std::string stats_index_path(const std::string& filepath){
+    return filepath + ".index";
+}
+
+void stats_file_stamp(const std::string& filepath, qint64& size, qint64& time){
+    QFileInfo info(QString::fromStdString(filepath));
+    if (!info.exists()){
+        size = -1;
+        time = -1;
+        return;
+    }
+    size = info.size();
+    time = info.lastModified().toMSecsSinceEpoch();
+}
+
+bool read_stats_file(const std::string& filepath, std::string& data){
+    QFile file(QString::fromStdString(filepath));
+    if (!file.open(QIODevice::ReadOnly)){
+        return false;
+    }
+    QByteArray bytes = file.readAll();
+    data.assign(bytes.data(), bytes.size());
+    return true;
+}
+
+//  Parse a decimal sequence number. Returns false if "str" isn't one.
+bool parse_seqnum(const std::string& str, uint64_t& seqnum){
+    if (str.empty() || str.size() > 19){
+        return false;
+    }
+    seqnum = 0;
+    for (char ch : str){
+        if (ch < '0' || ch > '9'){
+            return false;
+        }
+        seqnum = seqnum * 10 + (ch - '0');
+    }
+    return true;
+}
+
+//  Returns the last journal entry recorded in the header of the stats file.
+//  0 if there is no stats file or it has no header.
+uint64_t read_stats_file_merged(const std::string& filepath){
+    QFile file(QString::fromStdString(filepath));
+    if (!file.open(QIODevice::ReadOnly)){
+        return 0;
+    }
+    std::string line = file.readLine().toStdString();
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')){
+        line.pop_back();
+    }
+    uint64_t seqnum;
+    if (line.compare(0, STATS_FILE_MERGED_HEADER.size(), STATS_FILE_MERGED_HEADER) != 0 ||
+        !parse_seqnum(line.substr(STATS_FILE_MERGED_HEADER.size()), seqnum)
+    ){
+        return 0;
+    }
+    return seqnum;
+}
+bool save_stats_file(const std::string& filepath, const StatSet& set, uint64_t last_merged){
+    QSaveFile file(QString::fromStdString(filepath));
+    if (!file.open(QIODevice::WriteOnly)){
+        return false;
+    }
+    std::string data = STATS_FILE_MERGED_HEADER + std::to_string(last_merged) + "\r\n\r\n";
+    data += set.to_str();
+    if (file.write(data.c_str(), data.size()) != (qint64)data.size()){
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+//  Split "data" into lines. An unterminated last line is an incomplete write
+//  and is dropped.
+std::vector<std::string> split_complete_lines(const std::string& data){
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (true){
+        size_t end = data.find('\n', start);
+        if (end == std::string::npos){
+            return lines;
+        }
+        size_t stop = end;
+        if (stop > start && data[stop - 1] == '\r'){
+            stop--;
+        }
+        lines.emplace_back(data.substr(start, stop - start));
+        start = end + 1;
+    }
+}
+
+bool parse_stats_journal_line(const std::string& line, StatJournalEntry& entry){
+    size_t pos0 = line.find('\t');
+    if (pos0 == std::string::npos){
+        return false;
+    }
+    size_t pos1 = line.find('\t', pos0 + 1);
+    if (pos1 == std::string::npos){
+        return false;
+    }
+    if (!parse_seqnum(line.substr(0, pos0), entry.seqnum)){
+        return false;
+    }
+    entry.identifier = line.substr(pos0 + 1, pos1 - pos0 - 1);
+    entry.line = line.substr(pos1 + 1);
+    return true;
+}
+std::vector<StatJournalEntry> read_stats_journal(const std::string& filepath){
+    std::vector<StatJournalEntry> entries;
+    std::string data;
+    if (!read_stats_file(stats_journal_path(filepath), data)){
+        return entries;
+    }
+    for (const std::string& line : split_complete_lines(data)){
+        StatJournalEntry entry;
+        if (parse_stats_journal_line(line, entry)){
+            entries.emplace_back(std::move(entry));
+        }
+    }
+    return entries;
+}
+
+bool write_stats_index(const std::string& filepath, const StatIndex& index){
+    std::string data = std::to_string(index.file_size) + " " + std::to_string(index.file_time) + "\n";
+    data += std::to_string(index.last_merged) + "\n";
+    for (const auto& item : index.totals){
+        data += item.first + "\t" + item.second.to_line() + "\n";
+    }
+
+    QSaveFile file(QString::fromStdString(stats_index_path(filepath)));
+    if (!file.open(QIODevice::WriteOnly)){
+        return false;
+    }
+    if (file.write(data.c_str(), data.size()) != (qint64)data.size()){
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+//  Returns false if there is no index or it is out of date.
+bool read_stats_index(const std::string& filepath, StatIndex& index){
+    std::string data;
+    if (!read_stats_file(stats_index_path(filepath), data)){
+        return false;
+    }
+    std::vector<std::string> lines = split_complete_lines(data);
+    if (lines.size() < 2){
+        return false;
+    }
+
+    long long size, time;
+    if (sscanf(lines[0].c_str(), "%lld %lld", &size, &time) != 2){
+        return false;
+    }
+    qint64 current_size, current_time;
+    stats_file_stamp(filepath, current_size, current_time);
+    if (size != current_size || time != current_time){
+        return false;
+    }
+
+    index.file_size = size;
+    index.file_time = time;
+    if (!parse_seqnum(lines[1], index.last_merged)){
+        return false;
+    }
+    for (size_t c = 2; c < lines.size(); c++){
+        size_t pos = lines[c].find('\t');
+        if (pos == std::string::npos){
+            return false;
+        }
+        index.totals[lines[c].substr(0, pos)].parse_and_append_line(lines[c].substr(pos + 1));
+    }
+    return true;
+}
+
+//  Build the index from the stats file itself.
+void rebuild_stats_index(const std::string& filepath, StatIndex& index){
+    stats_file_stamp(filepath, index.file_size, index.file_time);
+    index.last_merged = read_stats_file_merged(filepath);
+
+    StatSet set;
+    set.open_from_file(filepath);
+
+    index.totals.clear();
+    for (const auto& item : set.lists()){
+        if (item.second.size() == 0){
+            continue;
+        }
+        item.second.aggregate(index.totals[item.first]);
+    }
+
+    write_stats_index(filepath, index);
+}
+
+void load_stats_index(const std::string& filepath, StatIndex& index){
+    if (!read_stats_index(filepath, index)){
+        rebuild_stats_index(filepath, index);
+    }
+}
+
+bool compact_stats_file(const std::string& filepath){
+    std::vector<StatJournalEntry> journal = read_stats_journal(filepath);
+    StatIndex index;
+    load_stats_index(filepath, index);
+
+    //  Entries at or below "last_merged" are already in the stats file. The
+    //  program died after the last merge, but before the journal was removed.
+    StatSet set;
+    bool loaded = false;
+    uint64_t last_merged = index.last_merged;
+    for (const StatJournalEntry& entry : journal){
+        if (entry.seqnum <= index.last_merged){
+            continue;
+        }
+        if (!loaded){
+            set.open_from_file(filepath);
+            loaded = true;
+        }
+        set[entry.identifier] += entry.line;
+        index.totals[entry.identifier].parse_and_append_line(StatLine(entry.line).stats());
+        last_merged = std::max(last_merged, entry.seqnum);
+    }
+
+    if (loaded){
+        if (!save_stats_file(filepath, set, last_merged)){
+            return false;
+        }
+        stats_file_stamp(filepath, index.file_size, index.file_time);
+        index.last_merged = last_merged;
+        if (!write_stats_index(filepath, index)){
+            return false;
+        }
+    }
+
+    QFile::remove(QString::fromStdString(stats_journal_path(filepath)));
+    return true;
+}
+
+
+//  The last stats file used by this process.
+std::string current_stats_file;
+
+//  If the stats file has been changed in the settings, merge what's left in
+//  the journal of the old one. Otherwise it would sit there and never be
+//  counted. Must be called with "stats_file_lock" held.
+void switch_stats_file(const std::string& filepath){
+    if (current_stats_file == filepath){
+        return;
+    }
+    std::string previous = std::move(current_stats_file);
+    current_stats_file = filepath;
+    if (previous.empty() || !QFile::exists(QString::fromStdString(stats_journal_path(previous)))){
+        return;
+    }
+    QLockFile lock(QString::fromStdString(previous + ".lock"));
+    if (lock.lock()){
+        compact_stats_file(previous);
+    }
+}
+
+}
+
+
+
+bool StatSet::aggregate_file(
+    const std::string& filepath,
+    const std::string& identifier,
+    StatsTracker& tracker
+){
+    std::lock_guard<std::mutex> lg(stats_file_lock);
+    switch_stats_file(filepath);
+    QLockFile lock(QString::fromStdString(filepath + ".lock"));
+    if (!lock.lock()){
+        return false;
+    }
+
+    std::vector<StatJournalEntry> journal = read_stats_journal(filepath);
+    StatIndex index;
+    load_stats_index(filepath, index);
+
+    auto iter = index.totals.find(identifier);
+    if (iter != index.totals.end()){
+        tracker.parse_and_append_line(iter->second.to_line());
+    }
+    for (const StatJournalEntry& entry : journal){
+        if (entry.seqnum > index.last_merged && entry.identifier == identifier){
+            tracker.parse_and_append_line(StatLine(entry.line).stats());
+        }
+    }
+    return true;
+}
+
+bool StatSet::update_file(
+    const std::string& filepath,
+    const std::string& identifier,
+    StatsTracker& tracker
+){
+    std::lock_guard<std::mutex> lg(stats_file_lock);
+    switch_stats_file(filepath);
+    QLockFile lock(QString::fromStdString(filepath + ".lock"));
+    if (!lock.lock()){
+        return false;
+    }
+
+    QFile file(QString::fromStdString(stats_journal_path(filepath)));
+    if (!file.open(QIODevice::ReadWrite)){
+        return false;
+    }
+
+    //  Drop the partial entry from an interrupted write.
+    QByteArray data = file.readAll();
+    qint64 size = data.lastIndexOf('\n') + 1;
+    if (size != data.size()){
+        if (!file.resize(size)){
+            return false;
+        }
+    }
+
+    //  Number the entry after the last one in the journal, or after the last
+    //  one merged into the stats file if the journal is empty.
+    uint64_t seqnum = read_stats_file_merged(filepath);
+    if (size > 1){
+        qint64 start = data.lastIndexOf('\n', size - 2) + 1;
+        StatJournalEntry last;
+        if (parse_stats_journal_line(std::string(data.data() + start, size - start - 1), last)){
+            seqnum = std::max(seqnum, last.seqnum);
+        }
+    }
+
+    std::string entry = StatJournalEntry{seqnum + 1, identifier, StatLine(tracker).to_str()}.to_str() + "\n";
+    file.seek(file.size());
+    if (file.write(entry.c_str(), entry.size()) != (qint64)entry.size() || !file.flush()){
+        return false;
+    }
+    qint64 journal_size = file.size();
+    file.close();
+
+    //  The entry is already saved. Failing to merge it isn't an error.
+    if (journal_size >= STATS_JOURNAL_COMPACTION_SIZE){
+        compact_stats_file(filepath);
+    }
+
+    return true;
+}
+
+bool StatSet::compact_file(const std::string& filepath){
+    std::lock_guard<std::mutex> lg(stats_file_lock);
+    QLockFile lock(QString::fromStdString(filepath + ".lock"));
+    if (!lock.lock()){
+        return false;
+    }
+    return compact_stats_file(filepath);
+}
+
+
+
 }
 
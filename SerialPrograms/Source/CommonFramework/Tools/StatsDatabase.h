@@ -2,6 +2,27 @@
  *
  *  From: https://github.com/PokemonAutomation/Arduino-Source
  *
+ *  The stats file is only rewritten when it is compacted. New entries are
+ *  appended to "<stats file>.journal" instead. Once the journal gets large
+ *  enough, it is merged into the stats file.
+ *
+ *  Journal entries are numbered. The first line of the stats file records
+ *  the number of the last entry merged into it, so a merge that was cut
+ *  short is never counted twice.
+ *
+ *  "<stats file>.index" caches the totals of every identifier in the stats
+ *  file along with the last journal entry that has been merged into it. So
+ *  loading the historical stats of a program only needs the index and the
+ *  journal. The index is rebuilt if the stats file changes behind our back.
+ *
+ *  The stats file and the index are replaced atomically. If the program dies
+ *  at any point, the next access recovers without losing or double-counting
+ *  any entries. All accesses hold "<stats file>.lock" since several instances
+ *  of the program can share the same stats file.
+ *
+ *  If the stats file is changed in the settings, the journal of the old one
+ *  is merged into it the next time stats are loaded or saved.
+ *
  */
 
 #ifndef PokemonAutomation_StatsDatabase_H
@@ -53,15 +74,29 @@ public:
 
     std::string to_str() const;
 
-    void save_to_file(const std::string& filepath);
+    const std::map<std::string, StatList>& lists() const{ return m_data; }
+
+    bool save_to_file(const std::string& filepath) const;
     void open_from_file(const std::string& filepath);
 
+    //  Add the historical stats of "identifier" to "tracker".
+    //  Returns false if the stats file couldn't be locked.
+    static bool aggregate_file(
+        const std::string& filepath,
+        const std::string& identifier,
+        StatsTracker& tracker
+    );
+
+    //  Append the stats of "tracker" as a new entry of "identifier".
     static bool update_file(
         const std::string& filepath,
         const std::string& identifier,
         StatsTracker& tracker
     );
 
+    //  Merge the journal into the stats file.
+    static bool compact_file(const std::string& filepath);
+
 private:
     bool get_line(std::string& line, const char*& ptr);
     void load_from_string(const char* ptr);
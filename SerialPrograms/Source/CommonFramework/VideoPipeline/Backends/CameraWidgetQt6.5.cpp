@@ -98,7 +98,6 @@ CameraSession::CameraSession(Logger& logger, Resolution default_resolution)
     , m_default_resolution(default_resolution)
     , m_resolution(default_resolution)
     , m_last_frame_seqnum(0)
-    , m_last_image_timestamp(WallClock::min())
     , m_stats_conversion("ConvertFrame", "ms", 1000, std::chrono::seconds(10))
 {}
 
@@ -179,6 +178,60 @@ void CameraSession::report_rendered_frame(WallClock timestamp){
     m_fps_tracker_display.push_event(timestamp);
 }
 
+//  If the frame is already 32-bit BGRA/BGRX, it has the same memory layout
+//  as ImageRGB32. So map it and wrap the mapped memory directly instead of
+//  converting it. The mapped frame is kept alive by the QImage (and thus by
+//  every snapshot that references it) and is unmapped when the last one dies.
+//  Returns a null image if the frame cannot be used this way.
+static void unmap_video_frame(void* info){
+    QVideoFrame* frame = (QVideoFrame*)info;
+    frame->unmap();
+    delete frame;
+}
+static QImage wrap_mapped_frame(const QVideoFrame& frame){
+    QImage::Format format;
+    switch (frame.pixelFormat()){
+    case QVideoFrameFormat::Format_BGRA8888:
+        format = QImage::Format_ARGB32;
+        break;
+    case QVideoFrameFormat::Format_BGRX8888:
+        format = QImage::Format_RGB32;
+        break;
+    default:
+        return QImage();
+    }
+
+    //  toImage() will apply these. We don't.
+    if (frame.rotationAngle() != QVideoFrame::Rotation0 ||
+        frame.mirrored() ||
+        frame.surfaceFormat().scanLineDirection() != QVideoFrameFormat::TopToBottom
+    ){
+        return QImage();
+    }
+
+    std::unique_ptr<QVideoFrame> mapped(new QVideoFrame(frame));
+    if (!mapped->map(QVideoFrame::ReadOnly)){
+        return QImage();
+    }
+
+    QImage image(
+        mapped->bits(0),
+        mapped->width(), mapped->height(),
+        mapped->bytesPerLine(0),
+        format,
+        unmap_video_frame, mapped.get()
+    );
+    if (image.isNull()){
+        mapped->unmap();
+        return QImage();
+    }
+
+    //  Now owned by the QImage.
+    mapped.release();
+    return image;
+}
+
+
 VideoSnapshot CameraSession::snapshot(){
     //  Prevent multiple concurrent screenshots from entering here.
     std::lock_guard<std::mutex> lg(m_lock);
@@ -194,8 +247,8 @@ VideoSnapshot CameraSession::snapshot(){
     {
         SpinLockGuard lg0(m_frame_lock);
         frame_seqnum = m_last_frame_seqnum;
-        if (!m_last_image.isNull() && m_last_image_seqnum == frame_seqnum){
-            return VideoSnapshot(m_last_image, m_last_image_timestamp);
+        if (m_last_snapshot && m_last_image_seqnum == frame_seqnum){
+            return m_last_snapshot;
         }
         frame = m_last_frame;
         frame_timestamp = m_last_frame_timestamp;
@@ -208,20 +261,22 @@ VideoSnapshot CameraSession::snapshot(){
 
     WallClock time0 = current_time();
 
-    QImage image = frame.toImage();
-    QImage::Format format = image.format();
-    if (format != QImage::Format_ARGB32 && format != QImage::Format_RGB32){
-        image = image.convertToFormat(QImage::Format_ARGB32);
+    QImage image = wrap_mapped_frame(frame);
+    if (image.isNull()){
+        image = frame.toImage();
+        QImage::Format format = image.format();
+        if (format != QImage::Format_ARGB32 && format != QImage::Format_RGB32){
+            image.convertTo(QImage::Format_ARGB32);
+        }
     }
 
-    m_last_image = std::move(image);
-    m_last_image_timestamp = frame_timestamp;
+    m_last_snapshot = VideoSnapshot(std::move(image), frame_timestamp);
     m_last_image_seqnum = frame_seqnum;
 
     WallClock time1 = current_time();
     m_stats_conversion.report_data(m_logger, std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count());
 
-    return VideoSnapshot(m_last_image, m_last_image_timestamp);
+    return m_last_snapshot;
 }
 double CameraSession::fps_source(){
     SpinLockGuard lg(m_frame_lock);
@@ -301,8 +356,7 @@ void CameraSession::shutdown(){
     m_last_frame_timestamp = current_time();
     m_last_frame_seqnum++;
 
-    m_last_image = QImage();
-    m_last_image_timestamp = m_last_frame_timestamp;
+    m_last_snapshot.clear();
     m_last_image_seqnum = m_last_frame_seqnum;
 
 }
@@ -0,0 +1,299 @@
+/*  File Video Feed
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include "Common/Cpp/Exceptions.h"
+#include "FileVideoFeed.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+const char RAW_MAGIC[4] = {'P', 'A', 'V', 'R'};
+const uint32_t RAW_VERSION = 1;
+
+struct RawHeader{
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+};
+
+//  Each frame is its timestamp in microseconds followed by the pixels.
+size_t raw_frame_bytes(size_t width, size_t height){
+    return sizeof(int64_t) + width * height * sizeof(uint32_t);
+}
+
+//  Parse the number at the start of "name". Returns false if there isn't one.
+bool parse_leading_number(const std::string& name, uint64_t& number){
+    size_t c = 0;
+    number = 0;
+    while (c < name.size() && '0' <= name[c] && name[c] <= '9'){
+        number = number * 10 + (name[c] - '0');
+        c++;
+    }
+    return c > 0;
+}
+
+}
+
+
+
+FileVideoFeed::FileVideoFeed(
+    const std::string& path,
+    Playback playback,
+    std::chrono::milliseconds default_period
+)
+    : m_playback(playback)
+{
+    QFileInfo info(QString::fromStdString(path));
+    if (info.isDir()){
+        load_directory(path, default_period);
+    }else{
+        load_raw(path);
+    }
+    if (m_times.empty()){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Recording has no frames.", path);
+    }
+    reset();
+}
+FileVideoFeed::~FileVideoFeed() = default;
+
+void FileVideoFeed::load_directory(const std::string& path, std::chrono::milliseconds default_period){
+    QDir dir(QString::fromStdString(path));
+
+    std::ifstream timestamps((path + "/timestamps.txt").c_str());
+    if (timestamps){
+        std::string line;
+        while (std::getline(timestamps, line)){
+            std::istringstream is(line);
+            std::string file;
+            double milliseconds;
+            is >> file >> milliseconds;
+            if (is.fail()){
+                continue;   //  Empty or malformed line. Skip it.
+            }
+            m_files.emplace_back(dir.filePath(QString::fromStdString(file)).toStdString());
+            m_times.emplace_back((int64_t)(milliseconds * 1000));
+        }
+    }else{
+        QStringList filters{"*.png", "*.jpg", "*.jpeg", "*.bmp"};
+        QStringList names = dir.entryList(filters, QDir::Files, QDir::Name);
+
+        std::vector<std::pair<uint64_t, std::string>> frames;
+        bool numbered = true;
+        for (const QString& name : names){
+            uint64_t number = 0;
+            numbered &= parse_leading_number(name.toStdString(), number);
+            frames.emplace_back(number, dir.filePath(name).toStdString());
+        }
+        if (numbered){
+            //  "10.png" comes before "9.png" by name.
+            std::stable_sort(
+                frames.begin(), frames.end(),
+                [](const auto& x, const auto& y){ return x.first < y.first; }
+            );
+        }
+        for (size_t c = 0; c < frames.size(); c++){
+            m_files.emplace_back(std::move(frames[c].second));
+            m_times.emplace_back(
+                numbered
+                    ? std::chrono::microseconds((frames[c].first - frames[0].first) * 1000)
+                    : std::chrono::microseconds(default_period) * (int64_t)c
+            );
+        }
+    }
+
+    //  Timestamps must not go backwards.
+    for (size_t c = 1; c < m_times.size(); c++){
+        m_times[c] = std::max(m_times[c], m_times[c - 1]);
+    }
+    if (!m_times.empty()){
+        std::chrono::microseconds first = m_times[0];
+        for (std::chrono::microseconds& time : m_times){
+            time -= first;
+        }
+    }
+}
+void FileVideoFeed::load_raw(const std::string& path){
+    m_raw.reset(new QFile(QString::fromStdString(path)));
+    if (!m_raw->open(QIODevice::ReadOnly)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open recording.", path);
+    }
+
+    RawHeader header;
+    if (m_raw->read((char*)&header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, RAW_MAGIC, sizeof(RAW_MAGIC)) != 0 ||
+        header.version != RAW_VERSION
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Not a raw video recording.", path);
+    }
+    m_raw_width = header.width;
+    m_raw_height = header.height;
+
+    //  Ignore a partial frame at the end. The recorder may have been killed.
+    size_t frame_bytes = raw_frame_bytes(m_raw_width, m_raw_height);
+    size_t frames = (size_t)(m_raw->size() - sizeof(header)) / frame_bytes;
+    m_times.reserve(frames);
+    for (size_t c = 0; c < frames; c++){
+        int64_t microseconds;
+        if (!m_raw->seek(sizeof(header) + c * frame_bytes) ||
+            m_raw->read((char*)&microseconds, sizeof(microseconds)) != sizeof(microseconds)
+        ){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to read recording.", path);
+        }
+        m_times.emplace_back(microseconds);
+    }
+}
+ImageRGB32 FileVideoFeed::load_frame(size_t index){
+    if (!m_raw){
+        return ImageRGB32(m_files[index]);
+    }
+
+    ImageRGB32 frame(m_raw_width, m_raw_height);
+    size_t row_bytes = m_raw_width * sizeof(uint32_t);
+    m_raw->seek(sizeof(RawHeader) + index * raw_frame_bytes(m_raw_width, m_raw_height) + sizeof(int64_t));
+    for (size_t r = 0; r < m_raw_height; r++){
+        char* row = (char*)frame.data() + r * frame.bytes_per_row();
+        if (m_raw->read(row, row_bytes) != (qint64)row_bytes){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to read recording.", m_raw->fileName().toStdString());
+        }
+    }
+    return frame;
+}
+
+
+
+size_t FileVideoFeed::frame_index(WallClock timestamp) const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    auto time = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - m_base);
+    auto iter = std::upper_bound(m_times.begin(), m_times.end(), time);
+    return iter == m_times.begin() ? 0 : (size_t)(iter - m_times.begin()) - 1;
+}
+void FileVideoFeed::seek(size_t index){
+    std::lock_guard<std::mutex> lg(m_lock);
+    index = std::min(index, m_times.size());
+    m_exhausted = index >= m_times.size();
+    if (m_playback == Playback::REAL_TIME){
+        m_base = current_time() - (m_exhausted ? m_times.back() : m_times[index]);
+    }
+    m_next = index;
+}
+bool FileVideoFeed::exhausted() const{
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_exhausted;
+}
+void FileVideoFeed::reset(){
+    {
+        std::lock_guard<std::mutex> lg(m_lock);
+        m_base = current_time();
+        m_current = (size_t)-1;
+        m_last.clear();
+    }
+    seek(0);
+}
+
+VideoSnapshot FileVideoFeed::snapshot(){
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    size_t index;
+    if (m_playback == Playback::AS_FAST_AS_POSSIBLE){
+        if (m_next >= m_times.size()){
+            m_exhausted = true;
+            return m_last;
+        }
+        index = m_next++;
+    }else{
+        auto time = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - m_base);
+        auto iter = std::upper_bound(m_times.begin(), m_times.end(), time);
+        index = iter == m_times.begin() ? 0 : (size_t)(iter - m_times.begin()) - 1;
+
+        //  The last frame stays up for as long as the average frame.
+        std::chrono::microseconds last_frame = m_times.size() > 1
+            ? m_times.back() / (int64_t)(m_times.size() - 1)
+            : std::chrono::microseconds(0);
+        if (time >= m_times.back() + last_frame && m_current == m_times.size() - 1){
+            m_exhausted = true;
+        }
+        if (index == m_current){
+            return m_last;
+        }
+    }
+
+    m_last = VideoSnapshot(load_frame(index), m_base + m_times[index]);
+    m_current = index;
+    m_display_rate.push_event();
+    return m_last;
+}
+
+double FileVideoFeed::fps_source(){
+    if (m_times.size() < 2 || m_times.back().count() == 0){
+        return 0;
+    }
+    return (double)(m_times.size() - 1) * 1000000 / m_times.back().count();
+}
+double FileVideoFeed::fps_display(){
+    std::lock_guard<std::mutex> lg(m_lock);
+    return m_display_rate.events_per_second();
+}
+
+
+
+RawVideoRecorder::RawVideoRecorder(const std::string& path, size_t width, size_t height)
+    : m_path(path)
+    , m_file(new QFile(QString::fromStdString(path)))
+    , m_width(width)
+    , m_height(height)
+{
+    RawHeader header;
+    memcpy(header.magic, RAW_MAGIC, sizeof(RAW_MAGIC));
+    header.version = RAW_VERSION;
+    header.width = (uint32_t)width;
+    header.height = (uint32_t)height;
+    if (!m_file->open(QIODevice::WriteOnly) ||
+        m_file->write((const char*)&header, sizeof(header)) != sizeof(header)
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to create recording.", m_path);
+    }
+}
+RawVideoRecorder::~RawVideoRecorder() = default;
+
+void RawVideoRecorder::write(const ImageViewRGB32& frame, WallClock timestamp){
+    if (frame.width() != m_width || frame.height() != m_height){
+        throw FileException(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Frame is " + std::to_string(frame.width()) + " x " + std::to_string(frame.height()) +
+            ". Expected " + std::to_string(m_width) + " x " + std::to_string(m_height) + ".",
+            m_path
+        );
+    }
+    if (!m_started){
+        m_start = timestamp;
+        m_started = true;
+    }
+
+    int64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - m_start).count();
+    bool ok = m_file->write((const char*)&microseconds, sizeof(microseconds)) == sizeof(microseconds);
+    size_t row_bytes = m_width * sizeof(uint32_t);
+    for (size_t r = 0; ok && r < m_height; r++){
+        const char* row = (const char*)frame.data() + r * frame.bytes_per_row();
+        ok = m_file->write(row, row_bytes) == (qint64)row_bytes;
+    }
+    if (!ok){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write to recording.", m_path);
+    }
+}
+
+
+
+}
@@ -0,0 +1,144 @@
+/*  File Video Feed
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      A VideoFeed that plays back a recording instead of a live camera.
+ *
+ *  This lets the inference callbacks run on a recorded session without a
+ *  Switch or capture card attached. The recording keeps its original frame
+ *  timing, so the callbacks see the same spacing between frames that they
+ *  saw live.
+ *
+ *  A recording is either:
+ *
+ *    - A directory of frames. The frames are played in file name order.
+ *      If the directory has a "timestamps.txt", each line of it is
+ *      "<file name> <milliseconds>" and only the listed files are played.
+ *      Otherwise, if every file name starts with a number, that number is
+ *      the timestamp in milliseconds. Otherwise, the frames are evenly
+ *      spaced by "default_period".
+ *
+ *    - A raw recording (".pavr") written by RawVideoRecorder.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_FileVideoFeed_H
+#define PokemonAutomation_VideoPipeline_FileVideoFeed_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "Common/Cpp/EventRateTracker.h"
+#include "VideoFeed.h"
+
+class QFile;
+
+namespace PokemonAutomation{
+
+
+class FileVideoFeed : public VideoFeed{
+public:
+    enum class Playback{
+        //  Frames are shown at the time they were recorded. "snapshot()"
+        //  returns the frame that is current at the time of the call.
+        REAL_TIME,
+        //  Every call to "snapshot()" moves on to the next frame. Frames are
+        //  never skipped. Snapshot timestamps still keep the recorded spacing.
+        AS_FAST_AS_POSSIBLE,
+    };
+
+public:
+    //  Throws FileException if the recording can't be opened or is empty.
+    FileVideoFeed(
+        const std::string& path,
+        Playback playback,
+        std::chrono::milliseconds default_period = std::chrono::milliseconds(33)
+    );
+    virtual ~FileVideoFeed();
+
+    Playback playback() const{ return m_playback; }
+
+    size_t frames() const{ return m_times.size(); }
+
+    //  Time of the frame relative to the first frame of the recording.
+    std::chrono::microseconds frame_time(size_t index) const{ return m_times[index]; }
+
+    //  Returns the index of the frame that a snapshot with "timestamp" was taken from.
+    size_t frame_index(WallClock timestamp) const;
+
+    //  Continue playback from frame "index".
+    void seek(size_t index);
+
+    //  Returns true once the whole recording has been played. That is, the
+    //  last frame was returned by "snapshot()" and someone has asked for
+    //  another one since.
+    bool exhausted() const;
+
+    //  Start over from the first frame.
+    virtual void reset() override;
+
+    virtual VideoSnapshot snapshot() override;
+
+    //  Frame rate of the recording.
+    virtual double fps_source() override;
+    //  Rate at which new frames are actually being returned by "snapshot()".
+    virtual double fps_display() override;
+
+
+private:
+    void load_directory(const std::string& path, std::chrono::milliseconds default_period);
+    void load_raw(const std::string& path);
+    ImageRGB32 load_frame(size_t index);
+
+private:
+    const Playback m_playback;
+
+    std::vector<std::chrono::microseconds> m_times;
+
+    //  Directory recordings.
+    std::vector<std::string> m_files;
+
+    //  Raw recordings.
+    std::unique_ptr<QFile> m_raw;
+    size_t m_raw_width = 0;
+    size_t m_raw_height = 0;
+
+    mutable std::mutex m_lock;
+    //  Timestamp of the first frame of the recording.
+    WallClock m_base;
+    //  The next frame to return for AS_FAST_AS_POSSIBLE.
+    size_t m_next = 0;
+    bool m_exhausted = false;
+
+    size_t m_current = (size_t)-1;
+    VideoSnapshot m_last;
+    EventRateTracker m_display_rate;
+};
+
+
+
+//  Record frames to a raw recording that can be played back with FileVideoFeed.
+//  All frames must have the same dimensions.
+class RawVideoRecorder{
+public:
+    //  Throws FileException if the file can't be created.
+    RawVideoRecorder(const std::string& path, size_t width, size_t height);
+    ~RawVideoRecorder();
+
+    //  Throws FileException if the frame has the wrong dimensions or can't be written.
+    void write(const ImageViewRGB32& frame, WallClock timestamp);
+
+private:
+    std::string m_path;
+    std::unique_ptr<QFile> m_file;
+    size_t m_width;
+    size_t m_height;
+    WallClock m_start;
+    bool m_started = false;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,45 @@
+/*  Serial Connection Stats
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/PrettyPrint.h"
+#include "ClientSource/Connection/RttEstimator.h"
+#include "CommonFramework/Tools/BotBaseHandle.h"
+#include "SerialConnectionStats.h"
+
+namespace PokemonAutomation{
+
+
+SerialConnectionStat::SerialConnectionStat(BotBaseHandle& botbase)
+    : m_botbase(botbase)
+    , m_last_retransmits(0)
+{}
+
+OverlayStatSnapshot SerialConnectionStat::get_current(){
+    std::lock_guard<std::mutex> lg(m_lock);
+
+    RttStats stats;
+    if (!m_botbase.try_get_rtt_stats(stats) || stats.samples == 0){
+        return OverlayStatSnapshot{"Serial RTT: ---"};
+    }
+
+    auto ms = [](std::chrono::microseconds x){
+        return tostr_fixed(x.count() / 1000., 1);
+    };
+
+    //  Highlight it while the connection is retransmitting.
+    Color color = stats.retransmits > m_last_retransmits ? COLOR_ORANGE : COLOR_WHITE;
+    m_last_retransmits = stats.retransmits;
+
+    return OverlayStatSnapshot{
+        "Serial RTT: " + ms(stats.srtt) + " ms, p99: " + ms(stats.p99) +
+        " ms, RTO: " + ms(stats.rto) + " ms, Retransmits: " + std::to_string(stats.retransmits),
+        color
+    };
+}
+
+
+
+}
@@ -0,0 +1,34 @@
+/*  Serial Connection Stats
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_SerialConnectionStats_H
+#define PokemonAutomation_SerialConnectionStats_H
+
+#include <mutex>
+#include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
+
+namespace PokemonAutomation{
+
+class BotBaseHandle;
+
+
+class SerialConnectionStat : public OverlayStat{
+public:
+    SerialConnectionStat(BotBaseHandle& botbase);
+
+    virtual OverlayStatSnapshot get_current() override;
+
+private:
+    BotBaseHandle& m_botbase;
+
+    std::mutex m_lock;
+    uint64_t m_last_retransmits;
+};
+
+
+
+}
+#endif
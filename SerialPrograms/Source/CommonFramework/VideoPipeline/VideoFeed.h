@@ -10,6 +10,7 @@
 #include <memory>
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImagePyramid.h"
 
 namespace PokemonAutomation{
 
@@ -22,6 +23,10 @@ struct VideoSnapshot{
     //  This will be as close as possible to when the frame was taken.
     WallClock timestamp = WallClock::min();
 
+    //  Downscaled copies of the frame. Shared by all copies of this snapshot
+    //  so that each level is built at most once per frame.
+    std::shared_ptr<ImagePyramidRGB32> pyramid;
+
     VideoSnapshot()
          : frame(std::make_shared<const ImageRGB32>())
          , timestamp(WallClock::min())
@@ -29,6 +34,7 @@ struct VideoSnapshot{
     VideoSnapshot(ImageRGB32 p_frame, WallClock p_timestamp)
          : frame(std::make_shared<const ImageRGB32>(std::move(p_frame)))
          , timestamp(p_timestamp)
+         , pyramid(std::make_shared<ImagePyramidRGB32>(frame))
     {}
 
     //  Returns true if the snapshot is valid.
@@ -39,8 +45,22 @@ struct VideoSnapshot{
     operator std::shared_ptr<const ImageRGB32>() const{ return frame; }
     operator ImageViewRGB32() const{ return *frame; }
 
+    //  Return the frame downscaled by 2^level in each dimension. (level 0 is the
+    //  frame itself) Use this for checks that look at the whole frame and don't
+    //  need full resolution. Thread-safe.
+    ImageViewRGB32 downscaled(size_t level) const{
+        if (pyramid){
+            return pyramid->level(level);
+        }
+        if (frame){
+            return *frame;
+        }
+        return ImageViewRGB32();
+    }
+
     void clear(){
         frame.reset();
+        pyramid.reset();
         timestamp = WallClock::min();
     }
 };
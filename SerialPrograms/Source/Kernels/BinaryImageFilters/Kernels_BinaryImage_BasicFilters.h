@@ -79,6 +79,18 @@ void compress_rgb32_to_binary_range(
 
 
 
+//  Same as the single-filter `compress_rgb32_to_binary_range()`, but the ranges
+//  are applied to the HSV32 of each pixel. (see Kernels/ImageHSV/Kernels_ImageHSV.h)
+//  `mins` and `maxs` are packed the same way as an HSV32 pixel: alpha, H, S, V.
+//  If the min hue is larger than the max hue, the hue range wraps around.
+//  e.g. H in [240, 15] accepts reds on both sides of H = 0.
+void compress_rgb32_to_binary_hsv_range(
+    const uint32_t* image, size_t bytes_per_row,
+    PackedBinaryMatrix_IB& matrix,
+    uint32_t mins, uint32_t maxs
+);
+
+
 
 //  Compress (image, bytes_per_row) into a binary_image.
 //  For each pixel, set to 1 if the Euclidean distance of the pixel color to the expected color <= max distance.
@@ -8,6 +8,7 @@
 
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix_Arch_64x8_arm64_NEON.h"
 #include "Kernels_BinaryImage_BasicFilters_Routines.h"
+#include "Kernels_BinaryImage_BasicFilters_Default.h"
 #include "Kernels_BinaryImage_BasicFilters_arm64_NEON.h"
 
 namespace PokemonAutomation{
@@ -44,6 +45,19 @@ void compress_rgb32_to_binary_range_64x8_arm64_NEON(
 }
 
 
+void compress_rgb32_to_binary_hsv_range_64x8_arm64_NEON(
+    const uint32_t* image, size_t bytes_per_row,
+    PackedBinaryMatrix_IB& matrix, uint32_t mins, uint32_t maxs
+){
+    Compressor_HsvRange_Default compressor(mins, maxs);
+    compress_rgb32_to_binary(
+        image, bytes_per_row,
+        static_cast<PackedBinaryMatrix_64x8_arm64_NEON&>(matrix).get(), compressor
+    );
+}
+
+
+
 void compress_rgb32_to_binary_euclidean_64x8_arm64_NEON(
     const uint32_t* image, size_t bytes_per_row,
     PackedBinaryMatrix_IB& matrix,
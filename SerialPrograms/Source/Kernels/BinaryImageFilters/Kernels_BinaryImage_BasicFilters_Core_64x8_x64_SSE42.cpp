@@ -47,6 +47,19 @@ void compress_rgb32_to_binary_range_64x8_x64_SSE42(
 
 
 
+void compress_rgb32_to_binary_hsv_range_64x8_x64_SSE42(
+    const uint32_t* image, size_t bytes_per_row,
+    PackedBinaryMatrix_IB& matrix, uint32_t mins, uint32_t maxs
+){
+    Compressor_HsvRange_x64_SSE41 compressor(mins, maxs);
+    compress_rgb32_to_binary(
+        image, bytes_per_row,
+        static_cast<PackedBinaryMatrix_64x8_x64_SSE42&>(matrix).get(), compressor
+    );
+}
+
+
+
 void compress_rgb32_to_binary_euclidean_64x8_x64_SSE42(
     const uint32_t* image, size_t bytes_per_row,
     PackedBinaryMatrix_IB& matrix,
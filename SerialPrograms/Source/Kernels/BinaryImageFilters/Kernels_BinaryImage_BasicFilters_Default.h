@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <cstddef>
 #include "Common/Compiler.h"
+#include "Kernels/ImageHSV/Kernels_ImageHSV_Default.h"
 
 #include <iostream>
 using std::cout;
@@ -110,6 +111,35 @@ private:
 
 
 
+//  Same as Compressor_RgbRange_Default, but on the HSV32 of each pixel.
+//  (see Kernels_ImageHSV_Default.h) The hue range wraps around if the min
+//  hue is larger than the max hue.
+class Compressor_HsvRange_Default{
+public:
+    Compressor_HsvRange_Default(uint32_t mins, uint32_t maxs)
+        : m_min_hue(mins & 0x00ff0000)
+        , m_range(
+            mins & 0xff00ffff,
+            (maxs & 0xff00ffff) | ((maxs - m_min_hue) & 0x00ff0000)
+        )
+    {}
+
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels, size_t count = 64) const{
+        uint32_t hsv[64];
+        for (size_t c = 0; c < count; c++){
+            uint32_t pixel = rgb32_to_hsv32_Default(pixels[c]);
+            hsv[c] = (pixel & 0xff00ffff) | ((pixel - m_min_hue) & 0x00ff0000);
+        }
+        return m_range.convert64(hsv, count);
+    }
+
+private:
+    uint32_t m_min_hue;
+    Compressor_RgbRange_Default m_range;
+};
+
+
+
 class Compressor_RgbEuclidean_Default{
 public:
     Compressor_RgbEuclidean_Default(uint32_t expected, double max_euclidean_distance)
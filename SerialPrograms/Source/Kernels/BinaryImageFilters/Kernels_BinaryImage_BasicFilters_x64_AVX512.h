@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <immintrin.h>
 #include "Common/Compiler.h"
+#include "Kernels/ImageHSV/Kernels_ImageHSV_x64_AVX512.h"
 
 //#include <iostream>
 //using std::cout;
@@ -116,6 +117,61 @@ private:
 
 
 
+//  Same as Compressor_RgbRange_x64_AVX512, but on the HSV32 of each pixel.
+class Compressor_HsvRange_x64_AVX512{
+public:
+    Compressor_HsvRange_x64_AVX512(uint32_t mins, uint32_t maxs)
+        : m_min_hue(_mm512_set1_epi32(mins & 0x00ff0000))
+        , m_mins(_mm512_set1_epi32(mins & 0xff00ffff))
+        , m_maxs(_mm512_set1_epi32((maxs & 0xff00ffff) | ((maxs - (mins & 0x00ff0000)) & 0x00ff0000)))
+    {}
+
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels) const{
+        uint64_t bits = 0;
+        bits |= convert16(_mm512_loadu_si512((const __m512i*)(pixels +  0))) <<  0;
+        bits |= convert16(_mm512_loadu_si512((const __m512i*)(pixels + 16))) << 16;
+        bits |= convert16(_mm512_loadu_si512((const __m512i*)(pixels + 32))) << 32;
+        bits |= convert16(_mm512_loadu_si512((const __m512i*)(pixels + 48))) << 48;
+        return bits;
+    }
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels, size_t count) const{
+        uint64_t bits = 0;
+        size_t c = 0;
+        size_t lc = count / 16;
+        while (lc--){
+            __m512i pixel = _mm512_loadu_si512((const __m512i*)pixels);
+            bits |= convert16(pixel) << c;
+            pixels += 16;
+            c += 16;
+        }
+        count %= 16;
+        if (count){
+            uint64_t mask = ((uint64_t)1 << count) - 1;
+            __m512i pixel = _mm512_maskz_loadu_epi32((__mmask16)mask, pixels);
+            bits |= (convert16(pixel) & mask) << c;
+        }
+        return bits;
+    }
+
+private:
+    PA_FORCE_INLINE uint64_t convert16(__m512i pixel) const{
+        pixel = rgb32_to_hsv32_x64_AVX512(pixel);
+        pixel = _mm512_sub_epi8(pixel, m_min_hue);
+        __mmask64 cmp64A = _mm512_cmple_epu8_mask(m_mins, pixel);
+        __mmask64 cmp64B = _mm512_mask_cmple_epu8_mask(cmp64A, pixel, m_maxs);
+        pixel = _mm512_movm_epi8(cmp64B);
+        __mmask16 cmp16 = _mm512_cmpeq_epi32_mask(pixel, _mm512_set1_epi32(-1));
+        return cmp16;
+    }
+
+private:
+    __m512i m_min_hue;
+    __m512i m_mins;
+    __m512i m_maxs;
+};
+
+
+
 class Compressor_RgbEuclidean_x64_AVX512{
 public:
     Compressor_RgbEuclidean_x64_AVX512(uint32_t expected, double max_euclidean_distance)
@@ -0,0 +1,67 @@
+/*  Image Downscale
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageDownscale.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void downscale_half_Default(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+);
+void downscale_half_x64_SSE41(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+);
+void downscale_half_x64_AVX2(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+);
+void downscale_half_x64_AVX512(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+);
+
+
+
+void downscale_half(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        downscale_half_x64_AVX512(out, out_bytes_per_row, in, in_bytes_per_row, out_width, out_height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        downscale_half_x64_AVX2(out, out_bytes_per_row, in, in_bytes_per_row, out_width, out_height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        downscale_half_x64_SSE41(out, out_bytes_per_row, in, in_bytes_per_row, out_width, out_height);
+        return;
+    }
+#endif
+    downscale_half_Default(out, out_bytes_per_row, in, in_bytes_per_row, out_width, out_height);
+}
+
+
+
+
+}
+}
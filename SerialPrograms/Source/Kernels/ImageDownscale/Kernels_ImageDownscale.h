@@ -0,0 +1,31 @@
+/*  Image Downscale
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageDownscale_H
+#define PokemonAutomation_Kernels_ImageDownscale_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Downscale an image by 2 in each dimension using a 2x2 box filter.
+//  Each output pixel is the rounded average of the corresponding 2x2 block of
+//  input pixels. All 4 channels (including alpha) are averaged independently.
+//  The input must be at least (2 * out_width) x (2 * out_height).
+//  The result is bit-exact across all instruction sets.
+void downscale_half(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+);
+
+
+}
+}
+#endif
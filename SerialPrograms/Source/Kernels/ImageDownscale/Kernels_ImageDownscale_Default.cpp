@@ -0,0 +1,36 @@
+/*  Image Downscale (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Kernels_ImageDownscale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void downscale_half_Default(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+){
+    if (out_width == 0 || out_height == 0){
+        return;
+    }
+    for (size_t r = 0; r < out_height; r++){
+        const uint32_t* in0 = in;
+        const uint32_t* in1 = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        downscale_half_row_Default(out, in0, in1, out_width);
+        in = (const uint32_t*)((const char*)in + 2 * in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+
+}
+}
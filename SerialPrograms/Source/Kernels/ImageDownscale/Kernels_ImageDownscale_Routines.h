@@ -0,0 +1,39 @@
+/*  Image Downscale
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageDownscale_Routines_H
+#define PokemonAutomation_Kernels_ImageDownscale_Routines_H
+
+#include <stdint.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Rounded average of 4 pixels. Each channel is done independently.
+//  Even and odd channels are split into 16-bit fields so nothing overflows.
+PA_FORCE_INLINE uint32_t average_4_pixels(uint32_t a, uint32_t b, uint32_t c, uint32_t d){
+    const uint32_t MASK = 0x00ff00ff;
+    uint32_t even = (a & MASK) + (b & MASK) + (c & MASK) + (d & MASK) + 0x00020002;
+    uint32_t odd = ((a >> 8) & MASK) + ((b >> 8) & MASK) + ((c >> 8) & MASK) + ((d >> 8) & MASK) + 0x00020002;
+    return ((even >> 2) & MASK) | (((odd >> 2) & MASK) << 8);
+}
+
+//  Downscale one pair of input rows into "out_width" output pixels.
+PA_FORCE_INLINE void downscale_half_row_Default(
+    uint32_t* out, const uint32_t* in0, const uint32_t* in1,
+    size_t out_width
+){
+    for (size_t c = 0; c < out_width; c++){
+        out[c] = average_4_pixels(in0[2*c + 0], in0[2*c + 1], in1[2*c + 0], in1[2*c + 1]);
+    }
+}
+
+
+}
+}
+#endif
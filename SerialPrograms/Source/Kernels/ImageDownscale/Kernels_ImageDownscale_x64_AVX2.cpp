@@ -0,0 +1,75 @@
+/*  Image Downscale (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <stdint.h>
+#include <stddef.h>
+#include <immintrin.h>
+#include "Kernels_ImageDownscale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Take 8 pixels from each of 2 rows. Return the 4 averaged pixels as 16 x uint16.
+//  Output pixels are in order: [0, 1 | 2, 3] (one pair per 128-bit lane)
+PA_FORCE_INLINE __m256i downscale_half_x64_AVX2(__m256i r0, __m256i r1){
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(r0, zero), _mm256_unpacklo_epi8(r1, zero));
+    __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(r0, zero), _mm256_unpackhi_epi8(r1, zero));
+    lo = _mm256_add_epi16(lo, _mm256_srli_si256(lo, 8));
+    hi = _mm256_add_epi16(hi, _mm256_srli_si256(hi, 8));
+    __m256i sum = _mm256_unpacklo_epi64(lo, hi);
+    sum = _mm256_add_epi16(sum, _mm256_set1_epi16(2));
+    return _mm256_srli_epi16(sum, 2);
+}
+PA_FORCE_INLINE void downscale_half_row_x64_AVX2(
+    uint32_t* out, const uint32_t* in0, const uint32_t* in1, size_t out_width
+){
+    size_t lc = out_width / 8;
+    for (size_t c = 0; c < lc; c++){
+        __m256i a = downscale_half_x64_AVX2(
+            _mm256_loadu_si256((const __m256i*)(in0 + 0)),
+            _mm256_loadu_si256((const __m256i*)(in1 + 0))
+        );
+        __m256i b = downscale_half_x64_AVX2(
+            _mm256_loadu_si256((const __m256i*)(in0 + 8)),
+            _mm256_loadu_si256((const __m256i*)(in1 + 8))
+        );
+
+        //  Pixel pairs are now ordered: [01, 45, 23, 67]
+        __m256i pixels = _mm256_packus_epi16(a, b);
+        pixels = _mm256_permute4x64_epi64(pixels, 216);
+        _mm256_storeu_si256((__m256i*)out, pixels);
+        in0 += 16;
+        in1 += 16;
+        out += 8;
+    }
+    downscale_half_row_Default(out, in0, in1, out_width % 8);
+}
+void downscale_half_x64_AVX2(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+){
+    if (out_width == 0 || out_height == 0){
+        return;
+    }
+    for (size_t r = 0; r < out_height; r++){
+        const uint32_t* in0 = in;
+        const uint32_t* in1 = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        downscale_half_row_x64_AVX2(out, in0, in1, out_width);
+        in = (const uint32_t*)((const char*)in + 2 * in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,76 @@
+/*  Image Downscale (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <stdint.h>
+#include <stddef.h>
+#include <immintrin.h>
+#include "Kernels_ImageDownscale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Take 16 pixels from each of 2 rows. Return the 8 averaged pixels as 32 x uint16.
+//  Each 128-bit lane holds one pair of output pixels.
+PA_FORCE_INLINE __m512i downscale_half_x64_AVX512(__m512i r0, __m512i r1){
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i lo = _mm512_add_epi16(_mm512_unpacklo_epi8(r0, zero), _mm512_unpacklo_epi8(r1, zero));
+    __m512i hi = _mm512_add_epi16(_mm512_unpackhi_epi8(r0, zero), _mm512_unpackhi_epi8(r1, zero));
+    lo = _mm512_add_epi16(lo, _mm512_bsrli_epi128(lo, 8));
+    hi = _mm512_add_epi16(hi, _mm512_bsrli_epi128(hi, 8));
+    __m512i sum = _mm512_unpacklo_epi64(lo, hi);
+    sum = _mm512_add_epi16(sum, _mm512_set1_epi16(2));
+    return _mm512_srli_epi16(sum, 2);
+}
+PA_FORCE_INLINE void downscale_half_row_x64_AVX512(
+    uint32_t* out, const uint32_t* in0, const uint32_t* in1, size_t out_width
+){
+    //  Pixel pairs after packing are ordered: [01, 89, 23, AB, 45, CD, 67, EF]
+    const __m512i PERMUTE = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+
+    size_t lc = out_width / 16;
+    for (size_t c = 0; c < lc; c++){
+        __m512i a = downscale_half_x64_AVX512(
+            _mm512_loadu_si512((const __m512i*)(in0 + 0)),
+            _mm512_loadu_si512((const __m512i*)(in1 + 0))
+        );
+        __m512i b = downscale_half_x64_AVX512(
+            _mm512_loadu_si512((const __m512i*)(in0 + 16)),
+            _mm512_loadu_si512((const __m512i*)(in1 + 16))
+        );
+        __m512i pixels = _mm512_packus_epi16(a, b);
+        pixels = _mm512_permutexvar_epi64(PERMUTE, pixels);
+        _mm512_storeu_si512((__m512i*)out, pixels);
+        in0 += 32;
+        in1 += 32;
+        out += 16;
+    }
+    downscale_half_row_Default(out, in0, in1, out_width % 16);
+}
+void downscale_half_x64_AVX512(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+){
+    if (out_width == 0 || out_height == 0){
+        return;
+    }
+    for (size_t r = 0; r < out_height; r++){
+        const uint32_t* in0 = in;
+        const uint32_t* in1 = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        downscale_half_row_x64_AVX512(out, in0, in1, out_width);
+        in = (const uint32_t*)((const char*)in + 2 * in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
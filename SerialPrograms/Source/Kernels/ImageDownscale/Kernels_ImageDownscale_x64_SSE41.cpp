@@ -0,0 +1,70 @@
+/*  Image Downscale (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <stdint.h>
+#include <stddef.h>
+#include <smmintrin.h>
+#include "Kernels_ImageDownscale_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Take 4 pixels from each of 2 rows. Return the 2 averaged pixels as 8 x uint16.
+PA_FORCE_INLINE __m128i downscale_half_x64_SSE41(__m128i r0, __m128i r1){
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r1, zero));
+    __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r1, zero));
+    lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+    hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+    __m128i sum = _mm_unpacklo_epi64(lo, hi);
+    sum = _mm_add_epi16(sum, _mm_set1_epi16(2));
+    return _mm_srli_epi16(sum, 2);
+}
+PA_FORCE_INLINE void downscale_half_row_x64_SSE41(
+    uint32_t* out, const uint32_t* in0, const uint32_t* in1, size_t out_width
+){
+    size_t lc = out_width / 4;
+    for (size_t c = 0; c < lc; c++){
+        __m128i a = downscale_half_x64_SSE41(
+            _mm_loadu_si128((const __m128i*)(in0 + 0)),
+            _mm_loadu_si128((const __m128i*)(in1 + 0))
+        );
+        __m128i b = downscale_half_x64_SSE41(
+            _mm_loadu_si128((const __m128i*)(in0 + 4)),
+            _mm_loadu_si128((const __m128i*)(in1 + 4))
+        );
+        _mm_storeu_si128((__m128i*)out, _mm_packus_epi16(a, b));
+        in0 += 8;
+        in1 += 8;
+        out += 4;
+    }
+    downscale_half_row_Default(out, in0, in1, out_width % 4);
+}
+void downscale_half_x64_SSE41(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t out_width, size_t out_height
+){
+    if (out_width == 0 || out_height == 0){
+        return;
+    }
+    for (size_t r = 0; r < out_height; r++){
+        const uint32_t* in0 = in;
+        const uint32_t* in1 = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        downscale_half_row_x64_SSE41(out, in0, in1, out_width);
+        in = (const uint32_t*)((const char*)in + 2 * in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
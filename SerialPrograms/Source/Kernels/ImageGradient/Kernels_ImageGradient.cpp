@@ -0,0 +1,109 @@
+/*  Image Gradient
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageGradient.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void sobel_gradient_rgb32_Default(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void sobel_gradient_rgb32_x64_SSE41(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void sobel_gradient_rgb32_x64_AVX2(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+
+void sobel_gradient_rgb32(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        sobel_gradient_rgb32_x64_AVX2(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        sobel_gradient_rgb32_x64_SSE41(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+        return;
+    }
+#endif
+    sobel_gradient_rgb32_Default(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+}
+
+
+
+double gradient_block_match_rgb32_Default(
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    size_t max_offset, size_t block_radius
+);
+double gradient_block_match_rgb32_x64_SSE41(
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    size_t max_offset, size_t block_radius
+);
+double gradient_block_match_rgb32_x64_AVX2(
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    size_t max_offset, size_t block_radius
+);
+
+double gradient_block_match_rgb32(
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    size_t max_offset, size_t block_radius
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return gradient_block_match_rgb32_x64_AVX2(
+            query, query_bytes_per_row, query_width, query_height,
+            templ, templ_bytes_per_row, templ_width, templ_height,
+            max_offset, block_radius
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return gradient_block_match_rgb32_x64_SSE41(
+            query, query_bytes_per_row, query_width, query_height,
+            templ, templ_bytes_per_row, templ_width, templ_height,
+            max_offset, block_radius
+        );
+    }
+#endif
+    return gradient_block_match_rgb32_Default(
+        query, query_bytes_per_row, query_width, query_height,
+        templ, templ_bytes_per_row, templ_width, templ_height,
+        max_offset, block_radius
+    );
+}
+
+
+
+}
+}
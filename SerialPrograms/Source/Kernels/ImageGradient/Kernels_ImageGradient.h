@@ -0,0 +1,64 @@
+/*  Image Gradient
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Sobel gradients of RGB32 images and shifted matching of gradient images.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageGradient_H
+#define PokemonAutomation_Kernels_ImageGradient_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Output pixel of sobel_gradient_rgb32() for pixels that have no gradient.
+const uint32_t SOBEL_GRADIENT_NONE = 0x80008000;
+
+
+//  3x3 Sobel filter over (in, in_bytes_per_row), summed over the R, G, B channels.
+//
+//  Each output pixel packs two int16_t: gx in the lower half and gy in the
+//  upper half. gx is positive when the image gets brighter to the right.
+//  gy is positive when the image gets brighter towards the top.
+//
+//  Pixels on the image border and pixels with any pixel of alpha < 128 in
+//  their 3x3 window are set to SOBEL_GRADIENT_NONE.
+//
+//  "in" and "out" must not overlap.
+void sobel_gradient_rgb32(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+
+
+//  Compare two gradient images where each pixel is (|gx| << 16) | (|gy| << 8)
+//  and pixels with alpha < 128 have no gradient.
+//
+//  For every query pixel that has a gradient, take the square block of
+//  radius "block_radius" around it. Shift the template by every offset in
+//  [-max_offset, max_offset] on both axes and take the lowest mean pixel
+//  distance over the block. Return the mean of these over the query pixels.
+//
+//  The distance between two pixels is:
+//      (max(gx0, gx1) * (gx0 - gx1)^2 + max(gy0, gy1) * (gy0 - gy1)^2) / 255
+//
+//  Only pixels that have a gradient in both images are part of a block.
+//  Returns NaN if no query pixel has any such block.
+double gradient_block_match_rgb32(
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    size_t max_offset, size_t block_radius
+);
+
+
+}
+}
+#endif
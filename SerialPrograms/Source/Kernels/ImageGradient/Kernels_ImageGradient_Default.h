@@ -0,0 +1,90 @@
+/*  Image Gradient (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageGradient_Default_H
+#define PokemonAutomation_Kernels_ImageGradient_Default_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <algorithm>
+#include "Common/Compiler.h"
+#include "Kernels_ImageGradient.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Sobel at column "x" of "row1". "row0" and "row2" are the rows above and below.
+//  The filter is linear so it is done once on R + G + B instead of per channel.
+PA_FORCE_INLINE uint32_t sobel_gradient_rgb32_Default(
+    const uint32_t* row0, const uint32_t* row1, const uint32_t* row2, size_t x
+){
+    //  Alpha >= 128 on all 9 pixels <=> the top bit of all 9 pixels is set.
+    uint32_t opaque =
+        row0[x - 1] & row0[x] & row0[x + 1] &
+        row1[x - 1] & row1[x] & row1[x + 1] &
+        row2[x - 1] & row2[x] & row2[x + 1];
+    if ((int32_t)opaque >= 0){
+        return SOBEL_GRADIENT_NONE;
+    }
+
+    auto sum = [](uint32_t pixel){
+        return (int)((pixel >> 16) & 0xff) + (int)((pixel >> 8) & 0xff) + (int)(pixel & 0xff);
+    };
+    int s00 = sum(row0[x - 1]), s01 = sum(row0[x]), s02 = sum(row0[x + 1]);
+    int s10 = sum(row1[x - 1]),                     s12 = sum(row1[x + 1]);
+    int s20 = sum(row2[x - 1]), s21 = sum(row2[x]), s22 = sum(row2[x + 1]);
+
+    int gx = (s02 - s00) + 2*(s12 - s10) + (s22 - s20);
+    int gy = (s00 + 2*s01 + s02) - (s20 + 2*s21 + s22);
+    return ((uint32_t)gy << 16) | ((uint32_t)gx & 0xffff);
+}
+class SobelRgb32_Default{
+public:
+    //  Fill out[1] to out[width - 2].
+    PA_FORCE_INLINE void row(
+        uint32_t* out,
+        const uint32_t* row0, const uint32_t* row1, const uint32_t* row2,
+        size_t width
+    ) const{
+        for (size_t x = 1; x + 1 < width; x++){
+            out[x] = sobel_gradient_rgb32_Default(row0, row1, row2, x);
+        }
+    }
+};
+
+
+//  Pixel distance of gradient_block_match_rgb32() without the "/ 255".
+//  Fits in 26 bits.
+PA_FORCE_INLINE uint32_t gradient_distance_Default(uint32_t query, uint32_t templ){
+    int qx = (query >> 16) & 0xff;
+    int qy = (query >>  8) & 0xff;
+    int tx = (templ >> 16) & 0xff;
+    int ty = (templ >>  8) & 0xff;
+    return (uint32_t)(std::max(qx, tx) * (qx - tx) * (qx - tx) + std::max(qy, ty) * (qy - ty) * (qy - ty));
+}
+class GradientDistance_Default{
+public:
+    //  dist[x] = distance between query[x] and templ[x], count[x] = 1
+    //  if both pixels have a gradient. Otherwise both are 0.
+    PA_FORCE_INLINE void row(
+        uint32_t* dist, uint32_t* count,
+        const uint32_t* query, const uint32_t* templ,
+        size_t width
+    ) const{
+        for (size_t x = 0; x < width; x++){
+            bool valid = (int32_t)(query[x] & templ[x]) < 0;
+            dist[x] = valid ? gradient_distance_Default(query[x], templ[x]) : 0;
+            count[x] = valid;
+        }
+    }
+};
+
+
+
+}
+}
+#endif
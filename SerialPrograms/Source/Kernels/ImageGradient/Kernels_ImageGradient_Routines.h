@@ -0,0 +1,151 @@
+/*  Image Gradient Routines
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageGradient_Routines_H
+#define PokemonAutomation_Kernels_ImageGradient_Routines_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include "Kernels_ImageGradient.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+template <typename Filter>
+void sobel_gradient_rgb32(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height,
+    const Filter& filter
+){
+    if (width == 0 || height == 0){
+        return;
+    }
+    for (size_t r = 0; r < height; r++){
+        uint32_t* row_out = (uint32_t*)((char*)out + r * out_bytes_per_row);
+        row_out[0] = SOBEL_GRADIENT_NONE;
+        row_out[width - 1] = SOBEL_GRADIENT_NONE;
+        if (width < 3 || r == 0 || r + 1 == height){
+            std::fill(row_out, row_out + width, SOBEL_GRADIENT_NONE);
+            continue;
+        }
+        const uint32_t* row1 = (const uint32_t*)((const char*)in + r * in_bytes_per_row);
+        const uint32_t* row0 = (const uint32_t*)((const char*)row1 - in_bytes_per_row);
+        const uint32_t* row2 = (const uint32_t*)((const char*)row1 + in_bytes_per_row);
+        filter.row(row_out, row0, row1, row2, width);
+    }
+}
+
+
+
+//  Instead of summing each block for every pixel and offset, build the
+//  per-pixel distances once per offset and read the block sums out of
+//  summed-area tables.
+template <typename Distance>
+double gradient_block_match_rgb32(
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    size_t max_offset, size_t block_radius,
+    const Distance& distance
+){
+    const size_t width = query_width;
+    const size_t height = query_height;
+    const size_t stride = width + 1;
+
+    std::vector<uint32_t> dist(width);
+    std::vector<uint32_t> count(width);
+    std::vector<uint64_t> dist_table(stride * (height + 1), 0);
+    std::vector<uint32_t> count_table(stride * (height + 1), 0);
+    std::vector<double> best(width * height, std::numeric_limits<double>::infinity());
+
+    auto query_row = [&](size_t y){
+        return (const uint32_t*)((const char*)query + y * query_bytes_per_row);
+    };
+
+    const ptrdiff_t offset = (ptrdiff_t)max_offset;
+    for (ptrdiff_t oy = -offset; oy <= offset; oy++){
+        for (ptrdiff_t ox = -offset; ox <= offset; ox++){
+            //  Query columns [x0, x1) land inside the template.
+            ptrdiff_t x0 = std::max<ptrdiff_t>(0, -ox);
+            ptrdiff_t x1 = std::min<ptrdiff_t>((ptrdiff_t)width, (ptrdiff_t)templ_width - ox);
+
+            for (size_t y = 0; y < height; y++){
+                std::fill(dist.begin(), dist.end(), 0);
+                std::fill(count.begin(), count.end(), 0);
+                ptrdiff_t ty = (ptrdiff_t)y + oy;
+                if (x0 < x1 && ty >= 0 && ty < (ptrdiff_t)templ_height){
+                    const uint32_t* t = (const uint32_t*)((const char*)templ + ty * templ_bytes_per_row);
+                    distance.row(
+                        dist.data() + x0, count.data() + x0,
+                        query_row(y) + x0, t + x0 + ox,
+                        x1 - x0
+                    );
+                }
+
+                const uint64_t* dist_above = &dist_table[y * stride];
+                const uint32_t* count_above = &count_table[y * stride];
+                uint64_t* dist_sums = &dist_table[(y + 1) * stride];
+                uint32_t* count_sums = &count_table[(y + 1) * stride];
+                uint64_t dist_run = 0;
+                uint32_t count_run = 0;
+                for (size_t x = 0; x < width; x++){
+                    dist_run += dist[x];
+                    count_run += count[x];
+                    dist_sums[x + 1] = dist_above[x + 1] + dist_run;
+                    count_sums[x + 1] = count_above[x + 1] + count_run;
+                }
+            }
+
+            for (size_t y = 0; y < height; y++){
+                const uint32_t* q = query_row(y);
+                size_t by0 = y < block_radius ? 0 : y - block_radius;
+                size_t by1 = std::min(height, y + block_radius + 1);
+                for (size_t x = 0; x < width; x++){
+                    if ((int32_t)q[x] >= 0){
+                        continue;
+                    }
+                    size_t bx0 = x < block_radius ? 0 : x - block_radius;
+                    size_t bx1 = std::min(width, x + block_radius + 1);
+                    uint32_t n =
+                        count_table[by1 * stride + bx1] - count_table[by0 * stride + bx1] -
+                        count_table[by1 * stride + bx0] + count_table[by0 * stride + bx0];
+                    if (n == 0){
+                        continue;
+                    }
+                    uint64_t sum =
+                        dist_table[by1 * stride + bx1] - dist_table[by0 * stride + bx1] -
+                        dist_table[by1 * stride + bx0] + dist_table[by0 * stride + bx0];
+                    double score = (double)sum / 255 / n;
+                    double& current = best[y * width + x];
+                    current = std::min(current, score);
+                }
+            }
+        }
+    }
+
+    double total = 0;
+    size_t pixels = 0;
+    for (double score : best){
+        if (score != std::numeric_limits<double>::infinity()){
+            total += score;
+            pixels++;
+        }
+    }
+    return total / pixels;
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,46 @@
+/*  Image Gradient (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include "Kernels_ImageGradient_Routines.h"
+#include "Kernels_ImageGradient_x64_AVX2.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void sobel_gradient_rgb32_x64_AVX2(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+    SobelRgb32_x64_AVX2 filter;
+    sobel_gradient_rgb32(out, out_bytes_per_row, in, in_bytes_per_row, width, height, filter);
+}
+
+
+double gradient_block_match_rgb32_x64_AVX2(
+    const uint32_t* query, size_t query_bytes_per_row,
+    size_t query_width, size_t query_height,
+    const uint32_t* templ, size_t templ_bytes_per_row,
+    size_t templ_width, size_t templ_height,
+    size_t max_offset, size_t block_radius
+){
+    GradientDistance_x64_AVX2 distance;
+    return gradient_block_match_rgb32(
+        query, query_bytes_per_row, query_width, query_height,
+        templ, templ_bytes_per_row, templ_width, templ_height,
+        max_offset, block_radius,
+        distance
+    );
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,109 @@
+/*  Image Gradient (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageGradient_x64_AVX2_H
+#define PokemonAutomation_Kernels_ImageGradient_x64_AVX2_H
+
+#include <immintrin.h>
+#include "Kernels_ImageGradient_Default.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class SobelRgb32_x64_AVX2{
+public:
+    PA_FORCE_INLINE void row(
+        uint32_t* out,
+        const uint32_t* row0, const uint32_t* row1, const uint32_t* row2,
+        size_t width
+    ) const{
+        size_t x = 1;
+        for (; x + 9 <= width; x += 8){
+            _mm256_storeu_si256((__m256i*)(out + x), sobel8(row0 + x - 1, row1 + x - 1, row2 + x - 1));
+        }
+        for (; x + 1 < width; x++){
+            out[x] = sobel_gradient_rgb32_Default(row0, row1, row2, x);
+        }
+    }
+
+private:
+    //  R + G + B of each pixel.
+    static PA_FORCE_INLINE __m256i sum(__m256i pixel){
+        pixel = _mm256_maddubs_epi16(pixel, _mm256_set1_epi32(0x00010101));
+        return _mm256_madd_epi16(pixel, _mm256_set1_epi16(1));
+    }
+
+    //  8 pixels centered on row1[1] to row1[8].
+    static PA_FORCE_INLINE __m256i sobel8(const uint32_t* row0, const uint32_t* row1, const uint32_t* row2){
+        __m256i p00 = _mm256_loadu_si256((const __m256i*)(row0 + 0));
+        __m256i p01 = _mm256_loadu_si256((const __m256i*)(row0 + 1));
+        __m256i p02 = _mm256_loadu_si256((const __m256i*)(row0 + 2));
+        __m256i p10 = _mm256_loadu_si256((const __m256i*)(row1 + 0));
+        __m256i p11 = _mm256_loadu_si256((const __m256i*)(row1 + 1));
+        __m256i p12 = _mm256_loadu_si256((const __m256i*)(row1 + 2));
+        __m256i p20 = _mm256_loadu_si256((const __m256i*)(row2 + 0));
+        __m256i p21 = _mm256_loadu_si256((const __m256i*)(row2 + 1));
+        __m256i p22 = _mm256_loadu_si256((const __m256i*)(row2 + 2));
+
+        __m256i opaque = _mm256_and_si256(_mm256_and_si256(p00, p01), p02);
+        opaque = _mm256_and_si256(opaque, _mm256_and_si256(_mm256_and_si256(p10, p11), p12));
+        opaque = _mm256_and_si256(opaque, _mm256_and_si256(_mm256_and_si256(p20, p21), p22));
+        opaque = _mm256_srai_epi32(opaque, 31);
+
+        __m256i s00 = sum(p00), s01 = sum(p01), s02 = sum(p02);
+        __m256i s10 = sum(p10),                 s12 = sum(p12);
+        __m256i s20 = sum(p20), s21 = sum(p21), s22 = sum(p22);
+
+        __m256i gx = _mm256_add_epi32(_mm256_sub_epi32(s02, s00), _mm256_sub_epi32(s22, s20));
+        gx = _mm256_add_epi32(gx, _mm256_slli_epi32(_mm256_sub_epi32(s12, s10), 1));
+        __m256i gy = _mm256_sub_epi32(_mm256_add_epi32(s00, s02), _mm256_add_epi32(s20, s22));
+        gy = _mm256_add_epi32(gy, _mm256_slli_epi32(_mm256_sub_epi32(s01, s21), 1));
+
+        __m256i out = _mm256_blend_epi16(gx, _mm256_slli_epi32(gy, 16), 0xaa);
+        return _mm256_blendv_epi8(_mm256_set1_epi32(SOBEL_GRADIENT_NONE), out, opaque);
+    }
+};
+
+
+class GradientDistance_x64_AVX2{
+public:
+    PA_FORCE_INLINE void row(
+        uint32_t* dist, uint32_t* count,
+        const uint32_t* query, const uint32_t* templ,
+        size_t width
+    ) const{
+        size_t x = 0;
+        for (; x + 8 <= width; x += 8){
+            __m256i q = _mm256_loadu_si256((const __m256i*)(query + x));
+            __m256i t = _mm256_loadu_si256((const __m256i*)(templ + x));
+            __m256i valid = _mm256_srai_epi32(_mm256_and_si256(q, t), 31);
+            __m256i d = _mm256_add_epi32(
+                distance8(_mm256_srli_epi32(q, 16), _mm256_srli_epi32(t, 16)),
+                distance8(_mm256_srli_epi32(q, 8), _mm256_srli_epi32(t, 8))
+            );
+            _mm256_storeu_si256((__m256i*)(dist + x), _mm256_and_si256(d, valid));
+            _mm256_storeu_si256((__m256i*)(count + x), _mm256_srli_epi32(valid, 31));
+        }
+        GradientDistance_Default().row(dist + x, count + x, query + x, templ + x, width - x);
+    }
+
+private:
+    //  max(q, t) * (q - t)^2 on the lowest byte of each lane.
+    static PA_FORCE_INLINE __m256i distance8(__m256i q, __m256i t){
+        q = _mm256_and_si256(q, _mm256_set1_epi32(0xff));
+        t = _mm256_and_si256(t, _mm256_set1_epi32(0xff));
+        __m256i diff = _mm256_abs_epi32(_mm256_sub_epi32(q, t));
+        diff = _mm256_mullo_epi16(diff, diff);
+        return _mm256_mullo_epi32(diff, _mm256_max_epi32(q, t));
+    }
+};
+
+
+
+}
+}
+#endif
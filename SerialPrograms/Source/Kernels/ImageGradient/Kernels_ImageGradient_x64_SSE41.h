@@ -0,0 +1,109 @@
+/*  Image Gradient (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageGradient_x64_SSE41_H
+#define PokemonAutomation_Kernels_ImageGradient_x64_SSE41_H
+
+#include <smmintrin.h>
+#include "Kernels_ImageGradient_Default.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+class SobelRgb32_x64_SSE41{
+public:
+    PA_FORCE_INLINE void row(
+        uint32_t* out,
+        const uint32_t* row0, const uint32_t* row1, const uint32_t* row2,
+        size_t width
+    ) const{
+        size_t x = 1;
+        for (; x + 5 <= width; x += 4){
+            _mm_storeu_si128((__m128i*)(out + x), sobel4(row0 + x - 1, row1 + x - 1, row2 + x - 1));
+        }
+        for (; x + 1 < width; x++){
+            out[x] = sobel_gradient_rgb32_Default(row0, row1, row2, x);
+        }
+    }
+
+private:
+    //  R + G + B of each pixel.
+    static PA_FORCE_INLINE __m128i sum(__m128i pixel){
+        pixel = _mm_maddubs_epi16(pixel, _mm_set1_epi32(0x00010101));
+        return _mm_madd_epi16(pixel, _mm_set1_epi16(1));
+    }
+
+    //  4 pixels centered on row1[1] to row1[4].
+    static PA_FORCE_INLINE __m128i sobel4(const uint32_t* row0, const uint32_t* row1, const uint32_t* row2){
+        __m128i p00 = _mm_loadu_si128((const __m128i*)(row0 + 0));
+        __m128i p01 = _mm_loadu_si128((const __m128i*)(row0 + 1));
+        __m128i p02 = _mm_loadu_si128((const __m128i*)(row0 + 2));
+        __m128i p10 = _mm_loadu_si128((const __m128i*)(row1 + 0));
+        __m128i p11 = _mm_loadu_si128((const __m128i*)(row1 + 1));
+        __m128i p12 = _mm_loadu_si128((const __m128i*)(row1 + 2));
+        __m128i p20 = _mm_loadu_si128((const __m128i*)(row2 + 0));
+        __m128i p21 = _mm_loadu_si128((const __m128i*)(row2 + 1));
+        __m128i p22 = _mm_loadu_si128((const __m128i*)(row2 + 2));
+
+        __m128i opaque = _mm_and_si128(_mm_and_si128(p00, p01), p02);
+        opaque = _mm_and_si128(opaque, _mm_and_si128(_mm_and_si128(p10, p11), p12));
+        opaque = _mm_and_si128(opaque, _mm_and_si128(_mm_and_si128(p20, p21), p22));
+        opaque = _mm_srai_epi32(opaque, 31);
+
+        __m128i s00 = sum(p00), s01 = sum(p01), s02 = sum(p02);
+        __m128i s10 = sum(p10),                 s12 = sum(p12);
+        __m128i s20 = sum(p20), s21 = sum(p21), s22 = sum(p22);
+
+        __m128i gx = _mm_add_epi32(_mm_sub_epi32(s02, s00), _mm_sub_epi32(s22, s20));
+        gx = _mm_add_epi32(gx, _mm_slli_epi32(_mm_sub_epi32(s12, s10), 1));
+        __m128i gy = _mm_sub_epi32(_mm_add_epi32(s00, s02), _mm_add_epi32(s20, s22));
+        gy = _mm_add_epi32(gy, _mm_slli_epi32(_mm_sub_epi32(s01, s21), 1));
+
+        __m128i out = _mm_blend_epi16(gx, _mm_slli_epi32(gy, 16), 0xaa);
+        return _mm_blendv_epi8(_mm_set1_epi32(SOBEL_GRADIENT_NONE), out, opaque);
+    }
+};
+
+
+class GradientDistance_x64_SSE41{
+public:
+    PA_FORCE_INLINE void row(
+        uint32_t* dist, uint32_t* count,
+        const uint32_t* query, const uint32_t* templ,
+        size_t width
+    ) const{
+        size_t x = 0;
+        for (; x + 4 <= width; x += 4){
+            __m128i q = _mm_loadu_si128((const __m128i*)(query + x));
+            __m128i t = _mm_loadu_si128((const __m128i*)(templ + x));
+            __m128i valid = _mm_srai_epi32(_mm_and_si128(q, t), 31);
+            __m128i d = _mm_add_epi32(
+                distance4(_mm_srli_epi32(q, 16), _mm_srli_epi32(t, 16)),
+                distance4(_mm_srli_epi32(q, 8), _mm_srli_epi32(t, 8))
+            );
+            _mm_storeu_si128((__m128i*)(dist + x), _mm_and_si128(d, valid));
+            _mm_storeu_si128((__m128i*)(count + x), _mm_srli_epi32(valid, 31));
+        }
+        GradientDistance_Default().row(dist + x, count + x, query + x, templ + x, width - x);
+    }
+
+private:
+    //  max(q, t) * (q - t)^2 on the lowest byte of each lane.
+    static PA_FORCE_INLINE __m128i distance4(__m128i q, __m128i t){
+        q = _mm_and_si128(q, _mm_set1_epi32(0xff));
+        t = _mm_and_si128(t, _mm_set1_epi32(0xff));
+        __m128i diff = _mm_abs_epi32(_mm_sub_epi32(q, t));
+        diff = _mm_mullo_epi16(diff, diff);
+        return _mm_mullo_epi32(diff, _mm_max_epi32(q, t));
+    }
+};
+
+
+
+}
+}
+#endif
@@ -0,0 +1,111 @@
+/*  Image HSV
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageHSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void rgb32_to_hsv32_Default(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void rgb32_to_hsv32_x64_SSE41(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void rgb32_to_hsv32_x64_AVX2(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void rgb32_to_hsv32_x64_AVX512(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void hsv32_to_rgb32_Default(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void hsv32_to_rgb32_x64_SSE41(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void hsv32_to_rgb32_x64_AVX2(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void hsv32_to_rgb32_x64_AVX512(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+
+
+
+void rgb32_to_hsv32(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        rgb32_to_hsv32_x64_AVX512(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        rgb32_to_hsv32_x64_AVX2(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        rgb32_to_hsv32_x64_SSE41(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+        return;
+    }
+#endif
+    rgb32_to_hsv32_Default(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+}
+void hsv32_to_rgb32(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        hsv32_to_rgb32_x64_AVX512(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        hsv32_to_rgb32_x64_AVX2(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        hsv32_to_rgb32_x64_SSE41(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+        return;
+    }
+#endif
+    hsv32_to_rgb32_Default(out, out_bytes_per_row, in, in_bytes_per_row, width, height);
+}
+
+
+
+}
+}
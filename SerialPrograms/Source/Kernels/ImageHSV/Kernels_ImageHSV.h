@@ -0,0 +1,39 @@
+/*  Image HSV
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Convert whole images between RGB32 and HSV32.
+ *
+ *  The pixel formats are the ones used by ImageRGB32 and ImageHSV32.
+ *  See Kernels_ImageHSV_Default.h for the exact conversions. All the
+ *  vectorized versions give the same results bit-for-bit.
+ *
+ *  "in" and "out" may be the same image.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageHSV_H
+#define PokemonAutomation_Kernels_ImageHSV_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void rgb32_to_hsv32(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+void hsv32_to_rgb32(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,43 @@
+/*  Image HSV (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels_ImageHSV_Default.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void rgb32_to_hsv32_Default(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            out[c] = rgb32_to_hsv32_Default(in[c]);
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+void hsv32_to_rgb32_Default(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            out[c] = hsv32_to_rgb32_Default(in[c]);
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
@@ -0,0 +1,92 @@
+/*  Image HSV (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  The scalar RGB32 <-> HSV32 conversions. These define the results that
+ *  every vectorized version must match bit-for-bit.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageHSV_Default_H
+#define PokemonAutomation_Kernels_ImageHSV_Default_H
+
+#include <stdint.h>
+#include <algorithm>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert an ARGB pixel to AHSV. Alpha is kept as is.
+//  H is the standard [0, 360) hue scaled to [0, 256). S and V are in [0, 255].
+//
+//  The divisions are done in float. All the operands are small integers, so
+//  the truncated quotients are exact and match the double-precision math that
+//  this conversion was originally written with.
+PA_FORCE_INLINE uint32_t rgb32_to_hsv32_Default(uint32_t pixel){
+    int r = (pixel >> 16) & 0xff;
+    int g = (pixel >>  8) & 0xff;
+    int b = pixel & 0xff;
+
+    int M = std::max(std::max(r, g), b);
+    int m = std::min(std::min(r, g), b);
+    int delta = M - m;
+
+    int S = 0;
+    if (M > 0){
+        S = 255 - (int)((float)(m*255 + M/2) / (float)M);
+    }
+
+    //  Hue scaled by 6 * delta, offset by the sextant that the max channel is in.
+    int N;
+    if (M == r){
+        N = g - b;
+    }else if (M == g){
+        N = b - r + 2*delta;
+    }else{
+        N = r - g + 4*delta;
+    }
+
+    //  Hues just below red (N < 0) round to 0 rather than wrapping to 255.
+    int H = 0;
+    if (delta > 0 && N >= 0){
+        H = (int)((float)(256*N + 3*delta) / (float)(6*delta));
+    }
+
+    return (pixel & 0xff000000) | ((uint32_t)H << 16) | ((uint32_t)S << 8) | (uint32_t)M;
+}
+
+
+//  Convert an AHSV pixel (as produced by rgb32_to_hsv32_Default()) back to ARGB.
+//  Alpha is kept as is.
+PA_FORCE_INLINE uint32_t hsv32_to_rgb32_Default(uint32_t pixel){
+    uint32_t H = (pixel >> 16) & 0xff;
+    uint32_t S = (pixel >>  8) & 0xff;
+    uint32_t V = pixel & 0xff;
+
+    //  Chroma: round(S * V / 255)
+    uint32_t C = S * V + 128;
+    C = (C + (C >> 8)) >> 8;
+
+    //  Each channel is V minus a fraction (0 to 256 / 256) of the chroma
+    //  that depends on how far the hue is from that channel.
+    uint32_t h6 = H * 6;
+    auto channel = [=](uint32_t offset){
+        int32_t k = (int32_t)(offset + h6);
+        if (k >= 1536){
+            k -= 1536;
+        }
+        int32_t w = std::min(k, 1024 - k);
+        w = std::min(std::max(w, (int32_t)0), (int32_t)256);
+        return V - ((C * (uint32_t)w + 128) >> 8);
+    };
+
+    return (pixel & 0xff000000) | (channel(1280) << 16) | (channel(768) << 8) | channel(256);
+}
+
+
+
+}
+}
+#endif
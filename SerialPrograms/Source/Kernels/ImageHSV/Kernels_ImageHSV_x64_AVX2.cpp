@@ -0,0 +1,57 @@
+/*  Image HSV (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include "Kernels_ImageHSV_Default.h"
+#include "Kernels_ImageHSV_x64_AVX2.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void rgb32_to_hsv32_x64_AVX2(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t c = 0;
+        for (; c + 8 <= width; c += 8){
+            __m256i pixel = _mm256_loadu_si256((const __m256i*)(in + c));
+            _mm256_storeu_si256((__m256i*)(out + c), rgb32_to_hsv32_x64_AVX2(pixel));
+        }
+        for (; c < width; c++){
+            out[c] = rgb32_to_hsv32_Default(in[c]);
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+void hsv32_to_rgb32_x64_AVX2(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+    for (size_t r = 0; r < height; r++){
+        size_t c = 0;
+        for (; c + 8 <= width; c += 8){
+            __m256i pixel = _mm256_loadu_si256((const __m256i*)(in + c));
+            _mm256_storeu_si256((__m256i*)(out + c), hsv32_to_rgb32_x64_AVX2(pixel));
+        }
+        for (; c < width; c++){
+            out[c] = hsv32_to_rgb32_Default(in[c]);
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,89 @@
+/*  Image HSV (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  8 pixels at a time. Same math as Kernels_ImageHSV_Default.h.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageHSV_x64_AVX2_H
+#define PokemonAutomation_Kernels_ImageHSV_x64_AVX2_H
+
+#include <stdint.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE __m256i rgb32_to_hsv32_x64_AVX2(__m256i pixel){
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask);
+    __m256i b = _mm256_and_si256(pixel, mask);
+
+    __m256i M = _mm256_max_epi32(_mm256_max_epi32(r, g), b);
+    __m256i m = _mm256_min_epi32(_mm256_min_epi32(r, g), b);
+    __m256i delta = _mm256_sub_epi32(M, m);
+
+    __m256 num = _mm256_cvtepi32_ps(_mm256_add_epi32(
+        _mm256_mullo_epi16(m, _mm256_set1_epi32(255)),
+        _mm256_srli_epi32(M, 1)
+    ));
+    __m256 den = _mm256_cvtepi32_ps(_mm256_max_epi32(M, _mm256_set1_epi32(1)));
+    __m256i S = _mm256_sub_epi32(_mm256_set1_epi32(255), _mm256_cvttps_epi32(_mm256_div_ps(num, den)));
+    S = _mm256_andnot_si256(_mm256_cmpeq_epi32(M, _mm256_setzero_si256()), S);
+
+    __m256i is_r = _mm256_cmpeq_epi32(M, r);
+    __m256i is_g = _mm256_cmpeq_epi32(M, g);
+    __m256i N = _mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_slli_epi32(delta, 2));
+    N = _mm256_blendv_epi8(N, _mm256_add_epi32(_mm256_sub_epi32(b, r), _mm256_slli_epi32(delta, 1)), is_g);
+    N = _mm256_blendv_epi8(N, _mm256_sub_epi32(g, b), is_r);
+
+    __m256i delta3 = _mm256_add_epi32(delta, _mm256_slli_epi32(delta, 1));
+    num = _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_slli_epi32(N, 8), delta3));
+    den = _mm256_cvtepi32_ps(_mm256_max_epi32(_mm256_slli_epi32(delta3, 1), _mm256_set1_epi32(1)));
+    __m256i H = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_div_ps(num, den)), _mm256_setzero_si256());
+
+    __m256i out = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+    out = _mm256_or_si256(out, _mm256_slli_epi32(H, 16));
+    out = _mm256_or_si256(out, _mm256_slli_epi32(S, 8));
+    out = _mm256_or_si256(out, M);
+    return out;
+}
+
+
+PA_FORCE_INLINE __m256i hsv32_to_rgb32_x64_AVX2_channel(
+    __m256i V, __m256i C, __m256i h6, int offset
+){
+    __m256i k = _mm256_add_epi32(h6, _mm256_set1_epi32(offset));
+    k = _mm256_sub_epi32(k, _mm256_and_si256(_mm256_cmpgt_epi32(k, _mm256_set1_epi32(1535)), _mm256_set1_epi32(1536)));
+    __m256i w = _mm256_min_epi32(k, _mm256_sub_epi32(_mm256_set1_epi32(1024), k));
+    w = _mm256_min_epi32(_mm256_max_epi32(w, _mm256_setzero_si256()), _mm256_set1_epi32(256));
+    w = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi16(C, w), _mm256_set1_epi32(128)), 8);
+    return _mm256_sub_epi32(V, w);
+}
+PA_FORCE_INLINE __m256i hsv32_to_rgb32_x64_AVX2(__m256i pixel){
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    __m256i H = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask);
+    __m256i S = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask);
+    __m256i V = _mm256_and_si256(pixel, mask);
+
+    __m256i C = _mm256_add_epi32(_mm256_mullo_epi16(S, V), _mm256_set1_epi32(128));
+    C = _mm256_srli_epi32(_mm256_add_epi32(C, _mm256_srli_epi32(C, 8)), 8);
+
+    __m256i h6 = _mm256_add_epi32(_mm256_slli_epi32(H, 2), _mm256_slli_epi32(H, 1));
+
+    __m256i out = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+    out = _mm256_or_si256(out, _mm256_slli_epi32(hsv32_to_rgb32_x64_AVX2_channel(V, C, h6, 1280), 16));
+    out = _mm256_or_si256(out, _mm256_slli_epi32(hsv32_to_rgb32_x64_AVX2_channel(V, C, h6, 768), 8));
+    out = _mm256_or_si256(out, hsv32_to_rgb32_x64_AVX2_channel(V, C, h6, 256));
+    return out;
+}
+
+
+
+}
+}
+#endif
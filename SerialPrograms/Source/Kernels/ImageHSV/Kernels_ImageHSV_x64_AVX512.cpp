@@ -0,0 +1,60 @@
+/*  Image HSV (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include "Kernels_ImageHSV_x64_AVX512.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void rgb32_to_hsv32_x64_AVX512(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+    __mmask16 tail = (__mmask16)(((uint32_t)1 << (width % 16)) - 1);
+    for (size_t r = 0; r < height; r++){
+        size_t c = 0;
+        for (; c + 16 <= width; c += 16){
+            __m512i pixel = _mm512_loadu_si512((const __m512i*)(in + c));
+            _mm512_storeu_si512((__m512i*)(out + c), rgb32_to_hsv32_x64_AVX512(pixel));
+        }
+        if (tail){
+            __m512i pixel = _mm512_maskz_loadu_epi32(tail, in + c);
+            _mm512_mask_storeu_epi32(out + c, tail, rgb32_to_hsv32_x64_AVX512(pixel));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+void hsv32_to_rgb32_x64_AVX512(
+    uint32_t* out, size_t out_bytes_per_row,
+    const uint32_t* in, size_t in_bytes_per_row,
+    size_t width, size_t height
+){
+    __mmask16 tail = (__mmask16)(((uint32_t)1 << (width % 16)) - 1);
+    for (size_t r = 0; r < height; r++){
+        size_t c = 0;
+        for (; c + 16 <= width; c += 16){
+            __m512i pixel = _mm512_loadu_si512((const __m512i*)(in + c));
+            _mm512_storeu_si512((__m512i*)(out + c), hsv32_to_rgb32_x64_AVX512(pixel));
+        }
+        if (tail){
+            __m512i pixel = _mm512_maskz_loadu_epi32(tail, in + c);
+            _mm512_mask_storeu_epi32(out + c, tail, hsv32_to_rgb32_x64_AVX512(pixel));
+        }
+        in = (const uint32_t*)((const char*)in + in_bytes_per_row);
+        out = (uint32_t*)((char*)out + out_bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
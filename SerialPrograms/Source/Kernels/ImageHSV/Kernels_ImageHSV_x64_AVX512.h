@@ -0,0 +1,95 @@
+/*  Image HSV (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  16 pixels at a time. Same math as Kernels_ImageHSV_Default.h.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageHSV_x64_AVX512_H
+#define PokemonAutomation_Kernels_ImageHSV_x64_AVX512_H
+
+#include <stdint.h>
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE __m512i rgb32_to_hsv32_x64_AVX512(__m512i pixel){
+    const __m512i mask = _mm512_set1_epi32(0xff);
+    __m512i r = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), mask);
+    __m512i g = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), mask);
+    __m512i b = _mm512_and_si512(pixel, mask);
+
+    __m512i M = _mm512_max_epi32(_mm512_max_epi32(r, g), b);
+    __m512i m = _mm512_min_epi32(_mm512_min_epi32(r, g), b);
+    __m512i delta = _mm512_sub_epi32(M, m);
+
+    __m512 num = _mm512_cvtepi32_ps(_mm512_add_epi32(
+        _mm512_mullo_epi16(m, _mm512_set1_epi32(255)),
+        _mm512_srli_epi32(M, 1)
+    ));
+    __m512 den = _mm512_cvtepi32_ps(_mm512_max_epi32(M, _mm512_set1_epi32(1)));
+    __m512i S = _mm512_maskz_sub_epi32(
+        _mm512_test_epi32_mask(M, M),
+        _mm512_set1_epi32(255), _mm512_cvttps_epi32(_mm512_div_ps(num, den))
+    );
+
+    __mmask16 is_r = _mm512_cmpeq_epi32_mask(M, r);
+    __mmask16 is_g = _mm512_cmpeq_epi32_mask(M, g);
+    __m512i N = _mm512_add_epi32(_mm512_sub_epi32(r, g), _mm512_slli_epi32(delta, 2));
+    N = _mm512_mask_blend_epi32(is_g, N, _mm512_add_epi32(_mm512_sub_epi32(b, r), _mm512_slli_epi32(delta, 1)));
+    N = _mm512_mask_blend_epi32(is_r, N, _mm512_sub_epi32(g, b));
+
+    __m512i delta3 = _mm512_add_epi32(delta, _mm512_slli_epi32(delta, 1));
+    num = _mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_slli_epi32(N, 8), delta3));
+    den = _mm512_cvtepi32_ps(_mm512_max_epi32(_mm512_slli_epi32(delta3, 1), _mm512_set1_epi32(1)));
+    __m512i H = _mm512_max_epi32(_mm512_cvttps_epi32(_mm512_div_ps(num, den)), _mm512_setzero_si512());
+
+    //  out = alpha | H << 16 | S << 8 | M
+    __m512i out = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+    out = _mm512_or_si512(out, _mm512_slli_epi32(H, 16));
+    out = _mm512_ternarylogic_epi32(out, _mm512_slli_epi32(S, 8), M, 0xfe);
+    return out;
+}
+
+
+PA_FORCE_INLINE __m512i hsv32_to_rgb32_x64_AVX512_channel(
+    __m512i V, __m512i C, __m512i h6, int offset
+){
+    __m512i k = _mm512_add_epi32(h6, _mm512_set1_epi32(offset));
+    k = _mm512_mask_sub_epi32(k, _mm512_cmpgt_epi32_mask(k, _mm512_set1_epi32(1535)), k, _mm512_set1_epi32(1536));
+    __m512i w = _mm512_min_epi32(k, _mm512_sub_epi32(_mm512_set1_epi32(1024), k));
+    w = _mm512_min_epi32(_mm512_max_epi32(w, _mm512_setzero_si512()), _mm512_set1_epi32(256));
+    w = _mm512_srli_epi32(_mm512_add_epi32(_mm512_mullo_epi16(C, w), _mm512_set1_epi32(128)), 8);
+    return _mm512_sub_epi32(V, w);
+}
+PA_FORCE_INLINE __m512i hsv32_to_rgb32_x64_AVX512(__m512i pixel){
+    const __m512i mask = _mm512_set1_epi32(0xff);
+    __m512i H = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), mask);
+    __m512i S = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), mask);
+    __m512i V = _mm512_and_si512(pixel, mask);
+
+    __m512i C = _mm512_add_epi32(_mm512_mullo_epi16(S, V), _mm512_set1_epi32(128));
+    C = _mm512_srli_epi32(_mm512_add_epi32(C, _mm512_srli_epi32(C, 8)), 8);
+
+    __m512i h6 = _mm512_add_epi32(_mm512_slli_epi32(H, 2), _mm512_slli_epi32(H, 1));
+
+    __m512i out = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+    out = _mm512_or_si512(out, _mm512_slli_epi32(hsv32_to_rgb32_x64_AVX512_channel(V, C, h6, 1280), 16));
+    out = _mm512_ternarylogic_epi32(
+        out,
+        _mm512_slli_epi32(hsv32_to_rgb32_x64_AVX512_channel(V, C, h6, 768), 8),
+        hsv32_to_rgb32_x64_AVX512_channel(V, C, h6, 256),
+        0xfe
+    );
+    return out;
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,96 @@
+/*  Image HSV (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  4 pixels at a time. Same math as Kernels_ImageHSV_Default.h.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageHSV_x64_SSE41_H
+#define PokemonAutomation_Kernels_ImageHSV_x64_SSE41_H
+
+#include <stdint.h>
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE __m128i rgb32_to_hsv32_x64_SSE41(__m128i pixel){
+    const __m128i mask = _mm_set1_epi32(0xff);
+    __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), mask);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), mask);
+    __m128i b = _mm_and_si128(pixel, mask);
+
+    __m128i M = _mm_max_epi32(_mm_max_epi32(r, g), b);
+    __m128i m = _mm_min_epi32(_mm_min_epi32(r, g), b);
+    __m128i delta = _mm_sub_epi32(M, m);
+
+    //  S = 255 - (m*255 + M/2) / M, or 0 if M == 0.
+    //  All products fit in 16 bits so "mullo_epi16" is enough.
+    __m128 num = _mm_cvtepi32_ps(_mm_add_epi32(
+        _mm_mullo_epi16(m, _mm_set1_epi32(255)),
+        _mm_srli_epi32(M, 1)
+    ));
+    __m128 den = _mm_cvtepi32_ps(_mm_max_epi32(M, _mm_set1_epi32(1)));
+    __m128i S = _mm_sub_epi32(_mm_set1_epi32(255), _mm_cvttps_epi32(_mm_div_ps(num, den)));
+    S = _mm_andnot_si128(_mm_cmpeq_epi32(M, _mm_setzero_si128()), S);
+
+    //  N = g - b           if M == r
+    //    = b - r + 2*delta if M == g
+    //    = r - g + 4*delta otherwise
+    __m128i is_r = _mm_cmpeq_epi32(M, r);
+    __m128i is_g = _mm_cmpeq_epi32(M, g);
+    __m128i N = _mm_add_epi32(_mm_sub_epi32(r, g), _mm_slli_epi32(delta, 2));
+    N = _mm_blendv_epi8(N, _mm_add_epi32(_mm_sub_epi32(b, r), _mm_slli_epi32(delta, 1)), is_g);
+    N = _mm_blendv_epi8(N, _mm_sub_epi32(g, b), is_r);
+
+    //  H = (256*N + 3*delta) / (6*delta), clamped below at 0.
+    //  When delta == 0, N is also 0 so the numerator is 0.
+    __m128i delta3 = _mm_add_epi32(delta, _mm_slli_epi32(delta, 1));
+    num = _mm_cvtepi32_ps(_mm_add_epi32(_mm_slli_epi32(N, 8), delta3));
+    den = _mm_cvtepi32_ps(_mm_max_epi32(_mm_slli_epi32(delta3, 1), _mm_set1_epi32(1)));
+    __m128i H = _mm_max_epi32(_mm_cvttps_epi32(_mm_div_ps(num, den)), _mm_setzero_si128());
+
+    __m128i out = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+    out = _mm_or_si128(out, _mm_slli_epi32(H, 16));
+    out = _mm_or_si128(out, _mm_slli_epi32(S, 8));
+    out = _mm_or_si128(out, M);
+    return out;
+}
+
+
+PA_FORCE_INLINE __m128i hsv32_to_rgb32_x64_SSE41_channel(
+    __m128i V, __m128i C, __m128i h6, int offset
+){
+    __m128i k = _mm_add_epi32(h6, _mm_set1_epi32(offset));
+    k = _mm_sub_epi32(k, _mm_and_si128(_mm_cmpgt_epi32(k, _mm_set1_epi32(1535)), _mm_set1_epi32(1536)));
+    __m128i w = _mm_min_epi32(k, _mm_sub_epi32(_mm_set1_epi32(1024), k));
+    w = _mm_min_epi32(_mm_max_epi32(w, _mm_setzero_si128()), _mm_set1_epi32(256));
+    w = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(C, w), _mm_set1_epi32(128)), 8);
+    return _mm_sub_epi32(V, w);
+}
+PA_FORCE_INLINE __m128i hsv32_to_rgb32_x64_SSE41(__m128i pixel){
+    const __m128i mask = _mm_set1_epi32(0xff);
+    __m128i H = _mm_and_si128(_mm_srli_epi32(pixel, 16), mask);
+    __m128i S = _mm_and_si128(_mm_srli_epi32(pixel, 8), mask);
+    __m128i V = _mm_and_si128(pixel, mask);
+
+    __m128i C = _mm_add_epi32(_mm_mullo_epi16(S, V), _mm_set1_epi32(128));
+    C = _mm_srli_epi32(_mm_add_epi32(C, _mm_srli_epi32(C, 8)), 8);
+
+    __m128i h6 = _mm_add_epi32(_mm_slli_epi32(H, 2), _mm_slli_epi32(H, 1));
+
+    __m128i out = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+    out = _mm_or_si128(out, _mm_slli_epi32(hsv32_to_rgb32_x64_SSE41_channel(V, C, h6, 1280), 16));
+    out = _mm_or_si128(out, _mm_slli_epi32(hsv32_to_rgb32_x64_SSE41_channel(V, C, h6, 768), 8));
+    out = _mm_or_si128(out, hsv32_to_rgb32_x64_SSE41_channel(V, C, h6, 256));
+    return out;
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,85 @@
+/*  Waterfill Component Tree
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Kernels_Waterfill_Session.h"
+#include "Kernels_Waterfill_ComponentTree.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace Waterfill{
+
+
+
+WaterfillComponentTree::WaterfillComponentTree(const std::vector<PackedBinaryMatrix_IB*>& levels, size_t min_area)
+    : m_levels(levels.size())
+{
+    if (levels.empty()){
+        return;
+    }
+
+    std::unique_ptr<WaterfillSession> session = make_WaterfillSession(*levels[0]);
+    WaterfillObject object;
+
+    auto finder = session->make_iterator(min_area);
+    while (finder->find_next(object, true)){
+        m_levels[0].emplace_back(m_nodes.size());
+        m_nodes.emplace_back(Node{std::move(object), 0, NO_PARENT, {}});
+    }
+
+    for (size_t level = 1; level < levels.size(); level++){
+        session->set_source(*levels[level]);
+
+        //  Objects that were too small on the level above cannot contain
+        //  anything big enough on this level. So we only need to look inside
+        //  the objects that were kept.
+        for (size_t region : m_levels[level - 1]){
+            const WaterfillObject& bounds = m_nodes[region].object;
+            finder = session->make_iterator(
+                min_area,
+                bounds.min_x, bounds.min_y,
+                bounds.max_x, bounds.max_y
+            );
+            while (finder->find_next(object, true)){
+                //  The search area is rounded out to whole tiles. So the
+                //  object may belong to a neighbor instead.
+                size_t parent = find_parent(level - 1, region, object);
+                size_t index = m_nodes.size();
+                m_nodes[parent].children.emplace_back(index);
+                m_levels[level].emplace_back(index);
+                m_nodes.emplace_back(Node{std::move(object), level, parent, {}});
+            }
+        }
+    }
+}
+
+size_t WaterfillComponentTree::find_parent(size_t level, size_t hint, const WaterfillObject& object) const{
+    size_t x = object.body_x;
+    size_t y = object.body_y;
+    auto contains = [=](const WaterfillObject& parent){
+        return
+            parent.min_x <= x && x < parent.max_x &&
+            parent.min_y <= y && y < parent.max_y &&
+            parent.object->get(x, y);
+    };
+
+    if (contains(m_nodes[hint].object)){
+        return hint;
+    }
+    for (size_t index : m_levels[level]){
+        if (contains(m_nodes[index].object)){
+            return index;
+        }
+    }
+    throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Waterfill levels are not nested.");
+}
+
+
+
+
+}
+}
+}
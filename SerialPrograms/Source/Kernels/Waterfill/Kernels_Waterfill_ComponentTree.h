@@ -0,0 +1,77 @@
+/*  Waterfill Component Tree
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Waterfill over a set of nested thresholds of the same image.
+ *
+ *  Detectors often filter the same image with progressively tighter ranges
+ *  and waterfill each result. Since every object at a tighter threshold lies
+ *  entirely inside an object of the looser threshold, only the looser level
+ *  needs a full scan. Each deeper level is only searched inside the bounding
+ *  boxes of the objects found in the level above it.
+ *
+ *  The objects found on each level are exactly the same as running a full
+ *  waterfill with the same "min_area" on each matrix separately. Only the
+ *  order is different. Within a level, objects are grouped by their parent.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_Waterfill_ComponentTree_H
+#define PokemonAutomation_Kernels_Waterfill_ComponentTree_H
+
+#include <vector>
+#include "Kernels_Waterfill_Types.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace Waterfill{
+
+
+class WaterfillComponentTree{
+public:
+    static constexpr size_t NO_PARENT = (size_t)0 - 1;
+
+    struct Node{
+        WaterfillObject object;
+        size_t level;
+        size_t parent;
+        std::vector<size_t> children;
+    };
+
+
+public:
+    //  Every bit that is set in "levels[i + 1]" must also be set in "levels[i]".
+    //  All the matrices must be the same type and size. They are zeroed in
+    //  the process.
+    //
+    //  Objects smaller than "min_area" are dropped from every level.
+    //  Objects are always kept. (WaterfillObject::object is constructed)
+    WaterfillComponentTree(const std::vector<PackedBinaryMatrix_IB*>& levels, size_t min_area);
+
+    size_t levels() const{ return m_levels.size(); }
+
+    //  Indices of all the nodes on the specified level.
+    const std::vector<size_t>& level(size_t index) const{ return m_levels[index]; }
+
+    const Node& node(size_t index) const{ return m_nodes[index]; }
+    const std::vector<Node>& nodes() const{ return m_nodes; }
+
+
+private:
+    //  Find the node on "level" that contains "object".
+    //  "hint" is checked first.
+    size_t find_parent(size_t level, size_t hint, const WaterfillObject& object) const;
+
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<std::vector<size_t>> m_levels;
+};
+
+
+
+
+}
+}
+}
+#endif
@@ -28,6 +28,15 @@ public:
 
     virtual std::unique_ptr<WaterfillIterator> make_iterator(size_t min_area) = 0;
 
+    //  Same as above, but only start objects in the tiles that overlap the
+    //  pixel rectangle [min_x, max_x) x [min_y, max_y). Objects are still
+    //  filled in their entirety even if they extend outside the rectangle.
+    virtual std::unique_ptr<WaterfillIterator> make_iterator(
+        size_t min_area,
+        size_t min_x, size_t min_y,
+        size_t max_x, size_t max_y
+    ) = 0;
+
     //  Get the object at the specific bit position.
     //  The object will be removed from the input matrix.
     //  Return true if there is an object at the bit (x, y); false otherwise.
@@ -79,6 +79,11 @@ public:
     size_t tile_height() const{ return m_source->tile_height(); }
 
     virtual std::unique_ptr<WaterfillIterator> make_iterator(size_t min_area) override;
+    virtual std::unique_ptr<WaterfillIterator> make_iterator(
+        size_t min_area,
+        size_t min_x, size_t min_y,
+        size_t max_x, size_t max_y
+    ) override;
 
     //  Get the object at the specific bit position.
     //  The object will be removed from the input matrix.
@@ -138,12 +143,34 @@ public:
     WaterfillIterator_t(WaterfillSession_t<Tile, TileRoutines>& session, size_t min_area)
         : m_session(session)
         , m_min_area(min_area)
+        , m_tile_col_start(0)
+        , m_tile_col_end(session.tile_width())
+        , m_tile_row_end(session.tile_height())
+    {}
+    WaterfillIterator_t(
+        WaterfillSession_t<Tile, TileRoutines>& session, size_t min_area,
+        size_t min_x, size_t min_y,
+        size_t max_x, size_t max_y
+    )
+        : m_session(session)
+        , m_min_area(min_area)
+        , m_tile_col_start(min_x / Tile::WIDTH)
+        , m_tile_col_end(std::min((max_x + Tile::WIDTH - 1) / Tile::WIDTH, session.tile_width()))
+        , m_tile_row_end(std::min((max_y + Tile::HEIGHT - 1) / Tile::HEIGHT, session.tile_height()))
+        , m_tile_row(min_y / Tile::HEIGHT)
+        , m_tile_col(m_tile_col_start)
     {}
     virtual bool find_next(WaterfillObject& object, bool keep_object) override;
 
 private:
     WaterfillSession_t<Tile, TileRoutines>& m_session;
     size_t m_min_area;
+
+    //  Range of tiles to search. (end is one past the last)
+    size_t m_tile_col_start;
+    size_t m_tile_col_end;
+    size_t m_tile_row_end;
+
     size_t m_tile_row = 0;
     size_t m_tile_col = 0;
 };
@@ -156,6 +183,18 @@ template <typename Tile, typename TileRoutines>
 std::unique_ptr<WaterfillIterator> WaterfillSession_t<Tile, TileRoutines>::make_iterator(size_t min_area){
     return std::make_unique<WaterfillIterator_t<Tile, TileRoutines>>(*this, min_area);
 }
+template <typename Tile, typename TileRoutines>
+std::unique_ptr<WaterfillIterator> WaterfillSession_t<Tile, TileRoutines>::make_iterator(
+    size_t min_area,
+    size_t min_x, size_t min_y,
+    size_t max_x, size_t max_y
+){
+    return std::make_unique<WaterfillIterator_t<Tile, TileRoutines>>(
+        *this, min_area,
+        min_x, min_y,
+        max_x, max_y
+    );
+}
 
 
 template <typename Tile, typename TileRoutines>
@@ -379,8 +418,8 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
 
 template <typename Tile, typename TileRoutines>
 bool WaterfillIterator_t<Tile, TileRoutines>::find_next(WaterfillObject& object, bool keep_object){
-    while (m_tile_row < m_session.tile_height()){
-        while (m_tile_col < m_session.tile_width()){
+    while (m_tile_row < m_tile_row_end){
+        while (m_tile_col < m_tile_col_end){
             while (true){
                 //  Not object found. Move to next tile.
                 if (!m_session.find_object_in_tile(object, keep_object, m_tile_col, m_tile_row)){
@@ -394,7 +433,7 @@ bool WaterfillIterator_t<Tile, TileRoutines>::find_next(WaterfillObject& object,
             }
             m_tile_col++;
         }
-        m_tile_col = 0;
+        m_tile_col = m_tile_col_start;
         m_tile_row++;
     }
     return false;
@@ -0,0 +1,42 @@
+/*  Xoroshiro128+
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_Xoroshiro128Plus.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void xoroshiro128plus_last_bits_Default(
+    uint64_t* out, size_t stride, size_t words,
+    uint64_t s0[XOROSHIRO128PLUS_LANES],
+    uint64_t s1[XOROSHIRO128PLUS_LANES]
+);
+void xoroshiro128plus_last_bits_x64_AVX2(
+    uint64_t* out, size_t stride, size_t words,
+    uint64_t s0[XOROSHIRO128PLUS_LANES],
+    uint64_t s1[XOROSHIRO128PLUS_LANES]
+);
+
+void xoroshiro128plus_last_bits(
+    uint64_t* out, size_t stride, size_t words,
+    uint64_t s0[XOROSHIRO128PLUS_LANES],
+    uint64_t s1[XOROSHIRO128PLUS_LANES]
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        xoroshiro128plus_last_bits_x64_AVX2(out, stride, words, s0, s1);
+        return;
+    }
+#endif
+    xoroshiro128plus_last_bits_Default(out, stride, words, s0, s1);
+}
+
+
+
+}
+}
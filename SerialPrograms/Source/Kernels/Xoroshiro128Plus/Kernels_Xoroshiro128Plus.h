@@ -0,0 +1,36 @@
+/*  Xoroshiro128+
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *      Several Xoroshiro128+ generators stepped side by side.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_Xoroshiro128Plus_H
+#define PokemonAutomation_Kernels_Xoroshiro128Plus_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+const size_t XOROSHIRO128PLUS_LANES = 8;
+
+
+//  For each lane "l", write the lowest bit of the next "words * 64" results
+//  of generator (s0[l], s1[l]) into out[l * stride + 0 ... words - 1].
+//  Result "i" goes into bit (i % 64) of word (i / 64).
+//
+//  The generators are left at the state after the last result.
+void xoroshiro128plus_last_bits(
+    uint64_t* out, size_t stride, size_t words,
+    uint64_t s0[XOROSHIRO128PLUS_LANES],
+    uint64_t s1[XOROSHIRO128PLUS_LANES]
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,40 @@
+/*  Xoroshiro128+ (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "Kernels_Xoroshiro128Plus.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void xoroshiro128plus_last_bits_Default(
+    uint64_t* out, size_t stride, size_t words,
+    uint64_t s0[XOROSHIRO128PLUS_LANES],
+    uint64_t s1[XOROSHIRO128PLUS_LANES]
+){
+    for (size_t l = 0; l < XOROSHIRO128PLUS_LANES; l++){
+        uint64_t x0 = s0[l];
+        uint64_t x1 = s1[l];
+        for (size_t w = 0; w < words; w++){
+            uint64_t bits = 0;
+            for (size_t b = 0; b < 64; b++){
+                //  Shift in from the top so that after 64 results the first
+                //  one ends up in bit 0.
+                bits = (bits >> 1) | ((x0 + x1) << 63);
+                uint64_t t = x0 ^ x1;
+                x0 = ((x0 << 24) | (x0 >> 40)) ^ t ^ (t << 16);
+                x1 = (t << 37) | (t >> 27);
+            }
+            out[l * stride + w] = bits;
+        }
+        s0[l] = x0;
+        s1[l] = x1;
+    }
+}
+
+
+}
+}
@@ -0,0 +1,77 @@
+/*  Xoroshiro128+ (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_Xoroshiro128Plus.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct Xoroshiro128Plus_x64_AVX2{
+    __m256i s0;
+    __m256i s1;
+    __m256i bits;
+
+    template <int k>
+    static PA_FORCE_INLINE __m256i rotl(__m256i x){
+        return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+    }
+
+    PA_FORCE_INLINE void step(){
+        bits = _mm256_or_si256(
+            _mm256_srli_epi64(bits, 1),
+            _mm256_slli_epi64(_mm256_add_epi64(s0, s1), 63)
+        );
+        __m256i t = _mm256_xor_si256(s0, s1);
+        s0 = _mm256_xor_si256(_mm256_xor_si256(rotl<24>(s0), t), _mm256_slli_epi64(t, 16));
+        s1 = rotl<37>(t);
+    }
+};
+
+
+void xoroshiro128plus_last_bits_x64_AVX2(
+    uint64_t* out, size_t stride, size_t words,
+    uint64_t s0[XOROSHIRO128PLUS_LANES],
+    uint64_t s1[XOROSHIRO128PLUS_LANES]
+){
+    static_assert(XOROSHIRO128PLUS_LANES == 8);
+
+    //  Two independent vectors to hide the latency of each step.
+    Xoroshiro128Plus_x64_AVX2 lo, hi;
+    lo.s0 = _mm256_loadu_si256((const __m256i*)(s0 + 0));
+    lo.s1 = _mm256_loadu_si256((const __m256i*)(s1 + 0));
+    hi.s0 = _mm256_loadu_si256((const __m256i*)(s0 + 4));
+    hi.s1 = _mm256_loadu_si256((const __m256i*)(s1 + 4));
+
+    for (size_t w = 0; w < words; w++){
+        lo.bits = _mm256_setzero_si256();
+        hi.bits = _mm256_setzero_si256();
+        for (size_t b = 0; b < 64; b++){
+            lo.step();
+            hi.step();
+        }
+        alignas(32) uint64_t bits[8];
+        _mm256_store_si256((__m256i*)(bits + 0), lo.bits);
+        _mm256_store_si256((__m256i*)(bits + 4), hi.bits);
+        for (size_t l = 0; l < 8; l++){
+            out[l * stride + w] = bits[l];
+        }
+    }
+
+    _mm256_storeu_si256((__m256i*)(s0 + 0), lo.s0);
+    _mm256_storeu_si256((__m256i*)(s1 + 0), lo.s1);
+    _mm256_storeu_si256((__m256i*)(s0 + 4), hi.s0);
+    _mm256_storeu_si256((__m256i*)(s1 + 4), hi.s1);
+}
+
+
+}
+}
+#endif
@@ -12,6 +12,7 @@
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
+#include "CommonFramework/Resources/ResourcePreloader.h"
 #include "CommonFramework/Tools/BlackBorderCheck.h"
 #include "NintendoSwitch_MultiSwitchProgramOption.h"
 #include "NintendoSwitch_MultiSwitchProgramSession.h"
@@ -84,6 +85,8 @@ void MultiSwitchProgramSession::run_program_instance(MultiSwitchProgramEnvironme
         start_program_video_check(env.consoles[c], m_option.descriptor().feedback());
     }
 
+    ResourcePreloader::instance().wait_for(m_option.descriptor().required_resources());
+
     m_scope.store(&scope, std::memory_order_release);
 
     try{
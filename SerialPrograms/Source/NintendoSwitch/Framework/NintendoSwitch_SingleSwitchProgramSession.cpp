@@ -11,6 +11,7 @@
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "CommonFramework/Notifications/ProgramInfo.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
+#include "CommonFramework/Resources/ResourcePreloader.h"
 #include "CommonFramework/Tools/BlackBorderCheck.h"
 #include "NintendoSwitch_SingleSwitchProgramOption.h"
 #include "NintendoSwitch_SingleSwitchProgramSession.h"
@@ -63,6 +64,8 @@ void SingleSwitchProgramSession::run_program_instance(SingleSwitchProgramEnviron
 
     start_program_video_check(env.console, m_option.descriptor().feedback());
 
+    ResourcePreloader::instance().wait_for(m_option.descriptor().required_resources());
+
     m_scope.store(&scope, std::memory_order_release);
 
     try{
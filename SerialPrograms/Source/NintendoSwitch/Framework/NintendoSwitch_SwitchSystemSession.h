@@ -31,6 +31,7 @@
 namespace PokemonAutomation{
     class CpuUtilizationStat;
     class ThreadUtilizationStat;
+    class SerialConnectionStat;
 namespace NintendoSwitch{
 
 class SwitchSystemOption;
@@ -87,6 +88,7 @@ private:
 
     std::unique_ptr<CpuUtilizationStat> m_cpu_utilization;
     std::unique_ptr<ThreadUtilizationStat> m_main_thread_utilization;
+    std::unique_ptr<SerialConnectionStat> m_serial_connection;
 };
 
 
@@ -0,0 +1,33 @@
+/*  Pokemon Preload
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/Resources/ResourcePreloader.h"
+#include "Pokemon/Inference/Pokemon_NameReader.h"
+#include "Pokemon_Preload.h"
+
+namespace PokemonAutomation{
+namespace Pokemon{
+
+
+const std::string PRELOAD_POKEMON_NAME_READER = "Pokemon: Name Reader";
+
+
+void register_preload_resources(){
+    ResourcePreloader& preloader = ResourcePreloader::instance();
+    preloader.add(
+        PRELOAD_POKEMON_NAME_READER, std::chrono::milliseconds(500), {},
+        []{ PokemonNameReader::instance(); }
+    );
+
+    //  Most programs build their language option from this reader, so it's
+    //  needed as soon as almost any panel is opened.
+    preloader.preload({PRELOAD_POKEMON_NAME_READER});
+}
+
+
+
+}
+}
@@ -0,0 +1,28 @@
+/*  Pokemon Preload
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Resources shared by all the Pokemon games. See ResourcePreloader.
+ *
+ */
+
+#ifndef PokemonAutomation_Pokemon_Preload_H
+#define PokemonAutomation_Pokemon_Preload_H
+
+#include <string>
+
+namespace PokemonAutomation{
+namespace Pokemon{
+
+
+extern const std::string PRELOAD_POKEMON_NAME_READER;
+
+
+//  Safe to call from every game that uses these.
+void register_preload_resources();
+
+
+
+}
+}
+#endif
@@ -6,7 +6,7 @@
 
 #include "Common/Cpp/PrettyPrint.h"
 //#include "Kernels/Waterfill/Kernels_Waterfill.h"
-#include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_ComponentTree.h"
 #include "CommonFramework/ImageTools/BinaryImage_FilterRgb32.h"
 //#include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_SparkleDetectorRadial.h"
@@ -86,11 +86,10 @@ void ShinySparkleSetBDSP::update_alphas(){
 
 
 
-ShinySparkleSetBDSP find_sparkles(WaterfillSession& session){
+ShinySparkleSetBDSP find_sparkles(const WaterfillComponentTree& tree, size_t level){
     ShinySparkleSetBDSP sparkles;
-    auto finder = session.make_iterator(20);
-    WaterfillObject object;
-    while (finder->find_next(object, true)){
+    for (size_t index : tree.level(level)){
+        const WaterfillObject& object = tree.node(index).object;
         PokemonSwSh::RadialSparkleDetector radial_sparkle(object);
         if (radial_sparkle.is_ball()){
             sparkles.balls.emplace_back(object.min_x, object.min_y, object.max_x, object.max_y);
@@ -118,12 +117,15 @@ void ShinySparkleSetBDSP::read_from_image(const ImageViewRGB32& image){
             {0xff909000, 0xffffffff},
         }
     );
-    auto session = make_WaterfillSession();
+    std::vector<PackedBinaryMatrix_IB*> levels;
+    for (PackedBinaryMatrix& matrix : matrices){
+        levels.emplace_back(&static_cast<PackedBinaryMatrix_IB&>(matrix));
+    }
+    WaterfillComponentTree tree(levels, 20);
 
     double best_alpha = 0;
-    for (PackedBinaryMatrix& matrix : matrices){
-        session->set_source(matrix);
-        ShinySparkleSetBDSP sparkles = find_sparkles(*session);
+    for (size_t level = 0; level < tree.levels(); level++){
+        ShinySparkleSetBDSP sparkles = find_sparkles(tree, level);
         sparkles.update_alphas();
         double alpha = sparkles.alpha_overall();
         if (best_alpha < alpha){
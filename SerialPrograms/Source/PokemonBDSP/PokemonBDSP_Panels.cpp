@@ -5,6 +5,7 @@
  */
 
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "Pokemon/Resources/Pokemon_Preload.h"
 #include "PokemonBDSP_Panels.h"
 
 #include "PokemonBDSP_Settings.h"
@@ -49,7 +50,9 @@ namespace PokemonBDSP{
 
 PanelListFactory::PanelListFactory()
     : PanelListDescriptor(Pokemon::STRING_POKEMON + " Brilliant Diamond and Shining Pearl")
-{}
+{
+    Pokemon::register_preload_resources();
+}
 
 std::vector<PanelEntry> PanelListFactory::make_panels() const{
     std::vector<PanelEntry> ret;
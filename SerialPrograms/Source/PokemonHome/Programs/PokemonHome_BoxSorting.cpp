@@ -7,7 +7,6 @@
 /* TODO ideas
 break into smaller functions
 read pokemon name and store the slug (easier to detect missread than reading a number)
-Optimise the swapping algo
 Add enum for ball ? Also, BDSP is reading from swsh data. Worth refactoring ?
 
 ideas for more checks :
@@ -24,10 +23,13 @@ language
 "stamps"
 */
 
+#include <stdlib.h>
 #include <map>
 #include <optional>
 #include <sstream>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
@@ -49,6 +51,7 @@ language
 #include "PokemonSwSh/Commands/PokemonSwSh_Commands_GameEntry.h"
 #include "PokemonSwSh/Programs/ReleaseHelpers.h"
 #include "PokemonHome_BoxSorting.h"
+#include "PokemonHome_BoxSortingPlanner.h"
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -57,8 +60,6 @@ using namespace Pokemon;
 
 
 const size_t MAX_BOXES = 200;
-const size_t MAX_COLUMNS = 6;
-const size_t MAX_ROWS = 5;
 
 BoxSorting_Descriptor::BoxSorting_Descriptor()
     : SingleSwitchProgramDescriptor(
@@ -138,106 +139,6 @@ BoxSorting::BoxSorting()
 
 
 
-struct Cursor{
-    size_t box;
-    size_t row;
-    size_t column;
-};
-
-std::ostream& operator<<(std::ostream& os, const Cursor& cursor){
-    os << "(" << cursor.box << "/" << cursor.row << "/" << cursor.column << ")";
-    return os;
-}
-
-Cursor get_cursor(size_t index){
-    Cursor ret;
-
-    ret.column = index % MAX_COLUMNS;
-    index = index / MAX_COLUMNS;
-
-    ret.row = index % MAX_ROWS;
-    index = index / MAX_ROWS;
-
-    ret.box = index;
-    return ret;
-}
-
-size_t get_index(size_t box, size_t row, size_t column){
-    return box * MAX_ROWS * MAX_COLUMNS + row * MAX_COLUMNS + column;
-}
-
-
-
-struct Pokemon{
-    const std::vector<BoxSortingSelection>* preferences;
-
-    // When adding any new member here, do not forget to modify the operators below (ctrl-f "new struct members")
-    uint16_t national_dex_number = 0;
-    bool shiny = false;
-    bool gmax = false;
-    std::string ball_slug = "";
-    StatsHuntGenderFilter gender = StatsHuntGenderFilter::Genderless;
-    uint32_t ot_id = 0;
-};
-
-bool operator==(const Pokemon& lhs, const Pokemon& rhs){
-    // NOTE edit when adding new struct members
-    return lhs.national_dex_number == rhs.national_dex_number &&
-           lhs.shiny == rhs.shiny &&
-           lhs.gmax == rhs.gmax &&
-           lhs.ball_slug == rhs.ball_slug &&
-           lhs.gender == rhs.gender;
-}
-
-bool operator<(const std::optional<Pokemon>& lhs, const std::optional<Pokemon>& rhs){
-    if (!lhs.has_value()){
-        return false;
-    }
-    if (!rhs.has_value()){
-        return true;
-    }
-
-    for (const BoxSortingSelection preference : *lhs->preferences){
-        switch(preference.sort_type) {
-        // NOTE edit when adding new struct members
-        // TODO TESTING and account for preference.reverse
-        case BoxSortingSortType::NationalDexNo:
-            if (lhs->national_dex_number != rhs->national_dex_number){
-                return lhs->national_dex_number < rhs->national_dex_number;
-            }
-            break;
-        case BoxSortingSortType::Shiny:
-            if (lhs->shiny != rhs->shiny){
-                return lhs->shiny;
-            }
-            break;
-        case BoxSortingSortType::Gigantamax:
-            if (lhs->gmax != rhs->gmax){
-                return lhs->gmax;
-            }
-            break;
-        case BoxSortingSortType::Ball_Slug:
-            if (lhs->ball_slug < rhs->ball_slug){
-                return true;
-            }
-            if (lhs->ball_slug > rhs->ball_slug){
-                return false;
-            }
-            break;
-        case BoxSortingSortType::Gender:
-            if (lhs->gender < rhs->gender){
-                return true;
-            }
-            if (lhs->gender > rhs->gender){
-                return false;
-            }
-            break;
-        }
-    }
-
-    return lhs->national_dex_number < rhs->national_dex_number;
-}
-
 std::ostream& operator<<(std::ostream& os, const std::optional<Pokemon>& pokemon)
 {
     if (pokemon.has_value()){
@@ -313,54 +214,27 @@ bool go_to_first_slot(SingleSwitchProgramEnvironment& env, BotBaseContext& conte
     ss << "Moving cursor from " << cur_cursor << " to " << dest_cursor;
     env.console.log(ss.str());
 
-    // TODO: shortest path movement though pages, boxes
-    for (size_t i = cur_cursor.box; i < dest_cursor.box; ++i){
+    CursorMoves moves = get_cursor_moves(cur_cursor, dest_cursor);
+
+    for (int64_t i = 0; i < moves.boxes; ++i){
         pbf_press_button(context, BUTTON_R, 10, GAME_DELAY+30);
     }
-    for (size_t i = dest_cursor.box; i < cur_cursor.box; ++i){
+    for (int64_t i = 0; i < -moves.boxes; ++i){
         pbf_press_button(context, BUTTON_L, 10, GAME_DELAY+30);
     }
 
-
-    // direct nav up or down through rows
-    if (!(cur_cursor.row == 0 && dest_cursor.row == 4) && !(dest_cursor.row == 0 && cur_cursor.row == 4)) {
-        for (size_t i = cur_cursor.row; i < dest_cursor.row; ++i){
-            pbf_press_dpad(context, DPAD_DOWN, 10, GAME_DELAY);
-        }
-        for (size_t i = dest_cursor.row; i < cur_cursor.row; ++i){
-            pbf_press_dpad(context, DPAD_UP, 10, GAME_DELAY);
-        }
-    } else { // wrap around is faster to move between first or last row
-        if (cur_cursor.row == 0 && dest_cursor.row == 4) {
-            for (size_t i = 0; i <= 2; ++i){
-                pbf_press_dpad(context, DPAD_UP, 10, GAME_DELAY);
-            }
-        } else {
-            for (size_t i = 0; i <= 2; ++i){
-                pbf_press_dpad(context, DPAD_DOWN, 10, GAME_DELAY);
-            }
-        }
+    for (int64_t i = 0; i < moves.rows; ++i){
+        pbf_press_dpad(context, DPAD_DOWN, 10, GAME_DELAY);
+    }
+    for (int64_t i = 0; i < -moves.rows; ++i){
+        pbf_press_dpad(context, DPAD_UP, 10, GAME_DELAY);
     }
 
-    // direct nav forward or backward through columns
-    if ((dest_cursor.column > cur_cursor.column && dest_cursor.column - cur_cursor.column <= 3) || (cur_cursor.column > dest_cursor.column && cur_cursor.column - dest_cursor.column <= 3)) {
-        for (size_t i = cur_cursor.column; i < dest_cursor.column; ++i){
-            pbf_press_dpad(context, DPAD_RIGHT, 10, GAME_DELAY);
-        }
-        for (size_t i = dest_cursor.column; i < cur_cursor.column; ++i){
-            pbf_press_dpad(context, DPAD_LEFT, 10, GAME_DELAY);
-        }
-    } else { // wrap around is faster if direct movement is more than 3 away
-        if (dest_cursor.column > cur_cursor.column) {
-            for (size_t i = 0; i < MAX_COLUMNS - (dest_cursor.column - cur_cursor.column); ++i){
-                pbf_press_dpad(context, DPAD_LEFT, 10, GAME_DELAY);
-            }
-        }
-        if (cur_cursor.column > dest_cursor.column) {
-            for (size_t i = 0; i < MAX_COLUMNS - (cur_cursor.column - dest_cursor.column); ++i){
-                pbf_press_dpad(context, DPAD_RIGHT, 10, GAME_DELAY);
-            }
-        }
+    for (int64_t i = 0; i < moves.columns; ++i){
+        pbf_press_dpad(context, DPAD_RIGHT, 10, GAME_DELAY);
+    }
+    for (int64_t i = 0; i < -moves.columns; ++i){
+        pbf_press_dpad(context, DPAD_LEFT, 10, GAME_DELAY);
     }
 
     context.wait_for_all_requests();
@@ -398,59 +272,55 @@ void output_boxes_data_json(const std::vector<std::optional<Pokemon>>& boxes_dat
     pokemon_data.dump(json_path + ".json");
 }
 
+void output_sort_plan_json(const SortPlan& plan, const std::string& path){
+    JsonArray swaps;
+    for (const SortSwap& swap : plan.swaps){
+        JsonObject entry;
+        for (const auto& item : {std::make_pair("pick", swap.pick), std::make_pair("drop", swap.drop)}){
+            Cursor cursor = get_cursor(item.second);
+            JsonObject slot;
+            slot["index"] = item.second;
+            slot["box"] = cursor.box;
+            slot["row"] = cursor.row;
+            slot["column"] = cursor.column;
+            entry[item.first] = std::move(slot);
+        }
+        swaps.push_back(std::move(entry));
+    }
+    swaps.dump(path);
+}
+
 void do_sort(
     SingleSwitchProgramEnvironment& env,
     BotBaseContext& context,
     std::vector<std::optional<Pokemon>> boxes_data,
-    std::vector<std::optional<Pokemon>> boxes_sorted,
+    const SortPlan& plan,
     BoxSorting_Descriptor::Stats& stats,
     Cursor& cur_cursor,
     uint16_t GAME_DELAY
     ) {
     std::ostringstream ss;
-    // this need to be separated into functions when I will redo the whole thing but I just wanted it to work
-
-    // going thru the sorted list one by one and for each one go through the current pokemon layout to find the closest possible match to fill the slot
-    for (size_t poke_nb_s = 0; poke_nb_s < boxes_sorted.size(); poke_nb_s++){
-        if (boxes_sorted[poke_nb_s] == std::nullopt){ // we've hit the end of the sorted list.
-            break;
-        }
-        for (size_t poke_nb = poke_nb_s; poke_nb < boxes_data.size(); poke_nb++){
-            Cursor cursor_s = get_cursor(poke_nb_s);
-            Cursor cursor = get_cursor(poke_nb);
-
-            // ss << "Comparing " << boxes_data[poke_nb] << " at " << cursor << " to " << boxes_sorted[poke_nb_s] << " at " << cursor_s;
-            // env.console.log(ss.str());
-            // ss.str("");
-
-            //check for a match and also check if the pokemon is not already in the slot
-            stats.compare++;
-            env.update_stats();
-            if(boxes_sorted[poke_nb_s] == boxes_data[poke_nb] && poke_nb_s == poke_nb){ // Same spot no need to move.
-                break;
-            }
-            if(boxes_sorted[poke_nb_s] == boxes_data[poke_nb]){
-                ss << "Swapping " << boxes_data[poke_nb] << " at " << cursor << " and " << boxes_sorted[poke_nb_s] << " at " << cursor_s;
-                env.console.log(ss.str());
-                ss.str("");
+    for (const SortSwap& swap : plan.swaps){
+        Cursor cursor = get_cursor(swap.pick);
+        Cursor cursor_s = get_cursor(swap.drop);
 
-                //moving cursor to the pokemon to pick it up
-                cur_cursor = move_cursor_to(env, context, cur_cursor, cursor, GAME_DELAY);
-                pbf_press_button(context, BUTTON_Y, 10, GAME_DELAY+30);
+        ss << "Swapping " << boxes_data[swap.pick] << " at " << cursor << " and " << boxes_data[swap.drop] << " at " << cursor_s;
+        env.console.log(ss.str());
+        ss.str("");
 
-                //moving to destination to place it or swap it
-                cur_cursor = move_cursor_to(env, context, cur_cursor, cursor_s, GAME_DELAY);
-                pbf_press_button(context, BUTTON_Y, 10, GAME_DELAY+30);
+        //moving cursor to the pokemon to pick it up
+        cur_cursor = move_cursor_to(env, context, cur_cursor, cursor, GAME_DELAY);
+        pbf_press_button(context, BUTTON_Y, 10, GAME_DELAY+30);
 
-                context.wait_for_all_requests();
+        //moving to destination to place it or swap it
+        cur_cursor = move_cursor_to(env, context, cur_cursor, cursor_s, GAME_DELAY);
+        pbf_press_button(context, BUTTON_Y, 10, GAME_DELAY+30);
 
-                std::swap(boxes_data[poke_nb_s], boxes_data[poke_nb]);
-                stats.swaps++;
-                env.update_stats();
+        context.wait_for_all_requests();
 
-                break;
-            }
-        }
+        std::swap(boxes_data[swap.drop], boxes_data[swap.pick]);
+        stats.swaps++;
+        env.update_stats();
     }
 }
 
@@ -716,8 +586,26 @@ void BoxSorting::program(SingleSwitchProgramEnvironment& env, BotBaseContext& co
     const std::string sorted_path = json_path + "-sorted";
     output_boxes_data_json(boxes_sorted, sorted_path);
 
-    if (!DRY_RUN) {
-        do_sort(env, context, boxes_data, boxes_sorted, stats, cur_cursor, GAME_DELAY);
+    SortPlan greedy_plan = plan_sort_greedy(boxes_data, boxes_sorted);
+    SortPlan plan = plan_sort_by_cycles(boxes_data, boxes_sorted, greedy_plan, cur_cursor, GAME_DELAY);
+    output_sort_plan_json(plan, json_path + ".sortplan");
+    stats.compare += plan.compares;
+    env.update_stats();
+
+    auto ticks_to_string = [](uint64_t ticks){
+        return duration_to_string(std::chrono::milliseconds(ticks * 1000 / TICKS_PER_SECOND));
+    };
+    uint64_t greedy_ticks = estimate_sort_ticks(greedy_plan, cur_cursor, GAME_DELAY);
+    uint64_t plan_ticks = estimate_sort_ticks(plan, cur_cursor, GAME_DELAY);
+    std::string summary =
+        "Sort plan: " + std::to_string(plan.swaps.size()) + " swaps, about " + ticks_to_string(plan_ticks) +
+        ". (first-match order: " + std::to_string(greedy_plan.swaps.size()) + " swaps, about " + ticks_to_string(greedy_ticks) + ")";
+    env.console.log(summary, COLOR_BLUE);
+    if (DRY_RUN) {
+        env.console.overlay().add_log("Plan: " + ticks_to_string(plan_ticks), COLOR_WHITE);
+        env.console.overlay().add_log("First match: " + ticks_to_string(greedy_ticks), COLOR_WHITE);
+    } else {
+        do_sort(env, context, boxes_data, plan, stats, cur_cursor, GAME_DELAY);
     }
 
     send_program_finished_notification(env, NOTIFICATION_PROGRAM_FINISH);
@@ -0,0 +1,436 @@
+/*  Home Box Sorting Planner
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdlib.h>
+#include <algorithm>
+#include <map>
+#include "PokemonHome_BoxSortingPlanner.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonHome{
+
+
+std::ostream& operator<<(std::ostream& os, const Cursor& cursor){
+    os << "(" << cursor.box << "/" << cursor.row << "/" << cursor.column << ")";
+    return os;
+}
+
+Cursor get_cursor(size_t index){
+    Cursor ret;
+
+    ret.column = index % MAX_COLUMNS;
+    index = index / MAX_COLUMNS;
+
+    ret.row = index % MAX_ROWS;
+    index = index / MAX_ROWS;
+
+    ret.box = index;
+    return ret;
+}
+
+size_t get_index(size_t box, size_t row, size_t column){
+    return box * MAX_ROWS * MAX_COLUMNS + row * MAX_COLUMNS + column;
+}
+
+
+
+bool operator==(const Pokemon& lhs, const Pokemon& rhs){
+    // NOTE edit when adding new struct members
+    return lhs.national_dex_number == rhs.national_dex_number &&
+           lhs.shiny == rhs.shiny &&
+           lhs.gmax == rhs.gmax &&
+           lhs.ball_slug == rhs.ball_slug &&
+           lhs.gender == rhs.gender;
+}
+
+bool operator<(const std::optional<Pokemon>& lhs, const std::optional<Pokemon>& rhs){
+    if (!lhs.has_value()){
+        return false;
+    }
+    if (!rhs.has_value()){
+        return true;
+    }
+
+    for (const BoxSortingSelection preference : *lhs->preferences){
+        switch(preference.sort_type) {
+        // NOTE edit when adding new struct members
+        // TODO TESTING and account for preference.reverse
+        case BoxSortingSortType::NationalDexNo:
+            if (lhs->national_dex_number != rhs->national_dex_number){
+                return lhs->national_dex_number < rhs->national_dex_number;
+            }
+            break;
+        case BoxSortingSortType::Shiny:
+            if (lhs->shiny != rhs->shiny){
+                return lhs->shiny;
+            }
+            break;
+        case BoxSortingSortType::Gigantamax:
+            if (lhs->gmax != rhs->gmax){
+                return lhs->gmax;
+            }
+            break;
+        case BoxSortingSortType::Ball_Slug:
+            if (lhs->ball_slug < rhs->ball_slug){
+                return true;
+            }
+            if (lhs->ball_slug > rhs->ball_slug){
+                return false;
+            }
+            break;
+        case BoxSortingSortType::Gender:
+            if (lhs->gender < rhs->gender){
+                return true;
+            }
+            if (lhs->gender > rhs->gender){
+                return false;
+            }
+            break;
+        }
+    }
+
+    return lhs->national_dex_number < rhs->national_dex_number;
+}
+
+
+
+CursorMoves get_cursor_moves(const Cursor& cur_cursor, const Cursor& dest_cursor){
+    CursorMoves moves;
+    moves.boxes = (int64_t)dest_cursor.box - (int64_t)cur_cursor.box;
+
+    // wrap around is faster to move between first or last row
+    if (cur_cursor.row == 0 && dest_cursor.row == 4){
+        moves.rows = -3;
+    }else if (dest_cursor.row == 0 && cur_cursor.row == 4){
+        moves.rows = 3;
+    }else{
+        moves.rows = (int64_t)dest_cursor.row - (int64_t)cur_cursor.row;
+    }
+
+    // wrap around is faster if direct movement is more than 3 away
+    moves.columns = (int64_t)dest_cursor.column - (int64_t)cur_cursor.column;
+    if (moves.columns > 3){
+        moves.columns -= (int64_t)MAX_COLUMNS;
+    }else if (moves.columns < -3){
+        moves.columns += (int64_t)MAX_COLUMNS;
+    }
+
+    return moves;
+}
+
+uint64_t move_cursor_ticks(const Cursor& cur_cursor, const Cursor& dest_cursor, uint16_t GAME_DELAY){
+    CursorMoves moves = get_cursor_moves(cur_cursor, dest_cursor);
+    return std::abs(moves.boxes) * (10 + GAME_DELAY + 30) +
+           (std::abs(moves.rows) + std::abs(moves.columns)) * (10 + GAME_DELAY);
+}
+uint64_t press_y_ticks(uint16_t GAME_DELAY){
+    return 10 + GAME_DELAY + 30;
+}
+
+
+
+// Go through the sorted list one by one and for each one, go through the
+// current layout to find the first match to fill the slot.
+SortPlan plan_sort_greedy(
+    std::vector<std::optional<Pokemon>> boxes_data,
+    const std::vector<std::optional<Pokemon>>& boxes_sorted
+){
+    SortPlan plan;
+    for (size_t poke_nb_s = 0; poke_nb_s < boxes_sorted.size(); poke_nb_s++){
+        if (boxes_sorted[poke_nb_s] == std::nullopt){ // we've hit the end of the sorted list.
+            break;
+        }
+        for (size_t poke_nb = poke_nb_s; poke_nb < boxes_data.size(); poke_nb++){
+            plan.compares++;
+            if (boxes_sorted[poke_nb_s] == boxes_data[poke_nb] && poke_nb_s == poke_nb){ // Same spot no need to move.
+                break;
+            }
+            if (boxes_sorted[poke_nb_s] == boxes_data[poke_nb]){
+                plan.swaps.emplace_back(SortSwap{poke_nb, poke_nb_s});
+                std::swap(boxes_data[poke_nb_s], boxes_data[poke_nb]);
+                break;
+            }
+        }
+    }
+    return plan;
+}
+
+uint64_t estimate_sort_ticks(const SortPlan& plan, Cursor cursor, uint16_t GAME_DELAY){
+    uint64_t ticks = 0;
+    for (const SortSwap& swap : plan.swaps){
+        Cursor pick = get_cursor(swap.pick);
+        Cursor drop = get_cursor(swap.drop);
+        ticks += move_cursor_ticks(cursor, pick, GAME_DELAY) + press_y_ticks(GAME_DELAY);
+        ticks += move_cursor_ticks(pick, drop, GAME_DELAY) + press_y_ticks(GAME_DELAY);
+        cursor = drop;
+    }
+    return ticks;
+}
+
+namespace{
+
+
+// Pick which slot each slot takes its Pokemon from. "source_of[slot]" is where
+// the Pokemon that ends up in "slot" starts.
+//
+// Identical Pokemon (and empty slots) are interchangeable, so this isn't fixed.
+// Each cycle saves a swap, so:
+//  1.  Pair up slots that just need to trade with each other.
+//  2.  Pair up the rest of the Pokemon in order.
+//  3.  That leaves chains that start with a Pokemon that needs to leave the
+//      sorted range and end at an empty slot in the sorted range. Close each
+//      chain on its own empty slot.
+std::vector<size_t> assign_sources_by_class(
+    const std::vector<std::optional<Pokemon>>& boxes_data,
+    const std::vector<std::optional<Pokemon>>& boxes_sorted,
+    uint64_t& compares
+){
+    const size_t slots = boxes_data.size();
+
+    // Split the slots into classes of identical Pokemon. Identical Pokemon are
+    // also tied in the sort order so each class is within one run of ties.
+    std::vector<size_t> class_slot;   // A slot of "boxes_sorted" in each class.
+    std::vector<size_t> target_class(slots);
+    for (size_t run = 0; run < slots;){
+        size_t first_class = class_slot.size();
+        size_t end = run;
+        for (; end < slots && !(boxes_sorted[run] < boxes_sorted[end]); end++){
+            size_t c = first_class;
+            for (; c < class_slot.size(); c++){
+                compares++;
+                if (boxes_sorted[class_slot[c]] == boxes_sorted[end]){
+                    break;
+                }
+            }
+            if (c == class_slot.size()){
+                class_slot.emplace_back(end);
+            }
+            target_class[end] = c;
+        }
+        run = end;
+    }
+    std::vector<size_t> current_class(slots);
+    for (size_t poke_nb = 0; poke_nb < slots; poke_nb++){
+        auto run = std::lower_bound(boxes_sorted.begin(), boxes_sorted.end(), boxes_data[poke_nb]);
+        size_t c = target_class[run - boxes_sorted.begin()];
+        for (;; c++){
+            compares++;
+            if (boxes_sorted[class_slot[c]] == boxes_data[poke_nb]){
+                break;
+            }
+        }
+        current_class[poke_nb] = c;
+    }
+
+    const size_t NONE = (size_t)-1;
+    std::vector<size_t> source_of(slots, NONE);
+    std::vector<size_t> target_of(slots, NONE);
+    auto assign = [&](size_t source, size_t target){
+        source_of[target] = source;
+        target_of[source] = target;
+    };
+
+    // Slots that need to change by (what they have, what they need).
+    std::map<std::pair<size_t, size_t>, std::vector<size_t>> misplaced;
+    for (size_t poke_nb = 0; poke_nb < slots; poke_nb++){
+        if (current_class[poke_nb] == target_class[poke_nb]){
+            assign(poke_nb, poke_nb);
+        }else{
+            misplaced[{current_class[poke_nb], target_class[poke_nb]}].emplace_back(poke_nb);
+        }
+    }
+
+    // 1.
+    for (auto& item : misplaced){
+        if (item.first.first > item.first.second){
+            continue;
+        }
+        auto iter = misplaced.find({item.first.second, item.first.first});
+        if (iter == misplaced.end()){
+            continue;
+        }
+        std::vector<size_t>& forward = item.second;
+        std::vector<size_t>& backward = iter->second;
+        size_t pairs = std::min(forward.size(), backward.size());
+        for (size_t i = 0; i < pairs; i++){
+            assign(forward[i], backward[i]);
+            assign(backward[i], forward[i]);
+        }
+        forward.erase(forward.begin(), forward.begin() + pairs);
+        backward.erase(backward.begin(), backward.begin() + pairs);
+    }
+
+    // 2.
+    size_t empty_class = NONE;
+    for (size_t poke_nb = 0; poke_nb < slots; poke_nb++){
+        if (!boxes_sorted[poke_nb].has_value()){
+            empty_class = target_class[poke_nb];
+            break;
+        }
+    }
+    std::vector<std::vector<size_t>> sources(class_slot.size());
+    std::vector<std::vector<size_t>> targets(class_slot.size());
+    for (size_t poke_nb = 0; poke_nb < slots; poke_nb++){
+        if (source_of[poke_nb] == NONE){
+            targets[target_class[poke_nb]].emplace_back(poke_nb);
+        }
+        if (target_of[poke_nb] == NONE){
+            sources[current_class[poke_nb]].emplace_back(poke_nb);
+        }
+    }
+    for (size_t c = 0; c < class_slot.size(); c++){
+        if (c == empty_class){
+            continue;
+        }
+        for (size_t i = 0; i < targets[c].size(); i++){
+            assign(sources[c][i], targets[c][i]);
+        }
+    }
+
+    // 3.
+    if (empty_class != NONE){
+        for (size_t poke_nb : targets[empty_class]){
+            size_t slot = poke_nb;
+            while (current_class[slot] != empty_class){
+                slot = target_of[slot];
+            }
+            assign(slot, poke_nb);
+        }
+    }
+
+    return source_of;
+}
+
+// The sources that the swaps of "plan" end up with.
+std::vector<size_t> assign_sources_by_plan(size_t slots, const SortPlan& plan){
+    std::vector<size_t> source_of(slots);
+    for (size_t poke_nb = 0; poke_nb < slots; poke_nb++){
+        source_of[poke_nb] = poke_nb;
+    }
+    for (const SortSwap& swap : plan.swaps){
+        std::swap(source_of[swap.pick], source_of[swap.drop]);
+    }
+    return source_of;
+}
+
+// Do the permutation in "source_of" one cycle at a time.
+//
+// Pick up a Pokemon and drop it on the slot that needs what's there. Whatever
+// was there is now under the cursor and gets carried around the cycle. So a
+// cycle of k slots takes k - 1 swaps and the cursor never goes back. The one
+// edge of the cycle that gets skipped is the most expensive one. Cycles are
+// done nearest first.
+SortPlan walk_cycles(
+    const std::vector<std::optional<Pokemon>>& boxes_data,
+    const std::vector<size_t>& source_of,
+    Cursor cursor,
+    uint16_t GAME_DELAY
+){
+    SortPlan plan;
+    const size_t slots = boxes_data.size();
+
+    // Walking a cycle means swapping (path[i], path[i + 1]) in order.
+    std::vector<std::vector<size_t>> paths;
+    std::vector<bool> visited(slots, false);
+    for (size_t poke_nb = 0; poke_nb < slots; poke_nb++){
+        if (visited[poke_nb] || source_of[poke_nb] == poke_nb){
+            continue;
+        }
+        std::vector<size_t> cycle;
+        for (size_t slot = poke_nb; !visited[slot]; slot = source_of[slot]){
+            visited[slot] = true;
+            cycle.emplace_back(slot);
+        }
+
+        // Start after the most expensive edge. The Pokemon being carried is
+        // whatever starts in the first slot, so that can't be empty.
+        const size_t NONE = (size_t)-1;
+        size_t start = NONE;
+        uint64_t worst = 0;
+        for (size_t i = 0; i < cycle.size(); i++){
+            size_t next = (i + 1) % cycle.size();
+            if (!boxes_data[cycle[next]].has_value()){
+                continue;
+            }
+            uint64_t ticks = move_cursor_ticks(get_cursor(cycle[i]), get_cursor(cycle[next]), GAME_DELAY);
+            if (start == NONE || worst <= ticks){
+                worst = ticks;
+                start = next;
+            }
+        }
+        if (start == NONE){
+            // Only empty slots. There is nothing to move.
+            continue;
+        }
+        std::rotate(cycle.begin(), cycle.begin() + start, cycle.end());
+        paths.emplace_back(std::move(cycle));
+    }
+
+    while (!paths.empty()){
+        size_t best = 0;
+        uint64_t best_ticks = UINT64_MAX;
+        for (size_t c = 0; c < paths.size(); c++){
+            uint64_t ticks = move_cursor_ticks(cursor, get_cursor(paths[c][0]), GAME_DELAY);
+            if (ticks < best_ticks){
+                best_ticks = ticks;
+                best = c;
+            }
+        }
+        const std::vector<size_t>& path = paths[best];
+        for (size_t i = 0; i + 1 < path.size(); i++){
+            plan.swaps.emplace_back(SortSwap{path[i], path[i + 1]});
+        }
+        cursor = get_cursor(path.back());
+        std::swap(paths[best], paths.back());
+        paths.pop_back();
+    }
+
+    return plan;
+}
+
+
+}
+
+
+// Treat the sort as a permutation and do it one cycle at a time.
+//
+// Two permutations are tried: the one from matching up identical Pokemon,
+// and the one that the first-match order ends up with. Walking the cycles of
+// the latter never takes more swaps than the first-match order itself. Keep
+// the fastest plan that is no worse than "greedy" in swaps or in time, or
+// "greedy" itself if there isn't one.
+SortPlan plan_sort_by_cycles(
+    const std::vector<std::optional<Pokemon>>& boxes_data,
+    const std::vector<std::optional<Pokemon>>& boxes_sorted,
+    const SortPlan& greedy,
+    Cursor cursor,
+    uint16_t GAME_DELAY
+){
+    uint64_t compares = greedy.compares;
+    SortPlan candidates[] = {
+        walk_cycles(boxes_data, assign_sources_by_class(boxes_data, boxes_sorted, compares), cursor, GAME_DELAY),
+        walk_cycles(boxes_data, assign_sources_by_plan(boxes_data.size(), greedy), cursor, GAME_DELAY),
+    };
+
+    SortPlan plan = greedy;
+    uint64_t plan_ticks = estimate_sort_ticks(greedy, cursor, GAME_DELAY);
+    for (SortPlan& candidate : candidates){
+        uint64_t ticks = estimate_sort_ticks(candidate, cursor, GAME_DELAY);
+        if (candidate.swaps.size() <= greedy.swaps.size() && ticks < plan_ticks){
+            plan = std::move(candidate);
+            plan_ticks = ticks;
+        }
+    }
+    plan.compares = compares;
+    return plan;
+}
+
+
+
+}
+}
+}
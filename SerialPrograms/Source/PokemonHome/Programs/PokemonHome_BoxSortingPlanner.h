@@ -0,0 +1,112 @@
+/*  Home Box Sorting Planner
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonHome_BoxSortingPlanner_H
+#define PokemonAutomation_PokemonHome_BoxSortingPlanner_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Pokemon/Options/Pokemon_StatsHuntFilter.h"
+#include "PokemonHome/Options/PokemonHome_BoxSortingTable.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonHome{
+using Pokemon::StatsHuntGenderFilter;
+
+
+const size_t MAX_COLUMNS = 6;
+const size_t MAX_ROWS = 5;
+
+
+struct Cursor{
+    size_t box;
+    size_t row;
+    size_t column;
+};
+
+std::ostream& operator<<(std::ostream& os, const Cursor& cursor);
+
+Cursor get_cursor(size_t index);
+size_t get_index(size_t box, size_t row, size_t column);
+
+
+
+struct Pokemon{
+    const std::vector<BoxSortingSelection>* preferences;
+
+    // When adding any new member here, do not forget to modify the operators below (ctrl-f "new struct members")
+    uint16_t national_dex_number = 0;
+    bool shiny = false;
+    bool gmax = false;
+    std::string ball_slug = "";
+    StatsHuntGenderFilter gender = StatsHuntGenderFilter::Genderless;
+    uint32_t ot_id = 0;
+};
+
+bool operator==(const Pokemon& lhs, const Pokemon& rhs);
+bool operator<(const std::optional<Pokemon>& lhs, const std::optional<Pokemon>& rhs);
+
+
+
+// Number of presses to get from one slot to another. The cursor wraps around
+// rows and columns, so this is not always the direct path.
+struct CursorMoves{
+    int64_t boxes;      // > 0 is R, < 0 is L
+    int64_t rows;       // > 0 is down, < 0 is up
+    int64_t columns;    // > 0 is right, < 0 is left
+};
+
+CursorMoves get_cursor_moves(const Cursor& cur_cursor, const Cursor& dest_cursor);
+
+// Ticks spent by move_cursor_to() and by a Y press. This is the cost model for
+// planning the swaps.
+uint64_t move_cursor_ticks(const Cursor& cur_cursor, const Cursor& dest_cursor, uint16_t GAME_DELAY);
+uint64_t press_y_ticks(uint16_t GAME_DELAY);
+
+
+
+// Each swap picks up the Pokemon at "pick" with Y and drops it on "drop" with
+// Y, which swaps the two slots.
+struct SortSwap{
+    size_t pick;
+    size_t drop;
+};
+struct SortPlan{
+    std::vector<SortSwap> swaps;
+    uint64_t compares = 0;
+};
+
+// Fill each slot of the sorted order in turn with the first match in the
+// current layout.
+SortPlan plan_sort_greedy(
+    std::vector<std::optional<Pokemon>> boxes_data,
+    const std::vector<std::optional<Pokemon>>& boxes_sorted
+);
+
+// Same swaps as "greedy" or fewer, in less time or the same. "greedy" must be
+// the plan_sort_greedy() of the same layout.
+SortPlan plan_sort_by_cycles(
+    const std::vector<std::optional<Pokemon>>& boxes_data,
+    const std::vector<std::optional<Pokemon>>& boxes_sorted,
+    const SortPlan& greedy,
+    Cursor cursor,
+    uint16_t GAME_DELAY
+);
+
+// Ticks to do the swaps of "plan" starting from "cursor".
+uint64_t estimate_sort_ticks(const SortPlan& plan, Cursor cursor, uint16_t GAME_DELAY);
+
+
+
+}
+}
+}
+#endif
@@ -4,11 +4,6 @@
  *
  */
 
-#include <math.h>
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 #include "Common/Compiler.h"
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/Globals.h"
@@ -17,6 +12,7 @@
 #include "CommonFramework/ImageTools/ImageStats.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/ImageTools/ImageFilter.h"
+#include "CommonFramework/ImageTools/ImageGradient.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/ImageTypes/ImageHSV32.h"
 #include "CommonFramework/Logging/Logger.h"
@@ -103,64 +99,6 @@ std::string feature_to_str(const FeatureVector& a){
     return os.str();
 }
 
-void run_Sobel_gradient_filter(const ImageViewRGB32& image, std::function<void(size_t x, size_t y, int sum_x[3], int sum_y[3])> process_gradient){
-    const size_t width = image.width();
-    const size_t height = image.height();
-    // Kernel for computing gradient along x axis
-    const int kx[3][3] = {
-        {-1, 0, 1},
-        {-2, 0, 2},
-        {-1, 0, 1},
-    };
-    // kernel for gradient along y axis
-    const int ky[3][3] = {
-        { 1,  2,  1},
-        { 0,  0,  0},
-        {-1, -2, -1},
-    };
-    const int ksz = 3; // kernel size
-    if (width <= ksz || height <= ksz){
-        return;
-    }
-    const size_t x_end = width - ksz + 1;
-    const size_t y_end = height - ksz + 1;
-
-    for(size_t y = 0; y < y_end; y++){
-        for(size_t x = 0; x < x_end; x++){
-            int sum_x[3] = {0, 0, 0};
-            int sum_y[3] = {0, 0, 0};
-            bool has_alpha_pixel = false;
-            for(size_t sy = 0; sy < 3; sy++){
-                for(size_t sx = 0; sx < 3; sx++){
-                    uint32_t p = image.pixel(x + sx, y + sy);
-                    int alpha = p >> 24;
-                    if (alpha < 128){
-                        // We don't compute gradient when there is a pixel in the kernel
-                        // scope that is transparent
-                        has_alpha_pixel = true;
-                        break;
-                    }
-                    for(int ch = 0; ch < 3; ch++){ // rgb channel
-                        int shift = ch * 8;
-                        int c = (uint32_t(0xff) & p >> shift);
-
-                        sum_x[ch] += c * kx[sy][sx];
-                        sum_y[ch] += c * ky[sy][sx];
-                    }
-                }
-                if (has_alpha_pixel){
-                    break;
-                }
-            } // end of kernel operation
-            if (has_alpha_pixel){
-                continue;
-            }
-
-            process_gradient(x+1, y+1, sum_x, sum_y);
-        }
-    }
-}
-
 ImageRGB32 smooth_image(const ImageViewRGB32& image){
     // static int count = 0;
     // {
@@ -262,64 +200,6 @@ ImageRGB32 smooth_image(const ImageViewRGB32& image){
 }
 
 
-ImageRGB32 compute_image_gradient(const ImageViewRGB32& image){
-    ImageRGB32 result(image.width(), image.height());
-    result.fill(0);
-
-    run_Sobel_gradient_filter(image, [&](size_t x, size_t y, int sum_x[3], int sum_y[3]){
-        int gx = (sum_x[0] + sum_x[1] + sum_x[2] + 1) / 3;
-        int gy = (sum_y[0] + sum_y[1] + sum_y[2] + 1) / 3;
-
-        uint8_t gxc = (uint8_t)std::min(std::abs(gx), 255);
-        uint8_t gyc = (uint8_t)std::min(std::abs(gy), 255);
-
-        result.pixel(x, y) = combine_rgb(gxc, gyc, 0);
-    });
-
-    return result;
-}
-
-FeatureVector compute_gradient_histogram(const ImageViewRGB32& image){
-    const int num_angle_divisions = 8;
-    double division_angle = 2. * M_PI / num_angle_divisions;
-    double inverse_division_angle = 1.0 / division_angle;
-
-    std::array<int, num_angle_divisions> bin = {0};
-
-    int num_grad = 0;
-
-    run_Sobel_gradient_filter(image, [&](size_t x, size_t y, int sum_x[3], int sum_y[3]){
-        int gx = sum_x[0] + sum_x[1] + sum_x[2];
-        int gy = sum_y[0] + sum_y[1] + sum_y[2];
-        if (gx*gx + gy*gy <= 2000){
-            return;
-        }
-        num_grad++;
-
-        // if (count == 0){
-        //     // cout << "gxy " << sum_x[0] << " " << sum_x[1] << " " << sum_x[2] << ", " <<
-        //     //  sum_y[0] << " " << sum_y[1] << " " << sum_y[2] << endl;
-        //     int gxc = std::min(std::abs(gx), 255);
-        //     int gyc = std::min(std::abs(gy), 255);
-
-        //     output_image->setPixelColor(x, y, QColor(gxc, gyc, 0));
-        // }
-
-        double angle = std::atan2(gy, gx); // range in -pi, pi
-        int bin_idx = int((angle + M_PI) * inverse_division_angle);
-        // clamp bin to [0, 11]
-        bin_idx = std::min(std::max(bin_idx, 0), num_angle_divisions-1);
-        bin[bin_idx]++;
-    });
-
-    FeatureVector result(num_angle_divisions);
-    for(size_t i = 0; i < num_angle_divisions; i++){
-        result[i] = bin[i] / (FeatureType)num_grad;
-    }
-
-    return result;
-}
-
 } // end anonymous namespace
 
 FeatureVector compute_feature(const ImageViewRGB32& input_image){
@@ -365,36 +245,59 @@ FeatureVector compute_feature(const ImageViewRGB32& input_image){
     return result;
 }
 
-void load_and_visit_MMO_sprite(std::function<void(const std::string& slug, const ImageViewRGB32& sprite)> visit_sprit){
-    static const SpriteDatabase database("PokemonLA/MMOSprites.png", "PokemonLA/MMOSprites.json");
-    for (const auto& item : database){
-        // cout << "sprite " << count << endl;
-        const std::string& slug = item.first;
-        const auto& sprite = item.second.sprite;
-        if (sprite.width() != 128 || sprite.height() != 128){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Wrong size of Loaded MMO Sprite sprite: " + slug);
-        }
-        visit_sprit(slug, item.second.sprite.sub_image(12, 12, 104, 104).scale_to(50, 50));
-    }
+// The MMO sprites are matched at 50 x 50 without their 12 pixel border.
+// These are precomputed in the sprite bundle so they don't have to be built at startup.
+const char* MMO_SPRITE_FEATURE_SCALED = "MapSprite-50x50";
+const char* MMO_SPRITE_FEATURE_SMOOTHED = "MapSprite-50x50-Smoothed";
+
+ImageRGB32 scale_MMO_sprite(const ImageViewRGB32& sprite){
+    return sprite.sub_image(12, 12, 104, 104).scale_to(IMAGE_TEMPLATE_SIZE, IMAGE_TEMPLATE_SIZE);
+}
+
+const std::vector<SpriteBundleFeature>& MMO_SPRITE_BUNDLE_FEATURES(){
+    static const std::vector<SpriteBundleFeature> features{
+        {MMO_SPRITE_FEATURE_SCALED, scale_MMO_sprite},
+        {MMO_SPRITE_FEATURE_SMOOTHED, [](const ImageViewRGB32& sprite){
+            return smooth_image(scale_MMO_sprite(sprite));
+        }},
+    };
+    return features;
 }
 
 MMOSpriteMatchingMap build_MMO_sprite_matching_data(){
+    const SpriteDatabase& database = ALL_MMO_SPRITES();
 
     MMOSpriteMatchingMap sprite_map;
 
-    load_and_visit_MMO_sprite([&](const std::string& slug, const ImageViewRGB32& sprite){
+    for (const auto& item : database){
+        const std::string& slug = item.first;
+        if (item.second.sprite.width() != 128 || item.second.sprite.height() != 128){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Wrong size of Loaded MMO Sprite sprite: " + slug);
+        }
+
+        ImageRGB32 scaled_buffer;
+        ImageViewRGB32 sprite = database.feature(slug, MMO_SPRITE_FEATURE_SCALED);
+        if (!sprite){
+            scaled_buffer = scale_MMO_sprite(item.second.sprite);
+            sprite = scaled_buffer;
+        }
+        ImageRGB32 smoothed_buffer;
+        ImageViewRGB32 smoothed_sprite = database.feature(slug, MMO_SPRITE_FEATURE_SMOOTHED);
+        if (!smoothed_sprite){
+            smoothed_buffer = smooth_image(sprite);
+            smoothed_sprite = smoothed_buffer;
+        }
 
         PerSpriteMatchingData per_sprite_data;
 
         per_sprite_data.rgb_stats = image_stats(sprite);
         per_sprite_data.hsv_image = ImageHSV32(sprite);
 
-        ImageRGB32 smoothed_sprite = smooth_image(sprite);
-        per_sprite_data.gradient_image = compute_image_gradient(smoothed_sprite);
+        per_sprite_data.gradient_image = compute_sobel_gradient(smoothed_sprite);
         per_sprite_data.feature = compute_feature(smoothed_sprite);
 
         sprite_map.emplace(slug, std::move(per_sprite_data));
-    });
+    }
 
     return sprite_map;
 }
@@ -405,6 +308,10 @@ const MMOSpriteMatchingMap& MMO_SPRITE_MATCHING_DATA(){
     return sprite_matching_data;
 }
 
+void preload_MMO_sprite_matching_data(){
+    MMO_SPRITE_MATCHING_DATA();
+}
+
 
 std::multimap<double, std::string> match_pokemon_map_sprite_feature(const ImageViewRGB32& image, MapRegion region){
     const FeatureVector& image_feature = compute_feature(image);
@@ -505,7 +412,7 @@ ImageRGB32 compute_MMO_sprite_gradient(const ImageViewRGB32& image){
         // First scale the image
         return smooth_image(image.scale_to(IMAGE_TEMPLATE_SIZE, IMAGE_TEMPLATE_SIZE));
     }();
-    result = compute_image_gradient(result);
+    result = compute_sobel_gradient(result);
     
     size_t width = image.width();
     size_t height = image.height();
@@ -546,192 +453,8 @@ ImageRGB32 compute_MMO_sprite_gradient(const ImageViewRGB32& image){
 
 
 double compute_MMO_sprite_gradient_distance(const ImageViewRGB32& gradient_template, const ImageViewRGB32& gradient){
-    int tempt_width = (int)gradient_template.width();
-    int tempt_height = (int)gradient_template.height();
-
-    double score = 0.0f;
-    int max_offset = 2;
-
-    auto compute_pixel_dist = [](uint32_t t_g, uint32_t g){
-        int gx = uint32_t(0xff) & (g >> 16);
-        int gy = uint32_t(0xff) & (g >> 8);
-        int t_gx = uint32_t(0xff) & (t_g >> 16);
-        int t_gy = uint32_t(0xff) & (t_g >> 8);
-        double pixel_score = std::max(t_gx, gx) * (gx - t_gx) * (gx - t_gx) + std::max(t_gy, gy) * (gy - t_gy) * (gy - t_gy);
-        pixel_score /= 255;
-        return pixel_score;
-    };
-
-
-// #define USE_IMAGE_LEVEL_TRANSLATION
-// #define USE_PIXEL_LEVEL_TRANSLATION
-#define USE_BLOCK_LEVEL_TRANSLATION
-
-#ifdef USE_IMAGE_LEVEL_TRANSLATION
-    score = FLT_MAX;
-    for(int oy = -max_offset; oy <= max_offset; oy++){ // offset_y
-        for(int ox = -max_offset; ox <= max_offset; ox++){ // offset_x
-
-            float match_score = 0.0;
-            int num_gradients = 0;
-            for(size_t y = 0; y < gradient.height(); y++){
-                for(size_t x = 0; x < gradient.width(); x++){
-                    uint32_t g = gradient.pixel(x, y);
-                    if (is_transparent(g)){
-                        continue;
-                    }
-                    int my = (int)(y + oy); // moved y
-                    int mx = (int)(x + ox); // moved x
-                    if (mx < 0 || mx >= tempt_width || my < 0 || my >= tempt_height){
-                        continue;
-                    }
-
-                    uint32_t t_g = gradient_template.pixel(mx, my);
-                    if (is_transparent(t_g)){
-                        continue;
-                    }
-
-                    num_gradients++;
-
-                    float pixel_score = compute_pixel_dist(t_g, g);
-                    match_score += pixel_score;
-
-                    // output.setPixelColor(x, y, QColor(
-                    //     std::min((int)std::sqrt(gx*gx+gy*gy),255),
-                    //     std::min((int)std::sqrt(t_gx*t_gx+t_gy*t_gy), 255),
-                    //     0
-                    // ));
-                }
-            }
-
-            match_score = std::sqrt(match_score / num_gradients);
-            if (match_score < score){
-                score = match_score;
-            }
-        }
-    }
-    score = std::sqrt(score);
-#endif
-
-#ifdef USE_PIXEL_LEVEL_TRANSLATION
-    score = 0;
-    int num_gradients = 0;
-    for(size_t y = 0; y < gradient.height(); y++){
-        for(size_t x = 0; x < gradient.width(); x++){
-            uint32_t g = gradient.pixel(x, y);
-            uint32_t gx = uint32_t(0xff) & (g >> 16);
-            uint32_t gy = uint32_t(0xff) & (g >> 8);
-            uint32_t alpha = g >> 24;
-            if (alpha < 128){
-                continue;
-            }
-
-            float min_pixel_score = FLT_MAX;
-            for(int oy = -max_offset; oy <= max_offset; oy++){ // offset_y
-                for(int ox = -max_offset; ox <= max_offset; ox++){ // offset_x
-                    int my = (int)(y + oy); // moved y
-                    int mx = (int)(x + ox); // moved x
-                    if (mx < 0 || mx >= tempt_width || my < 0 || my >= tempt_height){
-                        continue;
-                    }
-                    // int dist_x = std::abs(ox);
-                    // int dist_y = std::abs(oy);
-                    // int dist2 = dist_x * dist_x + dist_y * dist_y;
-                    uint32_t t_g = scaled_template.pixel(mx, my);
-                    uint32_t t_a = t_g >> 24;
-                    if (t_a < 128){
-                        continue;
-                    }
-
-                    uint32_t t_gx = uint32_t(0xff) & (t_g >> 16);
-                    uint32_t t_gy = uint32_t(0xff) & (t_g >> 8);
-                    float pixel_score = std::max(t_gx, gx) * (gx - t_gx) * (gx - t_gx) + std::max(t_gy, gy) * (gy - t_gy) * (gy - t_gy);
-                    pixel_score /= 255;
-                    if (pixel_score < min_pixel_score){
-                        min_pixel_score = pixel_score;
-                    }
-
-                    if (ox == 0 && oy == 0){
-                        output.setPixelColor(x, y, QColor(
-                            std::min((int)std::sqrt(gx*gx+gy*gy),255),
-                            std::min((int)std::sqrt(t_gx*t_gx+t_gy*t_gy), 255),
-                            0
-                        ));
-                    }
-                }
-            } // end offset
-
-            if (min_pixel_score < FLT_MAX){
-                score += min_pixel_score;
-                num_gradients++;
-            }
-        }
-    }
-    score = std::sqrt(score / num_gradients);
-#endif
-
-#ifdef USE_BLOCK_LEVEL_TRANSLATION
-    int block_radius = 5;
-
-    score = 0;
-    int num_gradients = 0;
-
-    for(int y = 0; y < (int)gradient.height(); y++){
-        for(int x = 0; x < (int)gradient.width(); x++){
-            uint32_t g = gradient.pixel(x, y);
-            if (is_transparent(g)){
-                continue;
-            }
-
-            double min_block_score = FLT_MAX;
-            for(int oy = -max_offset; oy <= max_offset; oy++){ // offset_y
-                for(int ox = -max_offset; ox <= max_offset; ox++){ // offset_x
-
-                    double block_score = 0.0;
-                    int block_size = 0;
-                    for(int by = y - block_radius; by <= y + block_radius; by++){
-                        for(int bx = x - block_radius; bx <= x + block_radius; bx++){
-                            if (bx < 0 || bx >= (int)gradient.width() || by < 0 || by >= (int)gradient.height()){
-                                continue;
-                            }
-
-                            uint32_t bg = gradient.pixel(bx, by);
-                            if (is_transparent(bg)){
-                                continue;
-                            }
-
-                            int ty = by + oy; // template y
-                            int tx = bx + ox; // template x
-                            if (tx < 0 || tx >= tempt_width || ty < 0 || ty >= tempt_height){
-                                continue;
-                            }
-                            uint32_t t_bg = gradient_template.pixel(tx, ty);
-                            if (is_transparent(t_bg)){
-                                continue;
-                            }
-
-                            block_score += compute_pixel_dist(t_bg, bg);
-                            block_size++;
-                        }
-                    }
-                    block_score = block_score / block_size;
-                    min_block_score = std::min(min_block_score, block_score);
-                }
-            } // end offset
-
-            if (min_block_score < FLT_MAX){
-                score += min_block_score;
-                num_gradients++;
-            }
-        }
-    }
-    score = std::sqrt(score / num_gradients);
-#endif
-
-    // output.save("test_distance_alignment_" + QString::number(count) + ".png");
-    // count++;
-
-    return score;
+    // Each block of 11 x 11 pixels can move up to 2 pixels in each direction to find its best match.
+    return std::sqrt(sobel_gradient_block_distance(gradient_template, gradient, 2, 5));
 }
 
 double compute_hsv_dist2(uint32_t template_color, uint32_t color){
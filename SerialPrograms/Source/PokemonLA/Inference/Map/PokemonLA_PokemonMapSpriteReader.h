@@ -17,6 +17,8 @@ struct ImagePixelBox;
 
 namespace PokemonAutomation{
 
+struct SpriteBundleFeature;
+
 
 namespace NintendoSwitch{
 namespace PokemonLA{
@@ -55,6 +57,12 @@ MapSpriteMatchResult match_sprite_on_map(
     bool debug_mode = false
 );
 
+// The images derived from each MMO sprite that are stored in its sprite bundle.
+const std::vector<SpriteBundleFeature>& MMO_SPRITE_BUNDLE_FEATURES();
+
+// Build the sprite matching data now instead of on the first map read.
+void preload_MMO_sprite_matching_data();
+
 
 }
 }
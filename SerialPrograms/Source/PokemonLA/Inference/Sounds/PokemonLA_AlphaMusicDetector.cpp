@@ -28,12 +28,15 @@ float AlphaMusicDetector::get_score_threshold() const{
 std::unique_ptr<SpectrogramMatcher> AlphaMusicDetector::build_spectrogram_matcher(size_t sample_rate){
     const double low_frequency_filter = 50.0; // we don't match frequencies under 50.0 Hz
     const size_t templateSubdivision = 12;
-    return std::make_unique<SpectrogramMatcher>(
+    auto matcher = std::make_unique<SpectrogramMatcher>(
         "Alpha Music",
         AudioTemplateCache::instance().get_throw("PokemonLA/AlphaMusic", sample_rate),
         SpectrogramMatcher::Mode::RAW, sample_rate,
         low_frequency_filter, templateSubdivision
     );
+    //  Long template. Correlate each spectrum once instead of the whole template on every match.
+    matcher->set_engine(SpectrogramMatcher::Engine::INCREMENTAL);
+    return matcher;
 }
 
 
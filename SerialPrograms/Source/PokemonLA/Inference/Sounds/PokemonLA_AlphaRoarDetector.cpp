@@ -28,12 +28,15 @@ float AlphaRoarDetector::get_score_threshold() const{
 
 std::unique_ptr<SpectrogramMatcher> AlphaRoarDetector::build_spectrogram_matcher(size_t sample_rate){
     const double low_frequency_filter = 100.0; // we don't match frequencies under 100.0 Hz
-    return std::make_unique<SpectrogramMatcher>(
+    auto matcher = std::make_unique<SpectrogramMatcher>(
         "Alpha Roar",
         AudioTemplateCache::instance().get_throw("PokemonLA/AlphaRoar", sample_rate),
         SpectrogramMatcher::Mode::RAW, sample_rate,
         low_frequency_filter
     );
+    //  Long template. Correlate each spectrum once instead of the whole template on every match.
+    matcher->set_engine(SpectrogramMatcher::Engine::INCREMENTAL);
+    return matcher;
 }
 
 
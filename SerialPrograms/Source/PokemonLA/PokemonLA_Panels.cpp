@@ -6,6 +6,7 @@
 
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "Pokemon/Pokemon_Strings.h"
+#include "Resources/PokemonLA_Preload.h"
 #include "PokemonLA_Panels.h"
 
 #include "PokemonLA_Settings.h"
@@ -53,7 +54,9 @@ namespace PokemonLA{
 
 PanelListFactory::PanelListFactory()
     : PanelListDescriptor(Pokemon::STRING_POKEMON + " Legends Arceus")
-{}
+{
+    register_preload_resources();
+}
 
 std::vector<PanelEntry> PanelListFactory::make_panels() const{
     std::vector<PanelEntry> ret;
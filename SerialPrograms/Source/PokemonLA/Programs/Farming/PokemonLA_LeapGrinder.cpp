@@ -19,6 +19,7 @@
 #include "PokemonLA/Inference/Sounds/PokemonLA_ShinySoundDetector.h"
 #include "PokemonLA/Inference/PokemonLA_OverworldDetector.h"
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA/Programs/Farming/PokemonLA_LeapGrinder.h"
 
 namespace PokemonAutomation{
@@ -37,7 +38,9 @@ LeapGrinder_Descriptor::LeapGrinder_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class LeapGrinder_Descriptor::Stats : public StatsTracker{
 public:
     Stats()
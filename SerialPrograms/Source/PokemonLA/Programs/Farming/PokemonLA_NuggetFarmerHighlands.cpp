@@ -21,6 +21,7 @@
 #include "PokemonLA/Programs/PokemonLA_GameSave.h"
 #include "PokemonLA/Programs/PokemonLA_MountChange.h"
 #include "PokemonLA/Programs/PokemonLA_RegionNavigation.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA_NuggetFarmerHighlands.h"
 
 #include <iostream>
@@ -43,7 +44,9 @@ NuggetFarmerHighlands_Descriptor::NuggetFarmerHighlands_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class NuggetFarmerHighlands_Descriptor::Stats : public StatsTracker, public ShinyStatIncrementer{
 public:
     Stats()
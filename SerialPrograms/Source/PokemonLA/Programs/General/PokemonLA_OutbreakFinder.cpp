@@ -35,6 +35,7 @@
 #include "PokemonLA/Inference/Objects/PokemonLA_MMOQuestionMarkDetector.h"
 #include "PokemonLA_OutbreakFinder.h"
 #include "PokemonLA/Programs/PokemonLA_RegionNavigation.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA/PokemonLA_Settings.h"
 
 #include <sstream>
@@ -141,7 +142,9 @@ OutbreakFinder_Descriptor::OutbreakFinder_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_MMO_SPRITE_MATCHING, Pokemon::PRELOAD_POKEMON_NAME_READER});
+}
 class OutbreakFinder_Descriptor::Stats : public StatsTracker{
 public:
     Stats()
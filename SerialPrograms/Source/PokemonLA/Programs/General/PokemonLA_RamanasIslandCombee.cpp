@@ -24,6 +24,7 @@
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
 #include "PokemonLA/Programs/General/PokemonLA_RamanasIslandCombee.h"
 #include "PokemonLA/Programs/PokemonLA_LeapPokemonActions.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 
 namespace PokemonAutomation{
@@ -43,7 +44,9 @@ RamanasCombeeFinder_Descriptor::RamanasCombeeFinder_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class RamanasCombeeFinder_Descriptor::Stats : public StatsTracker{
 public:
     Stats()
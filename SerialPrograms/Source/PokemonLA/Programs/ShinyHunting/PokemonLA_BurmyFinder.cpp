@@ -25,6 +25,7 @@
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
 #include "PokemonLA/Programs/ShinyHunting/PokemonLA_BurmyFinder.h"
 #include "PokemonLA/Programs/PokemonLA_LeapPokemonActions.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 
 namespace PokemonAutomation{
@@ -44,7 +45,9 @@ BurmyFinder_Descriptor::BurmyFinder_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class BurmyFinder_Descriptor::Stats : public StatsTracker{
 public:
     Stats()
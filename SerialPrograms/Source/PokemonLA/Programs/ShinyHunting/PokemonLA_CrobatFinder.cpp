@@ -17,6 +17,7 @@
 #include "PokemonLA/Inference/Sounds/PokemonLA_ShinySoundDetector.h"
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
 #include "PokemonLA/Programs/PokemonLA_RegionNavigation.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA_CrobatFinder.h"
 
 namespace PokemonAutomation{
@@ -35,7 +36,9 @@ CrobatFinder_Descriptor::CrobatFinder_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class CrobatFinder_Descriptor::Stats : public StatsTracker, public ShinyStatIncrementer{
 public:
     Stats()
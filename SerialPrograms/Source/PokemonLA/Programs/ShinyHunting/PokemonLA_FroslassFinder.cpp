@@ -17,6 +17,7 @@
 #include "PokemonLA/Programs/PokemonLA_MountChange.h"
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
 #include "PokemonLA/Programs/PokemonLA_RegionNavigation.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA/Programs/ShinyHunting/PokemonLA_FroslassFinder.h"
 
 namespace PokemonAutomation{
@@ -36,7 +37,9 @@ FroslassFinder_Descriptor::FroslassFinder_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class FroslassFinder_Descriptor::Stats : public StatsTracker, public ShinyStatIncrementer{
 public:
     Stats()
@@ -15,6 +15,7 @@
 #include "PokemonLA/Inference/Sounds/PokemonLA_ShinySoundDetector.h"
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
 #include "PokemonLA/Programs/PokemonLA_RegionNavigation.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA_GalladeFinder.h"
 
 namespace PokemonAutomation{
@@ -33,7 +34,9 @@ GalladeFinder_Descriptor::GalladeFinder_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class GalladeFinder_Descriptor::Stats : public StatsTracker, public ShinyStatIncrementer{
 public:
     Stats()
@@ -14,6 +14,7 @@
 #include "PokemonLA/PokemonLA_Settings.h"
 #include "PokemonLA/Inference/Sounds/PokemonLA_ShinySoundDetector.h"
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA_PostMMOSpawnReset.h"
 
 namespace PokemonAutomation{
@@ -33,7 +34,9 @@ PostMMOSpawnReset_Descriptor::PostMMOSpawnReset_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class PostMMOSpawnReset_Descriptor::Stats : public StatsTracker, public ShinyStatIncrementer{
 public:
     Stats()
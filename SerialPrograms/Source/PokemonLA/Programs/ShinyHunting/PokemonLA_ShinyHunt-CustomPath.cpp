@@ -17,6 +17,7 @@
 #include "PokemonLA/Programs/PokemonLA_RegionNavigation.h"
 #include "PokemonLA/Programs/PokemonLA_MountChange.h"
 #include "PokemonLA/Programs/PokemonLA_TimeOfDayChange.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA_ShinyHunt-CustomPath.h"
 
 //#include <iostream>
@@ -39,7 +40,9 @@ ShinyHuntCustomPath_Descriptor::ShinyHuntCustomPath_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class ShinyHuntCustomPath_Descriptor::Stats : public StatsTracker, public ShinyStatIncrementer{
 public:
     Stats()
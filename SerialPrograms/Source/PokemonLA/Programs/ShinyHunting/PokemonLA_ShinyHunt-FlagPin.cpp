@@ -16,6 +16,7 @@
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
 #include "PokemonLA/Programs/PokemonLA_RegionNavigation.h"
 #include "PokemonLA/Programs/PokemonLA_FlagNavigationAir.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA_ShinyHunt-FlagPin.h"
 
 namespace PokemonAutomation{
@@ -35,7 +36,9 @@ ShinyHuntFlagPin_Descriptor::ShinyHuntFlagPin_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class ShinyHuntFlagPin_Descriptor::Stats : public StatsTracker, public ShinyStatIncrementer{
 public:
     Stats()
@@ -23,6 +23,7 @@
 #include "PokemonLA/Programs/PokemonLA_MountChange.h"
 #include "PokemonLA/Programs/PokemonLA_GameEntry.h"
 #include "PokemonLA/Programs/PokemonLA_RegionNavigation.h"
+#include "PokemonLA/Resources/PokemonLA_Preload.h"
 #include "PokemonLA/Programs/ShinyHunting/PokemonLA_UnownFinder.h"
 
 
@@ -43,7 +44,9 @@ UnownFinder_Descriptor::UnownFinder_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SHINY_SOUND});
+}
 class UnownFinder_Descriptor::Stats : public StatsTracker, public ShinyStatIncrementer{
 public:
     Stats()
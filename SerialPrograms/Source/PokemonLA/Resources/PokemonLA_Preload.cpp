@@ -0,0 +1,49 @@
+/*  Pokemon Legends Arceus Preload
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/Inference/AudioTemplateCache.h"
+#include "CommonFramework/Resources/ResourcePreloader.h"
+#include "Pokemon/Resources/Pokemon_Preload.h"
+#include "PokemonLA/Resources/PokemonLA_PokemonSprites.h"
+#include "PokemonLA/Inference/Map/PokemonLA_PokemonMapSpriteReader.h"
+#include "PokemonLA_Preload.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonLA{
+
+
+const std::string PRELOAD_MMO_SPRITES           = "PokemonLA: MMO Sprites";
+const std::string PRELOAD_MMO_SPRITE_MATCHING   = "PokemonLA: MMO Sprite Matching";
+const std::string PRELOAD_SHINY_SOUND           = "PokemonLA: Shiny Sound";
+
+
+void register_preload_resources(){
+    Pokemon::register_preload_resources();
+
+    ResourcePreloader& preloader = ResourcePreloader::instance();
+    preloader.add(
+        PRELOAD_MMO_SPRITES, std::chrono::milliseconds(300), {},
+        []{ ALL_MMO_SPRITES(); }
+    );
+    preloader.add(
+        PRELOAD_MMO_SPRITE_MATCHING, std::chrono::milliseconds(1000), {PRELOAD_MMO_SPRITES},
+        []{ preload_MMO_sprite_matching_data(); }
+    );
+
+    //  Audio is processed at 48 kHz unless the capture device only supports
+    //  44.1 kHz. That case still loads its template on first use.
+    preloader.add(
+        PRELOAD_SHINY_SOUND, std::chrono::milliseconds(200), {},
+        []{ AudioTemplateCache::instance().get_nothrow("PokemonLA/ShinySound", 48000); }
+    );
+}
+
+
+
+}
+}
+}
@@ -0,0 +1,30 @@
+/*  Pokemon Legends Arceus Preload
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Resources that Legends Arceus programs can ask the ResourcePreloader for.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonLA_Preload_H
+#define PokemonAutomation_PokemonLA_Preload_H
+
+#include <string>
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonLA{
+
+
+extern const std::string PRELOAD_MMO_SPRITE_MATCHING;
+extern const std::string PRELOAD_SHINY_SOUND;
+
+
+void register_preload_resources();
+
+
+
+}
+}
+}
+#endif
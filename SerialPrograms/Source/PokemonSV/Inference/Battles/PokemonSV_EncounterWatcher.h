@@ -42,6 +42,9 @@ public:
         const std::vector<AudioSpectrum>& new_spectrums,
         AudioFeed& audioFeed
     ) override;
+    virtual void set_spectrogram_front_end(std::shared_ptr<SpectrogramFrontEnd> front_end) override{
+        m_shiny_sound.set_spectrogram_front_end(std::move(front_end));
+    }
 
 private:
     NormalBattleMenuWatcher m_battle_menu;
@@ -6,6 +6,7 @@
 
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "Pokemon/Pokemon_Strings.h"
+#include "Resources/PokemonSV_Preload.h"
 #include "PokemonSV_Panels.h"
 
 #include "PokemonSV_Settings.h"
@@ -68,7 +69,9 @@ namespace PokemonSV{
 
 PanelListFactory::PanelListFactory()
     : PanelListDescriptor(Pokemon::STRING_POKEMON + " Scarlet and Violet")
-{}
+{
+    register_preload_resources();
+}
 
 std::vector<PanelEntry> PanelListFactory::make_panels() const{
     std::vector<PanelEntry> ret;
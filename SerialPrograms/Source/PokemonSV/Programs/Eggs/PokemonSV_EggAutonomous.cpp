@@ -26,6 +26,7 @@
 #include "PokemonSV/Programs/Eggs/PokemonSV_EggRoutines.h"
 #include "PokemonSV/Programs/Boxes/PokemonSV_BoxRelease.h"
 #include "PokemonSV/Programs/Sandwiches/PokemonSV_SandwichRoutines.h"
+#include "PokemonSV/Resources/PokemonSV_Preload.h"
 #include "PokemonSV_EggAutonomous.h"
 
 namespace PokemonAutomation{
@@ -45,7 +46,9 @@ EggAutonomous_Descriptor::EggAutonomous_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SANDWICH_INGREDIENTS});
+}
 struct EggAutonomous_Descriptor::Stats : public StatsTracker{
     Stats()
         : m_sandwiches(m_stats["Sandwiches"])
@@ -13,6 +13,7 @@
 #include "PokemonSV/Inference/Boxes/PokemonSV_IvJudgeReader.h"
 #include "PokemonSV/Programs/Eggs/PokemonSV_EggRoutines.h"
 #include "PokemonSV/Programs/PokemonSV_Navigation.h"
+#include "PokemonSV/Resources/PokemonSV_Preload.h"
 #include "PokemonSV_EggFetcher.h"
 
 namespace PokemonAutomation{
@@ -32,7 +33,9 @@ EggFetcher_Descriptor::EggFetcher_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SANDWICH_INGREDIENTS});
+}
 struct EggFetcher_Descriptor::Stats : public StatsTracker{
     Stats()
         : m_sandwiches(m_stats["Sandwiches"])
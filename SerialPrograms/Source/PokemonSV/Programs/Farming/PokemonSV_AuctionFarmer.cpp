@@ -28,6 +28,7 @@
 #include "PokemonSV/Resources/PokemonSV_AuctionItemNames.h"
 #include "PokemonSwSh/Commands/PokemonSwSh_Commands_DateSpam.h"
 #include "NintendoSwitch/Commands/NintendoSwitch_Commands_PushButtons.h"
+#include "PokemonSV/Resources/PokemonSV_Preload.h"
 
 #include "PokemonSV_AuctionFarmer.h"
 
@@ -51,7 +52,9 @@ AuctionFarmer_Descriptor::AuctionFarmer_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_AUCTION_ITEMS});
+}
 
 struct AuctionFarmer_Descriptor::Stats : public StatsTracker {
     Stats()
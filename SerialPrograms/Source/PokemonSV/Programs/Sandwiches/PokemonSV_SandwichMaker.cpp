@@ -12,6 +12,7 @@
 #include "Pokemon/Pokemon_Strings.h"
 #include "Common/Cpp/Exceptions.h"
 #include "PokemonSV/Programs/Sandwiches/PokemonSV_SandwichRoutines.h"
+#include "PokemonSV/Resources/PokemonSV_Preload.h"
 #include "PokemonSV_SandwichMaker.h"
 
 //#include <iostream>
@@ -36,7 +37,9 @@ SandwichMaker_Descriptor::SandwichMaker_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SANDWICH_INGREDIENTS});
+}
 
 SandwichMaker::SandwichMaker()
     : GO_HOME_WHEN_DONE(false)
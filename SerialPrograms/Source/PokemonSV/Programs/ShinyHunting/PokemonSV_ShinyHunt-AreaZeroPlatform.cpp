@@ -29,6 +29,7 @@
 #include "PokemonSV/Programs/Battles/PokemonSV_Battles.h"
 #include "PokemonSV/Programs/Sandwiches/PokemonSV_SandwichRoutines.h"
 #include "PokemonSV_LetsGoTools.h"
+#include "PokemonSV/Resources/PokemonSV_Preload.h"
 #include "PokemonSV_ShinyHunt-AreaZeroPlatform.h"
 
 //#include <iostream>
@@ -53,7 +54,9 @@ ShinyHuntAreaZeroPlatform_Descriptor::ShinyHuntAreaZeroPlatform_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SANDWICH_INGREDIENTS});
+}
 struct ShinyHuntAreaZeroPlatform_Descriptor::Stats : public LetsGoEncounterBotStats{
     Stats()
         : m_sandwiches(m_stats["Sandwiches"])
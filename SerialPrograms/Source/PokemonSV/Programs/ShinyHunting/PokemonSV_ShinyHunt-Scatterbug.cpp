@@ -24,6 +24,7 @@
 #include "PokemonSV/Programs/Battles/PokemonSV_Battles.h"
 #include "PokemonSV/Programs/Sandwiches/PokemonSV_SandwichRoutines.h"
 #include "PokemonSV_LetsGoTools.h"
+#include "PokemonSV/Resources/PokemonSV_Preload.h"
 #include "PokemonSV_ShinyHunt-Scatterbug.h"
 
 //#include <iostream>
@@ -48,7 +49,9 @@ ShinyHuntScatterbug_Descriptor::ShinyHuntScatterbug_Descriptor()
         AllowCommandsWhenRunning::DISABLE_COMMANDS,
         PABotBaseLevel::PABOTBASE_12KB
     )
-{}
+{
+    set_required_resources({PRELOAD_SANDWICH_INGREDIENTS});
+}
 struct ShinyHuntScatterbug_Descriptor::Stats : public LetsGoEncounterBotStats{
     Stats()
         : m_sandwiches(m_stats["Sandwiches"])
@@ -0,0 +1,85 @@
+/*  Pokemon Scarlet/Violet Preload
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/Resources/ResourcePreloader.h"
+#include "Pokemon/Resources/Pokemon_Preload.h"
+#include "PokemonSV/Resources/PokemonSV_Ingredients.h"
+#include "PokemonSV/Resources/PokemonSV_ItemSprites.h"
+#include "PokemonSV/Inference/PokemonSV_AuctionItemNameReader.h"
+#include "PokemonSV/Inference/Picnics/PokemonSV_SandwichIngredientDetector.h"
+#include "PokemonSV_Preload.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+
+
+const std::string PRELOAD_SANDWICH_FILLING_SPRITES      = "PokemonSV: Sandwich Filling Sprites";
+const std::string PRELOAD_SANDWICH_CONDIMENT_SPRITES    = "PokemonSV: Sandwich Condiment Sprites";
+const std::string PRELOAD_SANDWICH_FILLING_OCR          = "PokemonSV: Sandwich Filling OCR";
+const std::string PRELOAD_SANDWICH_CONDIMENT_OCR        = "PokemonSV: Sandwich Condiment OCR";
+const std::string PRELOAD_SANDWICH_INGREDIENTS          = "PokemonSV: Sandwich Ingredients";
+
+const std::string PRELOAD_AUCTION_ITEM_SPRITES          = "PokemonSV: Auction Item Sprites";
+const std::string PRELOAD_AUCTION_ITEM_NAME_READER      = "PokemonSV: Auction Item Name Reader";
+const std::string PRELOAD_AUCTION_ITEMS                 = "PokemonSV: Auction Items";
+
+
+void register_preload_resources(){
+    Pokemon::register_preload_resources();
+
+    ResourcePreloader& preloader = ResourcePreloader::instance();
+
+    preloader.add(
+        PRELOAD_SANDWICH_FILLING_SPRITES, std::chrono::milliseconds(150), {},
+        []{ SANDWICH_FILLINGS_DATABASE(); }
+    );
+    preloader.add(
+        PRELOAD_SANDWICH_CONDIMENT_SPRITES, std::chrono::milliseconds(150), {},
+        []{ SANDWICH_CONDIMENTS_DATABASE(); }
+    );
+    preloader.add(
+        PRELOAD_SANDWICH_FILLING_OCR, std::chrono::milliseconds(100), {},
+        []{ SandwichFillingOCR::instance(); }
+    );
+    preloader.add(
+        PRELOAD_SANDWICH_CONDIMENT_OCR, std::chrono::milliseconds(100), {},
+        []{ SandwichCondimentOCR::instance(); }
+    );
+    preloader.add(
+        PRELOAD_SANDWICH_INGREDIENTS, std::chrono::milliseconds(0),
+        {
+            PRELOAD_SANDWICH_FILLING_SPRITES,
+            PRELOAD_SANDWICH_CONDIMENT_SPRITES,
+            PRELOAD_SANDWICH_FILLING_OCR,
+            PRELOAD_SANDWICH_CONDIMENT_OCR,
+        },
+        []{}
+    );
+
+    preloader.add(
+        PRELOAD_AUCTION_ITEM_SPRITES, std::chrono::milliseconds(100), {},
+        []{ AUCTION_ITEM_SPRITES(); }
+    );
+    preloader.add(
+        PRELOAD_AUCTION_ITEM_NAME_READER, std::chrono::milliseconds(100), {},
+        []{ AuctionItemNameReader::instance(); }
+    );
+    preloader.add(
+        PRELOAD_AUCTION_ITEMS, std::chrono::milliseconds(0),
+        {
+            PRELOAD_AUCTION_ITEM_SPRITES,
+            PRELOAD_AUCTION_ITEM_NAME_READER,
+        },
+        []{}
+    );
+}
+
+
+
+}
+}
+}
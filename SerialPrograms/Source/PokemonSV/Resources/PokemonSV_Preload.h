@@ -0,0 +1,33 @@
+/*  Pokemon Scarlet/Violet Preload
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Resources that Scarlet/Violet programs can ask the ResourcePreloader for.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSV_Preload_H
+#define PokemonAutomation_PokemonSV_Preload_H
+
+#include <string>
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+
+
+//  Everything needed to read sandwich ingredients.
+extern const std::string PRELOAD_SANDWICH_INGREDIENTS;
+
+//  Everything needed to read auction items.
+extern const std::string PRELOAD_AUCTION_ITEMS;
+
+
+void register_preload_resources();
+
+
+
+}
+}
+}
+#endif
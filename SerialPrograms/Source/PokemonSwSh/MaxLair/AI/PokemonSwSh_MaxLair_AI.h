@@ -11,6 +11,7 @@
 #include "PokemonSwSh/MaxLair/Framework/PokemonSwSh_MaxLair_State.h"
 
 namespace PokemonAutomation{
+    class ParallelTaskRunner;
 namespace NintendoSwitch{
 namespace PokemonSwSh{
 namespace MaxLairInternal{
@@ -47,8 +48,10 @@ int8_t select_item(
 );
 
 //  Professor offers to exchange a Pokemon.
+//  The candidate matchups are scored on "task_runner".
 bool should_swap_with_professor(
     Logger& logger,
+    ParallelTaskRunner& task_runner,
     const GlobalState& state,
     size_t player_index
 );
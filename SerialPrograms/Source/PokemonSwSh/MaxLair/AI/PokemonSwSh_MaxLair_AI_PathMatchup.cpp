@@ -20,9 +20,15 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+//  Indexed directly by "PokemonType". NONE is never filled in.
+const size_t TYPE_COUNT = (size_t)PokemonType::FAIRY + 1;
+
+
 struct PathMatchDatabase{
     std::map<PokemonType, std::set<std::string>> rentals_by_type;
-    std::map<std::string, std::map<PokemonType, double>> type_vs_boss;
+
+    std::map<std::string, size_t> boss_ids;
+    std::vector<double> type_vs_boss;   //  [boss_id * TYPE_COUNT + type]
 
     static const PathMatchDatabase& instance(){
         static PathMatchDatabase database;
@@ -52,7 +58,11 @@ private:
 
         JsonObject& node = root.get_object_throw("base_node", path).get_object_throw("hash_table");
         for (auto& item : node){
-            std::map<PokemonType, double>& boss = type_vs_boss[item.first];
+            boss_ids.emplace(item.first, boss_ids.size());
+        }
+        type_vs_boss.resize(boss_ids.size() * TYPE_COUNT);
+        for (auto& item : node){
+            double* boss = &type_vs_boss[boss_ids[item.first] * TYPE_COUNT];
 
             JsonObject& obj = item.second.get_object_throw(path).get_object_throw("hash_table", path);
 
@@ -60,7 +70,7 @@ private:
                 if (type.first == PokemonType::NONE){
                     continue;
                 }
-                boss[type.first] = obj.get_double_throw(type.second, path);
+                boss[(size_t)type.first] = obj.get_double_throw(type.second, path);
             }
         }
     }
@@ -69,6 +79,48 @@ private:
 };
 
 
+double average_type_vs_boss(PokemonType type, PokemonType boss_type){
+    using namespace papkmnlib;
+
+    Type pkmnlib_type = serial_type_to_pkmnlib(boss_type);
+
+    double weight = 0;
+    size_t count = 0;
+    for (const auto& item : all_bosses_by_dex()){
+        const Pokemon& boss = get_pokemon(item.second);
+        if (boss_type == PokemonType::NONE || boss.has_type(pkmnlib_type)){
+            weight += type_vs_boss(type, boss.name());
+            count++;
+        }
+    }
+
+    return weight / (double)count;
+}
+
+//  "average_type_vs_boss()" for every pair of types. Path selection only ever
+//  needs these averages, so there's no reason to redo them for every path.
+struct BossTypeMatchDatabase{
+    std::vector<double> type_vs_boss_type;  //  [boss_type * TYPE_COUNT + type]
+
+    static const BossTypeMatchDatabase& instance(){
+        static BossTypeMatchDatabase database;
+        return database;
+    }
+
+private:
+    BossTypeMatchDatabase()
+        : type_vs_boss_type(TYPE_COUNT * TYPE_COUNT)
+    {
+        for (size_t boss_type = 0; boss_type < TYPE_COUNT; boss_type++){
+            for (size_t type = 1; type < TYPE_COUNT; type++){
+                type_vs_boss_type[boss_type * TYPE_COUNT + type] =
+                    average_type_vs_boss((PokemonType)type, (PokemonType)boss_type);
+            }
+        }
+    }
+};
+
+
 const std::set<std::string>& rentals_by_type(PokemonType type){
     const PathMatchDatabase& database = PathMatchDatabase::instance();
     auto iter = database.rentals_by_type.find(type);
@@ -81,34 +133,27 @@ const std::set<std::string>& rentals_by_type(PokemonType type){
 double type_vs_boss(PokemonType type, const std::string& boss_slug){
     const PathMatchDatabase& database = PathMatchDatabase::instance();
 
-    auto iter0 = database.type_vs_boss.find(boss_slug);
-    if (iter0 == database.type_vs_boss.end()){
+    auto iter = database.boss_ids.find(boss_slug);
+    if (iter == database.boss_ids.end()){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
     }
 
-    auto iter1 = iter0->second.find(type);
-    if (iter1 == iter0->second.end()){
+    if (type == PokemonType::NONE || (size_t)type >= TYPE_COUNT){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
     }
 
-    return iter1->second;
+    return database.type_vs_boss[iter->second * TYPE_COUNT + (size_t)type];
 }
 double type_vs_boss(PokemonType type, PokemonType boss_type){
-    using namespace papkmnlib;
-
-    Type pkmnlib_type = serial_type_to_pkmnlib(boss_type);
-
-    double weight = 0;
-    size_t count = 0;
-    for (const auto& item : all_bosses_by_dex()){
-        const Pokemon& boss = get_pokemon(item.second);
-        if (boss_type == PokemonType::NONE || boss.has_type(pkmnlib_type)){
-            weight += type_vs_boss(type, boss.name());
-            count++;
-        }
+    if (type == PokemonType::NONE || (size_t)type >= TYPE_COUNT || (size_t)boss_type >= TYPE_COUNT){
+        //  Not in the table. Let the per-boss lookup deal with it.
+        return average_type_vs_boss(type, boss_type);
     }
-
-    return weight / (double)count;
+    return BossTypeMatchDatabase::instance().type_vs_boss_type[(size_t)boss_type * TYPE_COUNT + (size_t)type];
+}
+void preload_path_matchup(){
+    PathMatchDatabase::instance();
+    BossTypeMatchDatabase::instance();
 }
 
 
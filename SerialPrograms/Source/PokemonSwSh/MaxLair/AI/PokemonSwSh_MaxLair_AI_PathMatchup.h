@@ -24,6 +24,9 @@ const std::set<std::string>& rentals_by_type(PokemonType type);
 double type_vs_boss(PokemonType type, const std::string& boss_slug);
 double type_vs_boss(PokemonType type, PokemonType boss_type);
 
+//  Load the path tables now instead of on first use.
+void preload_path_matchup();
+
 
 
 std::vector<std::vector<PathNode>> generate_paths(
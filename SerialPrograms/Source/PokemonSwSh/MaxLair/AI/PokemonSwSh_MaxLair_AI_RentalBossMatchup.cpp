@@ -4,6 +4,7 @@
  *
  */
 
+#include <cmath>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
@@ -20,23 +21,42 @@ namespace MaxLairInternal{
 
 
 struct MatchupDatabase{
-    std::map<std::string, std::map<std::string, double>> map;
+    std::map<std::string, size_t> rental_ids;
+    std::map<std::string, size_t> boss_ids;
+
+    //  [boss_id * rental_ids.size() + rental_id]
+    //  Boss-major so that averaging over rentals reads one contiguous row.
+    std::vector<double> table;
 
     static const MatchupDatabase& instance(){
         static MatchupDatabase database;
         return database;
     }
 
-    double get(const std::string& rental, const std::string& boss) const{
-        auto iter0 = map.find(rental);
-        if (iter0 == map.end()){
+    size_t rental_id(const std::string& rental) const{
+        auto iter = rental_ids.find(rental);
+        if (iter == rental_ids.end()){
             throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + rental);
         }
-        auto iter1 = iter0->second.find(boss);
-        if (iter1 == iter0->second.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + rental);
+        return iter->second;
+    }
+    size_t boss_id(const std::string& boss) const{
+        auto iter = boss_ids.find(boss);
+        if (iter == boss_ids.end()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + boss);
         }
-        return iter1->second;
+        return iter->second;
+    }
+    const double* row(size_t boss_id) const{
+        return table.data() + boss_id * rental_ids.size();
+    }
+
+    double get(const std::string& rental, const std::string& boss) const{
+        double score = row(boss_id(boss))[rental_id(rental)];
+        if (std::isnan(score)){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "No matchup for " + rental + " vs. " + boss);
+        }
+        return score;
     }
 
 private:
@@ -44,11 +64,21 @@ private:
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/boss_matchup_LUT.json";
         JsonValue json = load_json_file(path);
         JsonObject& root = json.get_object_throw(path);
+
+        //  Assign ids first so the table can be sized once.
         for (auto& item0 : root){
-            std::map<std::string, double>& sub = map[item0.first];
-            JsonObject& obj = item0.second.get_object_throw(path);
-            for (auto& item1 : obj){
-                sub[item1.first] = item1.second.get_double_throw(path);
+            rental_ids.emplace(item0.first, rental_ids.size());
+            for (auto& item1 : item0.second.get_object_throw(path)){
+                boss_ids.emplace(item1.first, boss_ids.size());
+            }
+        }
+
+        table.resize(boss_ids.size() * rental_ids.size(), NAN);
+        for (auto& item0 : root){
+            size_t rental = rental_ids[item0.first];
+            for (auto& item1 : item0.second.get_object_throw(path)){
+                size_t boss = boss_ids[item1.first];
+                table[boss * rental_ids.size() + rental] = item1.second.get_double_throw(path);
             }
         }
     }
@@ -57,6 +87,18 @@ private:
 double rental_vs_boss_matchup(const std::string& rental, const std::string& boss){
     return MatchupDatabase::instance().get(rental, boss);
 }
+size_t rental_matchup_id(const std::string& rental){
+    return MatchupDatabase::instance().rental_id(rental);
+}
+size_t boss_matchup_id(const std::string& boss){
+    return MatchupDatabase::instance().boss_id(boss);
+}
+const double* rental_vs_boss_matchups(size_t boss_id){
+    return MatchupDatabase::instance().row(boss_id);
+}
+void preload_rental_vs_boss_matchup(){
+    MatchupDatabase::instance();
+}
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses){
     using namespace papkmnlib;
 
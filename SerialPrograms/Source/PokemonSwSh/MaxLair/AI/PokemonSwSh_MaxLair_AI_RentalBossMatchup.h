@@ -19,6 +19,18 @@ namespace MaxLairInternal{
 double rental_vs_boss_matchup(const std::string& rental, const std::string& boss);
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses);
 
+//  Dense ids into the matchup table. These are assigned when the table is
+//  loaded. Throws if the Pokemon isn't in the table.
+size_t rental_matchup_id(const std::string& rental);
+size_t boss_matchup_id(const std::string& boss);
+
+//  The matchup of every rental against this boss, indexed by rental id.
+//  Rentals that have no matchup against this boss are NaN.
+const double* rental_vs_boss_matchups(size_t boss_id);
+
+//  Load the matchup table now instead of on first use.
+void preload_rental_vs_boss_matchup();
+
 
 
 }
@@ -5,6 +5,7 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Concurrency/ParallelTaskRunner.h"
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.h"
 #include "PokemonSwSh_MaxLair_AI.h"
@@ -23,6 +24,7 @@ namespace MaxLairInternal{
 //  Professor offers to exchange a Pokemon.
 bool should_swap_with_professor(
     Logger& logger,
+    ParallelTaskRunner& task_runner,
     const GlobalState& state,
     size_t player_index
 ){
@@ -51,18 +53,42 @@ bool should_swap_with_professor(
 
 
     //  Find the "average" rental against this boss.
-    std::multimap<double, const Pokemon*> list;
+    std::vector<std::pair<const Pokemon*, const Pokemon*>> matchups;   //  (boss, rental)
     for (const Pokemon* boss : boss_candidates_on_path){
         for (const auto& rental : all_rental_pokemon()){
             if (state.seen.find(rental.first) != state.seen.end()){
                 continue;
             }
-            list.emplace(evaluate_matchup(rental.second, *boss, {}, lives), &rental.second);
+            matchups.emplace_back(boss, &rental.second);
         }
     }
-    if (list.empty()){
+    if (matchups.empty()){
         throw InternalProgramError(&logger, PA_CURRENT_FUNCTION, "Opponent candidate list is empty.");
     }
+
+    //  Every one of these simulates a battle. Score them in parallel, then
+    //  rank them in the original order so that ties resolve the same way.
+    std::vector<double> scores(matchups.size());
+    {
+        const size_t BLOCK = 16;
+        std::vector<std::shared_ptr<AsyncTask>> tasks;
+        for (size_t s = 0; s < matchups.size(); s += BLOCK){
+            size_t e = std::min(s + BLOCK, matchups.size());
+            tasks.emplace_back(task_runner.dispatch([&, s, e]{
+                for (size_t c = s; c < e; c++){
+                    scores[c] = evaluate_matchup(*matchups[c].second, *matchups[c].first, {}, lives);
+                }
+            }));
+        }
+        for (std::shared_ptr<AsyncTask>& task : tasks){
+            task->wait_and_rethrow_exceptions();
+        }
+    }
+
+    std::multimap<double, const Pokemon*> list;
+    for (size_t c = 0; c < matchups.size(); c++){
+        list.emplace(scores[c], matchups[c].second);
+    }
     size_t midpoint = list.size() / 2;
     for (size_t c = 0; c < midpoint; c++){
         list.erase(list.begin());
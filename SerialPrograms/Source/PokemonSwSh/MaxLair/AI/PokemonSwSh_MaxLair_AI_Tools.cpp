@@ -4,6 +4,7 @@
  *
  */
 
+#include <cmath>
 #include <vector>
 #include "Common/Cpp/Exceptions.h"
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
@@ -91,6 +92,18 @@ std::vector<const papkmnlib::Pokemon*> get_boss_candidates(const GlobalState& st
 
 
 
+//  Matchup ids of "all_rental_pokemon()" in the same order.
+const std::vector<size_t>& all_rental_matchup_ids(){
+    static const std::vector<size_t> ids = []{
+        std::vector<size_t> ret;
+        for (const auto& rental : papkmnlib::all_rental_pokemon()){
+            ret.emplace_back(rental_matchup_id(rental.first));
+        }
+        return ret;
+    }();
+    return ids;
+}
+
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<const papkmnlib::Pokemon*>& bosses){
     using namespace papkmnlib;
 
@@ -99,12 +112,19 @@ double rental_vs_boss_matchup(const std::string& rental, const std::vector<const
     }
     double score = 0;
     if (rental.empty()){
+        //  Same order of summation as looking each one up by name so the
+        //  result is identical.
+        const std::vector<size_t>& rentals = all_rental_matchup_ids();
         for (const Pokemon* boss : bosses){
-            for (const auto& candidate : all_rental_pokemon()){
-                score += rental_vs_boss_matchup(candidate.first, boss->name());
+            const double* matchups = rental_vs_boss_matchups(boss_matchup_id(boss->name()));
+            for (size_t id : rentals){
+                score += matchups[id];
             }
         }
-        score /= bosses.size() * all_rental_pokemon().size();
+        if (std::isnan(score)){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Missing rental matchup against one of the bosses.");
+        }
+        score /= bosses.size() * rentals.size();
     }else{
         for (const Pokemon* boss : bosses){
             score += rental_vs_boss_matchup(rental, boss->name());
@@ -5,6 +5,7 @@
  */
 
 #include "Common/NintendoSwitch/NintendoSwitch_Protocol_PushButtons.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/Tools/ErrorDumper.h"
 #include "CommonFramework/Tools/InterruptableCommands.h"
@@ -38,6 +39,32 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+AdventureRuntime::AdventureRuntime(
+    const size_t p_host_index,
+    const Consoles& p_console_settings,
+    const EndBattleDecider& p_actions,
+    const bool p_go_home_when_done,
+    HostingSettings& p_hosting_settings,
+    EventNotificationOption& p_notification_status,
+    EventNotificationOption& p_notification_shiny,
+    Stats& p_session_stats
+)
+    : host_index(p_host_index)
+    , console_settings(p_console_settings)
+    , actions(p_actions)
+    , go_home_when_done(p_go_home_when_done)
+    , hosting_settings(p_hosting_settings)
+    , notification_status(p_notification_status)
+    , notification_shiny(p_notification_shiny)
+    , session_stats(p_session_stats)
+    , ai_task_runner(
+        [](){ GlobalSettings::instance().COMPUTE_PRIORITY0.set_on_this_thread(); },
+        0, 0
+    )
+{}
+
+
+
 StateMachineAction run_state_iteration(
     AdventureRuntime& runtime, size_t console_index,
     ProgramEnvironment& env, ConsoleHandle& console, BotBaseContext& context,
@@ -8,6 +8,7 @@
 #define PokemonAutomation_PokemonSwSh_MaxLair_StateMachine_H
 
 #include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Concurrency/ParallelTaskRunner.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "NintendoSwitch/NintendoSwitch_MultiSwitchProgram.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_QuantityReader.h"
@@ -60,16 +61,7 @@ struct AdventureRuntime{
         EventNotificationOption& p_notification_status,
         EventNotificationOption& p_notification_shiny,
         Stats& p_session_stats
-    )
-        : host_index(p_host_index)
-        , console_settings(p_console_settings)
-        , actions(p_actions)
-        , go_home_when_done(p_go_home_when_done)
-        , hosting_settings(p_hosting_settings)
-        , notification_status(p_notification_status)
-        , notification_shiny(p_notification_shiny)
-        , session_stats(p_session_stats)
-    {}
+    );
 
     const size_t host_index;
     const Consoles& console_settings;
@@ -90,6 +82,10 @@ struct AdventureRuntime{
     //  A lock to allow timed-serialization of Switches.
     //  For example: Don't let multiple Switches simultaneously choose to swap with Pokemon.
     std::mutex m_delay_lock;
+
+    //  Thread pool for the AI decisions that are worth parallelizing.
+    //  Shared by all the Switches for the whole run.
+    ParallelTaskRunner ai_task_runner;
 };
 
 
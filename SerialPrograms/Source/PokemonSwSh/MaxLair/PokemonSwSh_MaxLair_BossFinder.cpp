@@ -13,6 +13,7 @@
 #include "Pokemon/Pokemon_Strings.h"
 #include "PokemonSwSh/Programs/PokemonSwSh_GameEntry.h"
 #include "Program/PokemonSwSh_MaxLair_Run_Adventure.h"
+#include "PokemonSwSh/Resources/PokemonSwSh_Preload.h"
 #include "PokemonSwSh_MaxLair_BossFinder.h"
 
 namespace PokemonAutomation{
@@ -33,7 +34,9 @@ MaxLairBossFinder_Descriptor::MaxLairBossFinder_Descriptor()
         PABotBaseLevel::PABOTBASE_12KB,
         1, 4, 1
     )
-{}
+{
+    set_required_resources({PRELOAD_MAX_LAIR_TABLES});
+}
 std::unique_ptr<StatsTracker> MaxLairBossFinder_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
@@ -13,6 +13,7 @@
 #include "PokemonSwSh/Options/PokemonSwSh_BallSelectOption.h"
 #include "PokemonSwSh/Programs/PokemonSwSh_GameEntry.h"
 #include "Program/PokemonSwSh_MaxLair_Run_Adventure.h"
+#include "PokemonSwSh/Resources/PokemonSwSh_Preload.h"
 #include "PokemonSwSh_MaxLair_Standard.h"
 
 #include <iostream>
@@ -37,7 +38,9 @@ MaxLairStandard_Descriptor::MaxLairStandard_Descriptor()
         PABotBaseLevel::PABOTBASE_12KB,
         1, 4, 1
     )
-{}
+{
+    set_required_resources({PRELOAD_MAX_LAIR_TABLES});
+}
 std::unique_ptr<StatsTracker> MaxLairStandard_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
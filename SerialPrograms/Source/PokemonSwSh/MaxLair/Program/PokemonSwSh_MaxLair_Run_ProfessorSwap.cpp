@@ -40,7 +40,7 @@ void run_professor_swap(
     GlobalState inferred = state_tracker.synchronize(console, console_index);
 
 
-    bool swap = should_swap_with_professor(console, inferred, player_index);
+    bool swap = should_swap_with_professor(console, runtime.ai_task_runner, inferred, player_index);
     if (swap){
         console.log("Choosing to swap.", COLOR_PURPLE);
         std::lock_guard<std::mutex> lg(runtime.m_delay_lock);
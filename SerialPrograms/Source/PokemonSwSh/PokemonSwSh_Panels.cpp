@@ -5,6 +5,7 @@
  */
 
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "Resources/PokemonSwSh_Preload.h"
 #include "PokemonSwSh_Panels.h"
 
 #include "PokemonSwSh_Settings.h"
@@ -97,7 +98,9 @@ namespace PokemonSwSh{
 
 PanelListFactory::PanelListFactory()
     : PanelListDescriptor(Pokemon::STRING_POKEMON + " Sword and Shield")
-{}
+{
+    register_preload_resources();
+}
 
 std::vector<PanelEntry> PanelListFactory::make_panels() const{
     std::vector<PanelEntry> ret;
@@ -4,7 +4,6 @@
  *
  */
 
-#include <algorithm>
 #include "Common/Cpp/PrettyPrint.h"
 #include "CommonFramework/Exceptions/OperationFailedException.h"
 #include "NintendoSwitch/Commands/NintendoSwitch_Commands_PushButtons.h"
@@ -59,9 +58,7 @@ Xoroshiro128PlusState find_rng_state(
     }
     Xoroshiro128Plus rng = Xoroshiro128Plus::xoroshiro128plus_from_last_bits(std::pair(last_bits0, last_bits1));
 
-    for (size_t j = 0; j < 128; j++) {
-        rng.next();
-    }
+    rng.advance(128);
     console.log("RNG: state[0] = " + tostr_hex(rng.get_state().s0));
     console.log("RNG: state[1] = " + tostr_hex(rng.get_state().s1));
     return rng.get_state();
@@ -78,17 +75,12 @@ Xoroshiro128PlusState refind_rng_state(
     bool log_image_values)
 {
     Xoroshiro128Plus rng(last_known_state.s0, last_known_state.s1);
-    for (size_t i = 0; i < min_advances; i++) {
-        rng.next();
-    }
+    rng.advance(min_advances);
     OrbeetleAttackAnimationDetector detector(console, context);
-    size_t possible_indices = SIZE_MAX;
-    std::vector<bool> sequence = {};
-    std::vector<bool> last_bit_sequence = rng.generate_last_bit_sequence(max_advances - min_advances);
-    size_t distance = 0;
+    Xoroshiro128PlusLastBitMatcher matcher(rng.get_state(), max_advances - min_advances);
 
     size_t i = 0;
-    while (possible_indices > 1) {
+    while (matcher.observed() == 0 || matcher.candidates() > 1) {
         context.wait_for_all_requests();
 
         std::string text = std::to_string(++i) + "/?";
@@ -102,40 +94,27 @@ Xoroshiro128PlusState refind_rng_state(
             );
         case OrbeetleAttackAnimationDetector::SPECIAL:
             text += " : Special";
-            sequence.emplace_back(true);
+            matcher.push(true);
             break;
         case OrbeetleAttackAnimationDetector::PHYSICAL:
             text += " : Physical";
-            sequence.emplace_back(false);
+            matcher.push(false);
             break;
         }
         console.overlay().add_log(text, COLOR_BLUE);
         pbf_wait(context, 180);
-
-        std::vector<bool>::iterator last_bit_start = std::search(last_bit_sequence.begin(), last_bit_sequence.end(), sequence.begin(), sequence.end());
-        possible_indices = 0;
-        distance = 0;
-        while (last_bit_start != last_bit_sequence.end()) {
-            possible_indices++;
-            distance = std::distance(last_bit_sequence.begin(), last_bit_start);
-
-            last_bit_start++;
-            last_bit_start = std::search(last_bit_start, last_bit_sequence.end(), sequence.begin(), sequence.end());
-        }
     }
-    if (possible_indices == 0) {
+    if (matcher.candidates() == 0) {
         throw OperationFailedException(
             ErrorReport::SEND_ERROR_REPORT, console,
             "Detected sequence of attack motions does not exist in expected range."
         );
     }
 
-    distance += sequence.size();
-    console.log("RNG: needed " + std::to_string(sequence.size()) + " animations.");
+    size_t distance = matcher.first_candidate() + matcher.observed();
+    console.log("RNG: needed " + std::to_string(matcher.observed()) + " animations.");
     console.log("RNG: new state is " + std::to_string(distance + min_advances) + " advances from last known state.");
-    for (size_t advance = 0; advance < distance; advance++) {
-        rng.next();
-    }
+    rng.advance(distance);
     console.log("RNG: state[0] = " + tostr_hex(rng.get_state().s0));
     console.log("RNG: state[1] = " + tostr_hex(rng.get_state().s1));
 
@@ -5,6 +5,8 @@
  */
 
 #include <cstddef>
+#include <bit>
+#include "Kernels/Xoroshiro128Plus/Kernels_Xoroshiro128Plus.h"
 #include "PokemonSwSh/Programs/RNG/PokemonSwSh_Xoroshiro128Plus.h"
 
 namespace PokemonAutomation {
@@ -67,15 +69,105 @@ uint64_t Xoroshiro128Plus::nextInt(uint64_t bound) {
     return result;
 }
 
-std::vector<bool> Xoroshiro128Plus::generate_last_bit_sequence(size_t max_advances) {
-    std::vector<bool> sequence(max_advances);
-    Xoroshiro128Plus temp_rng(Xoroshiro128PlusState(state.s0, state.s1));
 
-    for (size_t i = 0; i < max_advances; i++) {
-        sequence.at(i) = (temp_rng.next() & 1) == 1;
-    };
+namespace {
 
-    return sequence;
+// The state update is linear over GF(2), so advancing 2^k times is a fixed
+// 128x128 bit matrix. "images[i]" is what the state with only bit "i" set
+// becomes. (bits 0-63 are s0, bits 64-127 are s1)
+struct Xoroshiro128PlusJump {
+    uint64_t images[128][2];
+
+    Xoroshiro128PlusState apply(Xoroshiro128PlusState state) const {
+        uint64_t s0 = 0;
+        uint64_t s1 = 0;
+        for (size_t i = 0; i < 64; i++) {
+            uint64_t mask0 = 0 - ((state.s0 >> i) & 1);
+            uint64_t mask1 = 0 - ((state.s1 >> i) & 1);
+            s0 ^= (images[i][0] & mask0) ^ (images[i + 64][0] & mask1);
+            s1 ^= (images[i][1] & mask0) ^ (images[i + 64][1] & mask1);
+        }
+        return Xoroshiro128PlusState(s0, s1);
+    }
+};
+
+// JUMPS()[k] advances 2^(k + JUMP_MIN_LOG2) times.
+const size_t JUMP_MIN_LOG2 = 6;
+const std::vector<Xoroshiro128PlusJump>& JUMPS() {
+    static const std::vector<Xoroshiro128PlusJump> jumps = []() {
+        Xoroshiro128PlusJump jump;
+        for (size_t i = 0; i < 128; i++) {
+            Xoroshiro128Plus rng(
+                i < 64 ? (uint64_t)1 << i : 0,
+                i < 64 ? 0 : (uint64_t)1 << (i - 64)
+            );
+            for (size_t c = 0; c < ((size_t)1 << JUMP_MIN_LOG2); c++) {
+                rng.next();
+            }
+            jump.images[i][0] = rng.state.s0;
+            jump.images[i][1] = rng.state.s1;
+        }
+
+        std::vector<Xoroshiro128PlusJump> ret;
+        ret.emplace_back(jump);
+        for (size_t k = JUMP_MIN_LOG2 + 1; k < 64; k++) {
+            const Xoroshiro128PlusJump& half = ret.back();
+            for (size_t i = 0; i < 128; i++) {
+                Xoroshiro128PlusState image = half.apply(Xoroshiro128PlusState(half.images[i][0], half.images[i][1]));
+                jump.images[i][0] = image.s0;
+                jump.images[i][1] = image.s1;
+            }
+            ret.emplace_back(jump);
+        }
+        return ret;
+    }();
+    return jumps;
+}
+
+}
+
+void Xoroshiro128Plus::advance(uint64_t advances) {
+    // A jump costs about as much as 64 steps. So step through the low bits.
+    for (uint64_t c = advances & (((uint64_t)1 << JUMP_MIN_LOG2) - 1); c > 0; c--) {
+        next();
+    }
+    advances >>= JUMP_MIN_LOG2;
+    if (advances == 0) {
+        return;
+    }
+
+    const std::vector<Xoroshiro128PlusJump>& jumps = JUMPS();
+    for (size_t k = 0; advances != 0; k++, advances >>= 1) {
+        if (advances & 1) {
+            state = jumps[k].apply(state);
+        }
+    }
+}
+
+std::vector<uint64_t> Xoroshiro128Plus::generate_last_bits(size_t count) const {
+    const size_t LANES = Kernels::XOROSHIRO128PLUS_LANES;
+    size_t words = (count + 63) / 64;
+    size_t words_per_lane = (words + LANES - 1) / LANES;
+
+    // Split the range evenly across the lanes and jump each one to the start
+    // of its part.
+    uint64_t s0[LANES];
+    uint64_t s1[LANES];
+    Xoroshiro128Plus lane(state);
+    for (size_t l = 0; l < LANES; l++) {
+        s0[l] = lane.state.s0;
+        s1[l] = lane.state.s1;
+        lane.advance(words_per_lane * 64);
+    }
+
+    std::vector<uint64_t> bits(words_per_lane * LANES);
+    Kernels::xoroshiro128plus_last_bits(bits.data(), words_per_lane, words_per_lane, s0, s1);
+
+    bits.resize(words);
+    if (count % 64 != 0) {
+        bits.back() &= ((uint64_t)1 << (count % 64)) - 1;
+    }
+    return bits;
 }
 
 // The generic solution to the system of equations to calculate the initial state from the last bits of 128 consecutive Xoroshiro128+ results.
@@ -252,4 +344,67 @@ Xoroshiro128Plus Xoroshiro128Plus::xoroshiro128plus_from_last_bits(std::pair<uin
 }
 
 
+
+Xoroshiro128PlusLastBitMatcher::Xoroshiro128PlusLastBitMatcher(Xoroshiro128PlusState state, size_t window)
+    : m_window(window)
+    , m_observed(0)
+    , m_bits(Xoroshiro128Plus(state).generate_last_bits(window))
+    , m_candidates((window + 63) / 64, ~(uint64_t)0)
+    , m_first_word(0)
+    , m_last_word(m_candidates.size())
+{
+    if (window % 64 != 0) {
+        m_candidates.back() = ((uint64_t)1 << (window % 64)) - 1;
+    }
+}
+
+uint64_t Xoroshiro128PlusLastBitMatcher::bits_word(size_t index) const {
+    return index < m_bits.size() ? m_bits[index] : 0;
+}
+
+void Xoroshiro128PlusLastBitMatcher::push(bool last_bit) {
+    // Start position "p" survives if result "p + m_observed" has this bit.
+    size_t shift_words = m_observed / 64;
+    size_t shift = m_observed % 64;
+    uint64_t flip = last_bit ? 0 : ~(uint64_t)0;
+    for (size_t w = m_first_word; w < m_last_word; w++) {
+        uint64_t bits = bits_word(w + shift_words);
+        if (shift != 0) {
+            bits = (bits >> shift) | (bits_word(w + shift_words + 1) << (64 - shift));
+        }
+        m_candidates[w] &= bits ^ flip;
+    }
+    m_observed++;
+
+    // The whole sequence must fit in the window.
+    size_t limit = m_observed <= m_window ? m_window - m_observed + 1 : 0;
+    for (size_t w = limit / 64; w < m_last_word; w++) {
+        size_t start = w * 64;
+        m_candidates[w] &= limit <= start ? 0 : ((uint64_t)1 << (limit - start)) - 1;
+    }
+
+    while (m_first_word < m_last_word && m_candidates[m_first_word] == 0) {
+        m_first_word++;
+    }
+    while (m_first_word < m_last_word && m_candidates[m_last_word - 1] == 0) {
+        m_last_word--;
+    }
+}
+
+size_t Xoroshiro128PlusLastBitMatcher::candidates() const {
+    size_t count = 0;
+    for (size_t w = m_first_word; w < m_last_word; w++) {
+        count += std::popcount(m_candidates[w]);
+    }
+    return count;
+}
+
+size_t Xoroshiro128PlusLastBitMatcher::first_candidate() const {
+    if (m_first_word == m_last_word) {
+        return SIZE_MAX;
+    }
+    return m_first_word * 64 + std::countr_zero(m_candidates[m_first_word]);
+}
+
+
 }
@@ -8,6 +8,7 @@
 #define PokemonAutomation_PokemonSwSh_Xoroshiro128Plus_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include <utility>
 #include <vector>
 
@@ -28,7 +29,13 @@ public:
     uint64_t next();
     uint64_t nextInt(uint64_t);
     Xoroshiro128PlusState get_state();
-    std::vector<bool> generate_last_bit_sequence(size_t max_advances);
+
+    //  Same as calling "next()" this many times, but in O(log(advances)).
+    void advance(uint64_t advances);
+
+    //  The last bits of the next "count" results without advancing this
+    //  generator. Result "i" is bit (i % 64) of word (i / 64).
+    std::vector<uint64_t> generate_last_bits(size_t count) const;
 
     static Xoroshiro128Plus xoroshiro128plus_from_last_bits(std::pair<uint64_t, uint64_t> last_bits);
 
@@ -39,5 +46,38 @@ private:
     uint64_t rotl(const uint64_t x, int k);
 };
 
+
+//  Finds where a sequence of observed last bits starts within the next
+//  "window" results of a known state.
+//
+//  Each observed bit rules out every start position that disagrees with it,
+//  so the cost per bit is proportional to the window in words, not bits.
+//  Only sequences that fit entirely within the window are matched.
+class Xoroshiro128PlusLastBitMatcher {
+public:
+    Xoroshiro128PlusLastBitMatcher(Xoroshiro128PlusState state, size_t window);
+
+    void push(bool last_bit);
+
+    size_t observed() const { return m_observed; }
+
+    //  Number of start positions that agree with everything observed so far.
+    size_t candidates() const;
+
+    //  The earliest of those start positions. SIZE_MAX if there are none.
+    size_t first_candidate() const;
+
+private:
+    uint64_t bits_word(size_t index) const;
+
+private:
+    size_t m_window;
+    size_t m_observed;
+    std::vector<uint64_t> m_bits;
+    std::vector<uint64_t> m_candidates;
+    size_t m_first_word;
+    size_t m_last_word;
+};
+
 }
 #endif
@@ -0,0 +1,49 @@
+/*  Pokemon Sword/Shield Preload
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include "CommonFramework/Resources/ResourcePreloader.h"
+#include "Pokemon/Resources/Pokemon_Preload.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_RentalBossMatchup.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathMatchup.h"
+#include "PokemonSwSh_Preload.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+
+
+const std::string PRELOAD_MAX_LAIR_BOSS_MATCHUPS    = "PokemonSwSh: Max Lair Boss Matchups";
+const std::string PRELOAD_MAX_LAIR_PATH_MATCHUPS    = "PokemonSwSh: Max Lair Path Matchups";
+const std::string PRELOAD_MAX_LAIR_TABLES           = "PokemonSwSh: Max Lair Tables";
+
+
+void register_preload_resources(){
+    Pokemon::register_preload_resources();
+
+    ResourcePreloader& preloader = ResourcePreloader::instance();
+    preloader.add(
+        PRELOAD_MAX_LAIR_BOSS_MATCHUPS, std::chrono::milliseconds(300), {},
+        []{ MaxLairInternal::preload_rental_vs_boss_matchup(); }
+    );
+    preloader.add(
+        PRELOAD_MAX_LAIR_PATH_MATCHUPS, std::chrono::milliseconds(100), {},
+        []{ MaxLairInternal::preload_path_matchup(); }
+    );
+    preloader.add(
+        PRELOAD_MAX_LAIR_TABLES, std::chrono::milliseconds(0),
+        {
+            PRELOAD_MAX_LAIR_BOSS_MATCHUPS,
+            PRELOAD_MAX_LAIR_PATH_MATCHUPS,
+        },
+        []{}
+    );
+}
+
+
+
+}
+}
+}
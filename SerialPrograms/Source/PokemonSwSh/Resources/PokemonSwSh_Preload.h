@@ -0,0 +1,30 @@
+/*  Pokemon Sword/Shield Preload
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Resources that Sword/Shield programs can ask the ResourcePreloader for.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSwSh_Preload_H
+#define PokemonAutomation_PokemonSwSh_Preload_H
+
+#include <string>
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSwSh{
+
+
+//  The Max Lair AI lookup tables.
+extern const std::string PRELOAD_MAX_LAIR_TABLES;
+
+
+void register_preload_resources();
+
+
+
+}
+}
+}
+#endif
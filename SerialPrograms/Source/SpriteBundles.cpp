@@ -0,0 +1,77 @@
+/*  Sprite Bundles
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <vector>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Resources/SpriteDatabase.h"
+#include "PokemonLA/Inference/Map/PokemonLA_PokemonMapSpriteReader.h"
+#include "SpriteBundles.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+struct SpriteSheet{
+    const char* sprite_path;
+    const char* json_path;
+    std::vector<SpriteBundleFeature> features;
+};
+
+//  Every SpriteDatabase in the program. Keep this in sync with the
+//  databases in the "*/Resources/" folders.
+std::vector<SpriteSheet> all_sprite_sheets(){
+    return {
+        {"Pokemon/BerrySprites.png", "Pokemon/BerrySprites.json", {}},
+        {"PokemonSwSh/PokeballSprites.png", "PokemonSwSh/PokeballSprites.json", {}},
+        {"PokemonSwSh/PokemonSprites.png", "PokemonSwSh/PokemonSprites.json", {}},
+        {"PokemonSwSh/PokemonSilhouettes.png", "PokemonSwSh/PokemonSprites.json", {}},
+        {"PokemonLA/PokemonSprites.png", "PokemonLA/PokemonSprites.json", {}},
+        {"PokemonLA/MMOSprites.png", "PokemonLA/MMOSprites.json", NintendoSwitch::PokemonLA::MMO_SPRITE_BUNDLE_FEATURES()},
+        {"PokemonSV/PokemonSprites.png", "PokemonSV/PokemonSprites.json", {}},
+        {"PokemonSV/PokemonSilhouettes.png", "PokemonSV/PokemonSprites.json", {}},
+        {"PokemonSV/Picnic/SandwichFillingSprites.png", "PokemonSV/Picnic/SandwichFillingSprites.json", {}},
+        {"PokemonSV/Picnic/SandwichCondimentSprites.png", "PokemonSV/Picnic/SandwichCondimentSprites.json", {}},
+        {"PokemonSV/Auction/AuctionItemSprites.png", "PokemonSV/Auction/AuctionItemSprites.json", {}},
+    };
+}
+
+}
+
+
+int build_sprite_bundles(){
+    Logger& logger = global_logger_tagged();
+    logger.log("Building sprite bundles...");
+
+    size_t failures = 0;
+    for (const SpriteSheet& sheet : all_sprite_sheets()){
+        try{
+            WallClock start = current_time();
+            SpriteDatabase::build_bundle(sheet.sprite_path, sheet.json_path, sheet.features);
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start).count();
+            logger.log(
+                "Wrote sprite bundle for " + std::string(sheet.sprite_path) +
+                " with " + std::to_string(sheet.features.size()) + " feature(s) in " + std::to_string(ms) + " ms.",
+                COLOR_BLUE
+            );
+        }catch (const Exception& error){
+            logger.log("Unable to build sprite bundle for " + std::string(sheet.sprite_path) + ": " + error.to_str(), COLOR_RED);
+            failures++;
+        }
+    }
+
+    if (failures != 0){
+        logger.log("Failed to build " + std::to_string(failures) + " sprite bundle(s).", COLOR_RED);
+        return 1;
+    }
+    logger.log("All sprite bundles built.", COLOR_BLUE);
+    return 0;
+}
+
+
+}
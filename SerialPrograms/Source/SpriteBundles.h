@@ -0,0 +1,29 @@
+/*  Sprite Bundles
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Offline step that writes a sprite bundle (see CommonFramework/Resources/SpriteBundle.h)
+ *  next to every sprite sheet in the resource folder.
+ *
+ *  Enable it by setting "20-GlobalSettings": "BUILD_SPRITE_BUNDLES" to true in
+ *  SerialPrograms-Settings.json. The program then writes the bundles and exits
+ *  without launching the GUI.
+ *
+ *  Rerun it whenever a sprite sheet or its json changes, or when the features
+ *  that a database stores in its bundle change. Until then, the stale bundles
+ *  are ignored and the sprite sheets are decoded as usual.
+ *
+ */
+
+#ifndef PokemonAutomation_SpriteBundles_H
+#define PokemonAutomation_SpriteBundles_H
+
+namespace PokemonAutomation{
+
+
+//  Returns 0 if all the bundles were written.
+int build_sprite_bundles();
+
+
+}
+#endif
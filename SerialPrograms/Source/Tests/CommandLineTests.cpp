@@ -7,9 +7,11 @@
 
 #include "CommandLineTests.h"
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CpuId/CpuId.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "PokemonLA_Tests.h"
 #include "TestMap.h"
+#include "TestBenchmark.h"
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
@@ -46,24 +48,67 @@ void print_equals(){
         } \
     } while (0)
 
-#define RETURN_IF_TEST_FAILED(test_func, file_path, num_passed) \
-    do { \
-        int _ret = 0; \
-        try { \
-            _ret = test_func(file_path); \
-        } catch (const std::exception& e) { \
-            cout << "Test: " << (file_path) << " threw exception: " << e.what() << endl; \
-        } catch (const Exception& e) {\
-           cout << "Test: " << (file_path) << " threw " << e.name() << ": <<<" << e.message() << ">>>" << endl; \
-        } \
-        if (_ret > 0) {\
-            print_equals(); \
-            cout << "Test: " << (file_path) << " failed." << endl; \
-            return _ret; \
-        } else if (_ret == 0){ \
-            num_passed++; \
-        } \
-    } while (0)
+// Run "test" on "file_path". An exception is reported, but doesn't fail the test.
+int run_and_catch(const std::string& file_path, const std::function<int()>& test){
+    try {
+        return test();
+    } catch (const std::exception& e) {
+        cout << "Test: " << file_path << " threw exception: " << e.what() << endl;
+    } catch (const Exception& e) {
+       cout << "Test: " << file_path << " threw " << e.name() << ": <<<" << e.message() << ">>>" << endl;
+    }
+    return 0;
+}
+
+// Run the test on one file. In benchmark mode, also time it. Kernel tests are
+// run and timed once for each CPU dispatch level that this machine supports.
+int run_test_file(const std::string& test_space, const std::string& test_name, TestFunction test_func, const std::string& file_path, size_t& num_passed){
+    TestBenchmark& benchmark = TestBenchmark::instance();
+    const std::string relative_path = QDir(QString::fromStdString(GlobalSettings::instance().COMMAND_LINE_TEST_FOLDER))
+        .relativeFilePath(QString::fromStdString(file_path)).toStdString();
+
+    auto run_level = [&](const char* cpu_level) -> int{
+        benchmark.begin_file(test_space + "_" + test_name, relative_path, cpu_level);
+        return run_and_catch(file_path, [&]() -> int{
+            int ret = test_func(file_path);
+            // The test passed but didn't go through a TestMap.h helper. Time the whole thing.
+            if (ret == 0 && benchmark.enabled() && !benchmark.ran()){
+                ret = benchmark.run([&](){ return test_func(file_path); });
+            }
+            return ret;
+        });
+    };
+
+    int ret = -1;
+    if (!benchmark.enabled() || test_space != "Kernels"){
+        ret = run_level("current");
+    }else{
+        const CPU_Features saved = CPU_CAPABILITY_CURRENT;
+        for (const CpuCapabilityOption& level : AVAILABLE_CAPABILITIES()){
+            if (!level.available){
+                continue;
+            }
+            cout << "CPU level: " << level.display << endl;
+            CPU_CAPABILITY_CURRENT = level.features;
+            ret = run_level(level.slug);
+            if (ret != 0){
+                break;
+            }
+        }
+        CPU_CAPABILITY_CURRENT = saved;
+    }
+
+    if (ret > 0){
+        print_equals();
+        cout << "Test: " << file_path << " failed." << endl;
+        return ret;
+    }
+    // A file counts once, however many CPU levels it ran at.
+    if (ret == 0){
+        num_passed++;
+    }
+    return 0;
+}
 
 bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ignore_list){
     for(const auto& path_prefix : ignore_list){
@@ -75,7 +120,10 @@ bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ign
     return false;
 }
 
-int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size_t& num_passed, const std::vector<QString>& ignore_list){
+int run_test_obj_dir(
+    const std::string& test_space, const std::string& test_name, TestFunction test_func,
+    const QString& directory_path, size_t& num_passed, const std::vector<QString>& ignore_list
+){
     QDirIterator file_iter(directory_path, QDir::Filter::Files, QDirIterator::IteratorFlag::Subdirectories);
 
     bool first_test_file = true;
@@ -101,7 +149,7 @@ int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size
 
         // Call the function to do the actual test:
         cout << file_path << endl;
-        RETURN_IF_TEST_FAILED(test_func, file_path, num_passed);
+        RETURN_IF_NOT_ZERO(run_test_file(test_space, test_name, test_func, file_path, num_passed));
     }
 
     return 0;
@@ -130,7 +178,7 @@ int run_test_obj(const std::string& test_space, const QFileInfo& obj_info, size_
 
     // Recursively get test filenames, like:
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/IngoBattleMenuDayTime_True.png
-    return run_test_obj_dir(test_func, obj_info.filePath(), num_passed, ignore_list);
+    return run_test_obj_dir(test_space, test_name, test_func, obj_info.filePath(), num_passed, ignore_list);
 }
 
 // Run the tests inside a folder representing a "test space".
@@ -183,6 +231,9 @@ int run_command_line_tests(){
 
     size_t num_passed = 0;
 
+    TestBenchmark& benchmark = TestBenchmark::instance();
+    benchmark.set_iterations(GlobalSettings::instance().COMMAND_LINE_BENCHMARK_ITERATIONS);
+
     const auto& selected_test_list = GlobalSettings::instance().COMMAND_LINE_TEST_LIST;
 
     // The ignore list will be used to skip path.
@@ -279,16 +330,29 @@ int run_command_line_tests(){
             print_equals();
             if (selected_path_info.isFile()){
                 // Call the function to do the actual test:
-                RETURN_IF_TEST_FAILED(test_func, full_path_cleaned.toStdString(), num_passed);
+                RETURN_IF_NOT_ZERO(run_test_file(test_space, test_name, test_func, full_path_cleaned.toStdString(), num_passed));
             } else{
                 // selected_path_info is a directory, go through each file recursively in the directory
-                RETURN_IF_NOT_ZERO(run_test_obj_dir(test_func, full_path_cleaned, num_passed, ignore_list));
+                RETURN_IF_NOT_ZERO(run_test_obj_dir(test_space, test_name, test_func, full_path_cleaned, num_passed, ignore_list));
             }
         } // end selected_test_list
     }
 
     print_equals();
     cout << num_passed << " test" << (num_passed > 1 ? "s" : "") << " passed" << std::endl;
+
+    if (benchmark.enabled()){
+        print_equals();
+        benchmark.print();
+        const std::string& output = GlobalSettings::instance().COMMAND_LINE_BENCHMARK_OUTPUT;
+        try{
+            benchmark.save(output);
+        }catch (FileException& e){
+            cerr << "Error: unable to write benchmark results: " << e.message() << endl;
+            return 1;
+        }
+        cout << "Benchmark results saved to " << output << endl;
+    }
     return 0;
 }
 
@@ -47,6 +47,10 @@
  *  
  * Those "hidden" files are useful for storing some metadata in the folder, or serving as an extra file in case some tests need more than one test files.
  * 
+ *  To benchmark the tests, set "20-GlobalSettings": "COMMAND_LINE_TESTS": "BENCHMARK_ITERATIONS" to the number of timed runs per test file.
+ *  The timings are written as JSON to "20-GlobalSettings": "COMMAND_LINE_TESTS": "BENCHMARK_OUTPUT" so that two builds can be compared.
+ *  See TestBenchmark.h for details.
+ * 
  *  How to add new test code:
  * 
  *  The test framework calls TestMap.h: find_test_function(test_space, test_obj_name) to find the test function related to a test path.
@@ -5,15 +5,43 @@
  */
 
 
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Qt/StringToolsQt.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h"
+#include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
+#include "CommonFramework/Language.h"
+#include "CommonFramework/Logging/FileWindowLogger.h"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "CommonFramework/AudioPipeline/AudioTemplate.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/Inference/BlackBorderDetector.h"
+#include "CommonFramework/Inference/BlackScreenDetector.h"
+#include "CommonFramework/Inference/AudioTemplateCache.h"
+#include "CommonFramework/Inference/SpectrogramFrontEnd.h"
+#include "CommonFramework/Inference/SpectrogramMatcher.h"
+#include "CommonFramework/OCR/OCR_StringNormalization.h"
+#include "CommonFramework/OCR/OCR_TextMatcher.h"
+#include "CommonFramework/OCR/OCR_SubstringMatchIndex.h"
 #include "CommonFramework_Tests.h"
+#include "InferenceReplay.h"
 #include "TestUtils.h"
 
 
+#include <cfloat>
+#include <cmath>
+#include <list>
+#include <random>
+#include <thread>
+#include <fstream>
 #include <iostream>
 using std::cout;
 using std::cerr;
@@ -32,4 +60,590 @@ int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool t
 }
 
 
+
+int test_CommonFramework_DictionaryMatchIndex(const std::string& dictionary_path){
+    if (dictionary_path.size() < 5 || dictionary_path.substr(dictionary_path.size() - 5) != ".json"){
+        cout << "Skip " << dictionary_path << " as it is not a json dictionary" << endl;
+        return -1;
+    }
+
+    double random_match_chance = 1. / 5;
+    for (size_t c = 1; c < (size_t)Language::EndOfList; c++){
+        const LanguageData& data = language_data((Language)c);
+        const std::string suffix = "-" + data.code + ".json";
+        if (dictionary_path.size() >= suffix.size() &&
+            dictionary_path.compare(dictionary_path.size() - suffix.size(), suffix.size(), suffix) == 0
+        ){
+            random_match_chance = data.random_match_chance;
+        }
+    }
+
+    //  Same normalization as OCR::DictionaryOCR.
+    OCR::SubstringMatchIndex::Database database;
+    JsonValue json = load_json_file(dictionary_path);
+    for (const auto& item : json.get_object_throw(dictionary_path)){
+        for (const auto& candidate : item.second.get_array_throw()){
+            database[OCR::normalize_utf32(candidate.get_string_throw())].insert(item.first);
+        }
+    }
+
+    auto time_start = current_time();
+    OCR::SubstringMatchIndex index(database, random_match_chance);
+    auto time_end = current_time();
+    cout << "Candidates: " << database.size() << ", Build: "
+         << std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() << " us" << endl;
+
+    //  Simulate OCR reads: substitute and drop characters and add junk around them.
+    std::vector<std::string> queries;
+    std::mt19937 rng(0);
+    for (const auto& item : database){
+        std::u32string text = item.first;
+        if (text.size() > 3 && rng() % 2){
+            text[rng() % text.size()] = U'x';
+        }
+        if (text.size() > 3 && rng() % 2){
+            text.erase(rng() % text.size(), 1);
+        }
+        if (rng() % 2){
+            text = U"- " + text + U" 1";
+        }
+        queries.emplace_back(to_utf8(text));
+    }
+
+    const double spreads[] = {0.0, 0.5, 2.0};
+    for (double spread : spreads){
+        std::vector<OCR::StringMatchResult> expected;
+        time_start = current_time();
+        for (const std::string& text : queries){
+            expected.emplace_back(OCR::match_substring(database, random_match_chance, text, spread));
+        }
+        time_end = current_time();
+        const auto brute_us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+
+        std::vector<OCR::StringMatchResult> actual;
+        time_start = current_time();
+        for (const std::string& text : queries){
+            actual.emplace_back(index.match_substring(text, spread));
+        }
+        time_end = current_time();
+        const auto index_us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+
+        cout << "Spread " << spread << ": " << queries.size() << " queries, brute force: " << brute_us
+             << " us, index: " << index_us << " us" << endl;
+
+        for (size_t c = 0; c < queries.size(); c++){
+            const OCR::StringMatchResult& x = expected[c];
+            const OCR::StringMatchResult& y = actual[c];
+            bool same = x.exact_match == y.exact_match && x.results.size() == y.results.size();
+            for (auto iter0 = x.results.begin(), iter1 = y.results.begin(); same && iter0 != x.results.end(); ++iter0, ++iter1){
+                same = iter0->first == iter1->first &&
+                    iter0->second.target == iter1->second.target &&
+                    iter0->second.token == iter1->second.token;
+            }
+            if (!same){
+                cerr << "Error: index result differs from brute force for \"" << queries[c] << "\"." << endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+
+
+int test_CommonFramework_SpectrogramMatcherEngines(const std::string& audio_path){
+    // XXX for now we assume the audio in the command line test is always 48000.
+    const size_t sample_rate = 48000;
+    AudioTemplate audio_stream = loadAudioTemplate(audio_path, sample_rate);
+    if (audio_stream.numFrequencies() == 0){
+        cout << "Skip " << audio_path << " as it is not an audio file" << endl;
+        return -1;
+    }
+
+    struct MatcherSetup{
+        const char* path;
+        SpectrogramMatcher::Mode mode;
+        double low_frequency_filter;
+        size_t templateSubdivision;
+    };
+    //  Same settings as the audio detectors with the default game settings.
+    const MatcherSetup setups[] = {
+        {"PokemonLA/ShinySound",                SpectrogramMatcher::Mode::SPIKE_CONV,   5000,   0},
+        {"PokemonLA/ItemDropSound",             SpectrogramMatcher::Mode::SPIKE_CONV,   5000,   0},
+        {"PokemonLA/AlphaRoar",                 SpectrogramMatcher::Mode::RAW,          100,    0},
+        {"PokemonLA/AlphaMusic",                SpectrogramMatcher::Mode::RAW,          50,     12},
+        {"PokemonBDSP/ShinySound",              SpectrogramMatcher::Mode::SPIKE_CONV,   5000,   0},
+        {"PokemonSV/ShinySound",                SpectrogramMatcher::Mode::SPIKE_CONV,   1000,   0},
+        {"PokemonSV/LetsGoKill",                SpectrogramMatcher::Mode::SPIKE_CONV,   1000,   0},
+        {"PokemonSwSh/BerryTreeRustlingSound",  SpectrogramMatcher::Mode::RAW,          2000,   1},
+    };
+
+    //  The engines round differently. Near a perfect match, where the error cancels out
+    //  to zero, this shows up as a difference of up to ~1e-3 in the score.
+    const float tolerance = 0.005f;
+
+    for (const MatcherSetup& setup : setups){
+        const AudioTemplate& audio_template = AudioTemplateCache::instance().get_throw(setup.path, sample_rate);
+
+        SpectrogramMatcher direct(
+            setup.path, audio_template, setup.mode, sample_rate,
+            setup.low_frequency_filter, setup.templateSubdivision
+        );
+        SpectrogramMatcher incremental(
+            setup.path, audio_template, setup.mode, sample_rate,
+            setup.low_frequency_filter, setup.templateSubdivision
+        );
+        incremental.set_engine(SpectrogramMatcher::Engine::INCREMENTAL);
+
+        //  Play the audio file then the template itself so that there is at least one close match.
+        std::vector<const float*> windows;
+        for (size_t i = 0; i < audio_stream.numWindows(); i++){
+            windows.emplace_back(audio_stream.getWindow(i));
+        }
+        for (size_t i = 0; i < audio_template.numWindows(); i++){
+            windows.emplace_back(audio_template.getWindow(i));
+        }
+
+        float best_direct = FLT_MAX;
+        float best_incremental = FLT_MAX;
+        double direct_us = 0;
+        double incremental_us = 0;
+        for (size_t stamp = 0; stamp < windows.size(); stamp++){
+            AlignedVector<float> freq_mag(audio_stream.numFrequencies());
+            memcpy(freq_mag.data(), windows[stamp], sizeof(float) * audio_stream.numFrequencies());
+            AudioSpectrum spectrum(stamp, sample_rate, std::make_shared<const AlignedVector<float>>(std::move(freq_mag)));
+
+            auto time0 = current_time();
+            const float score0 = direct.match(spectrum);
+            auto time1 = current_time();
+            const float score1 = incremental.match(spectrum);
+            auto time2 = current_time();
+            direct_us += std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+            incremental_us += std::chrono::duration_cast<std::chrono::microseconds>(time2 - time1).count();
+
+            const bool valid0 = score0 != FLT_MAX && !std::isnan(score0);
+            const bool valid1 = score1 != FLT_MAX && !std::isnan(score1);
+            if (valid0 != valid1 || (valid0 && std::fabs(score0 - score1) > tolerance)){
+                cerr << "Error: " << setup.path << " engines disagree at window " << stamp
+                     << ", direct: " << score0 << ", incremental: " << score1 << endl;
+                return 1;
+            }
+            if (valid0){
+                best_direct = std::min(best_direct, score0);
+                best_incremental = std::min(best_incremental, score1);
+            }
+        }
+
+        cout << setup.path << ": best score direct " << best_direct << ", incremental " << best_incremental
+             << ", time direct " << direct_us << " us, incremental " << incremental_us << " us" << endl;
+    }
+
+    return 0;
+}
+
+
+
+namespace{
+
+//  SpectrogramMatcher as it was before the filtering was moved into
+//  SpectrogramFrontEnd. Only the direct engine. Everything is done the same
+//  way and in the same order so that the scores can be compared bit for bit.
+class ReferenceSpectrogramMatcher{
+public:
+    ReferenceSpectrogramMatcher(
+        AudioTemplate audio_template, SpectrogramMatcher::Mode mode, size_t sample_rate,
+        double low_frequency_filter, size_t templateSubdivision
+    )
+        : m_template(std::move(audio_template))
+        , m_mode(mode)
+    {
+        const size_t numTemplateWindows = m_template.numWindows();
+        m_numOriginalFrequencies = m_template.numFrequencies();
+        const size_t halfSampleRate = sample_rate / 2;
+        m_originalFreqStart = int(low_frequency_filter * m_numOriginalFrequencies / halfSampleRate + 0.5);
+        m_originalFreqEnd = 20000 * m_numOriginalFrequencies / halfSampleRate + 1;
+
+        //  Same kernel as buildSpikeKernel().
+        size_t numKernelIntervals = int(199.21875 * m_numOriginalFrequencies / halfSampleRate + 0.5);
+        size_t slopeLen = numKernelIntervals / 2;
+        for (size_t i = 0; i <= slopeLen; i++){
+            m_convKernel.push_back(-4.0f + 8.f * i / (float)slopeLen);
+        }
+        for (size_t i = ((numKernelIntervals+1) % 2); i <= slopeLen; i++){
+            m_convKernel.push_back(-4.0f + 8.f * (slopeLen-i)/(float)slopeLen);
+        }
+
+        switch (m_mode){
+        case SpectrogramMatcher::Mode::SPIKE_CONV:
+            m_numFilteredFrequencies = (m_originalFreqEnd - m_originalFreqStart) - m_convKernel.size() + 1;
+            m_freqStart = 0;
+            m_freqEnd = m_numFilteredFrequencies;
+            break;
+        case SpectrogramMatcher::Mode::AVERAGE_5:
+            m_numFilteredFrequencies = (m_originalFreqEnd - m_originalFreqStart) / 5;
+            m_freqStart = 0;
+            m_freqEnd = m_numFilteredFrequencies;
+            break;
+        case SpectrogramMatcher::Mode::RAW:
+            m_numFilteredFrequencies = m_numOriginalFrequencies;
+            m_freqStart = m_originalFreqStart;
+            m_freqEnd = m_originalFreqEnd;
+            break;
+        }
+        if (m_mode != SpectrogramMatcher::Mode::RAW){
+            AudioTemplate filtered(m_numFilteredFrequencies, numTemplateWindows);
+            for (size_t i = 0; i < numTemplateWindows; i++){
+                filter(filtered.getWindow(i), m_template.getWindow(i));
+            }
+            m_template = std::move(filtered);
+        }
+
+        if (templateSubdivision <= 1){
+            m_templateRange.emplace_back(0, numTemplateWindows);
+            m_numSpectrumsNeeded = numTemplateWindows;
+        }else{
+            templateSubdivision = std::min(templateSubdivision, numTemplateWindows);
+            const size_t num_subWindows = numTemplateWindows / templateSubdivision;
+            m_numSpectrumsNeeded = num_subWindows;
+            for (size_t i = 0; i < templateSubdivision; i++){
+                m_templateRange.emplace_back(i * num_subWindows, (i+1) * num_subWindows);
+            }
+        }
+
+        //  Only the norm of the first sub-template is ever used.
+        float sumSqr = 0.0f;
+        for (size_t i = m_templateRange[0].first; i < m_templateRange[0].second; i++){
+            for (size_t j = m_freqStart; j < m_freqEnd; j++){
+                const float v = m_template.getWindow(i)[j];
+                sumSqr += v * v;
+            }
+        }
+        m_templateNorm = std::sqrt(sumSqr);
+    }
+
+    //  Spectrums must come in one at a time with consecutive stamps.
+    float match(const AudioSpectrum& spectrum, float& scale){
+        if (m_mode == SpectrogramMatcher::Mode::RAW){
+            m_spectrums.emplace_front(spectrum.magnitudes);
+        }else{
+            auto filtered = std::make_shared<AlignedVector<float>>(m_template.bufferSize());
+            filter(filtered->data(), spectrum.magnitudes->data());
+            m_spectrums.emplace_front(std::move(filtered));
+        }
+        while (m_spectrums.size() > m_numSpectrumsNeeded){
+            m_spectrums.pop_back();
+        }
+        if (m_spectrums.size() < m_numSpectrumsNeeded){
+            return FLT_MAX;
+        }
+
+        float score = FLT_MAX;
+        for (const std::pair<size_t, size_t>& range : m_templateRange){
+            const size_t windows = range.second - range.first;
+            const size_t freqs = m_freqEnd - m_freqStart;
+            std::vector<const float*> matrixA(windows);
+            std::vector<const float*> matrixT(windows);
+            auto iter = m_spectrums.begin();
+            for (size_t i = 0; i < windows; i++, iter++){
+                matrixT[i] = m_freqStart + m_template.getWindow(windows - 1 - i);
+                matrixA[i] = m_freqStart + (*iter)->data();
+            }
+            float sub_scale = Kernels::ScaleInvariantMatrixMatch::compute_scale(
+                freqs, windows, matrixA.data(), matrixT.data()
+            );
+            sub_scale = std::min<float>(sub_scale, 1000000);
+            float sum = Kernels::ScaleInvariantMatrixMatch::compute_error(
+                freqs, windows, sub_scale, matrixA.data(), matrixT.data()
+            );
+            float sub_score = sqrt(sum) / m_templateNorm;
+            sub_score = std::min<float>(sub_score, 1.0);
+            if (m_templateRange.size() == 1 || sub_score < score){
+                score = sub_score;
+                scale = sub_scale;
+            }
+        }
+        return score;
+    }
+
+private:
+    void filter(float* dst, const float* src) const{
+        switch (m_mode){
+        case SpectrogramMatcher::Mode::SPIKE_CONV:
+            Kernels::SpikeConvolution::compute_spike_kernel(
+                dst, src + m_originalFreqStart, m_originalFreqEnd - m_originalFreqStart,
+                m_convKernel.data(), m_convKernel.size()
+            );
+            return;
+        case SpectrogramMatcher::Mode::AVERAGE_5:
+            for (size_t j = 0; j < m_numFilteredFrequencies; j++){
+                const float* rawFreqMag = src + m_originalFreqStart + j*5;
+                dst[j] = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
+            }
+            return;
+        case SpectrogramMatcher::Mode::RAW:
+            return;
+        }
+    }
+
+private:
+    AudioTemplate m_template;
+    SpectrogramMatcher::Mode m_mode;
+    size_t m_numOriginalFrequencies = 0;
+    size_t m_originalFreqStart = 0;
+    size_t m_originalFreqEnd = 0;
+    size_t m_numFilteredFrequencies = 0;
+    size_t m_freqStart = 0;
+    size_t m_freqEnd = 0;
+    std::vector<float> m_convKernel;
+    std::vector<std::pair<size_t, size_t>> m_templateRange;
+    size_t m_numSpectrumsNeeded = 0;
+    float m_templateNorm = 0;
+    std::list<std::shared_ptr<const AlignedVector<float>>> m_spectrums;
+};
+
+bool bit_equal(float x, float y){
+    return memcmp(&x, &y, sizeof(float)) == 0;
+}
+
+}
+
+
+int test_CommonFramework_SpectrogramMatcherReference(const std::string& audio_path){
+    // XXX for now we assume the audio in the command line test is always 48000.
+    const size_t sample_rate = 48000;
+    AudioTemplate audio_stream = loadAudioTemplate(audio_path, sample_rate);
+    if (audio_stream.numFrequencies() == 0){
+        cout << "Skip " << audio_path << " as it is not an audio file" << endl;
+        return -1;
+    }
+
+    struct MatcherSetup{
+        const char* path;
+        SpectrogramMatcher::Mode mode;
+        double low_frequency_filter;
+        size_t templateSubdivision;
+    };
+    //  The audio detectors with the default game settings, plus AVERAGE_5 which none of them use.
+    const MatcherSetup setups[] = {
+        {"PokemonLA/ShinySound",                SpectrogramMatcher::Mode::SPIKE_CONV,   5000,   0},
+        {"PokemonLA/ItemDropSound",             SpectrogramMatcher::Mode::SPIKE_CONV,   5000,   0},
+        {"PokemonLA/AlphaRoar",                 SpectrogramMatcher::Mode::RAW,          100,    0},
+        {"PokemonLA/AlphaMusic",                SpectrogramMatcher::Mode::RAW,          50,     12},
+        {"PokemonBDSP/ShinySound",              SpectrogramMatcher::Mode::SPIKE_CONV,   5000,   0},
+        {"PokemonSV/ShinySound",                SpectrogramMatcher::Mode::SPIKE_CONV,   1000,   0},
+        {"PokemonSV/LetsGoKill",                SpectrogramMatcher::Mode::SPIKE_CONV,   1000,   0},
+        {"PokemonSwSh/BerryTreeRustlingSound",  SpectrogramMatcher::Mode::RAW,          2000,   1},
+        {"PokemonLA/ShinySound",                SpectrogramMatcher::Mode::AVERAGE_5,    5000,   0},
+    };
+
+    //  Every matcher that uses the front-end shares the filtering with the
+    //  matchers of the other setups that have the same filter. The front-end
+    //  identifies spectrums by stamp. So stamps keep counting across setups.
+    SpectrogramFrontEnd front_end;
+    uint64_t next_stamp = 0;
+
+    for (const MatcherSetup& setup : setups){
+        const AudioTemplate& audio_template = AudioTemplateCache::instance().get_throw(setup.path, sample_rate);
+
+        //  Play the audio file then the template itself so that there is at least one close match.
+        std::vector<AudioSpectrum> spectrums;
+        for (size_t i = 0; i < audio_stream.numWindows() + audio_template.numWindows(); i++){
+            const float* window = i < audio_stream.numWindows()
+                ? audio_stream.getWindow(i)
+                : audio_template.getWindow(i - audio_stream.numWindows());
+            AlignedVector<float> freq_mag(audio_stream.numFrequencies());
+            memcpy(freq_mag.data(), window, sizeof(float) * audio_stream.numFrequencies());
+            spectrums.emplace_back(next_stamp++, sample_rate, std::make_shared<const AlignedVector<float>>(std::move(freq_mag)));
+        }
+
+        ReferenceSpectrogramMatcher reference(
+            audio_template, setup.mode, sample_rate,
+            setup.low_frequency_filter, setup.templateSubdivision
+        );
+        SpectrogramMatcher standalone(
+            setup.path, audio_template, setup.mode, sample_rate,
+            setup.low_frequency_filter, setup.templateSubdivision
+        );
+        SpectrogramMatcher shared(
+            setup.path, audio_template, setup.mode, sample_rate,
+            setup.low_frequency_filter, setup.templateSubdivision
+        );
+        shared.use_front_end(front_end);
+
+        size_t matches = 0;
+        for (const AudioSpectrum& spectrum : spectrums){
+            float scale = 0;
+            const float score0 = reference.match(spectrum, scale);
+            const float score1 = standalone.match(spectrum);
+            const float score2 = shared.match(spectrum);
+            const bool valid = score0 != FLT_MAX;
+            if (!bit_equal(score0, score1) || !bit_equal(score0, score2) ||
+                (valid && (!bit_equal(scale, standalone.lastMatchedScale()) || !bit_equal(scale, shared.lastMatchedScale())))
+            ){
+                cerr << "Error: " << setup.path << " differs from the reference at window " << spectrum.stamp
+                     << ", reference: " << score0 << " (scale " << scale << ")"
+                     << ", standalone: " << score1 << " (scale " << standalone.lastMatchedScale() << ")"
+                     << ", shared: " << score2 << " (scale " << shared.lastMatchedScale() << ")" << endl;
+                return 1;
+            }
+            if (valid){
+                matches++;
+            }
+        }
+        cout << setup.path << ": " << matches << " scores match the reference exactly." << endl;
+    }
+
+    return 0;
+}
+
+
+
+
+int test_CommonFramework_FileWindowLoggerThroughput(const std::string& messages_path){
+    std::vector<std::string> messages;
+    {
+        std::ifstream file(messages_path);
+        std::string line;
+        while (std::getline(file, line)){
+            if (!line.empty() && line.back() == '\r'){
+                line.pop_back();
+            }
+            if (!line.empty()){
+                messages.emplace_back(std::move(line));
+            }
+        }
+    }
+    if (messages.empty()){
+        cout << "Skip " << messages_path << " as it has no messages" << endl;
+        return -1;
+    }
+
+    const size_t num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+    const size_t messages_per_thread = 100000;
+    const size_t total = num_threads * messages_per_thread;
+    const std::string log_path = QDir::temp().filePath("FileWindowLoggerThroughput.log").toStdString();
+
+    const FileWindowLogger::OverflowPolicy policies[] = {
+        FileWindowLogger::OverflowPolicy::BLOCK,
+        FileWindowLogger::OverflowPolicy::DROP,
+    };
+    for (FileWindowLogger::OverflowPolicy policy : policies){
+        const bool block = policy == FileWindowLogger::OverflowPolicy::BLOCK;
+        QFile::remove(QString::fromStdString(log_path));
+
+        uint64_t dropped;
+        auto time_start = current_time();
+        {
+            FileWindowLogger logger(log_path, 10000, policy);
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < num_threads; t++){
+                threads.emplace_back([&, t]{
+                    for (size_t c = 0; c < messages_per_thread; c++){
+                        logger.log(messages[(t + c) % messages.size()]);
+                    }
+                });
+            }
+            for (std::thread& thread : threads){
+                thread.join();
+            }
+            dropped = logger.dropped_messages();
+        }
+        auto time_end = current_time();
+
+        //  Every message that wasn't dropped must be in the file.
+        size_t written = 0;
+        {
+            std::ifstream file(log_path);
+            std::string line;
+            while (std::getline(file, line)){
+                if (line.find("FileWindowLogger: Dropped") == std::string::npos){
+                    written++;
+                }
+            }
+        }
+        QFile::remove(QString::fromStdString(log_path));
+
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+        cout << (block ? "Block" : "Drop") << ": " << num_threads << " threads, " << total << " messages, "
+             << us << " us, " << (double)total / std::max<int64_t>(us, 1) << " messages/us, dropped: " << dropped << endl;
+
+        if (block && dropped != 0){
+            cerr << "Error: messages were dropped with the blocking overflow policy." << endl;
+            return 1;
+        }
+        if (written + dropped != total){
+            cerr << "Error: " << written << " written + " << dropped << " dropped != " << total << " logged." << endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int test_CommonFramework_InferenceReplay(const std::string& recording_path){
+    const QFileInfo info(QString::fromStdString(recording_path));
+    std::string path;
+    if (info.suffix() == "pavr"){
+        path = recording_path;
+    }else if (info.fileName() == "timestamps.txt"){
+        path = info.dir().path().toStdString();
+    }else{
+        return -1;
+    }
+
+    std::vector<size_t> expected;
+    bool has_expected = false;
+    {
+        std::ifstream file(path + ".triggers");
+        has_expected = (bool)file;
+        size_t frame;
+        while (file >> frame){
+            expected.emplace_back(frame);
+        }
+    }
+
+    auto trigger_frames = [](const InferenceReplayReport& report){
+        std::vector<size_t> frames;
+        for (const InferenceReplayTrigger& trigger : report.triggers){
+            frames.emplace_back(trigger.frame_index);
+        }
+        return frames;
+    };
+
+    std::vector<size_t> first_run;
+    for (size_t run = 0; run < 2; run++){
+        FileVideoFeed feed(path, FileVideoFeed::Playback::AS_FAST_AS_POSSIBLE);
+        BlackScreenWatcher watcher;
+        InferenceReplayReport report = run_inference_replay(feed, {{watcher}});
+        cout << "As fast as possible, " << feed.frames() << " frames:" << endl;
+        cout << report.dump();
+
+        std::vector<size_t> frames = trigger_frames(report);
+        if (run == 0){
+            first_run = std::move(frames);
+        }else if (frames != first_run){
+            cerr << "Error: two as-fast-as-possible replays triggered on different frames." << endl;
+            return 1;
+        }
+    }
+    if (has_expected && first_run != expected){
+        cerr << "Error: replay triggered on " << first_run.size() << " frames. Expected " << expected.size()
+             << " frames from " << path << ".triggers." << endl;
+        return 1;
+    }
+
+    {
+        FileVideoFeed feed(path, FileVideoFeed::Playback::REAL_TIME);
+        BlackScreenWatcher watcher;
+        InferenceReplayReport report = run_inference_replay(feed, {{watcher}});
+        cout << "Real time, " << feed.fps_source() << " fps:" << endl;
+        cout << report.dump();
+    }
+
+    return 0;
+}
+
+
 }
@@ -9,12 +9,38 @@
 #ifndef PokemonAutomation_Tests_CommonFramework_Tests_H
 #define PokemonAutomation_Tests_CommonFramework_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool target);
 
+// Benchmark OCR::SubstringMatchIndex against the brute-force OCR::match_substring() on an OCR dictionary
+// json file, e.g. Resources/Pokemon/PokemonNameOCR/PokemonOCR-eng.json. Fails if any result differs.
+int test_CommonFramework_DictionaryMatchIndex(const std::string& dictionary_path);
+
+// Replay an audio file, followed by each bundled audio template, through SpectrogramMatchers with
+// both matching engines. Fails if the scores of the two engines differ.
+int test_CommonFramework_SpectrogramMatcherEngines(const std::string& audio_path);
+
+// Replay an audio file, followed by each bundled audio template, through a copy of the matcher from before
+// the filtering was shared, a SpectrogramMatcher with its own filtering, and one that shares a
+// SpectrogramFrontEnd. Fails unless all three give bit-identical scores.
+int test_CommonFramework_SpectrogramMatcherReference(const std::string& audio_path);
+
+// Benchmark FileWindowLogger by logging the lines of a text file from several threads at once.
+// Fails if any message is lost with the blocking overflow policy, or if the dropped count is wrong
+// with the dropping policy.
+int test_CommonFramework_FileWindowLoggerThroughput(const std::string& messages_path);
+
+// Replay a recording (a raw ".pavr" recording, or the "timestamps.txt" of a directory of frames) through
+// the video inference pipeline with a BlackScreenWatcher. Prints the latency and trigger report for both
+// playback modes. Fails if two as-fast-as-possible runs disagree, or if they don't trigger on the frames
+// listed in "<recording>.triggers" (one frame index per line) when that file exists.
+int test_CommonFramework_InferenceReplay(const std::string& recording_path);
+
 }
 
 #endif
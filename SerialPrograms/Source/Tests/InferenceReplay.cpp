@@ -0,0 +1,225 @@
+/*  Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <memory>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Concurrency/AsyncDispatcher.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/InferenceInfra/VisualInferenceCallback.h"
+#include "CommonFramework/InferenceInfra/VisualInferencePivot.h"
+#include "CommonFramework/InferenceInfra/InferenceSession.h"
+#include "InferenceReplay.h"
+#include "TestUtils.h"
+
+namespace PokemonAutomation{
+
+
+namespace{
+
+//  Sits between the pivot and the real callback to time it and to remember
+//  which frame it triggered on.
+class ReplayCallback : public VisualInferenceCallback{
+public:
+    ReplayCallback(VisualInferenceCallback& callback, bool skip_repeated_frames)
+        : VisualInferenceCallback(callback.label())
+        , m_callback(callback)
+        , m_skip_repeated_frames(skip_repeated_frames)
+    {}
+
+    virtual void make_overlays(VideoOverlaySet& items) const override{
+        m_callback.make_overlays(items);
+    }
+
+    //  Call before each new inference session. Frames up to and including
+    //  "skip_through" are ignored so that the same frame can't trigger twice.
+    void rearm(WallClock skip_through){
+        m_triggered = false;
+        m_skip_through = skip_through;
+    }
+
+    using VisualInferenceCallback::process_frame;
+    virtual bool process_frame(const VideoSnapshot& frame) override{
+        //  Once the recording is over, the feed keeps returning the last
+        //  frame. Don't run on it again.
+        if (m_skip_repeated_frames && frame.frame == m_last_frame){
+            return false;
+        }
+        if (frame.timestamp <= m_skip_through){
+            return false;
+        }
+        m_last_frame = frame.frame;
+
+        WallClock time0 = current_time();
+        bool triggered = m_callback.process_frame(frame);
+        WallClock time1 = current_time();
+        latency += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+
+        //  The pivot keeps running the callbacks until the session is torn
+        //  down. Only the first trigger of the session counts.
+        if (triggered && !m_triggered){
+            m_triggered = true;
+            trigger_frame = frame.timestamp;
+            trigger_time = time1;
+            trigger_process_time = time1 - time0;
+        }
+        return triggered;
+    }
+
+public:
+    StatAccumulatorI32 latency;
+    WallClock trigger_frame;
+    WallClock trigger_time;
+    WallDuration trigger_process_time;
+
+private:
+    VisualInferenceCallback& m_callback;
+    bool m_skip_repeated_frames;
+    bool m_triggered = false;
+    WallClock m_skip_through = WallClock::min();
+    std::shared_ptr<const ImageRGB32> m_last_frame;
+};
+
+}
+
+
+
+std::string InferenceReplayReport::dump() const{
+    const double DIVIDER = (double)(std::chrono::milliseconds(1) / std::chrono::microseconds(1));
+    const char* UNITS = " ms";
+
+    std::string str;
+    str += "Run Time: " + tostr_default(run_time.count() / DIVIDER) + UNITS + "\n";
+    str += "Pivot Utilization: Mean = " + tostr_default(pivot_utilization.mean() * 100) + "%";
+    str += ", Max = " + tostr_default(pivot_utilization.max() * 100) + "%\n";
+    for (const InferenceReplayCallbackStats& callback : callbacks){
+        str += callback.label + ": " + callback.latency.dump(UNITS, DIVIDER);
+        str += ", Triggers = " + std::to_string(callback.triggers) + "\n";
+    }
+    for (const InferenceReplayTrigger& trigger : triggers){
+        str += "Triggered: " + callbacks[trigger.callback_index].label;
+        str += " at frame " + std::to_string(trigger.frame_index);
+        str += " (" + tostr_default(trigger.stream_time.count() / DIVIDER) + UNITS + ")";
+        str += ", Latency = " + tostr_default(trigger.latency.count() / DIVIDER) + UNITS + "\n";
+    }
+    return str;
+}
+
+
+
+InferenceReplayReport run_inference_replay(
+    FileVideoFeed& feed,
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    bool stop_on_first_trigger,
+    std::chrono::milliseconds default_video_period
+){
+    const bool fast = feed.playback() == FileVideoFeed::Playback::AS_FAST_AS_POSSIBLE;
+
+    //  With a zero period, the pivot grabs a new frame every time it has run
+    //  all the callbacks on the last one.
+    if (fast){
+        default_video_period = std::chrono::milliseconds(0);
+    }
+
+    std::vector<std::unique_ptr<ReplayCallback>> replays;
+    std::vector<PeriodicInferenceCallback> session_callbacks;
+    for (const PeriodicInferenceCallback& callback : callbacks){
+        if (callback.callback == nullptr || callback.callback->type() != InferenceType::VISUAL){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Only visual callbacks can be replayed.");
+        }
+        replays.emplace_back(new ReplayCallback(static_cast<VisualInferenceCallback&>(*callback.callback), fast));
+        session_callbacks.emplace_back(
+            *replays.back(),
+            fast ? std::chrono::milliseconds(0) : callback.period
+        );
+    }
+
+    Logger& logger = global_logger_command_line();
+    DummyBotBase botbase(logger);
+    DummyVideoOverlay video_overlay;
+    DummyAudioFeed audio_feed;
+
+    InferenceReplayReport report;
+
+    AsyncDispatcher dispatcher(
+        [](){
+            GlobalSettings::instance().INFERENCE_PRIORITY0.set_on_this_thread();
+        },
+        0
+    );
+    CancellableHolder<CancellableScope> root_scope;
+    CancellableScope& scope = root_scope;
+    ConsoleHandle console(0, logger, &botbase, feed, video_overlay, audio_feed);
+    console.initialize_inference_threads(scope, dispatcher);
+
+    feed.reset();
+    WallClock start = current_time();
+    WallClock last_trigger_frame = WallClock::min();
+    while (true){
+        for (const std::unique_ptr<ReplayCallback>& callback : replays){
+            callback->rearm(last_trigger_frame);
+        }
+
+        int triggered;
+        {
+            CancellableHolder<CancellableScope> subscope(scope);
+            InferenceSession session(
+                subscope, console,
+                session_callbacks,
+                default_video_period
+            );
+            while (!subscope.cancelled() && !feed.exhausted()){
+                try{
+                    subscope.wait_for(std::chrono::milliseconds(10));
+                }catch (OperationCancelledException&){}
+                report.pivot_utilization += console.video_inference_pivot().current_utilization();
+            }
+            subscope.throw_if_cancelled_with_exception();
+            triggered = session.triggered_index();
+        }
+        if (triggered < 0){
+            break;
+        }
+
+        const ReplayCallback& callback = *replays[triggered];
+        InferenceReplayTrigger trigger;
+        trigger.callback_index = triggered;
+        trigger.frame_index = feed.frame_index(callback.trigger_frame);
+        trigger.stream_time = feed.frame_time(trigger.frame_index);
+        trigger.latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            fast ? callback.trigger_process_time : callback.trigger_time - callback.trigger_frame
+        );
+        report.triggers.emplace_back(trigger);
+        last_trigger_frame = callback.trigger_frame;
+
+        if (stop_on_first_trigger){
+            break;
+        }
+        if (fast){
+            feed.seek(trigger.frame_index + 1);
+        }
+        if (feed.exhausted()){
+            break;
+        }
+    }
+    report.run_time = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - start);
+
+    for (const std::unique_ptr<ReplayCallback>& callback : replays){
+        InferenceReplayCallbackStats stats;
+        stats.label = callback->label();
+        stats.latency = callback->latency;
+        report.callbacks.emplace_back(std::move(stats));
+    }
+    for (const InferenceReplayTrigger& trigger : report.triggers){
+        report.callbacks[trigger.callback_index].triggers++;
+    }
+
+    return report;
+}
+
+
+
+}
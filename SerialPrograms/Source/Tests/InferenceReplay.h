@@ -0,0 +1,84 @@
+/*  Inference Replay
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Run visual inference callbacks on a recording through the real inference
+ *  pipeline (VisualInferencePivot + InferenceSession) without any hardware.
+ *
+ *  Use this to measure detector throughput and trigger latency on recorded
+ *  sessions, and to check that a detector still triggers on the same frames.
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_InferenceReplay_H
+#define PokemonAutomation_Tests_InferenceReplay_H
+
+#include <string>
+#include <vector>
+#include "CommonFramework/Inference/StatAccumulator.h"
+#include "CommonFramework/InferenceInfra/InferenceCallback.h"
+#include "CommonFramework/VideoPipeline/FileVideoFeed.h"
+
+namespace PokemonAutomation{
+
+
+struct InferenceReplayTrigger{
+    //  Index of the callback that triggered.
+    size_t callback_index;
+    //  The frame that the callback triggered on.
+    size_t frame_index;
+    //  Recorded time of that frame relative to the start of the recording.
+    std::chrono::microseconds stream_time;
+    //  For REAL_TIME playback, how long after the frame was shown that the
+    //  callback returned true.
+    //  For AS_FAST_AS_POSSIBLE playback, how long the callback took on the frame.
+    std::chrono::microseconds latency;
+};
+
+struct InferenceReplayCallbackStats{
+    std::string label;
+    //  Time spent in "process_frame()". Units are microseconds.
+    StatAccumulatorI32 latency;
+    size_t triggers = 0;
+};
+
+struct InferenceReplayReport{
+    std::vector<InferenceReplayCallbackStats> callbacks;
+    std::vector<InferenceReplayTrigger> triggers;
+
+    //  Utilization of the video inference pivot thread, sampled while the
+    //  recording was playing.
+    FloatStatAccumulator pivot_utilization;
+
+    //  Wall clock time that the replay took.
+    std::chrono::microseconds run_time;
+
+    std::string dump() const;
+};
+
+
+//  Play "feed" and run "callbacks" on it until the recording is over.
+//  Only visual callbacks are supported.
+//
+//  Whenever a callback triggers, the trigger is recorded and a new inference
+//  session is started on the frames after the trigger frame.
+//  For AS_FAST_AS_POSSIBLE playback, every frame is seen by every callback
+//  and the trigger frames are deterministic. (When several callbacks trigger
+//  on the same frame, which one is reported may vary.)
+//  For REAL_TIME playback, the recording keeps playing while the new session
+//  is being set up, the same as it would live.
+//
+//  For AS_FAST_AS_POSSIBLE playback, the callback periods are ignored.
+//
+//  If a callback throws, the exception is rethrown from here.
+InferenceReplayReport run_inference_replay(
+    FileVideoFeed& feed,
+    const std::vector<PeriodicInferenceCallback>& callbacks,
+    bool stop_on_first_trigger = false,
+    std::chrono::milliseconds default_video_period = std::chrono::milliseconds(50)
+);
+
+
+
+}
+#endif
@@ -11,6 +11,8 @@
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/BinaryImage.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTools/ImageGradient.h"
+#include "CommonFramework/ImageTypes/ImageHSV32.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
@@ -23,17 +25,29 @@
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64x4_Default.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64xH_Default.h"
 #include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels/ImageDownscale/Kernels_ImageDownscale.h"
 #include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
+#include "Kernels/ImageGradient/Kernels_ImageGradient_Default.h"
+#include "Kernels/ImageGradient/Kernels_ImageGradient.h"
+#include "Kernels/ImageHSV/Kernels_ImageHSV_Default.h"
+#include "Kernels/ImageHSV/Kernels_ImageHSV.h"
 #include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
+#include "Kernels/Waterfill/Kernels_Waterfill_ComponentTree.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Routines.h"
+#include "Kernels/Xoroshiro128Plus/Kernels_Xoroshiro128Plus.h"
 #include "Kernels_Tests.h"
 #include "TestUtils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
+#include <random>
 using std::cout;
 using std::cerr;
 using std::endl;
@@ -73,6 +87,58 @@ int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image){
 }
 
 
+int test_kernels_ImageDownscale(const ImageViewRGB32& image){
+    const size_t width = image.width() / 2, height = image.height() / 2;
+    cout << "Testing downscale_half(), image size " << image.width() << " x " << image.height() << endl;
+
+    ImageRGB32 image_out(width, height);
+    Kernels::downscale_half(
+        image_out.data(), image_out.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        width, height
+    );
+
+    size_t error_count = 0;
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            uint32_t expected = 0;
+            for (size_t shift = 0; shift < 32; shift += 8){
+                uint32_t sum = 2;
+                sum += (image.pixel(2*x + 0, 2*y + 0) >> shift) & 0xff;
+                sum += (image.pixel(2*x + 1, 2*y + 0) >> shift) & 0xff;
+                sum += (image.pixel(2*x + 0, 2*y + 1) >> shift) & 0xff;
+                sum += (image.pixel(2*x + 1, 2*y + 1) >> shift) & 0xff;
+                expected |= (sum >> 2) << shift;
+            }
+            if (image_out.pixel(x, y) != expected && error_count < 10){
+                cout << "Error: wrong downscale result at (x,y) = " << x << ", " << y
+                     << ": " << Color(image_out.pixel(x, y)).to_string()
+                     << ", expected " << Color(expected).to_string() << endl;
+                ++error_count;
+            }
+        }
+    }
+    if (error_count){
+        return 1;
+    }
+
+    int num_iterations = 500;
+    auto time_start = current_time();
+    for(int i = 0; i < num_iterations; i++){
+        Kernels::downscale_half(
+            image_out.data(), image_out.bytes_per_row(),
+            image.data(), image.bytes_per_row(),
+            width, height
+        );
+    }
+    auto time_end = current_time();
+    const auto ms = std::chrono::duration_cast<Milliseconds>(time_end - time_start).count();
+    cout << "Running " << num_iterations << " iters, avg downscale time: " << (double)ms / num_iterations << " ms" << endl;
+
+    return 0;
+}
+
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image){
 
     if (test_binary_matrix_tile() != 0) {
@@ -599,6 +665,232 @@ int test_kernels_CompressRGB32ToBinaryEuclidean(const ImageViewRGB32& image){
 
 
 
+int test_kernels_ImageHSV(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing test_kernels_ImageHSV(), image size " << width << " x " << height << endl;
+
+    ImageHSV32 hsv(width, height);
+    ImageRGB32 rgb(width, height);
+
+    auto time_start = current_time();
+    Kernels::rgb32_to_hsv32(
+        hsv.data(), hsv.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        width, height
+    );
+    auto time_end = current_time();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+    cout << "RGB to HSV time: " << ns / 1000000. << " ms" << endl;
+
+    time_start = current_time();
+    Kernels::hsv32_to_rgb32(
+        rgb.data(), rgb.bytes_per_row(),
+        hsv.data(), hsv.bytes_per_row(),
+        width, height
+    );
+    time_end = current_time();
+    ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+    cout << "HSV to RGB time: " << ns / 1000000. << " ms" << endl;
+
+    //  H in [200, 40] wraps around through red.
+    const uint32_t mins = 0x00c83232;
+    const uint32_t maxs = 0xff28ffff;
+    PackedBinaryMatrix matrix(width, height);
+    time_start = current_time();
+    Kernels::compress_rgb32_to_binary_hsv_range(
+        image.data(), image.bytes_per_row(), matrix,
+        mins, maxs
+    );
+    time_end = current_time();
+    ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+    cout << "HSV range filter time: " << ns / 1000000. << " ms" << endl;
+
+    size_t error_count = 0;
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            uint32_t pixel = image.pixel(x, y);
+            uint32_t expected_hsv = Kernels::rgb32_to_hsv32_Default(pixel);
+            uint32_t expected_rgb = Kernels::hsv32_to_rgb32_Default(expected_hsv);
+            uint32_t h = (expected_hsv >> 16) & 0xff;
+            uint32_t s = (expected_hsv >> 8) & 0xff;
+            uint32_t v = expected_hsv & 0xff;
+            bool in_range = (h >= 200 || h <= 40) && s >= 50 && v >= 50;
+            if (hsv.pixel(x, y) != expected_hsv){
+                if (error_count < 10){
+                    cout << "Error: RGB to HSV mismatch at (" << x << ", " << y << "): "
+                         << Color(pixel).to_string() << " -> " << hsv.pixel(x, y) << ", expected " << expected_hsv << endl;
+                }
+                error_count++;
+            }
+            if (rgb.pixel(x, y) != expected_rgb){
+                if (error_count < 10){
+                    cout << "Error: HSV to RGB mismatch at (" << x << ", " << y << "): "
+                         << expected_hsv << " -> " << Color(rgb.pixel(x, y)).to_string()
+                         << ", expected " << Color(expected_rgb).to_string() << endl;
+                }
+                error_count++;
+            }
+            if (matrix.get(x, y) != in_range){
+                if (error_count < 10){
+                    cout << "Error: wrong HSV filter result at (" << x << ", " << y << "): "
+                         << Color(pixel).to_string() << ", HSV (" << h << ", " << s << ", " << v << ")"
+                         << (in_range ? ", should be in range but not set on matrix" : ", should not be in range but set on matrix") << endl;
+                }
+                error_count++;
+            }
+        }
+    }
+    if (error_count){
+        cout << "Error count: " << error_count << endl;
+        return 1;
+    }
+
+    //  Every RGB value, laid out as a 4096 x 4096 image so the vector
+    //  loops and their tails all get exercised.
+    ImageRGB32 all(4096, 4096);
+    for (size_t y = 0; y < 4096; y++){
+        for (size_t x = 0; x < 4096; x++){
+            all.pixel(x, y) = 0xff000000 | (uint32_t)(y << 12 | x);
+        }
+    }
+    ImageHSV32 all_hsv(4093, 4096);
+    Kernels::rgb32_to_hsv32(
+        all_hsv.data(), all_hsv.bytes_per_row(),
+        all.data(), all.bytes_per_row(),
+        4093, 4096
+    );
+    for (size_t y = 0; y < 4096; y++){
+        for (size_t x = 0; x < 4093; x++){
+            uint32_t expected = Kernels::rgb32_to_hsv32_Default(all.pixel(x, y));
+            if (all_hsv.pixel(x, y) != expected){
+                cout << "Error: RGB to HSV mismatch on " << Color(all.pixel(x, y)).to_string()
+                     << ": " << all_hsv.pixel(x, y) << ", expected " << expected << endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+
+int test_kernels_ImageGradient(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing test_kernels_ImageGradient(), image size " << width << " x " << height << endl;
+
+    std::vector<uint32_t> gradient(width * height);
+    auto time_start = current_time();
+    Kernels::sobel_gradient_rgb32(
+        gradient.data(), width * sizeof(uint32_t),
+        image.data(), image.bytes_per_row(),
+        width, height
+    );
+    auto time_end = current_time();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+    cout << "Sobel time: " << ns / 1000000. << " ms" << endl;
+
+    auto row = [&](size_t y){
+        return (const uint32_t*)((const char*)image.data() + y * image.bytes_per_row());
+    };
+    size_t error_count = 0;
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            uint32_t expected = Kernels::SOBEL_GRADIENT_NONE;
+            if (x > 0 && y > 0 && x + 1 < width && y + 1 < height){
+                expected = Kernels::sobel_gradient_rgb32_Default(
+                    row(y - 1), row(y), row(y + 1), x
+                );
+            }
+            if (gradient[y * width + x] != expected){
+                if (error_count < 10){
+                    cout << "Error: Sobel mismatch at (" << x << ", " << y << "): "
+                         << gradient[y * width + x] << ", expected " << expected << endl;
+                }
+                error_count++;
+            }
+        }
+    }
+    if (error_count){
+        cout << "Error count: " << error_count << endl;
+        return 1;
+    }
+
+    //  Match the image against a slightly shifted copy of itself at the MMO
+    //  sprite size. Compare against the straightforward per-block loops.
+    const size_t size = 50;
+    const int max_offset = 2;
+    const int block_radius = 5;
+    ImageRGB32 query = compute_sobel_gradient(image.scale_to(size, size));
+    ImageRGB32 templ = compute_sobel_gradient(image.scale_to(size + 3, size + 1));
+
+    time_start = current_time();
+    double distance = Kernels::gradient_block_match_rgb32(
+        query.data(), query.bytes_per_row(), query.width(), query.height(),
+        templ.data(), templ.bytes_per_row(), templ.width(), templ.height(),
+        max_offset, block_radius
+    );
+    time_end = current_time();
+    ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+    cout << "Block match time: " << ns / 1000000. << " ms" << endl;
+
+    auto is_opaque = [](uint32_t pixel){ return (pixel >> 24) >= 128; };
+    double total = 0;
+    size_t pixels = 0;
+    for (int y = 0; y < (int)query.height(); y++){
+        for (int x = 0; x < (int)query.width(); x++){
+            if (!is_opaque(query.pixel(x, y))){
+                continue;
+            }
+            double best = INFINITY;
+            for (int oy = -max_offset; oy <= max_offset; oy++){
+                for (int ox = -max_offset; ox <= max_offset; ox++){
+                    double sum = 0;
+                    size_t count = 0;
+                    for (int by = y - block_radius; by <= y + block_radius; by++){
+                        for (int bx = x - block_radius; bx <= x + block_radius; bx++){
+                            int tx = bx + ox;
+                            int ty = by + oy;
+                            if (bx < 0 || by < 0 || bx >= (int)query.width() || by >= (int)query.height() ||
+                                tx < 0 || ty < 0 || tx >= (int)templ.width() || ty >= (int)templ.height()
+                            ){
+                                continue;
+                            }
+                            uint32_t q = query.pixel(bx, by);
+                            uint32_t t = templ.pixel(tx, ty);
+                            if (!is_opaque(q) || !is_opaque(t)){
+                                continue;
+                            }
+                            int qx = (q >> 16) & 0xff, qy = (q >> 8) & 0xff;
+                            int t_x = (t >> 16) & 0xff, t_y = (t >> 8) & 0xff;
+                            sum += (std::max(qx, t_x) * (qx - t_x) * (qx - t_x) + std::max(qy, t_y) * (qy - t_y) * (qy - t_y)) / 255.;
+                            count++;
+                        }
+                    }
+                    if (count > 0){
+                        best = std::min(best, sum / count);
+                    }
+                }
+            }
+            if (best < INFINITY){
+                total += best;
+                pixels++;
+            }
+        }
+    }
+    double expected = total / pixels;
+    cout << "Block match distance: " << distance << ", expected " << expected << endl;
+    if (!(std::abs(distance - expected) <= 1e-9 * std::max(expected, 1.))){
+        cout << "Error: block match distance mismatch" << endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
 int test_kernels_Waterfill(const ImageViewRGB32& image){
     const size_t width = image.width();
     const size_t height = image.height();
@@ -672,6 +964,105 @@ int test_kernels_Waterfill(const ImageViewRGB32& image){
     return 0;
 }
 
+int test_kernels_WaterfillComponentTree(const ImageViewRGB32& image){
+    const size_t width = image.width();
+    const size_t height = image.height();
+    cout << "Testing test_kernels_WaterfillComponentTree(), image size " << width << " x " << height << endl;
+
+    const std::vector<std::pair<uint32_t, uint32_t>> filters{
+        {combine_rgb(128, 128, 0), combine_rgb(255, 255, 255)},
+        {combine_rgb(160, 160, 0), combine_rgb(255, 255, 255)},
+        {combine_rgb(192, 192, 0), combine_rgb(255, 255, 255)},
+        {combine_rgb(224, 224, 0), combine_rgb(255, 255, 255)},
+    };
+    const size_t min_area = 20;
+
+    std::vector<PackedBinaryMatrix> source_matrices;
+    for (const auto& filter : filters){
+        PackedBinaryMatrix matrix(width, height);
+        Kernels::compress_rgb32_to_binary_range(
+            image.data(), image.bytes_per_row(),
+            matrix, filter.first, filter.second
+        );
+        source_matrices.emplace_back(std::move(matrix));
+    }
+
+    auto sorted_boxes = [](std::vector<std::pair<ImagePixelBox, size_t>> boxes){
+        std::sort(
+            boxes.begin(), boxes.end(),
+            [](const std::pair<ImagePixelBox, size_t>& x, const std::pair<ImagePixelBox, size_t>& y){
+                if (x.first.min_y != y.first.min_y) return x.first.min_y < y.first.min_y;
+                if (x.first.min_x != y.first.min_x) return x.first.min_x < y.first.min_x;
+                if (x.first.max_y != y.first.max_y) return x.first.max_y < y.first.max_y;
+                if (x.first.max_x != y.first.max_x) return x.first.max_x < y.first.max_x;
+                return x.second < y.second;
+            }
+        );
+        return boxes;
+    };
+
+    //  Ground truth: waterfill each level separately.
+    std::vector<std::vector<std::pair<ImagePixelBox, size_t>>> gt_levels;
+    auto time_start = current_time();
+    for (const PackedBinaryMatrix& source : source_matrices){
+        PackedBinaryMatrix matrix = source.copy();
+        std::vector<std::pair<ImagePixelBox, size_t>> boxes;
+        for (const Kernels::Waterfill::WaterfillObject& object : Kernels::Waterfill::find_objects_inplace(matrix, min_area)){
+            boxes.emplace_back(ImagePixelBox(object.min_x, object.min_y, object.max_x, object.max_y), object.area);
+        }
+        gt_levels.emplace_back(sorted_boxes(std::move(boxes)));
+    }
+    auto time_end = current_time();
+    double gt_ms = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count() / 1000000.;
+
+    std::vector<PackedBinaryMatrix> matrices;
+    std::vector<Kernels::PackedBinaryMatrix_IB*> levels;
+    for (const PackedBinaryMatrix& source : source_matrices){
+        matrices.emplace_back(source.copy());
+    }
+    for (PackedBinaryMatrix& matrix : matrices){
+        levels.emplace_back(&static_cast<Kernels::PackedBinaryMatrix_IB&>(matrix));
+    }
+    time_start = current_time();
+    Kernels::Waterfill::WaterfillComponentTree tree(levels, min_area);
+    time_end = current_time();
+    double tree_ms = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count() / 1000000.;
+
+    TEST_RESULT_COMPONENT_EQUAL(tree.levels(), gt_levels.size(), "number of levels");
+    for (size_t level = 0; level < tree.levels(); level++){
+        std::vector<std::pair<ImagePixelBox, size_t>> boxes;
+        for (size_t index : tree.level(level)){
+            const Kernels::Waterfill::WaterfillComponentTree::Node& node = tree.node(index);
+            const Kernels::Waterfill::WaterfillObject& object = node.object;
+            boxes.emplace_back(ImagePixelBox(object.min_x, object.min_y, object.max_x, object.max_y), object.area);
+
+            if (level > 0){
+                const Kernels::Waterfill::WaterfillObject& parent = tree.node(node.parent).object;
+                TEST_RESULT_COMPONENT_EQUAL(tree.node(node.parent).level, level - 1, "parent level");
+                TEST_RESULT_COMPONENT_EQUAL(parent.object->get(object.body_x, object.body_y), true, "parent contains child");
+            }
+        }
+        boxes = sorted_boxes(std::move(boxes));
+
+        const std::vector<std::pair<ImagePixelBox, size_t>>& gt_boxes = gt_levels[level];
+        const std::string level_str = "level " + std::to_string(level);
+        cout << level_str << ": " << boxes.size() << " objects" << endl;
+        TEST_RESULT_COMPONENT_EQUAL(boxes.size(), gt_boxes.size(), level_str + " num objects");
+        for (size_t i = 0; i < boxes.size(); i++){
+            const std::string object_str = level_str + " object " + std::to_string(i);
+            TEST_RESULT_COMPONENT_EQUAL(boxes[i].second, gt_boxes[i].second, object_str + " area");
+            TEST_RESULT_COMPONENT_EQUAL(boxes[i].first.min_x, gt_boxes[i].first.min_x, object_str + " min_x");
+            TEST_RESULT_COMPONENT_EQUAL(boxes[i].first.min_y, gt_boxes[i].first.min_y, object_str + " min_y");
+            TEST_RESULT_COMPONENT_EQUAL(boxes[i].first.max_x, gt_boxes[i].first.max_x, object_str + " max_x");
+            TEST_RESULT_COMPONENT_EQUAL(boxes[i].first.max_y, gt_boxes[i].first.max_y, object_str + " max_y");
+        }
+    }
+
+    cout << "Separate waterfills: " << gt_ms << " ms, component tree: " << tree_ms << " ms" << endl;
+
+    return 0;
+}
+
 // Additional tests on binary matrix tile implementation
 template<class Tile> int test_binary_matrix_tile_t(){
     size_t num_iters = 100000;
@@ -980,4 +1371,89 @@ int test_binary_matrix_tile(){
     return 0;
 }
 
+
+int test_kernels_Xoroshiro128Plus(const std::string& config_path){
+    uint64_t seed = 0;
+    size_t words = 0;
+    {
+        std::ifstream file(config_path);
+        if (!(file >> seed >> words)){
+            cout << "Skip " << config_path << " as it does not start with \"<seed> <number of words>\"" << endl;
+            return -1;
+        }
+    }
+    const size_t LANES = XOROSHIRO128PLUS_LANES;
+
+    std::mt19937_64 rng(seed);
+    uint64_t start_s0[LANES];
+    uint64_t start_s1[LANES];
+    for (size_t l = 0; l < LANES; l++){
+        start_s0[l] = rng();
+        start_s1[l] = rng() | 1;
+    }
+
+    //  Step each generator one result at a time.
+    std::vector<uint64_t> expected(LANES * words);
+    uint64_t expected_s0[LANES];
+    uint64_t expected_s1[LANES];
+    for (size_t l = 0; l < LANES; l++){
+        uint64_t s0 = start_s0[l];
+        uint64_t s1 = start_s1[l];
+        for (size_t i = 0; i < 64 * words; i++){
+            expected[l * words + i / 64] |= ((s0 + s1) & 1) << (i % 64);
+            s1 ^= s0;
+            s0 = ((s0 << 24) | (s0 >> 40)) ^ s1 ^ (s1 << 16);
+            s1 = (s1 << 37) | (s1 >> 27);
+        }
+        expected_s0[l] = s0;
+        expected_s1[l] = s1;
+    }
+
+    //  Run the kernel at every CPU level this machine has, so both the
+    //  default and the vector versions are checked.
+    const CPU_Features saved = CPU_CAPABILITY_CURRENT;
+    for (const CpuCapabilityOption& level : AVAILABLE_CAPABILITIES()){
+        if (!level.available){
+            continue;
+        }
+        CPU_CAPABILITY_CURRENT = level.features;
+
+        //  Run it in two calls with a stride wider than a lane to check
+        //  that the generators carry on from where they stopped.
+        const size_t stride = words + 3;
+        const size_t first = words / 3;
+        std::vector<uint64_t> out(LANES * stride, 0);
+        uint64_t s0[LANES];
+        uint64_t s1[LANES];
+        memcpy(s0, start_s0, sizeof(s0));
+        memcpy(s1, start_s1, sizeof(s1));
+        xoroshiro128plus_last_bits(out.data(), stride, first, s0, s1);
+        xoroshiro128plus_last_bits(out.data() + first, stride, words - first, s0, s1);
+        CPU_CAPABILITY_CURRENT = saved;
+
+        for (size_t l = 0; l < LANES; l++){
+            for (size_t w = 0; w < words; w++){
+                if (out[l * stride + w] != expected[l * words + w]){
+                    cout << "Error: " << level.display << ": lane " << l << ", word " << w << " is " << out[l * stride + w]
+                         << ", but should be " << expected[l * words + w] << endl;
+                    return 1;
+                }
+            }
+            for (size_t w = words; w < stride; w++){
+                if (out[l * stride + w] != 0){
+                    cout << "Error: " << level.display << ": lane " << l << " wrote past its last word." << endl;
+                    return 1;
+                }
+            }
+            if (s0[l] != expected_s0[l] || s1[l] != expected_s1[l]){
+                cout << "Error: " << level.display << ": lane " << l << " did not end at the state after the last result." << endl;
+                return 1;
+            }
+        }
+        cout << level.display << ": " << LANES << " x " << words * 64 << " results match." << endl;
+    }
+
+    return 0;
+}
+
 }
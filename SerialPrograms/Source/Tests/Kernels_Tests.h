@@ -9,12 +9,16 @@
 #ifndef PokemonAutomation_Tests_Kernels_Tests_H
 #define PokemonAutomation_Tests_Kernels_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image);
 
+int test_kernels_ImageDownscale(const ImageViewRGB32& image);
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image);
 
 int test_kernels_FilterRGB32Range(const ImageViewRGB32& image);
@@ -29,8 +33,18 @@ int test_kernels_FilterByMask(const ImageViewRGB32& image);
 
 int test_kernels_CompressRGB32ToBinaryEuclidean(const ImageViewRGB32& image);
 
+int test_kernels_ImageHSV(const ImageViewRGB32& image);
+
+int test_kernels_ImageGradient(const ImageViewRGB32& image);
+
 int test_kernels_Waterfill(const ImageViewRGB32& image);
 
+int test_kernels_WaterfillComponentTree(const ImageViewRGB32& image);
+
+// Check the Xoroshiro128+ last bit kernel at every CPU level against a generator stepped one result at
+// a time. The test file holds the random seed and the number of 64-bit words per lane, e.g. "1 100".
+int test_kernels_Xoroshiro128Plus(const std::string& config_path);
+
 
 }
 
@@ -0,0 +1,132 @@
+/*  Pokemon Home Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+
+#include "PokemonHome/Programs/PokemonHome_BoxSortingPlanner.h"
+#include "PokemonHome_Tests.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace PokemonAutomation{
+
+using namespace NintendoSwitch::PokemonHome;
+
+
+int test_pokemonHome_BoxSortingPlanner(const std::string& config_path){
+    size_t seed = 0;
+    size_t num_layouts = 0;
+    {
+        std::ifstream file(config_path);
+        if (!(file >> seed >> num_layouts)){
+            cout << "Skip " << config_path << " as it does not start with \"<seed> <number of layouts>\"" << endl;
+            return -1;
+        }
+    }
+
+    std::mt19937 rng((std::mt19937::result_type)seed);
+    auto pick = [&](size_t count){
+        return std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+    };
+    const BoxSortingSortType SORT_TYPES[] = {
+        BoxSortingSortType::NationalDexNo,
+        BoxSortingSortType::Shiny,
+        BoxSortingSortType::Gigantamax,
+        BoxSortingSortType::Ball_Slug,
+        BoxSortingSortType::Gender,
+    };
+    const char* BALLS[] = {"poke-ball", "great-ball", "ultra-ball", "beast-ball"};
+    const StatsHuntGenderFilter GENDERS[] = {
+        StatsHuntGenderFilter::Male,
+        StatsHuntGenderFilter::Female,
+        StatsHuntGenderFilter::Genderless,
+    };
+
+    uint64_t total_plan_ticks = 0;
+    uint64_t total_greedy_ticks = 0;
+    for (size_t c = 0; c < num_layouts; c++){
+        std::vector<BoxSortingSelection> preferences;
+        for (BoxSortingSortType sort_type : SORT_TYPES){
+            if (pick(2) == 0){
+                preferences.emplace_back(BoxSortingSelection{sort_type, false});
+            }
+        }
+        std::shuffle(preferences.begin(), preferences.end(), rng);
+
+        //  Few species and many empty slots give lots of duplicates and
+        //  Pokemon that have to leave the sorted range.
+        const size_t slots = (1 + pick(4)) * MAX_ROWS * MAX_COLUMNS;
+        const size_t species = 1 + pick(slots);
+        const size_t empty_percent = pick(100);
+        std::vector<std::optional<NintendoSwitch::PokemonHome::Pokemon>> boxes_data(slots);
+        for (std::optional<NintendoSwitch::PokemonHome::Pokemon>& slot : boxes_data){
+            if (pick(100) < empty_percent){
+                continue;
+            }
+            NintendoSwitch::PokemonHome::Pokemon pokemon;
+            pokemon.preferences = &preferences;
+            pokemon.national_dex_number = (uint16_t)(1 + pick(species));
+            pokemon.shiny = pick(8) == 0;
+            pokemon.gmax = pick(8) == 0;
+            pokemon.ball_slug = BALLS[pick(4)];
+            pokemon.gender = GENDERS[pick(3)];
+            pokemon.ot_id = (uint32_t)pick(3);
+            slot = pokemon;
+        }
+        std::vector<std::optional<NintendoSwitch::PokemonHome::Pokemon>> boxes_sorted = boxes_data;
+        std::sort(boxes_sorted.begin(), boxes_sorted.end());
+
+        const Cursor cursor = get_cursor(pick(slots));
+        const uint16_t GAME_DELAY = (uint16_t)pick(30);
+        SortPlan greedy = plan_sort_greedy(boxes_data, boxes_sorted);
+        SortPlan plan = plan_sort_by_cycles(boxes_data, boxes_sorted, greedy, cursor, GAME_DELAY);
+
+        std::vector<std::optional<NintendoSwitch::PokemonHome::Pokemon>> boxes = boxes_data;
+        for (size_t i = 0; i < plan.swaps.size(); i++){
+            const SortSwap& swap = plan.swaps[i];
+            if (swap.pick >= slots || swap.drop >= slots){
+                cerr << "Error: layout " << c << ", swap " << i << " is out of range." << endl;
+                return 1;
+            }
+            if (!boxes[swap.pick].has_value()){
+                cerr << "Error: layout " << c << ", swap " << i << " picks up an empty slot." << endl;
+                return 1;
+            }
+            std::swap(boxes[swap.pick], boxes[swap.drop]);
+        }
+        if (boxes != boxes_sorted){
+            cerr << "Error: the plan for layout " << c << " does not sort it." << endl;
+            return 1;
+        }
+
+        uint64_t plan_ticks = estimate_sort_ticks(plan, cursor, GAME_DELAY);
+        uint64_t greedy_ticks = estimate_sort_ticks(greedy, cursor, GAME_DELAY);
+        if (plan.swaps.size() > greedy.swaps.size()){
+            cerr << "Error: layout " << c << " takes " << plan.swaps.size() << " swaps. The first-match order takes "
+                 << greedy.swaps.size() << "." << endl;
+            return 1;
+        }
+        if (plan_ticks > greedy_ticks){
+            cerr << "Error: layout " << c << " takes " << plan_ticks << " ticks. The first-match order takes "
+                 << greedy_ticks << "." << endl;
+            return 1;
+        }
+        total_plan_ticks += plan_ticks;
+        total_greedy_ticks += greedy_ticks;
+    }
+
+    cout << num_layouts << " layouts sorted in " << total_plan_ticks << " ticks. (first-match order: "
+         << total_greedy_ticks << " ticks)" << endl;
+    return 0;
+}
+
+
+}
@@ -0,0 +1,22 @@
+/*  Pokemon Home Tests
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+
+#ifndef PokemonAutomation_Tests_PokemonHome_Tests_H
+#define PokemonAutomation_Tests_PokemonHome_Tests_H
+
+#include <string>
+
+namespace PokemonAutomation{
+
+// Build random box layouts with duplicates and empty slots, apply the swaps planned by the box sorter and
+// check that they give the sorted order, and that the plan takes no more swaps and no more estimated time
+// than the first-match order. The test file holds the random seed and the number of layouts, e.g. "1 1000".
+int test_pokemonHome_BoxSortingPlanner(const std::string& config_path);
+
+}
+
+#endif
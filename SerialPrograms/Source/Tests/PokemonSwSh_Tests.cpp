@@ -6,6 +6,11 @@
 
 
 #include "Common/Compiler.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Concurrency/ParallelTaskRunner.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/Globals.h"
 #include "PokemonSwSh_Tests.h"
 #include "TestUtils.h"
 
@@ -16,14 +21,29 @@
 #include "PokemonSwSh/MaxLair/Inference/PokemonSwSh_MaxLair_Detect_BattleMenu.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_DialogBoxDetector.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_BoxShinySymbolDetector.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Types.h"
+#include "PokemonSwSh/Resources/PokemonSwSh_MaxLairDatabase.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathMatchup.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_RentalBossMatchup.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_Tools.h"
+#include "PokemonSwSh/Programs/RNG/PokemonSwSh_Xoroshiro128Plus.h"
 
 #include <QFileInfo>
 #include <QDir>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <memory>
+#include <random>
+#include <set>
 using std::cout;
 using std::cerr;
 using std::endl;
@@ -119,10 +139,685 @@ int test_pokemonSwSh_BoxShinySymbolDetector(const ImageViewRGB32& image, bool ta
 }
 
 int test_pokemonSwSh_BoxGenderDetector(const ImageViewRGB32& image, int target){
-    BoxGenderDetector detector;
+    NintendoSwitch::PokemonSwSh::BoxGenderDetector detector;
     const int result = int(detector.detect(image));
     TEST_RESULT_EQUAL(result, target);
     return 0;
 }
 
+
+
+namespace{
+
+using namespace NintendoSwitch::PokemonSwSh::MaxLairInternal;
+namespace papkmnlib = NintendoSwitch::PokemonSwSh::papkmnlib;
+
+//  The Max Lair matchup tables and the decisions that read them, as they were
+//  before the tables were made dense.
+class ReferenceMaxLairTables{
+public:
+    ReferenceMaxLairTables(){
+        {
+            std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/boss_matchup_LUT.json";
+            JsonValue json = load_json_file(path);
+            JsonObject& root = json.get_object_throw(path);
+            for (auto& item0 : root){
+                std::map<std::string, double>& sub = m_rental_vs_boss[item0.first];
+                JsonObject& obj = item0.second.get_object_throw(path);
+                for (auto& item1 : obj){
+                    sub[item1.first] = item1.second.get_double_throw(path);
+                }
+            }
+        }
+        {
+            std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/path_tree.json";
+            JsonValue json = load_json_file(path);
+            JsonObject& root = json.get_object_throw(path);
+            JsonObject& node = root.get_object_throw("base_node", path).get_object_throw("hash_table");
+            for (auto& item : node){
+                std::map<PokemonType, double>& boss = m_type_vs_boss[item.first];
+                JsonObject& obj = item.second.get_object_throw(path).get_object_throw("hash_table", path);
+                for (const auto& type : TYPE_ENUM_TO_SLUG){
+                    if (type.first == PokemonType::NONE){
+                        continue;
+                    }
+                    boss[type.first] = obj.get_double_throw(type.second, path);
+                }
+            }
+        }
+    }
+
+    const std::map<std::string, std::map<std::string, double>>& rental_vs_boss() const{ return m_rental_vs_boss; }
+    const std::map<std::string, std::map<PokemonType, double>>& type_vs_boss() const{ return m_type_vs_boss; }
+
+    double rental_vs_boss_matchup(const std::string& rental, const std::string& boss) const{
+        return m_rental_vs_boss.at(rental).at(boss);
+    }
+    double type_vs_boss(PokemonType type, const std::string& boss_slug) const{
+        return m_type_vs_boss.at(boss_slug).at(type);
+    }
+    double type_vs_boss(PokemonType type, PokemonType boss_type) const{
+        papkmnlib::Type pkmnlib_type = papkmnlib::serial_type_to_pkmnlib(boss_type);
+        double weight = 0;
+        size_t count = 0;
+        for (const auto& item : all_bosses_by_dex()){
+            const papkmnlib::Pokemon& boss = papkmnlib::get_pokemon(item.second);
+            if (boss_type == PokemonType::NONE || boss.has_type(pkmnlib_type)){
+                weight += type_vs_boss(type, boss.name());
+                count++;
+            }
+        }
+        return weight / (double)count;
+    }
+
+    double rental_vs_boss_matchup(const std::string& rental, const std::vector<const papkmnlib::Pokemon*>& bosses) const{
+        if (bosses.empty()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss list cannot be empty.");
+        }
+        double score = 0;
+        if (rental.empty()){
+            for (const papkmnlib::Pokemon* boss : bosses){
+                for (const auto& candidate : papkmnlib::all_rental_pokemon()){
+                    score += rental_vs_boss_matchup(candidate.first, boss->name());
+                }
+            }
+            score /= bosses.size() * papkmnlib::all_rental_pokemon().size();
+        }else{
+            for (const papkmnlib::Pokemon* boss : bosses){
+                score += rental_vs_boss_matchup(rental, boss->name());
+            }
+            score /= bosses.size();
+        }
+        return score;
+    }
+
+    double evaluate_hypothetical_team(
+        const GlobalState& state,
+        const papkmnlib::Pokemon* team[4],
+        const std::vector<const papkmnlib::Pokemon*>& boss_candidates_on_path
+    ) const{
+        uint8_t lives = 4;
+        double total = 0;
+        for (size_t c = 0; c < 4; c++){
+            double score = rental_vs_boss_matchup(team[c] == nullptr ? "" : team[c]->name(), boss_candidates_on_path);
+            if (team[c] != nullptr){
+                double hp = team[c]->hp_ratio();
+                if (hp >= 0){
+                    score *= (hp + lives - 1) / lives;
+                }
+            }
+            if (state.players[c].console_id < 0){
+                score *= 0.5;
+            }
+            total += score;
+        }
+        return total;
+    }
+
+    std::vector<PathNode> select_path(
+        const std::string& boss,
+        const PathMap& pathmap, uint8_t wins, int8_t path_side
+    ) const{
+        std::vector<std::vector<PathNode>> paths = generate_paths(pathmap, wins, path_side);
+        if (paths.empty()){
+            return {};
+        }
+        std::multimap<double, std::vector<PathNode>, std::greater<double>> rank;
+        for (const std::vector<PathNode>& path : paths){
+            rank.emplace(boss.empty() ? evaluate_path(pathmap.boss, path) : evaluate_path(boss, path), path);
+        }
+        return std::move(rank.begin()->second);
+    }
+
+    int8_t select_starter(const GlobalState& state, const std::string options[3]) const{
+        std::vector<const papkmnlib::Pokemon*> bosses = get_boss_candidates(state);
+        if (bosses.empty()){
+            return 0;
+        }
+        std::multimap<double, uint8_t, std::greater<double>> rank;
+        for (uint8_t c = 0; c < 3; c++){
+            if (options[c].empty()){
+                continue;
+            }
+            double score = 0;
+            for (const papkmnlib::Pokemon* boss : bosses){
+                score += rental_vs_boss_matchup(options[c], boss->name());
+            }
+            score /= bosses.size();
+            rank.emplace(score, c);
+        }
+        if (rank.empty()){
+            return 0;
+        }
+        return rank.begin()->second;
+    }
+
+    //  Serial, like it was before the matchups were scored on a thread pool.
+    bool should_swap_with_professor(const GlobalState& state, size_t player_index) const{
+        uint8_t lives = 4;
+
+        std::vector<const papkmnlib::Pokemon*> boss_candidates_on_path = get_boss_candidates(state);
+
+        std::unique_ptr<papkmnlib::Pokemon> current_team[4];
+        for (size_t c = 0; c < 4; c++){
+            current_team[c] = convert_player_to_pkmnlib(state.players[c]);
+        }
+
+        std::multimap<double, const papkmnlib::Pokemon*> list;
+        for (const papkmnlib::Pokemon* boss : boss_candidates_on_path){
+            for (const auto& rental : papkmnlib::all_rental_pokemon()){
+                if (state.seen.find(rental.first) != state.seen.end()){
+                    continue;
+                }
+                list.emplace(papkmnlib::evaluate_matchup(rental.second, *boss, {}, lives), &rental.second);
+            }
+        }
+        if (list.empty()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Opponent candidate list is empty.");
+        }
+        size_t midpoint = list.size() / 2;
+        for (size_t c = 0; c < midpoint; c++){
+            list.erase(list.begin());
+        }
+        const papkmnlib::Pokemon* average_rental = list.begin()->second;
+
+        std::multimap<double, int8_t, std::greater<double>> rank;
+        for (int8_t c = -1; c < 4; c++){
+            const papkmnlib::Pokemon* hypothetical_team[4];
+            for (size_t i = 0; i < 4; i++){
+                hypothetical_team[i] = current_team[i].get();
+            }
+            if (c >= 0){
+                hypothetical_team[c] = average_rental;
+            }
+            rank.emplace(evaluate_hypothetical_team(state, hypothetical_team, boss_candidates_on_path), c);
+        }
+        return rank.begin()->second == (int8_t)player_index;
+    }
+
+private:
+    template <typename Boss>
+    double evaluate_path(const Boss& boss, const std::vector<PathNode>& path) const{
+        const double weights[] = {1, 2, 3};
+        double weight = 0;
+        size_t battle_index = 3 - path.size();
+        size_t node_index = 0;
+        for (; battle_index < 3; node_index++, battle_index++){
+            weight += type_vs_boss(path[node_index].type, boss) * weights[battle_index];
+        }
+        return weight;
+    }
+
+private:
+    std::map<std::string, std::map<std::string, double>> m_rental_vs_boss;
+    std::map<std::string, std::map<PokemonType, double>> m_type_vs_boss;
+};
+
+
+//  Run both and return true if they both throw, or if they both return
+//  results that are "equal".
+template <typename Function0, typename Function1, typename Equal>
+bool same_outcome(Function0&& function0, Function1&& function1, Equal&& equal){
+    using Result = decltype(function0());
+    std::unique_ptr<Result> result0;
+    std::unique_ptr<Result> result1;
+    try{
+        result0 = std::make_unique<Result>(function0());
+    }catch (...){}
+    try{
+        result1 = std::make_unique<Result>(function1());
+    }catch (...){}
+    if (!result0 || !result1){
+        return !result0 && !result1;
+    }
+    return equal(*result0, *result1);
+}
+bool bit_equal(double x, double y){
+    return memcmp(&x, &y, sizeof(double)) == 0;
+}
+template <typename Type>
+bool equal(const Type& x, const Type& y){
+    return x == y;
+}
+bool same_path(const std::vector<PathNode>& x, const std::vector<PathNode>& y){
+    if (x.size() != y.size()){
+        return false;
+    }
+    for (size_t c = 0; c < x.size(); c++){
+        if (x[c].path_slot != y[c].path_slot || x[c].type != y[c].type){
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//  States at the points of a run where the AI picks a starter, a path or
+//  whether to take the professor's rental. Unread values are left unknown
+//  like they are in a real run.
+struct DecisionPoint{
+    const char* name;
+    GlobalState state;
+    std::string options[3];
+    size_t player_index;
+};
+PathMap make_path_map(
+    int8_t path_type, PokemonType boss,
+    std::initializer_list<PokemonType> mon3,
+    std::initializer_list<PokemonType> mon2,
+    std::initializer_list<PokemonType> mon1
+){
+    PathMap path;
+    path.path_type = path_type;
+    path.boss = boss;
+    std::copy(mon3.begin(), mon3.end(), path.mon3);
+    std::copy(mon2.begin(), mon2.end(), path.mon2);
+    std::copy(mon1.begin(), mon1.end(), path.mon1);
+    return path;
+}
+void set_player(GlobalState& state, size_t index, int8_t console_id, const std::string& pokemon, double hp, int8_t dead){
+    PlayerState& player = state.players[index];
+    player.console_id = console_id;
+    player.pokemon = pokemon;
+    Health health;
+    health.hp = hp;
+    health.dead = dead;
+    player.health = health;
+    if (!pokemon.empty()){
+        state.add_seen(pokemon);
+    }
+}
+std::vector<DecisionPoint> make_decision_points(){
+    using PT = PokemonType;
+    std::vector<DecisionPoint> ret;
+    {
+        //  One console with 3 NPCs, picking a starter before the path is read.
+        DecisionPoint& point = ret.emplace_back();
+        point.name = "starter, no path";
+        set_player(point.state, 0, 0, "", -1, -1);
+        set_player(point.state, 1, -1, "", -1, -1);
+        set_player(point.state, 2, -1, "", -1, -1);
+        set_player(point.state, 3, -1, "", -1, -1);
+        point.options[0] = "gengar";
+        point.options[1] = "machamp";
+        point.options[2] = "tentacruel";
+        point.player_index = 0;
+    }
+    {
+        //  Hunting a known boss, picking the last starter of 2 consoles.
+        DecisionPoint& point = ret.emplace_back();
+        point.name = "starter, boss known";
+        point.state.boss = "zapdos";
+        point.state.path = make_path_map(
+            0, PT::ELECTRIC,
+            {PT::WATER, PT::FIRE, PT::GRASS, PT::ROCK},
+            {PT::ICE, PT::GHOST, PT::FAIRY, PT::STEEL},
+            {PT::DRAGON, PT::POISON}
+        );
+        set_player(point.state, 0, 0, "alakazam", 1, 0);
+        set_player(point.state, 1, 1, "", -1, -1);
+        set_player(point.state, 2, -1, "onix", 1, 0);
+        set_player(point.state, 3, -1, "wartortle", 1, 0);
+        point.options[0] = "dugtrio";
+        point.options[1] = "electrode";
+        point.options[2] = "";
+        point.player_index = 1;
+    }
+    {
+        //  After the first win. The side isn't known yet and one HP bar
+        //  wasn't read.
+        DecisionPoint& point = ret.emplace_back();
+        point.name = "first win, side unknown";
+        point.state.path = make_path_map(
+            1, PT::DRAGON,
+            {PT::NORMAL, PT::FIGHTING, PT::FLYING, PT::BUG},
+            {PT::PSYCHIC, PT::DARK, PT::GROUND, PT::WATER},
+            {PT::FAIRY, PT::ICE}
+        );
+        point.state.wins = 1;
+        point.state.lives_left = 4;
+        set_player(point.state, 0, 0, "gengar", 0.45, 0);
+        set_player(point.state, 1, -1, "machamp", 1, 0);
+        set_player(point.state, 2, -1, "ivysaur", -1, -1);
+        set_player(point.state, 3, -1, "charmeleon", 0.8, 0);
+        point.state.add_seen("tentacruel");
+        point.state.add_seen("dugtrio");
+        point.options[0] = "onix";
+        point.options[1] = "alakazam";
+        point.options[2] = "electrode";
+        point.player_index = 0;
+    }
+    {
+        //  2 wins on the right side, hunting a boss with 4 consoles.
+        DecisionPoint& point = ret.emplace_back();
+        point.name = "second win, 4 consoles";
+        point.state.boss = "lugia";
+        point.state.path = make_path_map(
+            2, PT::PSYCHIC,
+            {PT::STEEL, PT::ELECTRIC, PT::GRASS, PT::FIRE},
+            {PT::DARK, PT::ROCK, PT::GHOST, PT::NORMAL},
+            {PT::BUG, PT::FIGHTING}
+        );
+        point.state.wins = 2;
+        point.state.path_side = 1;
+        point.state.lives_left = 2;
+        set_player(point.state, 0, 0, "wartortle", 0.2, 0);
+        set_player(point.state, 1, 1, "electrode", 0.65, 0);
+        set_player(point.state, 2, 2, "gengar", 1, 0);
+        set_player(point.state, 3, 3, "onix", 0.05, 0);
+        point.state.add_seen("machamp");
+        point.state.add_seen("alakazam");
+        point.state.add_seen("ivysaur");
+        point.state.add_seen("dugtrio");
+        point.state.add_seen("charmeleon");
+        point.options[0] = "tentacruel";
+        point.options[1] = "";
+        point.options[2] = "";
+        point.player_index = 3;
+    }
+    {
+        //  A fainted player and an NPC with an unread HP bar.
+        DecisionPoint& point = ret.emplace_back();
+        point.name = "first win, fainted player";
+        point.state.boss = "kyogre";
+        point.state.path = make_path_map(
+            0, PT::WATER,
+            {PT::GRASS, PT::ELECTRIC, PT::ICE, PT::POISON},
+            {PT::FIRE, PT::GROUND, PT::FLYING, PT::DRAGON},
+            {PT::STEEL, PT::FAIRY}
+        );
+        point.state.wins = 1;
+        point.state.path_side = 0;
+        point.state.lives_left = 3;
+        set_player(point.state, 0, 0, "ivysaur", 0, 1);
+        set_player(point.state, 1, 1, "tentacruel", 0.9, 0);
+        set_player(point.state, 2, -1, "dugtrio", -1, -1);
+        set_player(point.state, 3, -1, "alakazam", 0.3, 0);
+        point.state.add_seen("wartortle");
+        point.state.add_seen("gengar");
+        point.options[0] = "electrode";
+        point.options[1] = "machamp";
+        point.options[2] = "charmeleon";
+        point.player_index = 0;
+    }
+    for (DecisionPoint& point : ret){
+        std::vector<std::vector<PathNode>> paths = generate_paths(point.state.path, point.state.wins, point.state.path_side);
+        if (!paths.empty()){
+            point.state.last_best_path = paths[0];
+        }
+    }
+    return ret;
+}
+
+}
+
+
+int test_pokemonSwSh_MaxLair_AIMatchupTables(const std::string& config_path){
+    size_t seed = 0;
+    size_t num_states = 0;
+    {
+        std::ifstream file(config_path);
+        if (!(file >> seed >> num_states)){
+            cout << "Skip " << config_path << " as it does not start with \"<seed> <number of states>\"" << endl;
+            return -1;
+        }
+    }
+
+    const ReferenceMaxLairTables reference;
+    const size_t TYPE_COUNT = (size_t)PokemonType::FAIRY + 1;
+
+    //  Every entry of the tables.
+
+    std::set<std::string> all_bosses;
+    for (const auto& rental : reference.rental_vs_boss()){
+        for (const auto& boss : rental.second){
+            all_bosses.insert(boss.first);
+        }
+    }
+    for (const auto& rental : reference.rental_vs_boss()){
+        for (const std::string& boss : all_bosses){
+            if (!same_outcome(
+                [&]{ return rental_vs_boss_matchup(rental.first, boss); },
+                [&]{ return reference.rental_vs_boss_matchup(rental.first, boss); },
+                bit_equal
+            )){
+                cerr << "Error: rental_vs_boss_matchup(" << rental.first << ", " << boss << ") differs from the reference." << endl;
+                return 1;
+            }
+        }
+    }
+    for (const auto& boss : reference.type_vs_boss()){
+        for (size_t type = 1; type < TYPE_COUNT; type++){
+            if (!same_outcome(
+                [&]{ return type_vs_boss((PokemonType)type, boss.first); },
+                [&]{ return reference.type_vs_boss((PokemonType)type, boss.first); },
+                bit_equal
+            )){
+                cerr << "Error: type_vs_boss(" << type << ", " << boss.first << ") differs from the reference." << endl;
+                return 1;
+            }
+        }
+    }
+    for (size_t boss_type = 0; boss_type < TYPE_COUNT; boss_type++){
+        for (size_t type = 1; type < TYPE_COUNT; type++){
+            if (!same_outcome(
+                [&]{ return type_vs_boss((PokemonType)type, (PokemonType)boss_type); },
+                [&]{ return reference.type_vs_boss((PokemonType)type, (PokemonType)boss_type); },
+                bit_equal
+            )){
+                cerr << "Error: type_vs_boss(" << type << ", boss type " << boss_type << ") differs from the reference." << endl;
+                return 1;
+            }
+        }
+    }
+
+    //  Decisions on random states.
+
+    std::vector<std::string> rentals;
+    for (const auto& item : papkmnlib::all_rental_pokemon()){
+        rentals.emplace_back(item.first);
+    }
+    std::vector<std::string> bosses;
+    for (const auto& item : papkmnlib::all_boss_pokemon()){
+        bosses.emplace_back(item.first);
+    }
+
+    std::mt19937 rng((std::mt19937::result_type)seed);
+    auto pick = [&](size_t count){
+        return std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+    };
+    auto random_type = [&]{
+        return (PokemonType)(1 + pick(TYPE_COUNT - 1));
+    };
+
+    Logger& logger = global_logger_command_line();
+    ParallelTaskRunner task_runner([](){}, 0, 0);
+
+    auto check_decisions = [&](const std::string& name, const GlobalState& state, const std::string options[3], size_t player_index){
+        if (!same_outcome(
+            [&]{ return select_path(nullptr, state.boss, state.path, state.wins, state.path_side); },
+            [&]{ return reference.select_path(state.boss, state.path, state.wins, state.path_side); },
+            same_path
+        )){
+            cerr << "Error: select_path() differs from the reference on " << name << ":\n" << state.dump() << endl;
+            return false;
+        }
+        if (!same_outcome(
+            [&]{ return select_starter(logger, state, 0, options); },
+            [&]{ return reference.select_starter(state, options); },
+            equal<int8_t>
+        )){
+            cerr << "Error: select_starter() differs from the reference on " << name << ":\n" << state.dump() << endl;
+            return false;
+        }
+
+        std::vector<const papkmnlib::Pokemon*> boss_candidates = get_boss_candidates(state);
+        std::unique_ptr<papkmnlib::Pokemon> current_team[4];
+        const papkmnlib::Pokemon* team[4];
+        for (size_t i = 0; i < 4; i++){
+            current_team[i] = convert_player_to_pkmnlib(state.players[i]);
+            team[i] = current_team[i].get();
+        }
+        if (!same_outcome(
+            [&]{ return evaluate_hypothetical_team(state, team, {}, boss_candidates); },
+            [&]{ return reference.evaluate_hypothetical_team(state, team, boss_candidates); },
+            bit_equal
+        )){
+            cerr << "Error: evaluate_hypothetical_team() differs from the reference on " << name << ":\n" << state.dump() << endl;
+            return false;
+        }
+
+        if (!same_outcome(
+            [&]{ return should_swap_with_professor(logger, task_runner, state, player_index); },
+            [&]{ return reference.should_swap_with_professor(state, player_index); },
+            equal<bool>
+        )){
+            cerr << "Error: should_swap_with_professor() differs from the reference on " << name << ":\n" << state.dump() << endl;
+            return false;
+        }
+        return true;
+    };
+
+    for (size_t c = 0; c < num_states; c++){
+        GlobalState state;
+        if (pick(3) == 0){
+            state.boss = bosses[pick(bosses.size())];
+        }
+        state.path.path_type = (int8_t)pick(3);
+        state.path.boss = (PokemonType)pick(TYPE_COUNT);
+        for (PokemonType& type : state.path.mon3){
+            type = random_type();
+        }
+        for (PokemonType& type : state.path.mon2){
+            type = random_type();
+        }
+        for (PokemonType& type : state.path.mon1){
+            type = random_type();
+        }
+        state.wins = (uint8_t)pick(3);
+        state.path_side = (int8_t)pick(3) - 1;
+        for (size_t i = 0; i < 4; i++){
+            PlayerState& player = state.players[i];
+            player.console_id = pick(4) == 0 ? -1 : (int8_t)i;
+            if (pick(5) != 0){
+                player.pokemon = rentals[pick(rentals.size())];
+                state.add_seen(player.pokemon);
+            }
+            Health health;
+            health.hp = pick(101) / 100.;
+            health.dead = 0;
+            player.health = health;
+        }
+        for (size_t i = pick(20); i > 0; i--){
+            state.add_seen(rentals[pick(rentals.size())]);
+        }
+        std::vector<std::vector<PathNode>> paths = generate_paths(state.path, state.wins, state.path_side);
+        if (!paths.empty()){
+            state.last_best_path = paths[pick(paths.size())];
+        }
+
+        std::string options[3];
+        for (std::string& option : options){
+            if (pick(4) != 0){
+                option = rentals[pick(rentals.size())];
+            }
+        }
+        if (!check_decisions("random state " + std::to_string(c), state, options, pick(4))){
+            return 1;
+        }
+    }
+
+    //  Decisions on states from the points of a run that call into the AI.
+
+    std::vector<DecisionPoint> points = make_decision_points();
+    for (const DecisionPoint& point : points){
+        //  A misspelled slug would make both sides throw and pass.
+        std::set<std::string> slugs = point.state.seen;
+        slugs.insert(point.options, point.options + 3);
+        slugs.erase("");
+        for (const std::string& slug : slugs){
+            if (papkmnlib::all_rental_pokemon().find(slug) == papkmnlib::all_rental_pokemon().end()){
+                cerr << "Error: \"" << point.name << "\" uses unknown rental " << slug << "." << endl;
+                return 1;
+            }
+        }
+        if (!point.state.boss.empty() && papkmnlib::all_boss_pokemon().find(point.state.boss) == papkmnlib::all_boss_pokemon().end()){
+            cerr << "Error: \"" << point.name << "\" uses unknown boss " << point.state.boss << "." << endl;
+            return 1;
+        }
+        if (!check_decisions(point.name, point.state, point.options, point.player_index)){
+            return 1;
+        }
+    }
+
+    cout << "Matchup tables, " << num_states << " random states and " << points.size() << " run states match the reference." << endl;
+    return 0;
+}
+
+
+int test_pokemonSwSh_Xoroshiro128Plus(const std::string& config_path){
+    uint64_t seed = 0;
+    {
+        std::ifstream file(config_path);
+        if (!(file >> seed)){
+            cout << "Skip " << config_path << " as it does not start with \"<seed>\"" << endl;
+            return -1;
+        }
+    }
+    std::mt19937_64 rng(seed);
+    const Xoroshiro128PlusState start(rng(), rng() | 1);
+
+    auto same_state = [](const Xoroshiro128PlusState& x, const Xoroshiro128PlusState& y){
+        return x.s0 == y.s0 && x.s1 == y.s1;
+    };
+
+    //  advance() steps the low 6 bits and jumps the rest. Cover every count
+    //  on both sides of the first few jumps.
+    {
+        Xoroshiro128Plus stepped(start);
+        for (uint64_t advances = 0; advances <= 1000; advances++){
+            Xoroshiro128Plus jumped(start);
+            jumped.advance(advances);
+            if (!same_state(jumped.state, stepped.state)){
+                cerr << "Error: advance(" << advances << ") is not the same as " << advances << " calls to next()." << endl;
+                return 1;
+            }
+            stepped.next();
+        }
+    }
+    for (uint64_t advances : {4095, 4096, 4097, 65536 + 63, 1000003, (1 << 20) + 64}){
+        Xoroshiro128Plus jumped(start);
+        jumped.advance(advances);
+        Xoroshiro128Plus stepped(start);
+        for (uint64_t c = 0; c < advances; c++){
+            stepped.next();
+        }
+        if (!same_state(jumped.state, stepped.state)){
+            cerr << "Error: advance(" << advances << ") is not the same as " << advances << " calls to next()." << endl;
+            return 1;
+        }
+    }
+
+    //  generate_last_bits() jumps a generator to the start of each lane.
+    //  Include counts that leave lanes partly filled or empty.
+    for (size_t count : {0, 1, 63, 64, 65, 511, 512, 513, 8 * 64 * 5 + 17, 100000}){
+        std::vector<uint64_t> bits = Xoroshiro128Plus(start).generate_last_bits(count);
+        if (bits.size() != (count + 63) / 64){
+            cerr << "Error: generate_last_bits(" << count << ") returned " << bits.size() << " words." << endl;
+            return 1;
+        }
+        Xoroshiro128Plus stepped(start);
+        for (size_t i = 0; i < bits.size() * 64; i++){
+            uint64_t expected = i < count ? stepped.next() & 1 : 0;
+            if (((bits[i / 64] >> (i % 64)) & 1) != expected){
+                cerr << "Error: generate_last_bits(" << count << "), bit " << i << " should be " << expected << "." << endl;
+                return 1;
+            }
+        }
+    }
+
+    cout << "advance() and generate_last_bits() match next()." << endl;
+    return 0;
+}
+
 }
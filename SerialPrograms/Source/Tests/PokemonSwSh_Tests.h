@@ -38,6 +38,16 @@ int test_pokemonSwSh_BoxShinySymbolDetector(const ImageViewRGB32& image, bool ta
 
 int test_pokemonSwSh_BoxGenderDetector(const ImageViewRGB32& image, int target);
 
+// Build random Max Lair GlobalStates, plus states like the ones a run has when it calls into the AI, and
+// check that the AI gives exactly the same path, starter, team score and professor swap decisions as the
+// original map-based matchup tables, and that every table entry is the same. The test file holds the
+// random seed and the number of random states, e.g. "1 20".
+int test_pokemonSwSh_MaxLair_AIMatchupTables(const std::string& config_path);
+
+// Check Xoroshiro128Plus::advance() and generate_last_bits() against calls to next(), starting from a
+// random state. The test file holds the random seed, e.g. "1".
+int test_pokemonSwSh_Xoroshiro128Plus(const std::string& config_path);
+
 }
 
 #endif
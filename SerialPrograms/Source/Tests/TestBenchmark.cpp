@@ -0,0 +1,224 @@
+/*  Test Benchmark
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ */
+
+#include <stdlib.h>
+#include <new>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Containers/AlignedMalloc.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "TestBenchmark.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+
+#ifdef PA_BENCHMARK_ALLOCATIONS
+
+#include <atomic>
+
+//  Count every allocation that goes through the global operator new.
+//  The aligned overloads are left alone. Nothing in the program uses them.
+namespace{
+std::atomic<uint64_t> operator_new_calls(0);
+
+void* counted_malloc(size_t bytes){
+    operator_new_calls.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(bytes == 0 ? 1 : bytes);
+    if (ptr == nullptr){
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+void* counted_malloc(size_t bytes, const std::nothrow_t&) noexcept{
+    operator_new_calls.fetch_add(1, std::memory_order_relaxed);
+    return malloc(bytes == 0 ? 1 : bytes);
+}
+}
+
+void* operator new  (size_t bytes){ return counted_malloc(bytes); }
+void* operator new[](size_t bytes){ return counted_malloc(bytes); }
+void* operator new  (size_t bytes, const std::nothrow_t& tag) noexcept{ return counted_malloc(bytes, tag); }
+void* operator new[](size_t bytes, const std::nothrow_t& tag) noexcept{ return counted_malloc(bytes, tag); }
+void operator delete  (void* ptr) noexcept{ free(ptr); }
+void operator delete[](void* ptr) noexcept{ free(ptr); }
+void operator delete  (void* ptr, size_t) noexcept{ free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept{ free(ptr); }
+void operator delete  (void* ptr, const std::nothrow_t&) noexcept{ free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept{ free(ptr); }
+
+#endif
+
+
+
+namespace PokemonAutomation{
+
+
+#ifdef PA_BENCHMARK_ALLOCATIONS
+uint64_t test_benchmark_allocations(){
+    return operator_new_calls.load(std::memory_order_relaxed) + aligned_malloc_calls();
+}
+#endif
+
+
+namespace{
+
+//  Mute stdout and stderr for as long as this is alive.
+class MuteConsole{
+public:
+    MuteConsole()
+        : m_cout(cout.rdbuf(nullptr))
+        , m_cerr(cerr.rdbuf(nullptr))
+    {}
+    ~MuteConsole(){
+        cout.rdbuf(m_cout);
+        cerr.rdbuf(m_cerr);
+    }
+
+private:
+    std::streambuf* m_cout;
+    std::streambuf* m_cerr;
+};
+
+}
+
+
+
+TestBenchmark& TestBenchmark::instance(){
+    static TestBenchmark benchmark;
+    return benchmark;
+}
+
+void TestBenchmark::begin_file(const std::string& test_name, const std::string& file_path, const std::string& cpu_level){
+    m_test_name = test_name;
+    m_file_path = file_path;
+    m_cpu_level = cpu_level;
+    m_ran = false;
+}
+
+int TestBenchmark::run(const std::function<int()>& test){
+    m_ran = true;
+    int ret = test();
+    if (ret != 0 || m_iterations == 0){
+        return ret;
+    }
+
+    std::vector<double> times;
+    times.reserve(m_iterations);
+
+#ifdef PA_BENCHMARK_ALLOCATIONS
+    uint64_t allocations;
+#endif
+    {
+        MuteConsole mute;
+#ifdef PA_BENCHMARK_ALLOCATIONS
+        uint64_t allocations0 = test_benchmark_allocations();
+#endif
+        for (size_t c = 0; c < m_iterations; c++){
+            WallClock time0 = current_time();
+            test();
+            WallClock time1 = current_time();
+            times.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(time1 - time0).count() / 1000.);
+        }
+#ifdef PA_BENCHMARK_ALLOCATIONS
+        //  Don't count the allocations from "times" growing. It was reserved above.
+        allocations = test_benchmark_allocations() - allocations0;
+#endif
+    }
+
+    double sum = 0;
+    for (double time : times){
+        sum += time;
+    }
+    std::sort(times.begin(), times.end());
+
+    TestBenchmarkResult result;
+    result.test_name = m_test_name;
+    result.file_path = m_file_path;
+    result.cpu_level = m_cpu_level;
+    result.iterations = m_iterations;
+    result.min = times.front();
+    result.median = times[times.size() / 2];
+    result.p99 = times[std::min(times.size() - 1, (times.size() * 99 + 99) / 100 - 1)];
+    result.mean = sum / times.size();
+#ifdef PA_BENCHMARK_ALLOCATIONS
+    result.allocations = (double)allocations / m_iterations;
+#endif
+
+    cout << "Benchmark (" << m_cpu_level << "): "
+         << "min = " << result.min << " us, median = " << result.median << " us, p99 = " << result.p99 << " us";
+    if (result.allocations >= 0){
+        cout << ", allocations = " << result.allocations;
+    }
+    cout << endl;
+
+    m_results.emplace_back(std::move(result));
+    return ret;
+}
+
+void TestBenchmark::print() const{
+    cout << "Benchmark results (" << m_iterations << " iterations, times in us):" << endl;
+    cout << std::left << std::setw(12) << "CPU"
+         << std::right << std::setw(12) << "min"
+         << std::setw(12) << "median"
+         << std::setw(12) << "p99"
+         << std::setw(12) << "allocs"
+         << "  " << "test" << endl;
+    for (const TestBenchmarkResult& result : m_results){
+        cout << std::left << std::setw(12) << result.cpu_level
+             << std::right << std::fixed << std::setprecision(2)
+             << std::setw(12) << result.min
+             << std::setw(12) << result.median
+             << std::setw(12) << result.p99;
+        if (result.allocations >= 0){
+            cout << std::setw(12) << result.allocations;
+        }else{
+            cout << std::setw(12) << "-";
+        }
+        cout << "  " << result.file_path << endl;
+    }
+    cout << std::defaultfloat << std::setprecision(6);
+}
+
+void TestBenchmark::save(const std::string& path) const{
+    //  {"tests": {<test>: {<file>: {<cpu level>: {...}}}}}
+    JsonObject tests;
+    for (const TestBenchmarkResult& result : m_results){
+        JsonObject stats;
+        stats["min_us"] = result.min;
+        stats["median_us"] = result.median;
+        stats["p99_us"] = result.p99;
+        stats["mean_us"] = result.mean;
+        if (result.allocations >= 0){
+            stats["allocations"] = result.allocations;
+        }
+
+        JsonValue& test = tests[result.test_name];
+        if (!test.is_object()){
+            test = JsonObject();
+        }
+        JsonValue& file = (*test.get_object())[result.file_path];
+        if (!file.is_object()){
+            file = JsonObject();
+        }
+        (*file.get_object())[result.cpu_level] = std::move(stats);
+    }
+
+    JsonObject root;
+    root["arch"] = PA_ARCH_STRING;
+    root["iterations"] = m_iterations;
+    root["tests"] = std::move(tests);
+    root.dump(path);
+}
+
+
+
+}
@@ -0,0 +1,106 @@
+/*  Test Benchmark
+ *
+ *  From: https://github.com/PokemonAutomation/Arduino-Source
+ *
+ *  Benchmark mode for the command line tests.
+ *
+ *  When "20-GlobalSettings": "COMMAND_LINE_TESTS": "BENCHMARK_ITERATIONS" is
+ *  non-zero, every test file is first run once as a normal test. If it passes,
+ *  the test code is run that many more times with its console output muted and
+ *  each call is timed. The image and audio loading done by the TestMap.h
+ *  helpers is not part of the timing. Tests that don't use those helpers are
+ *  timed as a whole.
+ *
+ *  For each test file, the benchmark records min/median/p99 wall time. Builds
+ *  with PA_BENCHMARK_ALLOCATIONS defined also record the number of heap
+ *  allocations per call. Allocations are calls to the global "operator new"
+ *  and to "aligned_malloc()" (which backs all image buffers). Counting them
+ *  replaces the global "operator new", so it is left out of normal builds.
+ *
+ *  Kernel tests (test space "Kernels") are run once for every CPU dispatch
+ *  level that the machine supports, by setting CPU_CAPABILITY_CURRENT.
+ *
+ *  The results are written as JSON to
+ *  "20-GlobalSettings": "COMMAND_LINE_TESTS": "BENCHMARK_OUTPUT".
+ *  Keys are sorted so that the files from two builds can be diffed directly.
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_TestBenchmark_H
+#define PokemonAutomation_Tests_TestBenchmark_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace PokemonAutomation{
+
+
+struct TestBenchmarkResult{
+    std::string test_name;
+    std::string file_path;
+    std::string cpu_level;
+
+    size_t iterations = 0;
+
+    //  Wall time per call in microseconds.
+    double min = 0;
+    double median = 0;
+    double p99 = 0;
+    double mean = 0;
+
+    //  Heap allocations per call. Negative if they weren't counted.
+    double allocations = -1;
+};
+
+
+class TestBenchmark{
+public:
+    static TestBenchmark& instance();
+
+    size_t iterations() const{ return m_iterations; }
+    bool enabled() const{ return m_iterations > 0; }
+    void set_iterations(size_t iterations){ m_iterations = iterations; }
+
+    //  Called by the test runner before each test file.
+    void begin_file(const std::string& test_name, const std::string& file_path, const std::string& cpu_level);
+
+    //  Run "test" once. If benchmarking is enabled and the test passes, run it
+    //  again "iterations()" times and record the timings for the current file.
+    //  Returns the result of the first run.
+    int run(const std::function<int()>& test);
+
+    //  Whether "run()" has been called since the last "begin_file()".
+    bool ran() const{ return m_ran; }
+
+    const std::vector<TestBenchmarkResult>& results() const{ return m_results; }
+
+    //  Print a summary table to stdout.
+    void print() const;
+
+    //  Throws FileException if the file can't be written.
+    void save(const std::string& path) const;
+
+
+private:
+    size_t m_iterations = 0;
+
+    std::string m_test_name;
+    std::string m_file_path;
+    std::string m_cpu_level;
+    bool m_ran = false;
+
+    std::vector<TestBenchmarkResult> m_results;
+};
+
+
+#ifdef PA_BENCHMARK_ALLOCATIONS
+//  Number of heap allocations done by the process so far.
+uint64_t test_benchmark_allocations();
+#endif
+
+
+
+}
+#endif
@@ -9,10 +9,12 @@
 #include "CommonFramework_Tests.h"
 #include "Kernels_Tests.h"
 #include "NintendoSwitch_Tests.h"
+#include "PokemonHome_Tests.h"
 #include "PokemonLA_Tests.h"
 #include "PokemonSwSh_Tests.h"
 #include "PokemonSV_Tests.h"
 #include "TestMap.h"
+#include "TestBenchmark.h"
 #include "TestUtils.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
 
@@ -74,7 +76,7 @@ int image_filename_detector_helper(ImageFilenameFunction test_func, const std::s
         cout << "Skip " << test_path << " as it cannot be read as image" << endl;
         return -1;
     }
-    return test_func(image, basename);
+    return TestBenchmark::instance().run([&](){ return test_func(image, basename); });
 }
 
 
@@ -212,7 +214,7 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
     // from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
     std::reverse(spectrums.begin(), spectrums.end());
 
-    return test_func(spectrums, target_bool);
+    return TestBenchmark::instance().run([&](){ return test_func(spectrums, target_bool); });
 }
 
 
@@ -220,14 +222,24 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
 
 const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_ImageScaleBrightness", std::bind(image_void_detector_helper, test_kernels_ImageScaleBrightness, _1)},
+    {"Kernels_ImageDownscale", std::bind(image_void_detector_helper, test_kernels_ImageDownscale, _1)},
     {"Kernels_BinaryMatrix", std::bind(image_void_detector_helper, test_kernels_BinaryMatrix, _1)},
     {"Kernels_FilterRGB32Range", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Range, _1)},
     {"Kernels_FilterRGB32Euclidean", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Euclidean, _1)},
     {"Kernels_ToBlackWhiteRGB32Range", std::bind(image_void_detector_helper, test_kernels_ToBlackWhiteRGB32Range, _1)},
     {"Kernels_FilterByMask", std::bind(image_void_detector_helper, test_kernels_FilterByMask, _1)},
     {"Kernels_CompressRGB32ToBinaryEuclidean", std::bind(image_void_detector_helper, test_kernels_CompressRGB32ToBinaryEuclidean, _1)},
+    {"Kernels_ImageHSV", std::bind(image_void_detector_helper, test_kernels_ImageHSV, _1)},
+    {"Kernels_ImageGradient", std::bind(image_void_detector_helper, test_kernels_ImageGradient, _1)},
     {"Kernels_Waterfill", std::bind(image_void_detector_helper, test_kernels_Waterfill, _1)},
+    {"Kernels_WaterfillComponentTree", std::bind(image_void_detector_helper, test_kernels_WaterfillComponentTree, _1)},
+    {"Kernels_Xoroshiro128Plus", test_kernels_Xoroshiro128Plus},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
+    {"CommonFramework_DictionaryMatchIndex", test_CommonFramework_DictionaryMatchIndex},
+    {"CommonFramework_SpectrogramMatcherEngines", test_CommonFramework_SpectrogramMatcherEngines},
+    {"CommonFramework_SpectrogramMatcherReference", test_CommonFramework_SpectrogramMatcherReference},
+    {"CommonFramework_FileWindowLoggerThroughput", test_CommonFramework_FileWindowLoggerThroughput},
+    {"CommonFramework_InferenceReplay", test_CommonFramework_InferenceReplay},
     {"NintendoSwitch_UpdateMenuDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdateMenuDetector, _1)},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
     {"PokemonSwSh_MaxLair_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_MaxLair_BattleMenuDetector, _1)},
@@ -240,6 +252,9 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSwSh_BlackDialogBoxDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BlackDialogBoxDetector, _1)},
     {"PokemonSwSh_BoxShinySymbolDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BoxShinySymbolDetector, _1)},
     {"PokemonSwSh_BoxGenderDetector", std::bind(image_int_detector_helper, test_pokemonSwSh_BoxGenderDetector, _1)},
+    {"PokemonSwSh_MaxLair_AIMatchupTables", test_pokemonSwSh_MaxLair_AIMatchupTables},
+    {"PokemonSwSh_Xoroshiro128Plus", test_pokemonSwSh_Xoroshiro128Plus},
+    {"PokemonHome_BoxSortingPlanner", test_pokemonHome_BoxSortingPlanner},
     {"PokemonLA_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattleMenuDetector, _1)},
     {"PokemonLA_BattlePokemonSwitchDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattlePokemonSwitchDetector, _1)},
     {"PokemonLA_TransparentDialogueDetector", std::bind(image_bool_detector_helper, test_pokemonLA_TransparentDialogueDetector, _1)},